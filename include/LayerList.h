@@ -0,0 +1,344 @@
+#pragma once
+
+#include <set>
+#include <memory>
+#include <cstdint>
+#include <limits>
+#include <iterator>
+#include <initializer_list>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace scene
+{
+
+/**
+ * The set of layer IDs a node is member of.
+ *
+ * Layer IDs are small non-negative integers in practice, so membership
+ * is stored as a 64 bit mask, testing against another set (e.g. the set of
+ * visible layers) is a single AND operation. IDs outside the mask range
+ * are kept in a separately allocated std::set, which is only present when
+ * needed.
+ *
+ * The interface is a subset of std::set<int>, iteration yields the IDs
+ * in ascending order.
+ */
+class LayerList
+{
+public:
+	using value_type = int;
+	using size_type = std::size_t;
+
+	// Number of layer IDs stored in the bit mask: 0..InlineBits-1
+	static constexpr int InlineBits = 64;
+
+private:
+	std::uint64_t _bits;
+
+	// Negative IDs and IDs >= InlineBits, rarely allocated
+	std::unique_ptr<std::set<int>> _overflow;
+
+public:
+	class const_iterator
+	{
+	private:
+		const LayerList* _list;
+		int _value;
+		bool _end;
+
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = int;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const int*;
+		using reference = const int&;
+
+		const_iterator(const LayerList* list, int value, bool end) :
+			_list(list),
+			_value(value),
+			_end(end)
+		{}
+
+		reference operator*() const
+		{
+			return _value;
+		}
+
+		pointer operator->() const
+		{
+			return &_value;
+		}
+
+		const_iterator& operator++()
+		{
+			_end = !_list->findFrom(static_cast<long long>(_value) + 1, _value);
+			return *this;
+		}
+
+		const_iterator operator++(int)
+		{
+			auto copy = *this;
+			++(*this);
+			return copy;
+		}
+
+		bool operator==(const const_iterator& other) const
+		{
+			return _end == other._end && (_end || _value == other._value);
+		}
+
+		bool operator!=(const const_iterator& other) const
+		{
+			return !operator==(other);
+		}
+	};
+
+	using iterator = const_iterator;
+
+	LayerList() :
+		_bits(0)
+	{}
+
+	LayerList(std::initializer_list<int> ids) :
+		LayerList()
+	{
+		insert(ids.begin(), ids.end());
+	}
+
+	LayerList(const LayerList& other) :
+		_bits(other._bits),
+		_overflow(other._overflow ? std::make_unique<std::set<int>>(*other._overflow) : nullptr)
+	{}
+
+	LayerList(LayerList&& other) noexcept = default;
+
+	LayerList& operator=(const LayerList& other)
+	{
+		if (this != &other)
+		{
+			_bits = other._bits;
+			_overflow = other._overflow ? std::make_unique<std::set<int>>(*other._overflow) : nullptr;
+		}
+
+		return *this;
+	}
+
+	LayerList& operator=(LayerList&& other) noexcept = default;
+
+	void insert(int id)
+	{
+		if (isInline(id))
+		{
+			_bits |= bit(id);
+			return;
+		}
+
+		if (!_overflow)
+		{
+			_overflow = std::make_unique<std::set<int>>();
+		}
+
+		_overflow->insert(id);
+	}
+
+	template<typename InputIterator>
+	void insert(InputIterator first, InputIterator last)
+	{
+		for (; first != last; ++first)
+		{
+			insert(*first);
+		}
+	}
+
+	// Removes the given ID, returns the number of removed elements (0 or 1)
+	size_type erase(int id)
+	{
+		if (isInline(id))
+		{
+			auto wasSet = (_bits & bit(id)) != 0;
+			_bits &= ~bit(id);
+			return wasSet ? 1 : 0;
+		}
+
+		if (!_overflow)
+		{
+			return 0;
+		}
+
+		auto erased = _overflow->erase(id);
+
+		if (_overflow->empty())
+		{
+			_overflow.reset();
+		}
+
+		return erased;
+	}
+
+	void clear()
+	{
+		_bits = 0;
+		_overflow.reset();
+	}
+
+	bool contains(int id) const
+	{
+		if (isInline(id))
+		{
+			return (_bits & bit(id)) != 0;
+		}
+
+		return _overflow && _overflow->count(id) > 0;
+	}
+
+	size_type count(int id) const
+	{
+		return contains(id) ? 1 : 0;
+	}
+
+	const_iterator find(int id) const
+	{
+		return contains(id) ? const_iterator(this, id, false) : end();
+	}
+
+	bool empty() const
+	{
+		return _bits == 0 && !_overflow;
+	}
+
+	size_type size() const
+	{
+		return popCount(_bits) + (_overflow ? _overflow->size() : 0);
+	}
+
+	// Returns true if both sets share at least one layer ID
+	bool intersects(const LayerList& other) const
+	{
+		if ((_bits & other._bits) != 0)
+		{
+			return true;
+		}
+
+		if (!_overflow || !other._overflow)
+		{
+			return false;
+		}
+
+		for (auto id : *_overflow)
+		{
+			if (other._overflow->count(id) > 0) return true;
+		}
+
+		return false;
+	}
+
+	const_iterator begin() const
+	{
+		int first = 0;
+		bool found = findFrom(static_cast<long long>(std::numeric_limits<int>::min()), first);
+		return const_iterator(this, first, !found);
+	}
+
+	const_iterator end() const
+	{
+		return const_iterator(this, 0, true);
+	}
+
+	bool operator==(const LayerList& other) const
+	{
+		if (_bits != other._bits) return false;
+
+		if (!_overflow || !other._overflow)
+		{
+			return !_overflow && !other._overflow;
+		}
+
+		return *_overflow == *other._overflow;
+	}
+
+	bool operator!=(const LayerList& other) const
+	{
+		return !operator==(other);
+	}
+
+private:
+	static bool isInline(int id)
+	{
+		return id >= 0 && id < InlineBits;
+	}
+
+	static std::uint64_t bit(int id)
+	{
+		return static_cast<std::uint64_t>(1) << id;
+	}
+
+	static size_type popCount(std::uint64_t bits)
+	{
+		size_type count = 0;
+
+		for (; bits != 0; bits &= bits - 1)
+		{
+			++count;
+		}
+
+		return count;
+	}
+
+	static int lowestBit(std::uint64_t bits)
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward64(&index, bits);
+		return static_cast<int>(index);
+#else
+		return __builtin_ctzll(bits);
+#endif
+	}
+
+	// Finds the smallest contained ID >= from, returns false if there is none
+	bool findFrom(long long from, int& result) const
+	{
+		if (from < InlineBits)
+		{
+			if (from < 0 && _overflow)
+			{
+				auto candidate = _overflow->lower_bound(static_cast<int>(from));
+
+				if (candidate != _overflow->end() && *candidate < 0)
+				{
+					result = *candidate;
+					return true;
+				}
+			}
+
+			auto start = from < 0 ? 0 : static_cast<int>(from);
+			auto remaining = _bits & (~static_cast<std::uint64_t>(0) << start);
+
+			if (remaining != 0)
+			{
+				result = lowestBit(remaining);
+				return true;
+			}
+
+			from = InlineBits;
+		}
+
+		if (_overflow && from <= std::numeric_limits<int>::max())
+		{
+			auto candidate = _overflow->lower_bound(static_cast<int>(from));
+
+			if (candidate != _overflow->end())
+			{
+				result = *candidate;
+				return true;
+			}
+		}
+
+		return false;
+	}
+};
+
+}
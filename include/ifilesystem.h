@@ -12,6 +12,7 @@
 #include <set>
 #include <functional>
 #include <algorithm>
+#include <sigc++/signal.h>
 
 #include "imodule.h"
 #include "iarchive.h"
@@ -203,6 +204,10 @@ public:
 	virtual void addObserver(Observer& observer) = 0;
 	virtual void removeObserver(Observer& observer) = 0;
 
+    // Emitted after the filesystem has been (re-)initialised and all observers
+    // have been notified, for listeners that don't need the shutdown notification
+    virtual sigc::signal<void>& signal_Initialised() = 0;
+
 	// Returns the number of files in the VFS matching the given filename
 	virtual int getFileCount(const std::string& filename) = 0;
 
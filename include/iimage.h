@@ -116,6 +116,21 @@ public:
      * Load an image from a filesystem path.
      */
     virtual ImagePtr imageFromFile(const std::string& filename) const = 0;
+
+    /**
+     * \brief
+     * Determine the dimensions of an image in the VFS without loading it.
+     *
+     * The file is located the same way as in imageFromVFS(), but only its
+     * header is parsed. The result is cached per path until the VFS is shut
+     * down, which makes this cheap enough to be called for every material.
+     *
+     * \return
+     * false if the image could not be found or its header is not understood,
+     * in which case width and height are left untouched.
+     */
+    virtual bool getImageDimensionsFromVFS(const std::string& vfsPath,
+        std::size_t& width, std::size_t& height) const = 0;
 };
 
 const char* const MODULE_IMAGELOADER("ImageLoader");
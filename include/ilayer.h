@@ -1,10 +1,10 @@
 #pragma once
 
-#include <set>
 #include <string>
 #include <functional>
 #include "imodule.h"
 #include <sigc++/signal.h>
+#include "LayerList.h"
 
 namespace scene
 {
@@ -12,9 +12,6 @@ namespace scene
 class INode;
 typedef std::shared_ptr<INode> INodePtr;
 
-// A list of named layers
-typedef std::set<int> LayerList;
-
 /**
  * greebo: Interface of a Layered object.
  */
@@ -174,6 +171,21 @@ public:
 	 */
 	virtual bool updateNodeVisibility(const scene::INodePtr& node) = 0;
 
+	/**
+	 * Returns the number of entities and primitives in the scene which are
+	 * member of the given layer. This number is maintained incrementally,
+	 * it doesn't involve a scene traversal.
+	 */
+	virtual std::size_t getLayerMemberCount(int layerID) const = 0;
+
+	/**
+	 * Bookkeeping method invoked by the scene nodes: a node has been removed
+	 * from the layers in oldLayers and added to the ones in newLayers.
+	 * Nodes being inserted into the scene pass an empty oldLayers list,
+	 * nodes being removed from the scene pass an empty newLayers list.
+	 */
+	virtual void updateLayerMemberCounts(const LayerList& oldLayers, const LayerList& newLayers) = 0;
+
 	/**
 	 * greebo: Sets the selection status of the entire layer.
 	 *
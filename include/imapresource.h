@@ -115,6 +115,17 @@ public:
     virtual IMapResourcePtr createFromArchiveFile(const std::string& archivePath, 
         const std::string& filePathWithinArchive) = 0;
 
+    /**
+     * Create a loaded map resource for the given path, holding a copy of the
+     * nodes of another resource of the same file which is still loaded (like the
+     * one displayed in the prefab preview). Copying the nodes is much faster than
+     * parsing the file again. Returns an empty reference if there's no such
+     * resource, if its nodes have been modified or if the file has been changed
+     * on disk since it was loaded.
+     * Note: selection sets are not copied.
+     */
+    virtual IMapResourcePtr createFromLoadedResource(const std::string& path) = 0;
+
 	// Signal emitted when a MapExport is starting / is finished
 	typedef sigc::signal<void, const scene::IMapRootNodePtr&> ExportEvent;
 
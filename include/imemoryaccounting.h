@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+#include "imodule.h"
+
+namespace memory
+{
+
+/**
+ * The approximate memory footprint of a subsystem. The numbers are
+ * estimates based on the size of the containers and objects a subsystem
+ * is holding, they are not measured by hooking into the heap.
+ */
+struct Usage
+{
+	// The estimated number of bytes
+	std::size_t bytes = 0;
+
+	// The number of objects held by the subsystem (textures, models, undo operations, ...)
+	std::size_t numItems = 0;
+
+	Usage& operator+=(const Usage& other)
+	{
+		bytes += other.bytes;
+		numItems += other.numItems;
+		return *this;
+	}
+};
+
+// The usage reported by a named subsystem
+struct SubsystemUsage
+{
+	std::string name;
+	Usage usage;
+};
+
+}
+
+const char* const MODULE_MEMORY_ACCOUNTING("MemoryAccounting");
+
+/**
+ * Collects the approximate memory footprint of the various subsystems.
+ * Subsystems register a reporter function which is invoked whenever
+ * the usage is queried, i.e. there is no cost as long as nobody asks.
+ *
+ * The usage is printed by the "ShowMemoryUsage" command.
+ */
+class IMemoryAccounting :
+	public RegisterableModule
+{
+public:
+	using Reporter = std::function<memory::Usage()>;
+	using ReporterHandle = std::size_t;
+
+	virtual ~IMemoryAccounting() {}
+
+	/**
+	 * Registers a reporter for the named subsystem. Several reporters can use
+	 * the same name, their numbers are summed up (e.g. one per map root).
+	 * Reporters are invoked on the thread querying the usage, which is usually
+	 * the main thread. The returned handle is needed to remove the reporter.
+	 */
+	virtual ReporterHandle addReporter(const std::string& subsystem, const Reporter& reporter) = 0;
+
+	// Removes the reporter with the given handle, does nothing if it is unknown
+	virtual void removeReporter(ReporterHandle handle) = 0;
+
+	// Queries all reporters, returns the usage per subsystem sorted by the number of bytes (highest first)
+	virtual std::vector<memory::SubsystemUsage> collectUsage() = 0;
+};
+
+inline IMemoryAccounting& GlobalMemoryAccounting()
+{
+	static module::InstanceReference<IMemoryAccounting> _reference(MODULE_MEMORY_ACCOUNTING);
+	return _reference;
+}
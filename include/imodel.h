@@ -177,9 +177,12 @@ public:
 	*
 	* @modelName: This is usually the value of the "model" spawnarg of entities.
 	*
+	* @insertIntoCache: The model data is acquired through the model cache, pass false
+	* to not insert it into the cache if it's not in there yet (see IModelCache::getModel).
+	*
 	* @returns: the newly created modelnode (can be NULL if the model was not found).
 	*/
-	virtual scene::INodePtr loadModel(const std::string& modelName) = 0;
+	virtual scene::INodePtr loadModel(const std::string& modelName, bool insertIntoCache = true) = 0;
 
 	/**
 	* Load a model from the given (maybe be VFS or absolute), and return the IModel subclass for it.
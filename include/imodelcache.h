@@ -24,14 +24,26 @@ public:
 	 */
 	virtual scene::INodePtr getModelNode(const std::string& modelPath) = 0;
 
+	/**
+	 * Like getModelNode(), but models that are not in the cache yet are not
+	 * inserted after loading, their data is released along with the node.
+	 * Used for one-off renderings like thumbnails, where filling the cache
+	 * with every model the user is browsing would be a waste of memory.
+	 * Models that are already cached are shared as usual.
+	 */
+	virtual scene::INodePtr getUncachedModelNode(const std::string& modelPath) = 0;
+
 	/**
 	 * greebo: Get the IModel object for the given VFS path. The request is cached,
 	 * so calling this with the same path twice will return the same
 	 * IModelPtr to save memory.
 	 *
+	 * Pass insertIntoCache = false to not store a newly loaded model, a model
+	 * that is already cached is returned either way.
+	 *
 	 * This method is primarily used by the ModelLoaders to acquire their model data.
 	 */
-	virtual IModelPtr getModel(const std::string& modelPath) = 0;
+	virtual IModelPtr getModel(const std::string& modelPath, bool insertIntoCache = true) = 0;
 
     // Loads a model from the static resources in DarkRadiant's runtime data/resources folder
     virtual scene::INodePtr getModelNodeForStaticResource(const std::string& resourcePath) = 0;
@@ -4,6 +4,7 @@
 #include "ilayer.h"
 #include "irenderable.h"
 
+#include <cstddef>
 #include <set>
 #include <string>
 #include <memory>
@@ -257,6 +258,10 @@ public:
 	virtual void onPostUndo() {}
 	virtual void onPostRedo() {}
 
+	// The approximate heap memory held by this node (excluding its children and
+	// the node object itself), used for memory accounting. Defaults to zero.
+	virtual std::size_t getMemoryUsage() const { return 0; }
+
     // Called during recursive transform changed, but only by INodes themselves
     virtual void transformChangedLocal() = 0;
 };
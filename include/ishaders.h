@@ -190,6 +190,21 @@ public:
     /// Return true if the editor image is no tex for this shader.
     virtual bool isEditorImageNoTex() = 0;
 
+    /**
+     * Determine the dimensions of the editor image without loading it. If the
+     * image has not been loaded yet, the size is read from the image file header.
+     * Returns false if the size cannot be determined this way, the caller needs
+     * to fall back to getEditorImage() in that case.
+     */
+    virtual bool getEditorImageDimensions(std::size_t& width, std::size_t& height) = 0;
+
+    /**
+     * Drop this material's reference to its editor image. The GL texture is freed
+     * unless it is still used elsewhere, it will be reloaded on the next call to
+     * getEditorImage().
+     */
+    virtual void releaseEditorImage() = 0;
+
     // Returns the expression defining the editor image of this material, as passed to qer_editorimage statement,
     // or an empty string if this keyword was not used at all in this declaration.
     virtual shaders::IMapExpression::Ptr getEditorImageExpression() = 0;
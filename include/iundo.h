@@ -18,6 +18,9 @@ class IUndoMemento
 {
 public:
     virtual ~IUndoMemento() {}
+
+    // The approximate number of bytes held by this memento, used for memory accounting
+    virtual std::size_t getMemoryUsage() const = 0;
 };
 typedef std::shared_ptr<IUndoMemento> IUndoMementoPtr;
 
@@ -6,6 +6,24 @@
 namespace vcs
 {
 
+/**
+ * A text file opened from the version control history, whose contents
+ * are held contiguously in memory. The data pointer stays valid for the
+ * lifetime of this object, clients can read it without copying.
+ */
+class IVersionedTextFile :
+    public ArchiveTextFile
+{
+public:
+    virtual ~IVersionedTextFile() {}
+
+    // The raw contents of this file revision
+    virtual const char* getData() const = 0;
+
+    // The size of the contents in bytes
+    virtual std::size_t getSize() const = 0;
+};
+
 /**
  * Common interface of a version control module offering
  * methods to access its history.
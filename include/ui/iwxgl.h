@@ -20,6 +20,11 @@ public:
 
     /// Notifies the GL module that a GLWidget has been destroyed
     virtual void unregisterGLWidget(wxutil::GLWidget* widget) = 0;
+
+    /// Makes the shared context current on any of the registered widgets that is
+    /// currently shown, to issue GL calls outside of a paint event (e.g. to render
+    /// into a framebuffer object). Returns false if there is no such widget.
+    virtual bool makeSharedContextCurrent() = 0;
 };
 
 }
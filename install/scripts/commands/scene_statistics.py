@@ -0,0 +1,34 @@
+__commandName__ = 'SceneStatistics'
+__commandDisplayName__ = 'Print Scene Statistics'
+
+# This script only reads from the scene, it runs as long-running task in a
+# worker thread which reports its progress and can be cancelled, the views keep
+# rendering meanwhile. Scripts changing the scene need to put their changes into
+# GlobalScriptTask.modifyScene(callable) batches. Output goes to the console.
+__commandRunsInBackground__ = True
+__commandIsReadOnly__ = True
+
+def execute():
+	root = GlobalSceneGraph.root()
+
+	entities = GlobalBulkAccess.findEntities(root)
+	classnames = GlobalBulkAccess.getKeyValues(entities, 'classname')
+
+	counts = {}
+	for index, classname in enumerate(classnames):
+		counts[classname] = counts.get(classname, 0) + 1
+
+		if index % 1000 == 0:
+			GlobalScriptTask.setProgress(index / max(len(classnames), 1), 'Counting entities')
+
+	brushes = GlobalBulkAccess.findBrushes(root)
+	planes, brushIndices = GlobalBulkAccess.getFacePlanes(brushes)
+
+	print('Entities: {0}'.format(len(entities)))
+	print('Brushes: {0} ({1} faces)'.format(len(brushes), len(planes)))
+
+	for classname in sorted(counts, key=counts.get, reverse=True):
+		print('  {0}: {1}'.format(classname, counts[classname]))
+
+if __executeCommand__:
+	execute()
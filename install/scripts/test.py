@@ -394,3 +394,20 @@ print(GlobalLayerManager.layerIsVisible(1))
 
 GlobalLayerManager.setSelected(0, True)
 GlobalLayerManager.moveSelectionToLayer(1)
+
+# Test the bulk access interface (requires NumPy)
+entities = GlobalBulkAccess.findEntities(GlobalSceneGraph.root())
+print('Found {0} entities'.format(len(entities)))
+
+origins = GlobalBulkAccess.getEntityOrigins(entities)
+classnames = GlobalBulkAccess.getKeyValues(entities, 'classname')
+print(origins[:5], classnames[:5])
+
+# Move all entities up by 8 units in a single undoable step
+origins[:, 2] += 8
+GlobalBulkAccess.setEntityOrigins(entities, origins)
+
+brushes = GlobalBulkAccess.findBrushes(GlobalSceneGraph.root())
+planes, brushIndices = GlobalBulkAccess.getFacePlanes(brushes)
+vertices, faceIndices = GlobalBulkAccess.getFaceVertices(brushes)
+print('{0} brushes, {1} faces, {2} winding vertices'.format(len(brushes), len(planes), len(vertices)))
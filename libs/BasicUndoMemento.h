@@ -1,6 +1,7 @@
 #pragma once
 
 #include "iundo.h"
+#include "util/MemoryUsage.h"
 
 namespace undo
 {
@@ -23,6 +24,11 @@ public:
 	{
 		return _data;
 	}
+
+	std::size_t getMemoryUsage() const override
+	{
+		return sizeof(*this) + util::getHeapSize(_data);
+	}
 };
 
 } // namespace
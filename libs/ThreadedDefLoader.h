@@ -1,6 +1,8 @@
 #pragma once
 
 #include <future>
+#include <chrono>
+#include <mutex>
 #include <functional>
 #include <algorithm>
 #include <sigc++/signal.h>
@@ -76,6 +78,16 @@ public:
         return _result.get();
     }
 
+    // Returns true if the worker has been started and is done processing.
+    // In contrast to get() this never waits for the worker.
+    bool isFinished()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        return _loadingStarted && _result.valid() &&
+            _result.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
     // Resets the state of the loader to the state it had after construction.
     // If a background thread has been started, this will block and wait for it to finish.
     void reset()
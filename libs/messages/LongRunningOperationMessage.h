@@ -8,6 +8,7 @@ namespace radiant
 enum class OperationEvent
 {
 	Started,
+	Progress,
 	Finished,
 };
 
@@ -28,14 +29,28 @@ private:
 
 	std::string _message;
 
+	// Progress fraction in [0..1], negative values if the progress is unknown
+	float _progress;
+
+	bool _cancellationRequested;
+
+	bool _blocksScreenUpdates;
+
 public:
 	LongRunningOperationMessage(OperationEvent ev) :
 		LongRunningOperationMessage(ev, std::string())
 	{}
 
 	LongRunningOperationMessage(OperationEvent ev, const std::string& message) :
+		LongRunningOperationMessage(ev, message, -1.0f)
+	{}
+
+	LongRunningOperationMessage(OperationEvent ev, const std::string& message, float progress) :
 		_event(ev),
-		_message(message)
+		_message(message),
+		_progress(progress),
+		_cancellationRequested(false),
+		_blocksScreenUpdates(true)
 	{}
 
 	std::size_t getId() const override
@@ -52,6 +67,35 @@ public:
 	{
 		return _message;
 	}
+
+	float getProgress() const
+	{
+		return _progress;
+	}
+
+	// Set by the handler of a Progress event if the user
+	// asked to cancel the running operation
+	bool isCancellationRequested() const
+	{
+		return _cancellationRequested;
+	}
+
+	void requestCancellation()
+	{
+		_cancellationRequested = true;
+	}
+
+	// Whether the views stop rendering while the operation is running (default).
+	// Only evaluated for the Started event, user input is blocked regardless.
+	bool blocksScreenUpdates() const
+	{
+		return _blocksScreenUpdates;
+	}
+
+	void setBlocksScreenUpdates(bool blocksScreenUpdates)
+	{
+		_blocksScreenUpdates = blocksScreenUpdates;
+	}
 };
 
 }
@@ -5,6 +5,7 @@
 #include "idecltypes.h"
 #include "ThreadedDefLoader.h"
 #include "debugging/ScopedDebugTimer.h"
+#include "time/Tracing.h"
 #include "parser/ParseException.h"
 
 namespace parser
@@ -65,6 +66,7 @@ protected:
     void processFiles()
     {
         ScopedDebugTimer timer("[DeclParser] Parsed " + decl::getTypeName(_declType) + " declarations");
+        util::ScopedTrace trace("decl", "Parse declarations", decl::getTypeName(_declType));
 
         // Accumulate all the files and sort them before calling the protected parse() method
         std::vector<vfs::FileInfo> _incomingFiles;
@@ -88,6 +90,8 @@ protected:
 
             if (!file) continue;
 
+            util::ScopedTrace fileTrace("decl", "Parse file", file->getName());
+
             try
             {
                 // Parse entity defs from the file
@@ -0,0 +1,204 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "DefTokeniser.h"
+
+namespace parser
+{
+
+/**
+ * A DefTokeniser splitting an input stream into tokens on a worker thread.
+ * The tokens are handed over to the consuming thread in batches, such that
+ * the (character by character) tokenisation overlaps with the processing of
+ * the tokens. Only a few batches are read ahead of the consumer.
+ *
+ * The stream must not be accessed by anyone else while this tokeniser is
+ * alive. Exceptions thrown by the worker are re-thrown to the consumer once
+ * it reaches the point of failure. Destroying the tokeniser before all tokens
+ * have been consumed stops the worker thread.
+ */
+class ThreadedDefTokeniser :
+    public DefTokeniser
+{
+private:
+    using Batch = std::vector<std::string>;
+
+    static constexpr std::size_t BatchSize = 2048;
+    static constexpr std::size_t MaxQueuedBatches = 8;
+
+    std::mutex _lock;
+    std::condition_variable _batchAvailable;
+    std::condition_variable _spaceAvailable;
+
+    // Guarded by _lock
+    std::deque<Batch> _queue;
+    bool _finished;
+    bool _stopRequested;
+    std::exception_ptr _error;
+
+    // The batch the consumer is currently working on
+    Batch _current;
+    std::size_t _position;
+
+    std::thread _worker;
+
+public:
+    ThreadedDefTokeniser(std::istream& stream,
+                         const char* delims = WHITESPACE,
+                         const char* keptDelims = "{}()") :
+        _finished(false),
+        _stopRequested(false),
+        _position(0)
+    {
+        _worker = std::thread([this, &stream, delims, keptDelims]()
+        {
+            produce(stream, delims, keptDelims);
+        });
+    }
+
+    ThreadedDefTokeniser(const ThreadedDefTokeniser& other) = delete;
+    ThreadedDefTokeniser& operator=(const ThreadedDefTokeniser& other) = delete;
+
+    ~ThreadedDefTokeniser()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            _stopRequested = true;
+        }
+
+        _spaceAvailable.notify_all();
+        _worker.join();
+    }
+
+    bool hasMoreTokens() const override
+    {
+        return const_cast<ThreadedDefTokeniser*>(this)->ensureCurrentBatch();
+    }
+
+    std::string nextToken() override
+    {
+        if (hasMoreTokens())
+        {
+            return std::move(_current[_position++]);
+        }
+
+        throw ParseException("DefTokeniser: no more tokens");
+    }
+
+    std::string peek() const override
+    {
+        if (hasMoreTokens())
+        {
+            return _current[_position];
+        }
+
+        throw ParseException("DefTokeniser: no more tokens");
+    }
+
+private:
+    // Makes sure the current batch has a token left, waiting for the worker if necessary.
+    // Returns false if the stream is exhausted, re-throws the worker's exception if it failed.
+    bool ensureCurrentBatch()
+    {
+        if (_position < _current.size())
+        {
+            return true;
+        }
+
+        std::unique_lock<std::mutex> lock(_lock);
+
+        _batchAvailable.wait(lock, [this] { return !_queue.empty() || _finished; });
+
+        if (_queue.empty())
+        {
+            // All batches have been consumed
+            if (_error)
+            {
+                std::rethrow_exception(_error);
+            }
+
+            return false;
+        }
+
+        _current = std::move(_queue.front());
+        _queue.pop_front();
+        _position = 0;
+
+        lock.unlock();
+        _spaceAvailable.notify_one();
+
+        return true;
+    }
+
+    // Runs on the worker thread
+    void produce(std::istream& stream, const char* delims, const char* keptDelims)
+    {
+        try
+        {
+            BasicDefTokeniser<std::istream> tokeniser(stream, delims, keptDelims);
+
+            Batch batch;
+            batch.reserve(BatchSize);
+
+            while (tokeniser.hasMoreTokens())
+            {
+                batch.push_back(tokeniser.nextToken());
+
+                if (batch.size() == BatchSize)
+                {
+                    if (!push(std::move(batch))) return;
+
+                    batch = Batch();
+                    batch.reserve(BatchSize);
+                }
+            }
+
+            if (!batch.empty())
+            {
+                push(std::move(batch));
+            }
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            _error = std::current_exception();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            _finished = true;
+        }
+
+        _batchAvailable.notify_one();
+    }
+
+    // Queues the batch, blocks while the consumer is lagging behind.
+    // Returns false if the consumer is not interested in any more tokens.
+    bool push(Batch&& batch)
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+
+        _spaceAvailable.wait(lock, [this] { return _queue.size() < MaxQueuedBatches || _stopRequested; });
+
+        if (_stopRequested)
+        {
+            return false;
+        }
+
+        _queue.push_back(std::move(batch));
+
+        lock.unlock();
+        _batchAvailable.notify_one();
+
+        return true;
+    }
+};
+
+}
@@ -3,6 +3,7 @@
 #include <stdexcept>
 #include <limits>
 #include "igeometrystore.h"
+#include "imemoryaccounting.h"
 #include "itextstream.h"
 #include "ContinuousBuffer.h"
 #include "string/format.h"
@@ -292,6 +293,24 @@ public:
         return bounds;
     }
 
+    // The memory held by the vertex and index buffers of all frames,
+    // the number of items is the number of vertices in use
+    memory::Usage getMemoryUsage() const
+    {
+        memory::Usage usage;
+
+        for (const auto& frameBuffer : _frameBuffers)
+        {
+            usage.bytes += frameBuffer.vertices.getBufferSizeInBytes() + frameBuffer.indices.getBufferSizeInBytes();
+            usage.bytes += (frameBuffer.vertexTransactionLog.capacity() + frameBuffer.indexTransactionLog.capacity()) *
+                sizeof(detail::BufferTransaction);
+        }
+
+        usage.numItems = _frameBuffers[_currentBuffer].vertices.getNumAllocatedElements();
+
+        return usage;
+    }
+
     void printMemoryStats()
     {
         rMessage() << "-- Geometry Store Memory --" << std::endl;
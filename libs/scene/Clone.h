@@ -1,8 +1,11 @@
 #pragma once
 
 #include "inode.h"
+#include "imap.h"
 #include "iscenegraph.h"
+#include "iselectiongroup.h"
 #include <functional>
+#include <vector>
 
 namespace scene
 {
@@ -100,4 +103,62 @@ inline INodePtr cloneNodeIncludingDescendants(const INodePtr& node, const PostCl
 	return clone;
 }
 
+/**
+ * Clones every visited node into the same hierarchy below the given root node,
+ * non-cloneable nodes (and their children) are skipped. Selection group
+ * memberships are carried over to the group manager of the target root.
+ * Traverse the children of the source root with this walker.
+ */
+class SubgraphCloner :
+	public NodeVisitor
+{
+private:
+	IMapRootNodePtr _targetRoot;
+
+	// The clones of the currently visited node and its ancestors
+	// (empty pointers for the ones that couldn't be cloned)
+	std::vector<INodePtr> _path;
+
+public:
+	SubgraphCloner(const IMapRootNodePtr& targetRoot) :
+		_targetRoot(targetRoot)
+	{}
+
+	bool pre(const INodePtr& node) override
+	{
+		auto cloneParent = _path.empty() ? INodePtr(_targetRoot) : _path.back();
+		auto clone = cloneParent ? cloneSingleNode(node) : INodePtr();
+
+		_path.push_back(clone);
+
+		return true;
+	}
+
+	void post(const INodePtr& node) override
+	{
+		auto clone = _path.back();
+		_path.pop_back();
+
+		if (!clone) return;
+
+		auto cloneParent = _path.empty() ? INodePtr(_targetRoot) : _path.back();
+		cloneParent->addChildNode(clone);
+
+		copyGroupMemberships(node, clone);
+	}
+
+private:
+	void copyGroupMemberships(const INodePtr& sourceNode, const INodePtr& clone)
+	{
+		auto sourceSelectable = std::dynamic_pointer_cast<IGroupSelectable>(sourceNode);
+
+		if (!sourceSelectable) return;
+
+		for (auto id : sourceSelectable->getGroupIds())
+		{
+			_targetRoot->getSelectionGroupManager().findOrCreateSelectionGroup(id)->addNode(clone);
+		}
+	}
+};
+
 } // namespace
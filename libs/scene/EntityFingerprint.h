@@ -0,0 +1,49 @@
+#pragma once
+
+#include <map>
+#include <set>
+#include <string>
+#include "ientity.h"
+#include "math/Hash.h"
+#include "string/case_conv.h"
+
+namespace scene
+{
+
+/**
+ * Calculates the fingerprint of an entity, based on its own (non-inherited)
+ * key values and the given fingerprints of its child primitives.
+ *
+ * This is the algorithm used by the entity nodes' IComparableNode implementation,
+ * it's exposed here such that algorithms which already know the child fingerprints
+ * (like the map comparison) don't have to calculate them a second time.
+ */
+inline std::string calculateEntityFingerprint(const Entity& entity, const std::set<std::string>& childFingerprints)
+{
+    std::map<std::string, std::string> sortedKeyValues;
+
+    // Entities are just a collection of key/value pairs,
+    // use them in lower case form, ignore inherited keys, sort before hashing
+    entity.forEachKeyValue([&](const std::string& key, const std::string& value)
+    {
+        sortedKeyValues.emplace(string::to_lower_copy(key), string::to_lower_copy(value));
+    }, false);
+
+    math::Hash hash;
+
+    for (const auto& pair : sortedKeyValues)
+    {
+        hash.addString(pair.first);
+        hash.addString(pair.second);
+    }
+
+    // Entities need to include any child hashes, but be insensitive to their order
+    for (const auto& childFingerprint : childFingerprints)
+    {
+        hash.addString(childFingerprint);
+    }
+
+    return hash;
+}
+
+}
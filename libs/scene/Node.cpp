@@ -2,6 +2,8 @@
 
 #include "itransformnode.h"
 #include "iscenegraph.h"
+#include "imap.h"
+#include "ilayer.h"
 #include "debugging/debugging.h"
 #include "InstanceWalkers.h"
 #include "AABBAccumulateWalker.h"
@@ -124,27 +126,33 @@ bool Node::excluded() const
 
 void Node::addToLayer(int layerId)
 {
+	LayerList oldLayers = _layers;
 	_layers.insert(layerId);
+
+	onLayersChanged(oldLayers);
 }
 
 void Node::moveToLayer(int layerId)
 {
+	LayerList oldLayers = _layers;
 	_layers.clear();
 	_layers.insert(layerId);
+
+	onLayersChanged(oldLayers);
 }
 
 void Node::removeFromLayer(int layerId)
 {
-	// Look up the layer ID and remove it from the list
-	LayerList::iterator found = _layers.find(layerId);
-
-	if (found != _layers.end()) {
-		_layers.erase(found);
+	LayerList oldLayers = _layers;
 
+	if (_layers.erase(layerId) > 0)
+	{
 		// greebo: Make sure that every node is at least member of layer 0
 		if (_layers.empty()) {
 			_layers.insert(0);
 		}
+
+		onLayersChanged(oldLayers);
 	}
 }
 
@@ -157,10 +165,31 @@ void Node::assignToLayers(const LayerList& newLayers)
 {
 	if (!newLayers.empty())
     {
+        LayerList oldLayers = _layers;
         _layers = newLayers;
+
+        onLayersChanged(oldLayers);
     }
 }
 
+bool Node::isCountedInLayers() const
+{
+	auto type = getNodeType();
+	return type == Type::Entity || type == Type::Brush || type == Type::Patch;
+}
+
+void Node::onLayersChanged(const LayerList& oldLayers)
+{
+	if (!_instantiated || oldLayers == _layers || !isCountedInLayers()) return;
+
+	auto root = getRootNode();
+
+	if (root)
+	{
+		root->getLayerManager().updateLayerMemberCounts(oldLayers, _layers);
+	}
+}
+
 void Node::addChildNode(const INodePtr& node)
 {
 	// Add the node to the TraversableNodeSet, this triggers an
@@ -293,6 +322,11 @@ void Node::onInsertIntoScene(IMapRootNode& root)
 {
 	_instantiated = true;
 
+	if (isCountedInLayers())
+	{
+		root.getLayerManager().updateLayerMemberCounts(LayerList(), _layers);
+	}
+
     // The node was 100% not visible before, check if it is now
     if (visible())
     {
@@ -310,6 +344,11 @@ void Node::onRemoveFromScene(IMapRootNode& root)
 
 	_instantiated = false;
 
+	if (isCountedInLayers())
+	{
+		root.getLayerManager().updateLayerMemberCounts(_layers, LayerList());
+	}
+
     // The node is 100% not visible after removing from the scene
     if (wasVisible)
     {
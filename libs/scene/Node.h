@@ -214,6 +214,12 @@ protected:
 	virtual void removeAllChildNodes();
 
 private:
+	// Only entities and primitives are counted in the layer manager's member counts
+	bool isCountedInLayers() const;
+
+	// Propagates a change of this node's layer set to the layer manager
+	void onLayersChanged(const LayerList& oldLayers);
+
     void connectUndoSystem(IUndoSystem& undoSystem);
     void disconnectUndoSystem(IUndoSystem& undoSystem);
 
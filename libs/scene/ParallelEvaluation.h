@@ -0,0 +1,149 @@
+#pragma once
+
+#include <vector>
+#include <future>
+#include <thread>
+#include <algorithm>
+#include <type_traits>
+#include "inode.h"
+
+namespace scene
+{
+
+/**
+ * A node of a flattened subgraph, see flattenSubgraph().
+ */
+struct FlattenedNode
+{
+	INodePtr node;
+
+	// The distance to the subgraph root (direct children have depth 1)
+	std::size_t depth;
+};
+
+using FlattenedNodes = std::vector<FlattenedNode>;
+
+namespace detail
+{
+
+class SubgraphFlattener :
+	public NodeVisitor
+{
+private:
+	FlattenedNodes& _nodes;
+	std::size_t _depth;
+
+public:
+	SubgraphFlattener(FlattenedNodes& nodes, std::size_t startDepth) :
+		_nodes(nodes),
+		_depth(startDepth)
+	{}
+
+	bool pre(const INodePtr& node) override
+	{
+		_nodes.push_back(FlattenedNode{ node, _depth++ });
+		return true;
+	}
+
+	void post(const INodePtr& node) override
+	{
+		--_depth;
+	}
+};
+
+}
+
+/**
+ * Collects all nodes of the given subgraph into a vector, in depth-first
+ * pre-order. The descendants of a node are the elements directly following
+ * it with a larger depth value. If includeRoot is false, the traversal
+ * starts with the root's children (at depth 1).
+ */
+inline FlattenedNodes flattenSubgraph(const INodePtr& root, bool includeRoot)
+{
+	FlattenedNodes nodes;
+	detail::SubgraphFlattener flattener(nodes, includeRoot ? 0 : 1);
+
+	if (includeRoot)
+	{
+		root->traverse(flattener);
+	}
+	else
+	{
+		root->traverseChildren(flattener);
+	}
+
+	return nodes;
+}
+
+/**
+ * Invokes the given evaluation function for each index in [0..count), distributing
+ * the work across all available hardware threads. The returned vector contains
+ * the results in index order.
+ *
+ * The evaluation function is called concurrently, it must not modify the scene
+ * or any state shared between the items. If there are less than minItemsPerThread
+ * items per thread the work is done on the calling thread only.
+ *
+ * Result must not be bool, since std::vector<bool> elements can't be written
+ * from multiple threads, use an integer type instead.
+ */
+template<typename Result, typename EvaluationFunc>
+std::vector<Result> evaluateInParallel(std::size_t count, const EvaluationFunc& evaluate,
+	std::size_t minItemsPerThread = 1024)
+{
+	static_assert(!std::is_same_v<Result, bool>, "std::vector<bool> is not thread-safe");
+
+	std::vector<Result> results(count);
+
+	auto evaluateRange = [&](std::size_t begin, std::size_t end)
+	{
+		for (auto i = begin; i < end; ++i)
+		{
+			results[i] = evaluate(i);
+		}
+	};
+
+	std::size_t numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+	numThreads = std::min(numThreads, count / std::max(minItemsPerThread, static_cast<std::size_t>(1)));
+
+	if (numThreads <= 1)
+	{
+		evaluateRange(0, count);
+		return results;
+	}
+
+	std::size_t chunkSize = (count + numThreads - 1) / numThreads;
+	std::vector<std::future<void>> workers;
+
+	for (std::size_t begin = chunkSize; begin < count; begin += chunkSize)
+	{
+		workers.emplace_back(std::async(std::launch::async, evaluateRange,
+			begin, std::min(begin + chunkSize, count)));
+	}
+
+	// The calling thread is taking care of the first chunk
+	evaluateRange(0, chunkSize);
+
+	for (auto& worker : workers)
+	{
+		worker.get(); // propagates any exceptions
+	}
+
+	return results;
+}
+
+/**
+ * Invokes the given evaluation function for each of the given nodes, see above.
+ * The returned vector contains one result per node, in the same order.
+ */
+template<typename Result, typename EvaluationFunc>
+std::vector<Result> evaluateInParallel(const FlattenedNodes& nodes, const EvaluationFunc& evaluate)
+{
+	return evaluateInParallel<Result>(nodes.size(), [&](std::size_t index)
+	{
+		return evaluate(nodes[index].node);
+	});
+}
+
+}
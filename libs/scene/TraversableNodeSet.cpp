@@ -71,10 +71,91 @@ public:
 	ObserverOutputIterator& operator++(int) { return *this; }
 };
 
-typedef undo::BasicUndoMemento<TraversableNodeSet::NodeList> UndoListMemento;
+namespace
+{
+
+// The heap memory held by the given node and all its children
+std::size_t getSubgraphMemoryUsage(const INodePtr& node)
+{
+	auto total = node->getMemoryUsage();
+
+	node->foreachNode([&](const INodePtr& child)
+	{
+		total += getSubgraphMemoryUsage(child);
+		return true;
+	});
+
+	return total;
+}
+
+}
+
+/**
+ * Memento of the child list. Children which have been removed from the scene
+ * are kept alive by this memento alone, their memory is reported as part of
+ * the memento (children still in the scene are reported by their subsystems).
+ */
+class UndoListMemento :
+	public undo::BasicUndoMemento<TraversableNodeSet::NodeList>
+{
+public:
+	using BasicUndoMemento::BasicUndoMemento;
+
+	std::size_t getMemoryUsage() const override
+	{
+		auto total = BasicUndoMemento::getMemoryUsage();
+
+		for (const auto& node : data())
+		{
+			if (!node->inScene())
+			{
+				total += getSubgraphMemoryUsage(node);
+			}
+		}
+
+		return total;
+	}
+};
+
+/**
+ * Marks the set as being traversed for the lifetime of this object. The outermost
+ * traversal removes the slots of the nodes which have been erased in the meantime.
+ */
+class TraversableNodeSet::TraversalScope
+{
+private:
+	const TraversableNodeSet& _set;
+
+public:
+	TraversalScope(const TraversableNodeSet& set) :
+		_set(set)
+	{
+#if defined(_DEBUG)
+		if (_set._traversalDepth == 0)
+		{
+			_set._traversalThread = std::this_thread::get_id();
+		}
+
+		ASSERT_MESSAGE(_set._traversalThread == std::this_thread::get_id(),
+			"Child nodes are traversed on several threads at once");
+#endif
+		++_set._traversalDepth;
+	}
+
+	~TraversalScope()
+	{
+		if (--_set._traversalDepth == 0 && _set._hasEmptySlots)
+		{
+			_set.removeEmptySlots();
+		}
+	}
+};
 
 // Default constructor, creates an empty set
 TraversableNodeSet::TraversableNodeSet(Node& owner) :
+	_traversalDepth(0),
+	_hasEmptySlots(false),
+	_numPrepended(0),
 	_owner(owner),
 	_undoStateSaver(nullptr)
 {}
@@ -103,7 +184,8 @@ void TraversableNodeSet::prepend(const INodePtr& node)
 	undoSave();
 
 	// Insert the child node at the front of the list
-	_children.push_front(node);
+	_children.insert(_children.begin(), node);
+	++_numPrepended;
 
 	// Notify the owner (note: this usually triggers instantiation of the node)
 	_owner.onChildAdded(node);
@@ -117,12 +199,26 @@ void TraversableNodeSet::erase(const INodePtr& node)
 	_owner.onChildRemoved(node);
 
 	// Lookup the node and remove it from the list
-	NodeList::iterator i = std::find(_children.begin(), _children.end(), node);
+	auto i = std::find(_children.begin(), _children.end(), node);
 
-    if (i != _children.end())
+    if (i == _children.end())
 	{
-        _children.erase(i);
-    }
+		return;
+	}
+
+	if (_traversalDepth > 0)
+	{
+		ASSERT_MESSAGE(_traversalThread == std::this_thread::get_id(),
+			"Child node is erased while another thread is traversing");
+
+		// Keep the positions of the running traversals valid, the slot is removed later
+		i->reset();
+		_hasEmptySlots = true;
+	}
+	else
+	{
+		_children.erase(i);
+	}
 }
 
 void TraversableNodeSet::clear()
@@ -134,20 +230,42 @@ void TraversableNodeSet::clear()
 
 void TraversableNodeSet::traverse(NodeVisitor& visitor) const
 {
-	for (NodeList::const_iterator i = _children.begin();
-		 i != _children.end();)
+	TraversalScope scope(*this);
+
+	// The array might grow or shift during traversal, so iterate by index
+	auto numPrependedAtStart = _numPrepended;
+
+	for (std::size_t i = 0; ; ++i)
 	{
-		const scene::INodePtr& child = *(i++); // readability shortcut
-		// Traverse the child using the visitor
-		child->traverse(visitor);
+		// Nodes prepended in the meantime have moved the remaining ones back
+		auto index = i + _numPrepended - numPrependedAtStart;
+
+		if (index >= _children.size()) break;
+
+		// Skip the slots of erased nodes
+		if (!_children[index]) continue;
+
+		// Traverse the child using the visitor (Node::traverse keeps a reference to itself)
+		_children[index]->traverse(visitor);
 	}
 }
 
 bool TraversableNodeSet::foreachNode(const INode::VisitorFunc& functor) const
 {
-	for (NodeList::const_iterator i = _children.begin(); i != _children.end();)
+	TraversalScope scope(*this);
+
+	auto numPrependedAtStart = _numPrepended;
+
+	for (std::size_t i = 0; ; ++i)
 	{
-		const scene::INodePtr& child = *(i++); // readability shortcut
+		auto index = i + _numPrepended - numPrependedAtStart;
+
+		if (index >= _children.size()) break;
+
+		// Hold a reference, the slot might be emptied or moved while the functor runs
+		auto child = _children[index];
+
+		if (!child) continue;
 
 		// First, invoke the functor with this child node, 
 		// stopping traversal if the functor returns false
@@ -168,7 +286,18 @@ bool TraversableNodeSet::foreachNode(const INode::VisitorFunc& functor) const
 
 bool TraversableNodeSet::empty() const
 {
-	return _children.empty();
+	if (!_hasEmptySlots)
+	{
+		return _children.empty();
+	}
+
+	return std::none_of(_children.begin(), _children.end(), [](const INodePtr& node) { return node; });
+}
+
+void TraversableNodeSet::removeEmptySlots() const
+{
+	_children.erase(std::remove(_children.begin(), _children.end(), nullptr), _children.end());
+	_hasEmptySlots = false;
 }
 
 void TraversableNodeSet::connectUndoSystem(IUndoSystem& undoSystem)
@@ -193,6 +322,15 @@ void TraversableNodeSet::undoSave()
 IUndoMementoPtr TraversableNodeSet::exportState() const
 {
 	// Copy the current list of children and return the UndoMemento
+	if (_hasEmptySlots)
+	{
+		NodeList children;
+		std::copy_if(_children.begin(), _children.end(), std::back_inserter(children),
+			[](const INodePtr& node) { return node; });
+
+		return IUndoMementoPtr(new UndoListMemento(children));
+	}
+
 	return IUndoMementoPtr(new UndoListMemento(_children));
 }
 
@@ -203,6 +341,11 @@ void TraversableNodeSet::importState(const IUndoMementoPtr& state)
 	// Import the child set from the state
 	const auto& other = std::static_pointer_cast<UndoListMemento>(state)->data();
 
+	if (_hasEmptySlots)
+	{
+		removeEmptySlots();
+	}
+
 	// Copy the current container into a temporary one for later comparison
 	std::vector<INodePtr> before_sorted(_children.begin(), _children.end());
 	std::vector<INodePtr> after_sorted(other.begin(), other.end());
@@ -265,7 +408,7 @@ void TraversableNodeSet::notifyInsertAll()
 {
 	for (const auto& node : _children)
 	{
-		_owner.onChildAdded(node);
+		if (node) _owner.onChildAdded(node);
 	}
 }
 
@@ -273,7 +416,7 @@ void TraversableNodeSet::notifyEraseAll()
 {
 	for (const auto& node : _children)
 	{
-		_owner.onChildRemoved(node);
+		if (node) _owner.onChildRemoved(node);
 	}
 }
 
@@ -281,7 +424,7 @@ void TraversableNodeSet::setRenderSystem(const RenderSystemPtr& renderSystem)
 {
 	for (const auto& node : _children)
 	{
-		node->setRenderSystem(renderSystem);
+		if (node) node->setRenderSystem(renderSystem);
 	}
 }
 
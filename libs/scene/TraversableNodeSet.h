@@ -2,7 +2,10 @@
 
 #include "inode.h"
 #include "iundo.h"
-#include <list>
+#include <vector>
+#if defined(_DEBUG)
+#include <thread>
+#endif
 #include "util/Noncopyable.h"
 
 namespace scene
@@ -18,6 +21,15 @@ class Node;
  * onInsertIntoScene(root) methods are for. An UndoMemento is submitted to the UndoSystem as soon
  * as any child nodes are removed or inserted. When the user hits Undo, the UndoSystem sends back
  * the memento and asks the TraversableNodeSet to overwrite its current children with the saved state.
+ *
+ * The children are stored in a contiguous array. Nodes can be inserted and erased while the set is
+ * being traversed: erased nodes leave an empty slot behind until the outermost traversal is done,
+ * nodes appended during traversal are visited, prepended ones are not.
+ *
+ * The set is not thread-safe: traversals and modifications must all happen on the same
+ * thread, since compacting the empty slots moves the nodes under a concurrent reader.
+ * Code evaluating nodes in parallel flattens the subgraph on the calling thread first
+ * (see ParallelEvaluation.h). Debug builds assert on traversals running on several threads.
  */
 class TraversableNodeSet final :
 	public IUndoable,
@@ -25,10 +37,25 @@ class TraversableNodeSet final :
 	public sigc::trackable
 {
 public:
-	typedef std::list<INodePtr> NodeList;
+	typedef std::vector<INodePtr> NodeList;
 
 private:
-	NodeList _children;
+	// The child nodes in order, might contain empty slots during traversal
+	mutable NodeList _children;
+
+	// The number of (nested) traversals currently running over this set
+	mutable std::size_t _traversalDepth;
+
+#if defined(_DEBUG)
+	// The thread running the outermost traversal
+	mutable std::thread::id _traversalThread;
+#endif
+
+	// True if nodes have been erased during traversal, leaving empty slots
+	mutable bool _hasEmptySlots;
+
+	// Incremented on every prepend, running traversals use it to keep their position
+	std::size_t _numPrepended;
 
 	// The owning node which gets notified upon insertion/deletion of child nodes
 	Node& _owner;
@@ -93,6 +120,11 @@ public:
 	void setRenderSystem(const RenderSystemPtr& renderSystem);
 
 private:
+	class TraversalScope;
+
+	// Removes the slots of the nodes that have been erased during traversal
+	void removeEmptySlots() const;
+
 	// Sends the current state to the undosystem
 	void undoSave();
 
@@ -0,0 +1,132 @@
+#include "FingerprintIndex.h"
+
+#include <set>
+#include "ientity.h"
+#include "icomparablenode.h"
+#include "itextstream.h"
+#include "scene/EntityFingerprint.h"
+#include "scene/ParallelEvaluation.h"
+
+namespace scene
+{
+
+namespace merge
+{
+
+namespace
+{
+    // Entities are much more expensive to process than single primitives
+    constexpr std::size_t MinEntitiesPerThread = 64;
+
+    struct ComparableChild
+    {
+        INodePtr node;
+        IComparableNode* comparable;
+    };
+
+    struct EntityChildren
+    {
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    inline bool isPrimitive(const INodePtr& node)
+    {
+        return node->getNodeType() == INode::Type::Brush || node->getNodeType() == INode::Type::Patch;
+    }
+}
+
+FingerprintIndex::FingerprintIndex(const INodePtr& root)
+{
+    std::vector<Entry> entities;
+    std::vector<EntityChildren> entityChildren;
+    std::vector<ComparableChild> children;
+
+    // Collect the entities and their comparable children in a single pass,
+    // the children of each entity are stored in a contiguous range
+    root->foreachNode([&](const INodePtr& node)
+    {
+        if (node->getNodeType() != INode::Type::Entity) return true;
+
+        auto begin = children.size();
+
+        node->foreachNode([&](const INodePtr& child)
+        {
+            auto comparable = std::dynamic_pointer_cast<IComparableNode>(child);
+
+            if (comparable)
+            {
+                children.emplace_back(ComparableChild{ child, comparable.get() });
+            }
+
+            return true;
+        });
+
+        entities.emplace_back(Entry{ node, NodeUtils::GetEntityName(node) });
+        entityChildren.emplace_back(EntityChildren{ begin, children.size() });
+
+        return true;
+    });
+
+    // Hash all child nodes, this is where most of the time is spent
+    auto childFingerprints = evaluateInParallel<std::string>(children.size(), [&](std::size_t index)
+    {
+        return children[index].comparable->getFingerprint();
+    });
+
+    // Combine the child fingerprints, returns the number of fingerprint collisions
+    auto collisions = evaluateInParallel<std::size_t>(entities.size(), [&](std::size_t index)
+    {
+        auto& entry = entities[index];
+        std::set<std::string> fingerprints;
+        std::size_t numCollisions = 0;
+
+        for (auto i = entityChildren[index].begin; i < entityChildren[index].end; ++i)
+        {
+            fingerprints.insert(childFingerprints[i]);
+
+            if (!isPrimitive(children[i].node)) continue;
+
+            if (!entry.primitives.try_emplace(childFingerprints[i], children[i].node).second)
+            {
+                ++numCollisions;
+            }
+        }
+
+        entry.fingerprint = calculateEntityFingerprint(*Node_getEntity(entry.node), fingerprints);
+
+        return numCollisions;
+    }, MinEntitiesPerThread);
+
+    _entities.reserve(entities.size());
+
+    for (std::size_t i = 0; i < entities.size(); ++i)
+    {
+        if (collisions[i] > 0)
+        {
+            rWarning() << "More than one node with the same fingerprint found in the parent node with name " <<
+                entities[i].node->name() << std::endl;
+        }
+
+        // Only the first entity of a given fingerprint is indexed
+        if (!_entitiesByFingerprint.try_emplace(entities[i].fingerprint, _entities.size()).second)
+        {
+            rWarning() << "More than one node with the same fingerprint found in the parent node with name " <<
+                root->name() << std::endl;
+            continue;
+        }
+
+        _entities.emplace_back(std::move(entities[i]));
+    }
+}
+
+const FingerprintIndex::Entry* FingerprintIndex::findByFingerprint(const std::string& fingerprint) const
+{
+    auto found = _entitiesByFingerprint.find(fingerprint);
+
+    return found != _entitiesByFingerprint.end() ? &_entities[found->second] : nullptr;
+}
+
+}
+
+}
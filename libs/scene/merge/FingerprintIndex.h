@@ -0,0 +1,64 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "inode.h"
+#include "NodeUtils.h"
+
+namespace scene
+{
+
+namespace merge
+{
+
+/**
+ * Hashed index of the entities of a map, including the fingerprints of
+ * their child primitives.
+ *
+ * Calculating the fingerprints is by far the most expensive part of a map
+ * comparison. The index calculates the fingerprint of each primitive exactly
+ * once (distributed across all hardware threads) and derives the entity
+ * fingerprints from the known child fingerprints. Subsequent lookups by
+ * fingerprint are constant time.
+ */
+class FingerprintIndex
+{
+public:
+    struct Entry
+    {
+        INodePtr node;
+        std::string entityName;
+        std::string fingerprint;
+
+        // The child primitives of this entity, by fingerprint
+        Fingerprints primitives;
+    };
+
+private:
+    // All entities with a unique fingerprint, in scene order
+    std::vector<Entry> _entities;
+
+    // Entity fingerprint => index into _entities
+    std::unordered_map<std::string, std::size_t> _entitiesByFingerprint;
+
+public:
+    // Builds the index of all entities below the given root node
+    explicit FingerprintIndex(const INodePtr& root);
+
+    FingerprintIndex(const FingerprintIndex& other) = delete;
+    FingerprintIndex& operator=(const FingerprintIndex& other) = delete;
+
+    const std::vector<Entry>& getEntities() const
+    {
+        return _entities;
+    }
+
+    // Returns the entity entry with the given fingerprint, or nullptr if there's none
+    const Entry* findByFingerprint(const std::string& fingerprint) const;
+};
+
+}
+
+}
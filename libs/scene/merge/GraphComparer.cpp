@@ -1,5 +1,6 @@
 #include "GraphComparer.h"
 
+#include <map>
 #include <algorithm>
 #include "ientity.h"
 #include "i18n.h"
@@ -11,6 +12,7 @@
 #include "string/string.h"
 #include "command/ExecutionNotPossible.h"
 #include "NodeUtils.h"
+#include "scene/ParallelEvaluation.h"
 
 namespace scene
 {
@@ -18,15 +20,27 @@ namespace scene
 namespace merge
 {
 
+namespace
+{
+    // Diffing two entities involves sorting their key values and child fingerprints
+    constexpr std::size_t MinEntityDiffsPerThread = 16;
+}
+
 ComparisonResult::Ptr GraphComparer::Compare(const IMapRootNodePtr& source, const IMapRootNodePtr& base)
 {
-    auto result = std::make_shared<ComparisonResult>(source, base);
+    FingerprintIndex sourceIndex(source);
+    FingerprintIndex baseIndex(base);
 
-    auto sourceEntities = NodeUtils::CollectEntityFingerprints(source);
-    auto baseEntities = NodeUtils::CollectEntityFingerprints(base);
+    return Compare(source, sourceIndex, base, baseIndex);
+}
+
+ComparisonResult::Ptr GraphComparer::Compare(const IMapRootNodePtr& source, const FingerprintIndex& sourceIndex,
+    const IMapRootNodePtr& base, const FingerprintIndex& baseIndex)
+{
+    auto result = std::make_shared<ComparisonResult>(source, base);
 
     // Filter out all the matching nodes and store them in the result
-    if (sourceEntities.empty())
+    if (sourceIndex.getEntities().empty())
     {
         // Cannot merge the source without any entities in it
         throw cmd::ExecutionNotPossible(_("The source map doesn't contain any entities, cannot merge"));
@@ -34,33 +48,33 @@ ComparisonResult::Ptr GraphComparer::Compare(const IMapRootNodePtr& source, cons
 
     EntityMismatchByName sourceMismatches;
 
-    for (const auto& sourceEntity : sourceEntities)
+    for (const auto& sourceEntity : sourceIndex.getEntities())
     {
         // Check each source node for an equivalent node in the base
-        auto matchingBaseNode = baseEntities.find(sourceEntity.first);
+        auto matchingBaseEntity = baseIndex.findByFingerprint(sourceEntity.fingerprint);
 
-        if (matchingBaseNode != baseEntities.end())
+        if (matchingBaseEntity != nullptr)
         {
             // Found an equivalent node
-            result->equivalentEntities.emplace_back(ComparisonResult::Match{ sourceEntity.first, sourceEntity.second, matchingBaseNode->second });
+            result->equivalentEntities.emplace_back(ComparisonResult::Match{ sourceEntity.fingerprint, sourceEntity.node, matchingBaseEntity->node });
         }
         else
         {
-            auto entityName = NodeUtils::GetEntityName(sourceEntity.second);
-            sourceMismatches.emplace(entityName, EntityMismatch{ sourceEntity.first, sourceEntity.second, entityName });
+            sourceMismatches.emplace(sourceEntity.entityName, EntityMismatch{ sourceEntity.fingerprint, 
+                sourceEntity.node, sourceEntity.entityName, &sourceEntity.primitives });
         }
     }
 
     EntityMismatchByName baseMismatches;
 
-    for (const auto& baseEntity : baseEntities)
+    for (const auto& baseEntity : baseIndex.getEntities())
     {
-        // Check each source node for an equivalent node in the base
+        // Check each base node for an equivalent node in the source
         // Matching nodes have already been checked in the above loop
-        if (sourceEntities.count(baseEntity.first) == 0)
+        if (sourceIndex.findByFingerprint(baseEntity.fingerprint) == nullptr)
         {
-            auto entityName = NodeUtils::GetEntityName(baseEntity.second);
-            baseMismatches.emplace(entityName, EntityMismatch{ baseEntity.first, baseEntity.second, entityName });
+            baseMismatches.emplace(baseEntity.entityName, EntityMismatch{ baseEntity.fingerprint, 
+                baseEntity.node, baseEntity.entityName, &baseEntity.primitives });
         }
     }
 
@@ -73,69 +87,90 @@ ComparisonResult::Ptr GraphComparer::Compare(const IMapRootNodePtr& source, cons
 void GraphComparer::processDifferingEntities(ComparisonResult& result, const EntityMismatchByName& sourceMismatches, const EntityMismatchByName& baseMismatches)
 {
     // Find all entities that are missing in either source or base (by name)
-    std::list<EntityMismatchByName::value_type> missingInSource;
-    std::list<EntityMismatchByName::value_type> missingInBase;
-
-    std::list<EntityMismatchByName::value_type> matchingByName;
+    std::vector<std::string> missingInSource;
+    std::vector<std::string> missingInBase;
+    std::vector<std::string> matchingByName;
 
-    auto compareEntityNames = [](const EntityMismatchByName::value_type& left, const EntityMismatchByName::value_type& right)
+    for (const auto& pair : sourceMismatches)
     {
-        return left.first < right.first;
-    };
-
-    // Calculate intersection and two-way exclusives
-    std::set_intersection(sourceMismatches.begin(), sourceMismatches.end(), baseMismatches.begin(), baseMismatches.end(),
-        std::back_inserter(matchingByName), compareEntityNames);
+        if (baseMismatches.count(pair.first) > 0)
+        {
+            matchingByName.push_back(pair.first);
+        }
+        else
+        {
+            missingInBase.push_back(pair.first);
+        }
+    }
 
-    std::set_difference(sourceMismatches.begin(), sourceMismatches.end(), baseMismatches.begin(), baseMismatches.end(),
-        std::back_inserter(missingInBase), compareEntityNames);
+    for (const auto& pair : baseMismatches)
+    {
+        if (sourceMismatches.count(pair.first) == 0)
+        {
+            missingInSource.push_back(pair.first);
+        }
+    }
 
-    std::set_difference(baseMismatches.begin(), baseMismatches.end(), sourceMismatches.begin(), sourceMismatches.end(),
-        std::back_inserter(missingInSource), compareEntityNames);
+    // The differences are reported in the order of the entity names
+    std::sort(matchingByName.begin(), matchingByName.end());
+    std::sort(missingInSource.begin(), missingInSource.end());
+    std::sort(missingInBase.begin(), missingInBase.end());
 
-    for (const auto& match : matchingByName)
+    // Analyse the entities present in both graphs, the entities are independent of each other
+    auto entityDiffs = evaluateInParallel<ComparisonResult::EntityDifference>(matchingByName.size(), [&](std::size_t index)
     {
-        auto sourceMismatch = sourceMismatches.find(match.second.entityName)->second;
-        auto baseMismatch = baseMismatches.find(match.second.entityName)->second;
+        const auto& sourceMismatch = sourceMismatches.at(matchingByName[index]);
+        const auto& baseMismatch = baseMismatches.at(matchingByName[index]);
 
-        auto& entityDiff = result.differingEntities.emplace_back(ComparisonResult::EntityDifference
+        ComparisonResult::EntityDifference entityDiff
         {
             sourceMismatch.node,
             baseMismatch.node,
-            match.second.entityName,
+            sourceMismatch.entityName,
             sourceMismatch.fingerPrint,
             baseMismatch.fingerPrint,
             ComparisonResult::EntityDifference::Type::EntityPresentButDifferent
-        });
+        };
 
         // Analyse the key values
         entityDiff.differingKeyValues = compareKeyValues(sourceMismatch.node, baseMismatch.node);
 
         // Analyse the child nodes
-        entityDiff.differingChildren = compareChildNodes(sourceMismatch.node, baseMismatch.node);
+        entityDiff.differingChildren = compareChildNodes(*sourceMismatch.primitives, *baseMismatch.primitives);
+
+        return entityDiff;
+    }, MinEntityDiffsPerThread);
+
+    for (auto& entityDiff : entityDiffs)
+    {
+        result.differingEntities.emplace_back(std::move(entityDiff));
     }
 
-    for (const auto& mismatch : missingInSource)
+    for (const auto& name : missingInSource)
     {
+        const auto& mismatch = baseMismatches.at(name);
+
         result.differingEntities.emplace_back(ComparisonResult::EntityDifference
         {
             INodePtr(), // source node is empty
-            mismatch.second.node,
-            mismatch.second.entityName,
+            mismatch.node,
+            mismatch.entityName,
             std::string(),// source fingerprint is empty
-            mismatch.second.fingerPrint, // base fingerprint
+            mismatch.fingerPrint, // base fingerprint
             ComparisonResult::EntityDifference::Type::EntityMissingInSource
         });
     }
 
-    for (const auto& mismatch : missingInBase)
+    for (const auto& name : missingInBase)
     {
+        const auto& mismatch = sourceMismatches.at(name);
+
         result.differingEntities.emplace_back(ComparisonResult::EntityDifference
         {
-            mismatch.second.node,
+            mismatch.node,
             INodePtr(), // base node is empty
-            mismatch.second.entityName,
-            mismatch.second.fingerPrint, // source fingerprint
+            mismatch.entityName,
+            mismatch.fingerPrint, // source fingerprint
             std::string(),// base fingerprint is empty
             ComparisonResult::EntityDifference::Type::EntityMissingInBase
         });
@@ -226,25 +261,39 @@ std::list<ComparisonResult::KeyValueDifference> GraphComparer::compareKeyValues(
 }
 
 std::list<ComparisonResult::PrimitiveDifference> GraphComparer::compareChildNodes(
-    const INodePtr& sourceNode, const INodePtr& baseNode)
+    const Fingerprints& sourceChildren, const Fingerprints& baseChildren)
 {
     std::list<ComparisonResult::PrimitiveDifference> result;
 
-    auto sourceChildren = NodeUtils::CollectPrimitiveFingerprints(sourceNode);
-    auto baseChildren = NodeUtils::CollectPrimitiveFingerprints(baseNode);
+    using FingerprintAndNode = std::pair<std::string, INodePtr>;
 
-    std::vector<Fingerprints::value_type> missingInSource;
-    std::vector<Fingerprints::value_type> missingInBase;
+    std::vector<FingerprintAndNode> missingInSource;
+    std::vector<FingerprintAndNode> missingInBase;
+
+    for (const auto& pair : sourceChildren)
+    {
+        if (baseChildren.count(pair.first) == 0)
+        {
+            missingInBase.push_back(pair);
+        }
+    }
+
+    for (const auto& pair : baseChildren)
+    {
+        if (sourceChildren.count(pair.first) == 0)
+        {
+            missingInSource.push_back(pair);
+        }
+    }
 
-    auto compareFingerprint = [](const Fingerprints::value_type& left, const Fingerprints::value_type& right)
+    // Report the differences ordered by fingerprint, independently of the hash order
+    auto compareFingerprint = [](const FingerprintAndNode& left, const FingerprintAndNode& right)
     {
         return left.first < right.first;
     };
 
-    std::set_difference(sourceChildren.begin(), sourceChildren.end(),
-        baseChildren.begin(), baseChildren.end(), std::back_inserter(missingInBase), compareFingerprint);
-    std::set_difference(baseChildren.begin(), baseChildren.end(),
-        sourceChildren.begin(), sourceChildren.end(), std::back_inserter(missingInSource), compareFingerprint);
+    std::sort(missingInBase.begin(), missingInBase.end(), compareFingerprint);
+    std::sort(missingInSource.begin(), missingInSource.end(), compareFingerprint);
 
     for (const auto& pair : missingInBase)
     {
@@ -2,7 +2,7 @@
 
 #include <string>
 #include <list>
-#include <map>
+#include <unordered_map>
 #include <memory>
 
 #include "inode.h"
@@ -10,6 +10,7 @@
 #include "itextstream.h"
 
 #include "ComparisonResult.h"
+#include "FingerprintIndex.h"
 
 namespace scene
 {
@@ -24,23 +25,28 @@ namespace merge
  */
 class GraphComparer
 {
-private:
-    using Fingerprints = std::map<std::string, INodePtr>;
-
 public:
     struct EntityMismatch
     {
         std::string fingerPrint;
         INodePtr node;
         std::string entityName;
+
+        // The primitive fingerprints of this entity (owned by the index)
+        const Fingerprints* primitives;
     };
 
-    using EntityMismatchByName = std::map<std::string, EntityMismatch>;
+    using EntityMismatchByName = std::unordered_map<std::string, EntityMismatch>;
 
 public:
     // Compares the two graphs and returns the result
     static ComparisonResult::Ptr Compare(const IMapRootNodePtr& source, const IMapRootNodePtr& base);
 
+    // Compares the two graphs using the given (already built) fingerprint indexes.
+    // Use this overload to avoid re-indexing graphs that are compared more than once.
+    static ComparisonResult::Ptr Compare(const IMapRootNodePtr& source, const FingerprintIndex& sourceIndex,
+        const IMapRootNodePtr& base, const FingerprintIndex& baseIndex);
+
 private:
     static void processDifferingEntities(ComparisonResult& result, const EntityMismatchByName& sourceMismatches, 
         const EntityMismatchByName& baseMismatches);
@@ -49,7 +55,7 @@ private:
         const INodePtr& sourceNode, const INodePtr& baseNode);
 
     static std::list<ComparisonResult::PrimitiveDifference> compareChildNodes(
-        const INodePtr& sourceNode, const INodePtr& baseNode);
+        const Fingerprints& sourceChildren, const Fingerprints& baseChildren);
 };
 
 }
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <map>
+#include <unordered_map>
 #include "inode.h"
 #include "icomparablenode.h"
 #include "ientity.h"
@@ -12,7 +12,7 @@ namespace scene
 namespace merge
 {
 
-using Fingerprints = std::map<std::string, INodePtr>;
+using Fingerprints = std::unordered_map<std::string, INodePtr>;
 
 class NodeUtils
 {
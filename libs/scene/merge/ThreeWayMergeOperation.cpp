@@ -1,5 +1,6 @@
 #include "ThreeWayMergeOperation.h"
 
+#include <unordered_map>
 #include "itextstream.h"
 #include "inamespace.h"
 #include "NodeUtils.h"
@@ -16,17 +17,25 @@ namespace merge
 // Contains lookup tables needed during analysis of the two scenes
 struct ThreeWayMergeOperation::ComparisonData
 {
+    // The source differences are processed in the order of the entity names
     std::map<std::string, std::list<ComparisonResult::EntityDifference>::const_iterator> sourceDifferences;
-    std::map<std::string, std::list<ComparisonResult::EntityDifference>::const_iterator> targetDifferences;
-    std::map<std::string, INodePtr> targetEntities;
+    std::unordered_map<std::string, std::list<ComparisonResult::EntityDifference>::const_iterator> targetDifferences;
+    std::unordered_map<std::string, INodePtr> targetEntities;
+
+    const FingerprintIndex& targetEntityIndex;
 
     ComparisonResult::Ptr baseToSource;
     ComparisonResult::Ptr baseToTarget;
 
-    ComparisonData(const IMapRootNodePtr& baseRoot, const IMapRootNodePtr& sourceRoot, const IMapRootNodePtr& targetRoot)
+    ComparisonData(const IMapRootNodePtr& baseRoot, const FingerprintIndex& baseIndex, const IMapRootNodePtr& sourceRoot,
+        const IMapRootNodePtr& targetRoot, const FingerprintIndex& targetIndex) :
+        targetEntityIndex(targetIndex)
     {
-        baseToSource = GraphComparer::Compare(sourceRoot, baseRoot);
-        baseToTarget = GraphComparer::Compare(targetRoot, baseRoot);
+        // The source graph might have been changed since the last analysis, index it again
+        FingerprintIndex sourceIndex(sourceRoot);
+
+        baseToSource = GraphComparer::Compare(sourceRoot, sourceIndex, baseRoot, baseIndex);
+        baseToTarget = GraphComparer::Compare(targetRoot, targetIndex, baseRoot, baseIndex);
 
         // Create source and target entity diff dictionaries (by entity name)
         for (auto it = baseToSource->differingEntities.begin(); it != baseToSource->differingEntities.end(); ++it)
@@ -56,6 +65,16 @@ struct ThreeWayMergeOperation::ComparisonData
         auto found = targetEntities.find(name);
         return found != targetEntities.end() ? found->second : INodePtr();
     }
+
+    // Returns the primitives of the given target entity, by fingerprint
+    Fingerprints getTargetPrimitives(const ComparisonResult::EntityDifference& targetDiff) const
+    {
+        auto entry = targetEntityIndex.findByFingerprint(targetDiff.sourceFingerprint);
+
+        // Only entities with a unique fingerprint are indexed, fall back to collecting the children
+        return entry && entry->node == targetDiff.sourceNode ? entry->primitives :
+            NodeUtils::CollectPrimitiveFingerprints(targetDiff.sourceNode);
+    }
 };
 
 ThreeWayMergeOperation::ThreeWayMergeOperation(const scene::IMapRootNodePtr& baseRoot,
@@ -136,7 +155,7 @@ ConflictType ThreeWayMergeOperation::GetKeyValueConflictType(const ComparisonRes
 }
 
 void ThreeWayMergeOperation::processEntityModification(const ComparisonResult::EntityDifference& sourceDiff, 
-    const ComparisonResult::EntityDifference& targetDiff)
+    const ComparisonResult::EntityDifference& targetDiff, const Fingerprints& targetChildren)
 {
     assert(sourceDiff.type == ComparisonResult::EntityDifference::Type::EntityPresentButDifferent);
 
@@ -162,8 +181,6 @@ void ThreeWayMergeOperation::processEntityModification(const ComparisonResult::E
     }
 
     // Both graphs modified this entity, do an in-depth comparison
-    auto targetChildren = NodeUtils::CollectPrimitiveFingerprints(targetDiff.sourceNode);
-
     // Every primitive change that has been done to the target map can be applied
     // to the source map, since we can't detect whether one of them has been moved or retextured
     for (const auto& primitiveDiff : sourceDiff.differingChildren)
@@ -186,7 +203,7 @@ void ThreeWayMergeOperation::processEntityModification(const ComparisonResult::E
             // Check if this primitive is still present in the target map, otherwise we can't remove it
             if (primitivePresentInTargetMap)
             {
-                addAction(std::make_shared<RemoveChildAction>(targetChildren[primitiveDiff.fingerprint]));
+                addAction(std::make_shared<RemoveChildAction>(targetChildren.at(primitiveDiff.fingerprint)));
             }
             break;
         }
@@ -233,9 +250,9 @@ void ThreeWayMergeOperation::processEntityModification(const ComparisonResult::E
     }
 }
 
-void ThreeWayMergeOperation::compareAndCreateActions()
+void ThreeWayMergeOperation::compareAndCreateActions(const FingerprintIndex& baseIndex, const FingerprintIndex& targetIndex)
 {
-    ComparisonData data(_baseRoot, _sourceRoot, _targetRoot);
+    ComparisonData data(_baseRoot, baseIndex, _sourceRoot, _targetRoot, targetIndex);
 
     // Check each entity difference from the base to the source map
     // fully accept only those entities that are not altered in the target map, and detect conflicts
@@ -326,7 +343,7 @@ void ThreeWayMergeOperation::compareAndCreateActions()
         
         case ComparisonResult::EntityDifference::Type::EntityPresentButDifferent:
             // This entity has been modified in the source, check the target diff
-            processEntityModification(*pair.second, *targetDiff->second);
+            processEntityModification(*pair.second, *targetDiff->second, data.getTargetPrimitives(*targetDiff->second));
             break;
         }
     }
@@ -342,19 +359,22 @@ ThreeWayMergeOperation::Ptr ThreeWayMergeOperation::Create(const IMapRootNodePtr
 
     auto operation = std::make_shared<ThreeWayMergeOperation>(baseRoot, sourceRoot, targetRoot);
 
+    FingerprintIndex baseIndex(baseRoot);
+    FingerprintIndex targetIndex(targetRoot);
+
     // Phase 1 is to detect any entity additions from the source to the target that might cause name conflicts
     // After this pass some key values might have been changed
-    operation->adjustSourceEntitiesWithNameConflicts();
+    operation->adjustSourceEntitiesWithNameConflicts(baseIndex, targetIndex);
 
     // Phase 2 will run another comparison of the graphs (since key values might have been modified)
-    operation->compareAndCreateActions();
+    operation->compareAndCreateActions(baseIndex, targetIndex);
 
     return operation;
 }
 
-void ThreeWayMergeOperation::adjustSourceEntitiesWithNameConflicts()
+void ThreeWayMergeOperation::adjustSourceEntitiesWithNameConflicts(const FingerprintIndex& baseIndex, const FingerprintIndex& targetIndex)
 {
-    ComparisonData data(_baseRoot, _sourceRoot, _targetRoot);
+    ComparisonData data(_baseRoot, baseIndex, _sourceRoot, _targetRoot, targetIndex);
 
     std::set<INodePtr> sourceEntitiesToBeRenamed;
 
@@ -6,6 +6,7 @@
 #include "ComparisonResult.h"
 #include "MergeAction.h"
 #include "MergeOperationBase.h"
+#include "FingerprintIndex.h"
 
 namespace scene
 {
@@ -63,11 +64,13 @@ public:
     void applyActions() override;
 
 private:
-    void adjustSourceEntitiesWithNameConflicts();
+    // The base and target indexes are built once and shared by both analysis phases,
+    // since neither of these two graphs is modified before the actions are applied
+    void adjustSourceEntitiesWithNameConflicts(const FingerprintIndex& baseIndex, const FingerprintIndex& targetIndex);
     
-    void compareAndCreateActions();
+    void compareAndCreateActions(const FingerprintIndex& baseIndex, const FingerprintIndex& targetIndex);
     void processEntityModification(const ComparisonResult::EntityDifference& sourceDiff,
-        const ComparisonResult::EntityDifference& targetDiff);
+        const ComparisonResult::EntityDifference& targetDiff, const Fingerprints& targetChildren);
 
     static ConflictType GetKeyValueConflictType(const ComparisonResult::KeyValueDifference& sourceKeyValueDiff,
         const ComparisonResult::KeyValueDifference& targetKeyValueDiff);
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <streambuf>
+#include <ios>
+
+namespace stream
+{
+
+/**
+ * Read-only, seekable std::streambuf serving the given memory region.
+ * The contents are not copied, the get area points directly to the
+ * memory block, which needs to stay valid during the lifetime of this buffer.
+ */
+class MemoryStreamBuffer :
+	public std::streambuf
+{
+public:
+	MemoryStreamBuffer(const char* data, std::size_t size)
+	{
+		// The get area pointers are non-const, but we never write through them
+		auto begin = const_cast<char*>(data);
+		setg(begin, begin, begin + size);
+	}
+
+protected:
+	std::streampos seekoff(std::streamoff off, std::ios_base::seekdir way,
+		std::ios_base::openmode which = std::ios_base::in) override
+	{
+		if ((which & std::ios_base::in) == 0)
+		{
+			return std::streampos(-1);
+		}
+
+		std::streamoff base = 0;
+
+		if (way == std::ios_base::cur)
+		{
+			base = gptr() - eback();
+		}
+		else if (way == std::ios_base::end)
+		{
+			base = egptr() - eback();
+		}
+
+		auto newPos = base + off;
+
+		if (newPos < 0 || newPos > egptr() - eback())
+		{
+			return std::streampos(-1); // error
+		}
+
+		setg(eback(), eback() + newPos, egptr());
+
+		return std::streampos(newPos);
+	}
+
+	std::streampos seekpos(std::streampos pos, std::ios_base::openmode which = std::ios_base::in) override
+	{
+		return seekoff(std::streamoff(pos), std::ios_base::beg, which);
+	}
+
+	std::streamsize showmanyc() override
+	{
+		auto remaining = egptr() - gptr();
+		return remaining > 0 ? remaining : -1;
+	}
+};
+
+}
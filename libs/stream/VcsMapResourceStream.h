@@ -1,33 +1,51 @@
 #pragma once
 
+#include <sstream>
 #include "iversioncontrol.h"
 #include "itextstream.h"
 #include "MapResourceStream.h"
+#include "MemoryStreamBuffer.h"
 
 namespace stream
 {
 
-// Loading the given archive file into a buffer 
-// to serve the contents as MapResourceStream
+// Serves the given archive file as MapResourceStream. Files held in memory
+// by the VCS module are read in place, anything else is loaded into a buffer first.
 class VcsMapResourceStream :
     public MapResourceStream
 {
 private:
-    std::stringstream _contentStream;
-    bool _opened;
+    // Keeps the file contents alive while the stream is in use
+    ArchiveTextFilePtr _file;
+
+    std::unique_ptr<MemoryStreamBuffer> _buffer;
+    std::unique_ptr<std::istream> _contentStream;
 
 public:
     using Ptr = std::shared_ptr<VcsMapResourceStream>;
 
-    VcsMapResourceStream(const ArchiveTextFilePtr& vcsArchive)
+    VcsMapResourceStream(const ArchiveTextFilePtr& vcsArchive) :
+        _file(vcsArchive)
     {
         rMessage() << "Opened text file in VCS: " << vcsArchive->getName() << std::endl;
 
+        auto versionedFile = std::dynamic_pointer_cast<vcs::IVersionedTextFile>(vcsArchive);
+
+        if (versionedFile)
+        {
+            // Contents are already in memory, serve them without copying
+            _buffer = std::make_unique<MemoryStreamBuffer>(versionedFile->getData(), versionedFile->getSize());
+            _contentStream = std::make_unique<std::istream>(_buffer.get());
+            return;
+        }
+
         // We can't be sure if the returned stream is seekable,
         // so load everything into a seekable string stream
         std::istream vfsStream(&(vcsArchive->getInputStream()));
 
-        _contentStream << vfsStream.rdbuf();
+        auto stringStream = std::make_unique<std::stringstream>();
+        *stringStream << vfsStream.rdbuf();
+        _contentStream = std::move(stringStream);
     }
 
     // Returns true if the stream has been successfully opened
@@ -39,7 +57,7 @@ public:
     // Returns the (seekable) input stream
     virtual std::istream& getStream() override
     {
-        return _contentStream;
+        return *_contentStream;
     }
 
     // Factory method which will return a stream reference of the given VCS file
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <fmt/format.h>
+
+namespace util
+{
+
+/**
+ * Writes timing events to a stream using the Chrome trace event format,
+ * which can be inspected with chrome://tracing, Perfetto or Speedscope.
+ * Timestamps and durations are specified in microseconds. The JSON
+ * document is completed when the writer is destroyed.
+ */
+class ChromeTraceWriter
+{
+private:
+    std::ostream& _stream;
+    bool _firstEvent;
+
+public:
+    ChromeTraceWriter(std::ostream& stream) :
+        _stream(stream),
+        _firstEvent(true)
+    {
+        _stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    }
+
+    ChromeTraceWriter(const ChromeTraceWriter& other) = delete;
+    ChromeTraceWriter& operator=(const ChromeTraceWriter& other) = delete;
+
+    ~ChromeTraceWriter()
+    {
+        _stream << "\n]}\n";
+        _stream.flush();
+    }
+
+    // An event with a start time and a duration ("X" phase), the optional detail is shown in its arguments
+    void writeCompleteEvent(const std::string& name, const std::string& category,
+        std::uint32_t threadId, double startMicros, double durationMicros, const std::string& detail = std::string())
+    {
+        beginEvent();
+        _stream << fmt::format("{{\"name\":\"{0}\",\"cat\":\"{1}\",\"ph\":\"X\",\"pid\":1,\"tid\":{2},"
+            "\"ts\":{3:.3f},\"dur\":{4:.3f}",
+            escape(name), escape(category), threadId, startMicros, durationMicros);
+
+        if (!detail.empty())
+        {
+            _stream << fmt::format(",\"args\":{{\"detail\":\"{0}\"}}", escape(detail));
+        }
+
+        _stream << "}";
+    }
+
+    // A counter track with one or more named values ("C" phase)
+    void writeCounterEvent(const std::string& name, double timeMicros,
+        const std::map<std::string, std::size_t>& values)
+    {
+        beginEvent();
+        _stream << fmt::format("{{\"name\":\"{0}\",\"ph\":\"C\",\"pid\":1,\"ts\":{1:.3f},\"args\":{{",
+            escape(name), timeMicros);
+
+        bool first = true;
+
+        for (const auto& [key, value] : values)
+        {
+            _stream << (first ? "" : ",") << fmt::format("\"{0}\":{1}", escape(key), value);
+            first = false;
+        }
+
+        _stream << "}}";
+    }
+
+    // Metadata event assigning a display name to the given thread ID
+    void writeThreadName(std::uint32_t threadId, const std::string& name)
+    {
+        beginEvent();
+        _stream << fmt::format("{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{0},"
+            "\"args\":{{\"name\":\"{1}\"}}}}", threadId, escape(name));
+    }
+
+    // Escapes the characters which are not allowed in a JSON string literal
+    static std::string escape(const std::string& input)
+    {
+        std::string result;
+        result.reserve(input.size());
+
+        for (auto c : input)
+        {
+            switch (c)
+            {
+            case '"': result += "\\\""; break;
+            case '\\': result += "\\\\"; break;
+            case '\n': result += "\\n"; break;
+            case '\t': result += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    result += fmt::format("\\u{0:04x}", static_cast<int>(c));
+                }
+                else
+                {
+                    result += c;
+                }
+            }
+        }
+
+        return result;
+    }
+
+private:
+    void beginEvent()
+    {
+        _stream << (_firstEvent ? "\n" : ",\n");
+        _firstEvent = false;
+    }
+};
+
+}
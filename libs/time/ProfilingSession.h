@@ -0,0 +1,333 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <fmt/format.h>
+
+#include "ChromeTraceWriter.h"
+
+namespace util
+{
+
+/**
+ * Collects the time spent in named stages and the values of named counters
+ * while it is active. At most one session is active at a time, it is the one
+ * reporting to ScopedProfilingStage and addProfilingCount(), which are placed
+ * in the code paths of interest and do nothing if no session is active.
+ *
+ * Stages can be nested, for each stage both the total time and the time not
+ * spent in nested stages of the same thread ("self" time) are accumulated.
+ * If requested, every single stage run is kept for writing a Chrome trace.
+ *
+ * Stages and counters can be reported from any thread. The session must
+ * outlive all stages started while it was active.
+ */
+class ProfilingSession
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+private:
+    struct StageInfo
+    {
+        std::size_t calls = 0;
+        Clock::duration totalTime = Clock::duration::zero();
+        Clock::duration selfTime = Clock::duration::zero();
+    };
+
+    struct Event
+    {
+        const char* stage;
+        std::uint32_t threadId;
+        Clock::time_point start;
+        Clock::duration duration;
+    };
+
+    // Upper limit for the number of events kept for the trace
+    static constexpr std::size_t MaxEvents = 1000000;
+
+    std::string _name;
+    bool _recordEvents;
+    bool _active;
+
+    Clock::time_point _start;
+
+    mutable std::mutex _lock;
+    std::map<std::string, StageInfo, std::less<>> _stages;
+    std::map<std::string, std::size_t, std::less<>> _counters;
+    std::vector<Event> _events;
+    std::size_t _numDroppedEvents;
+    std::map<std::thread::id, std::uint32_t> _threadIds;
+
+public:
+    // Starts the session, becoming the active one unless another session is already active
+    ProfilingSession(const std::string& name, bool recordEvents = false) :
+        _name(name),
+        _recordEvents(recordEvents),
+        _active(false),
+        _start(Clock::now()),
+        _numDroppedEvents(0)
+    {
+        ProfilingSession* expected = nullptr;
+        _active = ActiveSession().compare_exchange_strong(expected, this);
+    }
+
+    ProfilingSession(const ProfilingSession& other) = delete;
+    ProfilingSession& operator=(const ProfilingSession& other) = delete;
+
+    ~ProfilingSession()
+    {
+        stop();
+    }
+
+    // Returns the currently active session, or nullptr if there is none
+    static ProfilingSession* GetActive()
+    {
+        return ActiveSession().load(std::memory_order_acquire);
+    }
+
+    bool isActive() const
+    {
+        return _active;
+    }
+
+    // Stops collecting information, the results stay available
+    void stop()
+    {
+        if (_active)
+        {
+            ProfilingSession* expected = this;
+            ActiveSession().compare_exchange_strong(expected, nullptr);
+            _active = false;
+        }
+    }
+
+    void addStageTime(const char* stage, Clock::time_point start, Clock::duration duration,
+        Clock::duration nestedDuration)
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+
+        auto info = _stages.find(std::string_view(stage));
+
+        if (info == _stages.end())
+        {
+            info = _stages.emplace(stage, StageInfo()).first;
+        }
+
+        ++info->second.calls;
+        info->second.totalTime += duration;
+        info->second.selfTime += duration - nestedDuration;
+
+        if (!_recordEvents) return;
+
+        if (_events.size() >= MaxEvents)
+        {
+            ++_numDroppedEvents;
+            return;
+        }
+
+        auto threadId = _threadIds.emplace(std::this_thread::get_id(),
+            static_cast<std::uint32_t>(_threadIds.size() + 1)).first->second;
+
+        _events.push_back(Event{ stage, threadId, start, duration });
+    }
+
+    void addToCounter(const char* counter, std::size_t amount)
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+
+        auto existing = _counters.find(std::string_view(counter));
+
+        if (existing == _counters.end())
+        {
+            _counters.emplace(counter, amount);
+            return;
+        }
+
+        existing->second += amount;
+    }
+
+    // Returns the accumulated value of the given counter
+    std::size_t getCounter(const std::string& counter) const
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+
+        auto existing = _counters.find(counter);
+        return existing != _counters.end() ? existing->second : 0;
+    }
+
+    // Returns the number of times the given stage has been run
+    std::size_t getNumStageCalls(const std::string& stage) const
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+
+        auto existing = _stages.find(stage);
+        return existing != _stages.end() ? existing->second.calls : 0;
+    }
+
+    /**
+     * Returns a table listing all stages, ordered by their total time,
+     * followed by the counter values, ready to be written to the log.
+     */
+    std::string getSummary() const
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+
+        std::vector<std::pair<std::string, StageInfo>> stages(_stages.begin(), _stages.end());
+
+        std::sort(stages.begin(), stages.end(), [](const auto& a, const auto& b)
+        {
+            return a.second.totalTime > b.second.totalTime;
+        });
+
+        auto summary = fmt::format("--- Profile: {0} ({1:.1f} msecs) ---\n", _name,
+            toMilliSeconds(Clock::now() - _start));
+
+        summary += fmt::format("{0:<36} {1:>10} {2:>12} {3:>12}\n", "Stage", "Calls", "Total msecs", "Self msecs");
+
+        for (const auto& [name, info] : stages)
+        {
+            summary += fmt::format("{0:<36} {1:>10} {2:>12.1f} {3:>12.1f}\n", name, info.calls,
+                toMilliSeconds(info.totalTime), toMilliSeconds(info.selfTime));
+        }
+
+        for (const auto& [name, value] : _counters)
+        {
+            summary += fmt::format("{0:<36} {1:>10}\n", name, value);
+        }
+
+        return summary;
+    }
+
+    // Writes the recorded stage events and the final counter values in Chrome trace format
+    void writeChromeTrace(std::ostream& stream) const
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+
+        ChromeTraceWriter writer(stream);
+
+        for (const auto& [id, threadId] : _threadIds)
+        {
+            writer.writeThreadName(threadId, fmt::format("Thread {0}", threadId));
+        }
+
+        auto end = _start;
+
+        for (const auto& event : _events)
+        {
+            writer.writeCompleteEvent(event.stage, _name, event.threadId,
+                toMicroSeconds(event.start - _start), toMicroSeconds(event.duration));
+
+            end = std::max(end, event.start + event.duration);
+        }
+
+        if (!_counters.empty())
+        {
+            std::map<std::string, std::size_t> counters(_counters.begin(), _counters.end());
+            writer.writeCounterEvent(_name, toMicroSeconds(end - _start), counters);
+        }
+
+        if (_numDroppedEvents > 0)
+        {
+            writer.writeCounterEvent("Dropped events", toMicroSeconds(end - _start),
+                { { "events", _numDroppedEvents } });
+        }
+    }
+
+private:
+    static std::atomic<ProfilingSession*>& ActiveSession()
+    {
+        static std::atomic<ProfilingSession*> _activeSession(nullptr);
+        return _activeSession;
+    }
+
+    static double toMilliSeconds(Clock::duration duration)
+    {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+
+    static double toMicroSeconds(Clock::duration duration)
+    {
+        return std::chrono::duration<double, std::micro>(duration).count();
+    }
+};
+
+/**
+ * Measures the time spent until the end of the scope, reporting it
+ * to the active ProfilingSession under the given stage name.
+ * If no session is active, this is doing nothing.
+ */
+class ScopedProfilingStage
+{
+private:
+    ProfilingSession* _session;
+    const char* _stage;
+
+    ProfilingSession::Clock::time_point _start;
+
+    // Time spent in stages nested into this one
+    ProfilingSession::Clock::duration _nestedDuration;
+    ScopedProfilingStage* _parent;
+
+public:
+    // The stage name needs to stay valid during the session, usually a string literal
+    ScopedProfilingStage(const char* stage) :
+        _session(ProfilingSession::GetActive()),
+        _stage(stage),
+        _nestedDuration(ProfilingSession::Clock::duration::zero()),
+        _parent(nullptr)
+    {
+        if (!_session) return;
+
+        _parent = CurrentStage();
+        CurrentStage() = this;
+        _start = ProfilingSession::Clock::now();
+    }
+
+    ScopedProfilingStage(const ScopedProfilingStage& other) = delete;
+    ScopedProfilingStage& operator=(const ScopedProfilingStage& other) = delete;
+
+    ~ScopedProfilingStage()
+    {
+        if (!_session) return;
+
+        auto duration = ProfilingSession::Clock::now() - _start;
+
+        CurrentStage() = _parent;
+
+        if (_parent)
+        {
+            _parent->_nestedDuration += duration;
+        }
+
+        _session->addStageTime(_stage, _start, duration, _nestedDuration);
+    }
+
+private:
+    // The innermost stage running in the calling thread
+    static ScopedProfilingStage*& CurrentStage()
+    {
+        static thread_local ScopedProfilingStage* _currentStage = nullptr;
+        return _currentStage;
+    }
+};
+
+// Adds the given amount to the named counter of the active ProfilingSession, if there is one
+inline void addProfilingCount(const char* counter, std::size_t amount = 1)
+{
+    if (auto session = ProfilingSession::GetActive(); session != nullptr)
+    {
+        session->addToCounter(counter, amount);
+    }
+}
+
+}
@@ -0,0 +1,436 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <fmt/format.h>
+
+#include "ChromeTraceWriter.h"
+
+namespace util
+{
+
+namespace detail
+{
+    // Checked by every trace point, kept outside of TraceRecorder to avoid any initialisation guards
+    inline std::atomic<bool> TracingEnabled(false);
+}
+
+/**
+ * A single timed event recorded by a ScopedTrace. Category and name
+ * are expected to be string literals, the detail (e.g. a file name)
+ * is optional. Events are stored in place, long details are cut off
+ * at the front, since the end of a path is the interesting part.
+ */
+struct TraceEvent
+{
+    static constexpr std::size_t MaxDetailLength = 95;
+
+    const char* category;
+    const char* name;
+    std::chrono::steady_clock::time_point start;
+    std::chrono::steady_clock::duration duration;
+    char detail[MaxDetailLength + 1];
+
+    void setDetail(const std::string& text)
+    {
+        auto length = std::min(text.length(), MaxDetailLength);
+        auto first = text.length() - length;
+
+        text.copy(detail, length, first);
+        detail[length] = '\0';
+
+        if (first > 0)
+        {
+            std::fill(detail, detail + 3, '.');
+        }
+    }
+};
+
+/**
+ * Fixed-size ring buffer holding the most recent trace events of a single thread.
+ * Once full, each new event replaces the oldest one.
+ *
+ * Only the owning thread is adding events, without taking any lock. Other threads
+ * may read or clear the buffer at any time: readers copy the events and discard
+ * the ones whose slots have been claimed by the writer in the meantime (the same
+ * scheme as a sequence lock). Storage is allocated in blocks on first use.
+ */
+class TraceBuffer
+{
+public:
+    static constexpr std::size_t Capacity = 16384;
+
+private:
+    static constexpr std::size_t BlockSize = 1024;
+    static constexpr std::size_t NumBlocks = Capacity / BlockSize;
+
+    std::atomic<TraceEvent*> _blocks[NumBlocks];
+
+    // The number of events the writer has started to write (claimed slots)
+    std::atomic<std::size_t> _numStarted;
+
+    // The number of events completely written, in order
+    std::atomic<std::size_t> _numWritten;
+
+    // Events before this number have been discarded by clear()
+    std::atomic<std::size_t> _numCleared;
+
+    std::uint32_t _threadId;
+
+    std::mutex _nameLock;
+    std::string _threadName;
+
+    std::atomic<bool> _threadFinished;
+
+public:
+    TraceBuffer(std::uint32_t threadId) :
+        _numStarted(0),
+        _numWritten(0),
+        _numCleared(0),
+        _threadId(threadId),
+        _threadName(fmt::format("Thread {0}", threadId)),
+        _threadFinished(false)
+    {
+        for (auto& block : _blocks)
+        {
+            block.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    TraceBuffer(const TraceBuffer& other) = delete;
+    TraceBuffer& operator=(const TraceBuffer& other) = delete;
+
+    ~TraceBuffer()
+    {
+        for (auto& block : _blocks)
+        {
+            delete[] block.load(std::memory_order_relaxed);
+        }
+    }
+
+    std::uint32_t getThreadId() const
+    {
+        return _threadId;
+    }
+
+    std::string getThreadName()
+    {
+        std::lock_guard<std::mutex> lock(_nameLock);
+        return _threadName;
+    }
+
+    void setThreadName(const std::string& name)
+    {
+        std::lock_guard<std::mutex> lock(_nameLock);
+        _threadName = name;
+    }
+
+    bool isThreadFinished() const
+    {
+        return _threadFinished;
+    }
+
+    void setThreadFinished()
+    {
+        _threadFinished = true;
+    }
+
+    // To be called by the owning thread only
+    void add(const char* category, const char* name, const std::string& detail,
+        std::chrono::steady_clock::time_point start, std::chrono::steady_clock::duration duration)
+    {
+        auto index = _numWritten.load(std::memory_order_relaxed);
+
+        // Claim the slot before touching it, readers will discard what they copied from it
+        _numStarted.store(index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        auto& event = getOrCreateSlot(index % Capacity);
+
+        event.category = category;
+        event.name = name;
+        event.start = start;
+        event.duration = duration;
+        event.setDetail(detail);
+
+        // Publish the event
+        _numWritten.store(index + 1, std::memory_order_release);
+    }
+
+    void clear()
+    {
+        _numCleared.store(_numWritten.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+
+    std::size_t getNumEvents() const
+    {
+        auto numWritten = _numWritten.load(std::memory_order_acquire);
+        auto numCleared = std::min(_numCleared.load(std::memory_order_relaxed), numWritten);
+
+        return std::min(numWritten - numCleared, Capacity);
+    }
+
+    // Invokes the functor for a copy of each event, oldest first
+    template<typename Functor>
+    void foreachEvent(Functor&& functor)
+    {
+        auto end = _numWritten.load(std::memory_order_acquire);
+        auto begin = std::max(_numCleared.load(std::memory_order_relaxed), end > Capacity ? end - Capacity : 0);
+
+        if (begin >= end) return;
+
+        std::vector<TraceEvent> events;
+        events.reserve(end - begin);
+
+        for (auto index = begin; index < end; ++index)
+        {
+            auto block = _blocks[(index % Capacity) / BlockSize].load(std::memory_order_acquire);
+            events.push_back(block[index % BlockSize]);
+        }
+
+        // Events in slots which have been claimed again while copying might be torn
+        std::atomic_thread_fence(std::memory_order_acquire);
+        auto numStarted = _numStarted.load(std::memory_order_relaxed);
+        auto firstValid = numStarted > Capacity ? numStarted - Capacity : 0;
+
+        for (auto index = std::max(begin, firstValid); index < end; ++index)
+        {
+            functor(events[index - begin]);
+        }
+    }
+
+private:
+    TraceEvent& getOrCreateSlot(std::size_t slot)
+    {
+        auto& blockPtr = _blocks[slot / BlockSize];
+        auto block = blockPtr.load(std::memory_order_relaxed);
+
+        if (!block)
+        {
+            block = new TraceEvent[BlockSize];
+            blockPtr.store(block, std::memory_order_release);
+        }
+
+        return block[slot % BlockSize];
+    }
+};
+
+/**
+ * Process-wide recorder collecting the events of all ScopedTrace instances
+ * in per-thread ring buffers, such that the last few seconds before a hitch
+ * can be inspected after the fact. Recording is off by default, a disabled
+ * trace point costs a single atomic load.
+ *
+ * The recorder lives in the module the trace points are compiled into,
+ * the console commands of the core module control the one of the core.
+ */
+class TraceRecorder
+{
+private:
+    // Buffers of finished threads are kept for the dump, up to this number
+    static constexpr std::size_t MaxFinishedThreadBuffers = 32;
+
+    std::mutex _lock;
+    std::vector<std::shared_ptr<TraceBuffer>> _buffers;
+    std::uint32_t _nextThreadId;
+
+    std::chrono::steady_clock::time_point _epoch;
+
+    // Holds the buffer of the calling thread, marking it as finished on thread exit
+    class ThreadBufferHandle
+    {
+    public:
+        std::shared_ptr<TraceBuffer> buffer;
+
+        ~ThreadBufferHandle()
+        {
+            if (buffer)
+            {
+                buffer->setThreadFinished();
+            }
+        }
+    };
+
+    TraceRecorder() :
+        _nextThreadId(1),
+        _epoch(std::chrono::steady_clock::now())
+    {}
+
+public:
+    static TraceRecorder& Instance()
+    {
+        // Never destroyed, threads might still be tracing during static destruction
+        static auto* instance = new TraceRecorder;
+        return *instance;
+    }
+
+    static bool IsEnabled()
+    {
+        return detail::TracingEnabled.load(std::memory_order_relaxed);
+    }
+
+    static void SetEnabled(bool enabled)
+    {
+        detail::TracingEnabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    // Returns the buffer of the calling thread, it is created on first use
+    TraceBuffer& getBufferForCurrentThread()
+    {
+        static thread_local ThreadBufferHandle _handle;
+
+        if (!_handle.buffer)
+        {
+            _handle.buffer = createBuffer();
+        }
+
+        return *_handle.buffer;
+    }
+
+    // Assigns a name to the calling thread, shown in the trace
+    void setCurrentThreadName(const std::string& name)
+    {
+        getBufferForCurrentThread().setThreadName(name);
+    }
+
+    // Discards all events recorded so far
+    void clear()
+    {
+        for (const auto& buffer : getBuffers())
+        {
+            buffer->clear();
+        }
+    }
+
+    std::size_t getNumEvents()
+    {
+        std::size_t numEvents = 0;
+
+        for (const auto& buffer : getBuffers())
+        {
+            numEvents += buffer->getNumEvents();
+        }
+
+        return numEvents;
+    }
+
+    // Writes the events of all thread buffers in Chrome trace format
+    void writeChromeTrace(std::ostream& stream)
+    {
+        ChromeTraceWriter writer(stream);
+
+        for (const auto& buffer : getBuffers())
+        {
+            writer.writeThreadName(buffer->getThreadId(), buffer->getThreadName());
+
+            buffer->foreachEvent([&](const TraceEvent& event)
+            {
+                writer.writeCompleteEvent(event.name, event.category, buffer->getThreadId(),
+                    toMicroSeconds(event.start - _epoch), toMicroSeconds(event.duration), event.detail);
+            });
+        }
+    }
+
+private:
+    std::vector<std::shared_ptr<TraceBuffer>> getBuffers()
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        return _buffers;
+    }
+
+    std::shared_ptr<TraceBuffer> createBuffer()
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+
+        // Forget about the oldest finished threads if there are too many of them,
+        // short-lived worker threads would otherwise accumulate
+        auto numFinished = std::count_if(_buffers.begin(), _buffers.end(),
+            [](const auto& buffer) { return buffer->isThreadFinished(); });
+
+        for (auto i = _buffers.begin(); i != _buffers.end() && numFinished >= MaxFinishedThreadBuffers;)
+        {
+            if ((*i)->isThreadFinished())
+            {
+                i = _buffers.erase(i);
+                --numFinished;
+                continue;
+            }
+
+            ++i;
+        }
+
+        _buffers.emplace_back(std::make_shared<TraceBuffer>(_nextThreadId++));
+
+        return _buffers.back();
+    }
+
+    static double toMicroSeconds(std::chrono::steady_clock::duration duration)
+    {
+        return std::chrono::duration<double, std::micro>(duration).count();
+    }
+};
+
+/**
+ * Trace point recording the time spent until the end of the scope into
+ * the buffer of the calling thread, if tracing is enabled. Category and name
+ * need to stay valid until the trace has been written, usually string literals.
+ * The optional detail string is only copied if tracing is enabled.
+ *
+ * util::ScopedTrace trace("vfs", "Open file", filename);
+ */
+class ScopedTrace
+{
+private:
+    const char* _category;
+    const char* _name;
+    std::string _detail;
+
+    bool _enabled;
+    std::chrono::steady_clock::time_point _start;
+
+public:
+    ScopedTrace(const char* category, const char* name) :
+        ScopedTrace(category, name, nullptr)
+    {}
+
+    ScopedTrace(const char* category, const char* name, const std::string& detail) :
+        ScopedTrace(category, name, &detail)
+    {}
+
+    ScopedTrace(const ScopedTrace& other) = delete;
+    ScopedTrace& operator=(const ScopedTrace& other) = delete;
+
+    ~ScopedTrace()
+    {
+        if (!_enabled) return;
+
+        auto duration = std::chrono::steady_clock::now() - _start;
+
+        TraceRecorder::Instance().getBufferForCurrentThread().add(_category, _name, _detail, _start, duration);
+    }
+
+private:
+    ScopedTrace(const char* category, const char* name, const std::string* detail) :
+        _category(category),
+        _name(name),
+        _enabled(TraceRecorder::IsEnabled())
+    {
+        if (!_enabled) return;
+
+        if (detail)
+        {
+            _detail = *detail;
+        }
+
+        _start = std::chrono::steady_clock::now();
+    }
+};
+
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace util
+{
+
+/**
+ * Helpers to estimate the heap memory held by standard containers, used by
+ * the subsystems reporting their footprint to the IMemoryAccounting module.
+ * Only the memory owned by the container itself is considered, memory
+ * owned by the elements (like the contents of a string) is not included.
+ */
+
+// The approximate size of a std::map, std::set or std::list node holding the given value type
+template<typename ValueType>
+constexpr std::size_t getContainerNodeSize()
+{
+	// The value plus the links to the neighbouring nodes and the colour/balance info
+	return sizeof(ValueType) + 4 * sizeof(void*);
+}
+
+// The heap memory held by the given string, which is zero as long as the small buffer suffices
+inline std::size_t getHeapSize(const std::string& str)
+{
+	static const std::size_t smallBufferCapacity = std::string().capacity();
+
+	return str.capacity() > smallBufferCapacity ? str.capacity() + 1 : 0;
+}
+
+namespace detail
+{
+
+template<typename Container, typename = void>
+struct HasCapacity : std::false_type {};
+
+template<typename Container>
+struct HasCapacity<Container, std::void_t<decltype(std::declval<const Container&>().capacity())>> : std::true_type {};
+
+template<typename Container, typename = void>
+struct IsContainer : std::false_type {};
+
+template<typename Container>
+struct IsContainer<Container, std::void_t<typename Container::value_type,
+	decltype(std::declval<const Container&>().size())>> : std::true_type {};
+
+}
+
+/**
+ * The heap memory held by an arbitrary object: contiguous containers are
+ * measured by their capacity, node based containers by their size. Objects
+ * that are not containers don't allocate anything (as far as we know).
+ */
+template<typename T>
+std::size_t getHeapSize(const T& object)
+{
+	if constexpr (detail::HasCapacity<T>::value)
+	{
+		return object.capacity() * sizeof(typename T::value_type);
+	}
+	else if constexpr (detail::IsContainer<T>::value)
+	{
+		return object.size() * getContainerNodeSize<typename T::value_type>();
+	}
+	else
+	{
+		return 0;
+	}
+}
+
+}
@@ -0,0 +1,305 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace util
+{
+
+/**
+ * Hands out memory blocks of a fixed size. The blocks are carved from
+ * larger chunks, released blocks are recycled through a free list.
+ * The chunks are returned to the system once all blocks have been released
+ * (e.g. when a map is unloaded), except for one which is kept for re-use.
+ * All methods are thread-safe.
+ */
+class FixedSizePool
+{
+private:
+	struct FreeBlock
+	{
+		FreeBlock* next;
+	};
+
+	std::size_t _blockSize;
+	std::size_t _alignment;
+	std::size_t _blocksPerChunk;
+
+	std::mutex _lock;
+
+	// Released blocks, ready for re-use
+	FreeBlock* _freeList;
+
+	// The not yet used remainder of the most recent chunk
+	unsigned char* _chunkCursor;
+	unsigned char* _chunkEnd;
+
+	std::vector<void*> _chunks;
+	std::size_t _numAllocatedBlocks;
+
+	// Aim for chunks of at least this size
+	static constexpr std::size_t MinChunkSize = 64 * 1024;
+	static constexpr std::size_t MinBlocksPerChunk = 16;
+
+public:
+	FixedSizePool(std::size_t blockSize, std::size_t alignment) :
+		_alignment(alignment < alignof(FreeBlock) ? alignof(FreeBlock) : alignment),
+		_freeList(nullptr),
+		_chunkCursor(nullptr),
+		_chunkEnd(nullptr),
+		_numAllocatedBlocks(0)
+	{
+		// Blocks must be able to hold the free list pointer, and every block needs to be aligned
+		_blockSize = blockSize < sizeof(FreeBlock) ? sizeof(FreeBlock) : blockSize;
+		_blockSize = (_blockSize + _alignment - 1) / _alignment * _alignment;
+
+		_blocksPerChunk = MinChunkSize / _blockSize;
+
+		if (_blocksPerChunk < MinBlocksPerChunk)
+		{
+			_blocksPerChunk = MinBlocksPerChunk;
+		}
+	}
+
+	FixedSizePool(const FixedSizePool& other) = delete;
+	FixedSizePool& operator=(const FixedSizePool& other) = delete;
+
+	~FixedSizePool()
+	{
+		for (auto chunk : _chunks)
+		{
+			::operator delete(chunk, std::align_val_t(_alignment));
+		}
+	}
+
+	void* allocate()
+	{
+		std::lock_guard<std::mutex> lock(_lock);
+
+		++_numAllocatedBlocks;
+
+		if (_freeList != nullptr)
+		{
+			auto block = _freeList;
+			_freeList = block->next;
+			return block;
+		}
+
+		if (_chunkCursor == _chunkEnd)
+		{
+			auto chunkSize = _blockSize * _blocksPerChunk;
+			auto chunk = static_cast<unsigned char*>(::operator new(chunkSize, std::align_val_t(_alignment)));
+
+			_chunks.push_back(chunk);
+			_chunkCursor = chunk;
+			_chunkEnd = chunk + chunkSize;
+		}
+
+		auto block = _chunkCursor;
+		_chunkCursor += _blockSize;
+
+		return block;
+	}
+
+	void deallocate(void* block)
+	{
+		std::lock_guard<std::mutex> lock(_lock);
+
+		if (--_numAllocatedBlocks == 0)
+		{
+			releaseChunks();
+			return;
+		}
+
+		auto freeBlock = static_cast<FreeBlock*>(block);
+		freeBlock->next = _freeList;
+		_freeList = freeBlock;
+	}
+
+	// The number of blocks currently in use
+	std::size_t getNumAllocatedBlocks()
+	{
+		std::lock_guard<std::mutex> lock(_lock);
+		return _numAllocatedBlocks;
+	}
+
+	// The memory held by this pool, including the unused blocks
+	std::size_t getReservedBytes()
+	{
+		std::lock_guard<std::mutex> lock(_lock);
+		return _chunks.size() * _blocksPerChunk * _blockSize;
+	}
+
+private:
+	// Frees all chunks but the first one, to be called when no block is in use
+	void releaseChunks()
+	{
+		if (_chunks.empty()) return;
+
+		for (auto i = _chunks.begin() + 1; i != _chunks.end(); ++i)
+		{
+			::operator delete(*i, std::align_val_t(_alignment));
+		}
+
+		_chunks.resize(1);
+
+		// Start carving blocks from the beginning of the remaining chunk again
+		_freeList = nullptr;
+		_chunkCursor = static_cast<unsigned char*>(_chunks.front());
+		_chunkEnd = _chunkCursor + _blockSize * _blocksPerChunk;
+	}
+};
+
+/**
+ * The pools serving the allocators rebound from PoolAllocator<T, Owner> to
+ * different types. std::allocate_shared only allocates the combined control
+ * block, whose type is an implementation detail, so the pools are looked up
+ * through the Owner type they have been created for.
+ */
+template<typename Owner>
+class PoolGroup
+{
+private:
+	struct Pools
+	{
+		std::mutex lock;
+		std::vector<FixedSizePool*> pools;
+	};
+
+	static Pools& GetPools()
+	{
+		// Never destroyed, like the pools themselves
+		static auto* pools = new Pools;
+		return *pools;
+	}
+
+public:
+	// Creates a new pool belonging to this group
+	static FixedSizePool* CreatePool(std::size_t blockSize, std::size_t alignment)
+	{
+		auto& pools = GetPools();
+		std::lock_guard<std::mutex> lock(pools.lock);
+
+		pools.pools.push_back(new FixedSizePool(blockSize, alignment));
+		return pools.pools.back();
+	}
+
+	// The number of blocks currently in use, summed over all pools of this group
+	static std::size_t GetNumAllocatedBlocks()
+	{
+		auto& pools = GetPools();
+		std::lock_guard<std::mutex> lock(pools.lock);
+
+		std::size_t total = 0;
+
+		for (auto pool : pools.pools)
+		{
+			total += pool->getNumAllocatedBlocks();
+		}
+
+		return total;
+	}
+
+	// The memory held by all pools of this group, including the blocks kept for re-use
+	static std::size_t GetReservedBytes()
+	{
+		auto& pools = GetPools();
+		std::lock_guard<std::mutex> lock(pools.lock);
+
+		std::size_t total = 0;
+
+		for (auto pool : pools.pools)
+		{
+			total += pool->getReservedBytes();
+		}
+
+		return total;
+	}
+};
+
+/**
+ * Standard allocator serving single objects of type T from a FixedSizePool
+ * shared by all allocators of the same type (arrays go to the default heap).
+ *
+ * Used with std::allocate_shared the pool is keyed on the combined control
+ * block and object type, so each node type gets its own pool, and nodes of
+ * the same type end up next to each other in memory:
+ *
+ * auto node = std::allocate_shared<BrushNode>(util::PoolAllocator<BrushNode>());
+ *
+ * Rebinding keeps the Owner type, the memory held for BrushNodes can be
+ * queried through PoolGroup<BrushNode>.
+ */
+template<typename T, typename Owner = T>
+class PoolAllocator
+{
+public:
+	typedef T value_type;
+
+	template<typename U>
+	struct rebind
+	{
+		typedef PoolAllocator<U, Owner> other;
+	};
+
+	PoolAllocator() noexcept
+	{}
+
+	template<typename U>
+	PoolAllocator(const PoolAllocator<U, Owner>& other) noexcept
+	{}
+
+	T* allocate(std::size_t n)
+	{
+		if (n != 1)
+		{
+			return std::allocator<T>().allocate(n);
+		}
+
+		return static_cast<T*>(GetPool().allocate());
+	}
+
+	void deallocate(T* p, std::size_t n)
+	{
+		if (n != 1)
+		{
+			std::allocator<T>().deallocate(p, n);
+			return;
+		}
+
+		GetPool().deallocate(p);
+	}
+
+	// The pool backing all PoolAllocator<T, Owner> instances
+	static FixedSizePool& GetPool()
+	{
+		// Never destroyed, pooled objects might still be released during static destruction.
+		// Its chunks are freed as soon as the last object is gone, so only one chunk is left behind.
+		static auto* pool = PoolGroup<Owner>::CreatePool(sizeof(T), alignof(T));
+		return *pool;
+	}
+};
+
+template<typename T, typename U, typename Owner>
+bool operator==(const PoolAllocator<T, Owner>&, const PoolAllocator<U, Owner>&) noexcept
+{
+	return true;
+}
+
+template<typename T, typename U, typename Owner>
+bool operator!=(const PoolAllocator<T, Owner>&, const PoolAllocator<U, Owner>&) noexcept
+{
+	return false;
+}
+
+// Creates an object of type T managed by a shared_ptr, allocated from the pool of its type
+template<typename T, typename... Args>
+std::shared_ptr<T> makePooledShared(Args&&... args)
+{
+	return std::allocate_shared<T>(PoolAllocator<T>(), std::forward<Args>(args)...);
+}
+
+}
@@ -4,11 +4,13 @@
 #include "dataview/TreeModel.h"
 #include "dataview/TreeViewItemStyle.h"
 #include "dataview/ThreadedResourceTreePopulator.h"
+#include "dataview/ResourceTreeModelCache.h"
 #include "dataview/ResourceTreeViewToolbar.h"
 #include "dataview/VFSTreePopulator.h"
 
 #include "i18n.h"
 #include "ifavourites.h"
+#include "ifilesystem.h"
 #include "ui/imainframe.h"
 #include "gamelib.h"
 
@@ -40,6 +42,15 @@ namespace
     // Registry XPath to lookup key that specifies the display folder
     const char* const FOLDER_KEY_PATH = "/entityChooser/displayFolderKey";
 
+    const char* const TREE_CACHE_KEY = "EntityClasses";
+
+    // The cached tree model is referencing the columns, they need to stay around
+    const ResourceTreeView::Columns& getTreeColumns()
+    {
+        static ResourceTreeView::Columns _columns;
+        return _columns;
+    }
+
     std::string getDialogTitle(EntityClassChooser::Purpose purpose)
     {
         switch (purpose)
@@ -143,7 +154,13 @@ public:
     ThreadedEntityClassLoader(const ResourceTreeView::Columns& cols) :
         ThreadedResourceTreePopulator(cols),
         _columns(cols)
-    {}
+    {
+        // The tree doesn't depend on the chooser's purpose, share it until the defs are reloaded
+        EnableModelCache(TREE_CACHE_KEY, {
+            GlobalFileSystem().signal_Initialised(),
+            GlobalEntityClassManager().defsReloadedSignal()
+        });
+    }
 
     ~ThreadedEntityClassLoader()
     {
@@ -166,6 +183,7 @@ public:
 // Main constructor
 EntityClassChooser::EntityClassChooser(Purpose purpose) :
     DialogBase(getDialogTitle(purpose)),
+    _columns(getTreeColumns()),
     _treeView(nullptr),
     _selectedName("")
 {
@@ -203,7 +221,7 @@ EntityClassChooser::EntityClassChooser(Purpose purpose) :
     // Listen for defs-reloaded signal (cannot bind directly to
     // ThreadedEntityClassLoader method because it is not sigc::trackable)
     _defsReloaded = GlobalEntityClassManager().defsReloadedSignal().connect(
-        sigc::mem_fun(this, &EntityClassChooser::loadEntityClasses)
+        sigc::mem_fun(this, &EntityClassChooser::onEntityClassesReloaded)
     );
 
     // Setup the tree view and invoke threaded loader to get the entity classes
@@ -273,6 +291,13 @@ void EntityClassChooser::loadEntityClasses()
     _treeView->Populate(std::make_shared<ThreadedEntityClassLoader>(_columns));
 }
 
+void EntityClassChooser::onEntityClassesReloaded()
+{
+    // The cache might not have received the signal yet, don't let it hand out the old tree
+    ResourceTreeModelCache::Invalidate(TREE_CACHE_KEY);
+    loadEntityClasses();
+}
+
 void EntityClassChooser::setSelectedEntityClass(const std::string& eclass)
 {
     _treeView->SetSelectedFullname(eclass);
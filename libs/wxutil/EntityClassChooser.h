@@ -39,7 +39,7 @@ public:
     };
 
 private:
-    ResourceTreeView::Columns _columns;
+    const ResourceTreeView::Columns& _columns;
     ResourceTreeView* _treeView;
     ResourceTreeViewToolbar* _treeViewToolbar;
 
@@ -59,6 +59,7 @@ private:
     ~EntityClassChooser();
 
     void loadEntityClasses();
+    void onEntityClassesReloaded();
 
     // Widget construction helpers
     void setupTreeView();
@@ -50,6 +50,20 @@ void GLWidget::DestroyPrivateContext()
 	}
 }
 
+bool GLWidget::MakeSharedContextCurrent()
+{
+	// SetCurrent() can only be called for a shown window, see OnPaint()
+	const auto& context = GlobalOpenGLContext().getSharedContext();
+
+	if (!context || !IsShownOnScreen()) return false;
+
+	// Use the globally shared context, we rely on this being of type GLContext
+	assert(std::dynamic_pointer_cast<GLContext>(context));
+
+	auto wxContext = std::static_pointer_cast<GLContext>(context);
+	return SetCurrent(wxContext->get());
+}
+
 GLWidget::~GLWidget()
 {
 	DestroyPrivateContext();
@@ -87,12 +101,7 @@ void GLWidget::OnPaint(wxPaintEvent& WXUNUSED(event))
 	}
 	else
 	{
-		// Use the globally shared context, we rely on this being of type GLContext
-		const auto& context = GlobalOpenGLContext().getSharedContext();
-		assert(std::dynamic_pointer_cast<GLContext>(context));
-
-		auto wxContext = std::static_pointer_cast<GLContext>(context);
-		SetCurrent(wxContext->get());
+		MakeSharedContextCurrent();
 	}
 
 	if (_renderCallback())
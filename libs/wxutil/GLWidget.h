@@ -32,6 +32,10 @@ public:
 	// Call this to enable/disable the private GL context of this widget
 	void SetHasPrivateContext(bool hasPrivateContext);
 
+	// Makes the application-wide shared GL context current on this widget,
+	// which is only possible while it is shown. Returns true on success.
+	bool MakeSharedContextCurrent();
+
 	virtual ~GLWidget();
 
 private:
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 #include <wx/event.h>
+#include "TreeModel.h"
 
 namespace wxutil
 {
@@ -26,6 +28,10 @@ public:
     // Define the event handler that is notified once population is done
     virtual void SetFinishedHandler(wxEvtHandler* finishedHandler) = 0;
 
+    // Define the columns the view is going to search, such that
+    // the search index can be prepared along with the model
+    virtual void SetSearchColumns(const std::vector<TreeModel::Column>& columns) = 0;
+
     // Will start the population and block until population is done.
     virtual void EnsurePopulated() = 0;
 
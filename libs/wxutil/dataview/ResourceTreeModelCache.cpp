@@ -0,0 +1,122 @@
+#include "ResourceTreeModelCache.h"
+
+#include <map>
+#include <mutex>
+#include "imodule.h"
+
+namespace wxutil
+{
+
+namespace
+{
+    struct CacheEntry
+    {
+        TreeModel::Ptr model;
+        std::size_t generation = 0;
+
+        // The connections to the signals invalidating this entry
+        std::vector<sigc::connection> connections;
+    };
+
+    struct Cache
+    {
+        std::mutex lock;
+        std::map<std::string, CacheEntry> entries;
+
+        sigc::connection modulesUninitialising;
+    };
+
+    Cache& getCache()
+    {
+        static Cache _cache;
+        return _cache;
+    }
+}
+
+TreeModel::Ptr ResourceTreeModelCache::Get(const std::string& key)
+{
+    auto& cache = getCache();
+    std::lock_guard<std::mutex> lock(cache.lock);
+
+    auto found = cache.entries.find(key);
+
+    return found != cache.entries.end() ? found->second.model : TreeModel::Ptr();
+}
+
+std::size_t ResourceTreeModelCache::GetGeneration(const std::string& key)
+{
+    auto& cache = getCache();
+    std::lock_guard<std::mutex> lock(cache.lock);
+
+    auto found = cache.entries.find(key);
+
+    return found != cache.entries.end() ? found->second.generation : 0;
+}
+
+void ResourceTreeModelCache::Store(const std::string& key, const TreeModel::Ptr& model, std::size_t generation)
+{
+    auto& cache = getCache();
+    std::lock_guard<std::mutex> lock(cache.lock);
+
+    auto& entry = cache.entries[key];
+
+    // Don't store anything that has been outdated while it was populated
+    if (entry.generation == generation)
+    {
+        entry.model = model;
+    }
+}
+
+void ResourceTreeModelCache::InvalidateOnSignals(const std::string& key, const std::vector<sigc::signal<void>>& signals)
+{
+    auto& cache = getCache();
+    std::lock_guard<std::mutex> lock(cache.lock);
+
+    if (!cache.modulesUninitialising.connected())
+    {
+        // The models are holding on to wx objects, release them while the application is still intact
+        cache.modulesUninitialising = module::GlobalModuleRegistry().signal_modulesUninitialising().connect(&Clear);
+    }
+
+    auto& entry = cache.entries[key];
+
+    if (!entry.connections.empty()) return;
+
+    for (auto signal : signals)
+    {
+        entry.connections.emplace_back(signal.connect([key]() { Invalidate(key); }));
+    }
+}
+
+void ResourceTreeModelCache::Invalidate(const std::string& key)
+{
+    auto& cache = getCache();
+    std::lock_guard<std::mutex> lock(cache.lock);
+
+    auto& entry = cache.entries[key];
+
+    entry.model.reset();
+    ++entry.generation;
+}
+
+void ResourceTreeModelCache::Clear()
+{
+    auto& cache = getCache();
+    std::lock_guard<std::mutex> lock(cache.lock);
+
+    for (auto& [key, entry] : cache.entries)
+    {
+        for (auto& connection : entry.connections)
+        {
+            connection.disconnect();
+        }
+
+        entry.connections.clear();
+        entry.model.reset();
+        ++entry.generation;
+    }
+
+    cache.modulesUninitialising.disconnect();
+}
+
+}
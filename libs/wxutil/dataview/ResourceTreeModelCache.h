@@ -0,0 +1,51 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <sigc++/signal.h>
+#include "TreeModel.h"
+
+namespace wxutil
+{
+
+/**
+ * Process-wide storage of populated resource tree models, such that
+ * re-opening a chooser dialog doesn't need to walk the VFS again.
+ * Cached models are shared by all ResourceTreeViews populated with the same
+ * key: they must not be cleared or restructured by the views, only row
+ * values (like the favourite status) may be changed.
+ *
+ * A cached model stays valid until one of the signals passed to
+ * InvalidateOnSignals() is emitted (or Invalidate() is called).
+ * Everything is released when the modules are uninitialising.
+ *
+ * All methods are thread-safe, but InvalidateOnSignals() must be
+ * called from the main thread.
+ */
+class ResourceTreeModelCache
+{
+public:
+    // Returns the model stored under the given key, or an empty pointer
+    static TreeModel::Ptr Get(const std::string& key);
+
+    // Returns the number of times the given key has been invalidated.
+    // Populators remember this before they start to work, to
+    // avoid storing a model that has been outdated in the meantime.
+    static std::size_t GetGeneration(const std::string& key);
+
+    // Stores the model under the given key, unless the key
+    // has been invalidated after the given generation
+    static void Store(const std::string& key, const TreeModel::Ptr& model, std::size_t generation);
+
+    // Connects the given signals to invalidate the key. Does nothing if
+    // the key has already been connected to its invalidation signals.
+    static void InvalidateOnSignals(const std::string& key, const std::vector<sigc::signal<void>>& signals);
+
+    // Removes the model stored under the given key
+    static void Invalidate(const std::string& key);
+
+    // Removes all models and disconnects all signals
+    static void Clear();
+};
+
+}
@@ -43,6 +43,7 @@ ResourceTreeView::ResourceTreeView(wxWindow* parent, const TreeModel::Ptr& model
     TreeView(parent, nullptr, style), // associate the model later
     _columns(columns),
     _mode(TreeMode::ShowAll),
+    _treeStoreIsShared(false),
     _expandTopLevelItemsAfterPopulation(false),
     _columnToSelectAfterPopulation(nullptr),
     _declType(decl::Type::None),
@@ -86,7 +87,7 @@ const TreeModel::Ptr& ResourceTreeView::GetTreeModel()
 void ResourceTreeView::SetTreeModel(const TreeModel::Ptr& model)
 {
     _treeStore = model;
-    _emptyFavouritesLabel = wxDataViewItem();
+    _treeStoreIsShared = false;
 
     if (!_treeStore)
     {
@@ -100,46 +101,55 @@ void ResourceTreeView::SetTreeModel(const TreeModel::Ptr& model)
 
 void ResourceTreeView::SetupTreeModelFilter()
 {
+    // The model might have been replaced
+    UpdateFilterMatches();
+
     // Set up the filter
     _treeModelFilter.reset(new TreeModelFilter(_treeStore));
 
     _treeModelFilter->SetVisibleFunc(
         std::bind(&ResourceTreeView::IsTreeModelRowOrAnyChildVisible, this, std::placeholders::_1));
 
-    AssociateModel(_treeModelFilter.get());
+    wxDataViewItemArray visibleChildren;
 
-    // Remove the dummy label in any case
-    if (_emptyFavouritesLabel.IsOk())
+    if (_mode == TreeMode::ShowFavourites &&
+        _treeModelFilter->GetChildren(_treeModelFilter->GetRoot(), visibleChildren) == 0)
     {
-        _treeStore->RemoveItem(_emptyFavouritesLabel);
-        _emptyFavouritesLabel = wxDataViewItem();
+        // All items filtered out, show the dummy label (it's not added
+        // to the tree store, since that might be shared with other views)
+        AssociateModel(GetEmptyFavouritesModel().get());
     }
-
-    if (_mode == TreeMode::ShowFavourites)
+    else
     {
-        wxDataViewItemArray visibleChildren;
-        if (_treeModelFilter->GetChildren(_treeModelFilter->GetRoot(), visibleChildren) == 0)
-        {
-            // All items filtered out, show the dummy label
-            if (!_emptyFavouritesLabel.IsOk())
-            {
-                wxutil::TreeModel::Row row = _treeStore->AddItem();
-                _emptyFavouritesLabel = row.getItem();
-
-                wxIcon icon;
-                icon.CopyFromBitmap(wxutil::GetLocalBitmap(ICON_LOADING));
-                row[_columns.iconAndName] = wxVariant(wxDataViewIconText(_("No favourites added so far"), icon));
-                row[_columns.isFavourite] = true;
-                row[_columns.isFolder] = false;
-
-                row.SendItemAdded();
-            }
-        }
+        AssociateModel(_treeModelFilter.get());
     }
 
     ExpandTopLevelItems();
 }
 
+const TreeModel::Ptr& ResourceTreeView::GetEmptyFavouritesModel()
+{
+    if (!_emptyFavouritesModel)
+    {
+        _emptyFavouritesModel = new TreeModel(_columns, true);
+
+        wxutil::TreeModel::Row row = _emptyFavouritesModel->AddItem();
+
+        wxIcon icon;
+        icon.CopyFromBitmap(wxutil::GetLocalBitmap(ICON_LOADING));
+        row[_columns.iconAndName] = wxVariant(wxDataViewIconText(_("No favourites added so far"), icon));
+        row[_columns.isFavourite] = true;
+        row[_columns.isFolder] = false;
+    }
+
+    return _emptyFavouritesModel;
+}
+
+bool ResourceTreeView::IsEmptyFavouritesLabelShown()
+{
+    return _emptyFavouritesModel && GetModel() == _emptyFavouritesModel.get();
+}
+
 ResourceTreeView::TreeMode ResourceTreeView::GetTreeMode() const
 {
     return _mode;
@@ -211,6 +221,8 @@ bool ResourceTreeView::SetFilterText(const wxString& filterText)
     // We use the lower-case copy of the given filter text
     _filterText = filterText.Lower();
 
+    UpdateFilterMatches();
+
     wxDataViewItem item = GetSelection();
 
     // Update the top level tree items which rebuilds the view
@@ -219,9 +231,7 @@ bool ResourceTreeView::SetFilterText(const wxString& filterText)
     // Keep the previous selection if not filtered out and is meaningful
     if (item.IsOk() && _treeModelFilter->ItemIsVisible(item))
     {
-        TreeModel::Row row(item, *GetModel());
-
-        if (!_filterText.empty() && !TreeModel::RowContainsString(row, _filterText, _colsToSearch, true))
+        if (!_filterText.empty() && _filterMatches.count(item.GetID()) == 0)
         {
             // The selected row is not relevant anymore
             return JumpToFirstFilterMatch();
@@ -238,7 +248,12 @@ bool ResourceTreeView::SetFilterText(const wxString& filterText)
 
 void ResourceTreeView::UpdateTreeVisibility()
 {
-    if (_treeModelFilter)
+    if (IsEmptyFavouritesLabelShown())
+    {
+        // The empty favourites label is shown, check whether it's still needed
+        SetupTreeModelFilter();
+    }
+    else if (_treeModelFilter)
     {
 #if defined(__WXGTK__) && !wxCHECK_VERSION(3, 0, 5)
         // In wxGTK 3.0.4 Cleared() will just wipe out the treeview
@@ -296,6 +311,7 @@ void ResourceTreeView::JumpToPrevFilterMatch()
 void ResourceTreeView::ClearFilterText()
 {
     _filterText.clear();
+    UpdateFilterMatches();
 
     UpdateTreeVisibility();
 
@@ -352,7 +368,8 @@ void ResourceTreeView::SetSelectedElement(const std::string& value, const TreeMo
     // Find the requested element
     auto item = GetTreeModel()->FindString(value, column);
 
-    if (item.IsOk())
+    // The item can't be selected while the empty favourites label is shown
+    if (item.IsOk() && !IsEmptyFavouritesLabelShown())
     {
         Select(item);
         EnsureVisible(item);
@@ -374,8 +391,16 @@ void ResourceTreeView::Clear()
 
     // Clear any data and/or active population objects
     _populator.reset();
-    _treeStore->Clear();
-    _emptyFavouritesLabel = wxDataViewItem();
+
+    if (_treeStoreIsShared)
+    {
+        // Leave the shared model alone, start over with a new one
+        SetTreeModel(TreeModel::Ptr(new TreeModel(_columns)));
+    }
+    else
+    {
+        _treeStore->Clear();
+    }
 }
 
 void ResourceTreeView::EnableFavouriteManagement(decl::Type declType)
@@ -408,9 +433,18 @@ void ResourceTreeView::Populate(const IResourceTreePopulator::Ptr& populator)
 
     row.SendItemAdded();
 
+    // Don't hide the loading row behind the empty favourites label
+    if (IsEmptyFavouritesLabelShown())
+    {
+        SetupTreeModelFilter();
+    }
+
     // It will fire the TreeModel::PopulationFinishedEvent when done, point it to ourselves
     populator->SetFinishedHandler(this);
 
+    // Let the populator prepare the search index for our filter
+    populator->SetSearchColumns(_colsToSearch);
+
     // Start population (this might be a thread or not)
     _populator = populator;
     _populator->Populate();
@@ -439,6 +473,7 @@ void ResourceTreeView::_onTreeStorePopulationFinished(TreeModel::PopulationFinis
 {
     UnselectAll();
     SetTreeModel(ev.GetTreeModel());
+    _treeStoreIsShared = true;
     _populator.reset();
     _progressItem = wxDataViewItem();
 
@@ -602,6 +637,12 @@ bool ResourceTreeView::IsFavouriteSelected()
 
 bool ResourceTreeView::IsTreeModelRowOrAnyChildVisible(TreeModel::Row& row)
 {
+    // With an active filter, subtrees without any matches can be skipped right away
+    if (!_filterText.empty() && _itemsContainingFilterMatches.count(row.getItem().GetID()) == 0)
+    {
+        return false;
+    }
+
     // Test the node itself
     if (IsTreeModelRowVisible(row))
     {
@@ -643,7 +684,26 @@ bool ResourceTreeView::IsTreeModelRowVisible(wxutil::TreeModel::Row& row)
 
 bool ResourceTreeView::IsTreeModelRowFiltered(wxutil::TreeModel::Row& row)
 {
-    return !_filterText.empty() && !TreeModel::RowContainsString(row, _filterText, _colsToSearch, true);
+    return !_filterText.empty() && _filterMatches.count(row.getItem().GetID()) == 0;
+}
+
+void ResourceTreeView::UpdateFilterMatches()
+{
+    _filterMatches.clear();
+    _itemsContainingFilterMatches.clear();
+
+    if (_filterText.empty() || !_treeStore) return;
+
+    // The tree store maintains a search index, no need to check every row
+    for (const auto& item : _treeStore->FindItemsContainingString(_filterText, _colsToSearch))
+    {
+        _filterMatches.insert(item.GetID());
+
+        // Mark the parents up to the first one that has been visited before
+        for (auto parent = item; parent.IsOk() && _itemsContainingFilterMatches.insert(parent.GetID()).second;
+             parent = _treeStore->GetParent(parent))
+        {}
+    }
 }
 
 bool ResourceTreeView::IsTreeModelRowVisibleByViewMode(wxutil::TreeModel::Row& row)
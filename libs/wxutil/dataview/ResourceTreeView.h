@@ -1,5 +1,6 @@
 #pragma once
 
+#include <unordered_set>
 #include "idecltypes.h"
 #include "TreeView.h"
 #include "TreeModel.h"
@@ -74,7 +75,15 @@ private:
 
     TreeModel::Ptr _treeStore;
     TreeModelFilter::Ptr _treeModelFilter;
-    wxDataViewItem _emptyFavouritesLabel;
+
+    // Models handed over by a populator might be shared with other views
+    // through the ResourceTreeModelCache, they are replaced instead of cleared
+    bool _treeStoreIsShared;
+
+    // Holds the label shown in favourites mode when there are no favourites,
+    // it is associated instead of the filter to leave the tree store alone
+    TreeModel::Ptr _emptyFavouritesModel;
+
     wxDataViewItem _progressItem;
     wxIcon _progressIcon;
 
@@ -91,6 +100,11 @@ private:
 
     wxString _filterText;
 
+    // The items matching the filter text, and the ones containing a match
+    // somewhere in their subtree (including the matches themselves)
+    std::unordered_set<void*> _filterMatches;
+    std::unordered_set<void*> _itemsContainingFilterMatches;
+
     // The column that is hosting the declaration path (used by e.g. "copy to clipboard")
     TreeModel::Column _declPathColumn;
 
@@ -183,6 +197,13 @@ private:
     // Returns true if the given row is filtered by an active filter text
     bool IsTreeModelRowFiltered(wxutil::TreeModel::Row& row);
 
+    // Looks up the items matching the current filter text in the tree store
+    void UpdateFilterMatches();
+
+    // Returns the model containing the "No favourites" label, creating it if necessary
+    const TreeModel::Ptr& GetEmptyFavouritesModel();
+    bool IsEmptyFavouritesLabelShown();
+
     void _onContextMenu(wxDataViewEvent& ev);
     void _onTreeStorePopulationProgress(TreeModel::PopulationProgressEvent& ev);
     void _onTreeStorePopulationFinished(TreeModel::PopulationFinishedEvent& ev);
@@ -1,5 +1,7 @@
 #include "ThreadedResourceTreePopulator.h"
 
+#include "ResourceTreeModelCache.h"
+
 namespace wxutil
 {
 
@@ -16,7 +18,8 @@ ThreadedResourceTreePopulator::ThreadedResourceTreePopulator(const TreeModel::Co
     wxThread(wxTHREAD_JOINABLE),
     _finishedHandler(nullptr),
     _columns(columns),
-    _started(false)
+    _started(false),
+    _cacheGeneration(0)
 {}
 
 ThreadedResourceTreePopulator::~ThreadedResourceTreePopulator()
@@ -53,6 +56,19 @@ wxThread::ExitCode ThreadedResourceTreePopulator::Entry()
 
         ThrowIfCancellationRequested();
 
+        // Same goes for the search index, such that filtering is fast right from the start
+        if (!_searchColumns.empty())
+        {
+            _treeStore->BuildSearchIndex(_searchColumns);
+
+            ThrowIfCancellationRequested();
+        }
+
+        if (!_cacheKey.empty())
+        {
+            ResourceTreeModelCache::Store(_cacheKey, _treeStore, _cacheGeneration);
+        }
+
         wxQueueEvent(_finishedHandler, new TreeModel::PopulationFinishedEvent(_treeStore));
     }
     catch (const ThreadAbortedException&)
@@ -68,11 +84,23 @@ void ThreadedResourceTreePopulator::PostEvent(wxEvent* ev)
     wxQueueEvent(_finishedHandler, ev);
 }
 
+void ThreadedResourceTreePopulator::EnableModelCache(const std::string& key,
+    const std::vector<sigc::signal<void>>& invalidationSignals)
+{
+    _cacheKey = key;
+    _cacheInvalidationSignals = invalidationSignals;
+}
+
 void ThreadedResourceTreePopulator::SetFinishedHandler(wxEvtHandler* finishedHandler)
 {
     _finishedHandler = finishedHandler;
 }
 
+void ThreadedResourceTreePopulator::SetSearchColumns(const std::vector<TreeModel::Column>& columns)
+{
+    _searchColumns = columns;
+}
+
 void ThreadedResourceTreePopulator::EnsurePopulated()
 {
     // Start the thread now if we have to
@@ -102,6 +130,22 @@ void ThreadedResourceTreePopulator::Populate()
 
     // Set the latch
     _started = true;
+
+    if (!_cacheKey.empty())
+    {
+        ResourceTreeModelCache::InvalidateOnSignals(_cacheKey, _cacheInvalidationSignals);
+
+        // No need to start the thread if the model has been populated before
+        if (auto cachedModel = ResourceTreeModelCache::Get(_cacheKey); cachedModel)
+        {
+            PostEvent(new TreeModel::PopulationFinishedEvent(cachedModel));
+            return;
+        }
+
+        // A model that has been invalidated in the meantime won't be stored
+        _cacheGeneration = ResourceTreeModelCache::GetGeneration(_cacheKey);
+    }
+
     wxThread::Run();
 }
 
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <stdexcept>
+#include <string>
+#include <vector>
+#include <sigc++/signal.h>
 #include <wx/thread.h>
 #include <wx/event.h>
 #include "TreeModel.h"
@@ -17,6 +20,10 @@ namespace wxutil
  * At the end of the thread execution this populator will send
  *  a wxutil::TreeModel::PopulationFinishedEvent to the handler.
  * 
+ * Subclasses can opt into the ResourceTreeModelCache by calling
+ * EnableModelCache(), the finished event will then carry the cached
+ * model (if available) without starting the thread at all.
+ * 
  * Note: if a subclass is introducing additional class members
  * that are used in the PopulateModel/SortModel methods, it's mandatory
  * for the subclass destructor to call EnsureStopped().
@@ -39,6 +46,14 @@ private:
     // Whether this thread has been started at all
     bool _started;
 
+    // The columns to build the search index for
+    std::vector<TreeModel::Column> _searchColumns;
+
+    // The key of the model in the ResourceTreeModelCache (empty if not cached)
+    std::string _cacheKey;
+    std::vector<sigc::signal<void>> _cacheInvalidationSignals;
+    std::size_t _cacheGeneration;
+
 protected:
     // Wrapper around TestDestroy that escalated by throwing a 
     // ThreadAbortedException when cancellation has been requested
@@ -59,6 +74,11 @@ protected:
     // Queues an event to the attached finished handler
     void PostEvent(wxEvent* ev);
 
+    // Share the populated model with all views using the same key, the cached
+    // model is discarded as soon as any of the given signals is emitted.
+    // The column record must outlive the cache (i.e. it should be a static).
+    void EnableModelCache(const std::string& key, const std::vector<sigc::signal<void>>& invalidationSignals);
+
 public:
     // Construct and initialise variables
     ThreadedResourceTreePopulator(const TreeModel::ColumnRecord& columns);
@@ -69,6 +89,8 @@ public:
 
     virtual void SetFinishedHandler(wxEvtHandler* finishedHandler) override;
 
+    virtual void SetSearchColumns(const std::vector<TreeModel::Column>& columns) override;
+
     // Blocks until the worker thread is done.
     virtual void EnsurePopulated() override;
 
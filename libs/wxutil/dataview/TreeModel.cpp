@@ -1,4 +1,5 @@
 #include "TreeModel.h"
+#include "TreeModelSearchIndex.h"
 
 #include <algorithm>
 #include <functional>
@@ -355,7 +356,24 @@ void TreeModel::SortModel(const TreeModel::SortFunction& sortFunction)
 
 void TreeModel::SortModelByColumn(const TreeModel::Column& column)
 {
-	SortModelRecursive(_rootNode, [&] (const wxDataViewItem& a, const wxDataViewItem& b)->bool
+	SortModelRecursive(_rootNode, GetColumnSortFunction(column));
+}
+
+void TreeModel::SortChildrenByColumn(const wxDataViewItem& parent, const TreeModel::Column& column)
+{
+	Node* parentNode = !parent.IsOk() ? _rootNode.get() : static_cast<Node*>(parent.GetID());
+	auto sortFunction = GetColumnSortFunction(column);
+
+	// Stable sort, already sorted siblings shouldn't be shuffled around
+	std::stable_sort(parentNode->children.begin(), parentNode->children.end(), [&] (const NodePtr& a, const NodePtr& b)->bool
+	{
+		return sortFunction(a->item, b->item);
+	});
+}
+
+TreeModel::SortFunction TreeModel::GetColumnSortFunction(const TreeModel::Column& column)
+{
+	return [this, column] (const wxDataViewItem& a, const wxDataViewItem& b)->bool
 	{
 		Row rowA(a, *this);
 		Row rowB(b, *this);
@@ -390,7 +408,7 @@ void TreeModel::SortModelByColumn(const TreeModel::Column& column)
 		}
 		
 		return false;
-	});
+	};
 }
 
 void TreeModel::SortModelFoldersFirst(const TreeModel::Column& stringColumn, 
@@ -555,6 +573,22 @@ bool TreeModel::RowContainsString(const Row& row, const wxString& value, const s
     return false;
 }
 
+void TreeModel::BuildSearchIndex(const std::vector<Column>& columns)
+{
+	_searchIndex = std::make_shared<TreeModelSearchIndex>(*this, columns);
+}
+
+std::vector<wxDataViewItem> TreeModel::FindItemsContainingString(const wxString& needle,
+	const std::vector<Column>& columns)
+{
+	if (!_searchIndex || !_searchIndex->IndexesColumns(columns))
+	{
+		BuildSearchIndex(columns);
+	}
+
+	return _searchIndex->FindItemsContainingString(needle);
+}
+
 bool TreeModel::HasDefaultCompare() const
 {
 	return _hasDefaultCompare;
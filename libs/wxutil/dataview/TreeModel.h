@@ -9,6 +9,8 @@
 namespace wxutil
 {
 
+class TreeModelSearchIndex;
+
 /**
  * Implements a wxwidgets DataViewModel, similar to wxDataViewTreeStore
  * but with more versatility of the stored columns.
@@ -390,6 +392,9 @@ private:
 	bool _hasDefaultCompare;
 	bool _isListModel;
 
+	// Built on demand by FindItemsContainingString()
+	std::shared_ptr<TreeModelSearchIndex> _searchIndex;
+
 protected:
 	// Constructor to be used by subclasses, allows an existing model to be referenced.
 	// The root node of the existing model will be shared by this instance.
@@ -441,6 +446,10 @@ public:
 	// Sorts the entire tree by the given column (can also be a IconText column)
 	virtual void SortModelByColumn(const TreeModel::Column& column);
 
+	// Sorts the immediate children of the given item by the given column, the rest of the
+	// tree is left alone. Items comparing equal keep their relative order.
+	virtual void SortChildrenByColumn(const wxDataViewItem& parent, const TreeModel::Column& column);
+
 	// Sort the model by a string-valued column, sorting folders on top.
 	// Pass a boolean-valued "is-a-folder" column to indicate which items are actual folders.
 	virtual void SortModelFoldersFirst(const Column& stringColumn, const Column& isFolderColumn);
@@ -475,6 +484,16 @@ public:
 	virtual void SetAttr(const wxDataViewItem& item, unsigned int col, const wxDataViewItemAttr& attr) const;
 	virtual void SetIsListModel(bool isListModel);
 
+	// Builds the search index used by FindItemsContainingString() for the given columns.
+	// This is expensive for large models, populator threads can call this before handing
+	// the model over to the UI. The index follows the changes signalled by this model.
+	virtual void BuildSearchIndex(const std::vector<Column>& columns);
+
+	// Returns all items containing the given (lower-case) string in any of the given columns,
+	// in no particular order. The search index is (re-)built if it's not covering these columns.
+	virtual std::vector<wxDataViewItem> FindItemsContainingString(const wxString& needle, 
+		const std::vector<Column>& columns);
+
 	// Search for an item in the given columns (forward), using previousMatch as reference point
 	// search is performed case-insensitively, partial matches are considered ("contains")
 	virtual wxDataViewItem FindNextString(const wxString& needle, 
@@ -539,6 +558,7 @@ protected:
 	wxDataViewItem FindRecursive(const TreeModel::Node& node, const std::function<bool (const TreeModel::Node&)>& predicate);
 	wxDataViewItem FindRecursiveUsingRows(const TreeModel::Node& node, const std::function<bool (TreeModel::Row&)>& predicate);
 	int RemoveItemsRecursively(const wxDataViewItem& parent, const std::function<bool (const Row&)>& predicate);
+	SortFunction GetColumnSortFunction(const TreeModel::Column& column);
 };
 
 // wx event macros
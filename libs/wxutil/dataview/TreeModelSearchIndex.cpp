@@ -0,0 +1,235 @@
+#include "TreeModelSearchIndex.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace wxutil
+{
+
+namespace
+{
+    inline std::uint32_t getTrigram(const std::string& text, std::size_t offset)
+    {
+        return static_cast<std::uint32_t>(static_cast<unsigned char>(text[offset])) << 16 |
+               static_cast<std::uint32_t>(static_cast<unsigned char>(text[offset + 1])) << 8 |
+               static_cast<std::uint32_t>(static_cast<unsigned char>(text[offset + 2]));
+    }
+
+    inline std::string toLowerUtf8(const wxString& value)
+    {
+        return value.Lower().ToUTF8().data();
+    }
+}
+
+// Keeps the index in sync with the changes the model is signalling to its views
+class TreeModelSearchIndex::ModelNotifier :
+    public wxDataViewModelNotifier
+{
+private:
+    TreeModelSearchIndex& _index;
+
+public:
+    ModelNotifier(TreeModelSearchIndex& index) :
+        _index(index)
+    {}
+
+    bool ItemAdded(const wxDataViewItem& parent, const wxDataViewItem& item) override
+    {
+        _index.AddRow(item);
+        return true;
+    }
+
+    bool ItemDeleted(const wxDataViewItem& parent, const wxDataViewItem& item) override
+    {
+        // Any children are gone as well, which we can't tell from here
+        _index._needsRebuild = true;
+        return true;
+    }
+
+    bool ItemChanged(const wxDataViewItem& item) override
+    {
+        // Replaces the existing entry
+        _index.AddRow(item);
+        return true;
+    }
+
+    bool ValueChanged(const wxDataViewItem& item, unsigned int col) override
+    {
+        return ItemChanged(item);
+    }
+
+    bool Cleared() override
+    {
+        _index._needsRebuild = true;
+        return true;
+    }
+
+    void Resort() override
+    {}
+};
+
+TreeModelSearchIndex::TreeModelSearchIndex(TreeModel& model, const std::vector<TreeModel::Column>& columns) :
+    _model(model),
+    _columns(columns),
+    _numObsoleteEntries(0),
+    _needsRebuild(false),
+    _notifier(new ModelNotifier(*this))
+{
+    _model.AddNotifier(_notifier);
+
+    Rebuild();
+}
+
+TreeModelSearchIndex::~TreeModelSearchIndex()
+{
+    // This deletes the notifier
+    _model.RemoveNotifier(_notifier);
+}
+
+bool TreeModelSearchIndex::IndexesColumns(const std::vector<TreeModel::Column>& columns) const
+{
+    return std::equal(_columns.begin(), _columns.end(), columns.begin(), columns.end(),
+        [](const TreeModel::Column& a, const TreeModel::Column& b)
+    {
+        return a.getColumnIndex() == b.getColumnIndex();
+    });
+}
+
+std::vector<wxDataViewItem> TreeModelSearchIndex::FindItemsContainingString(const wxString& needle)
+{
+    // Rebuild if the model changed in ways we couldn't follow, or if too many entries piled up
+    if (_needsRebuild || _numObsoleteEntries > _entries.size() / 2)
+    {
+        Rebuild();
+    }
+
+    std::vector<wxDataViewItem> result;
+    std::string needleUtf8 = needle.ToUTF8().data();
+
+    if (needleUtf8.size() < 3)
+    {
+        for (const auto& entry : _entries)
+        {
+            if (entry.item.IsOk() && entry.text.find(needleUtf8) != std::string::npos)
+            {
+                result.push_back(entry.item);
+            }
+        }
+
+        return result;
+    }
+
+    // Collect the entry lists of all trigrams in the needle
+    std::vector<const std::vector<std::size_t>*> entryLists;
+
+    for (std::size_t i = 0; i + 2 < needleUtf8.size(); ++i)
+    {
+        auto found = _trigrams.find(getTrigram(needleUtf8, i));
+
+        if (found == _trigrams.end())
+        {
+            return result; // no row contains this trigram
+        }
+
+        entryLists.push_back(&found->second);
+    }
+
+    // Intersect the lists, starting with the shortest one
+    std::sort(entryLists.begin(), entryLists.end(), [](const std::vector<std::size_t>* a, const std::vector<std::size_t>* b)
+    {
+        return a->size() < b->size();
+    });
+
+    auto candidates = *entryLists.front();
+
+    for (auto list = entryLists.begin() + 1; list != entryLists.end() && !candidates.empty(); ++list)
+    {
+        std::vector<std::size_t> intersection;
+        std::set_intersection(candidates.begin(), candidates.end(), (*list)->begin(), (*list)->end(),
+            std::back_inserter(intersection));
+        candidates.swap(intersection);
+    }
+
+    // The candidates contain all trigrams, check whether they're in the right order
+    for (auto index : candidates)
+    {
+        const auto& entry = _entries[index];
+
+        if (entry.item.IsOk() && entry.text.find(needleUtf8) != std::string::npos)
+        {
+            result.push_back(entry.item);
+        }
+    }
+
+    return result;
+}
+
+void TreeModelSearchIndex::Rebuild()
+{
+    _entries.clear();
+    _entryIndexByItem.clear();
+    _trigrams.clear();
+    _numObsoleteEntries = 0;
+    _needsRebuild = false;
+
+    _model.ForeachNode([&](TreeModel::Row& row)
+    {
+        AddRow(row.getItem());
+    });
+}
+
+void TreeModelSearchIndex::AddRow(const wxDataViewItem& item)
+{
+    if (!item.IsOk()) return;
+
+    if (_entryIndexByItem.count(item.GetID()) > 0)
+    {
+        RemoveRow(item);
+    }
+
+    TreeModel::Row row(item, _model);
+    Entry entry{ item, std::string() };
+
+    for (std::size_t i = 0; i < _columns.size(); ++i)
+    {
+        if (i > 0)
+        {
+            entry.text += '\n';
+        }
+
+        entry.text += toLowerUtf8(row[_columns[i]].getString());
+    }
+
+    auto index = _entries.size();
+
+    for (std::size_t i = 0; i + 2 < entry.text.size(); ++i)
+    {
+        auto& entryList = _trigrams[getTrigram(entry.text, i)];
+
+        // The same trigram can occur more than once in a single entry
+        if (entryList.empty() || entryList.back() != index)
+        {
+            entryList.push_back(index);
+        }
+    }
+
+    _entryIndexByItem[item.GetID()] = index;
+    _entries.emplace_back(std::move(entry));
+}
+
+void TreeModelSearchIndex::RemoveRow(const wxDataViewItem& item)
+{
+    auto found = _entryIndexByItem.find(item.GetID());
+
+    if (found == _entryIndexByItem.end()) return;
+
+    // Leave the trigram lists alone, the entry is just marked as obsolete
+    auto& entry = _entries[found->second];
+    entry.item = wxDataViewItem();
+    entry.text.clear();
+    ++_numObsoleteEntries;
+
+    _entryIndexByItem.erase(found);
+}
+
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "TreeModel.h"
+
+namespace wxutil
+{
+
+/**
+ * Substring search index over one or more text columns of a TreeModel,
+ * used to filter large resource trees without extracting and lower-casing
+ * the values of every row on each keystroke.
+ *
+ * The lower-case text of every row is stored along with a trigram index,
+ * a query only needs to look at the rows containing all the trigrams of
+ * the search string. Strings shorter than three characters are checked
+ * against the stored texts, which is still a lot cheaper than asking the model.
+ *
+ * The index follows the changes that are signalled by the model: added
+ * and changed rows are indexed right away, while removals invalidate
+ * the index, causing it to be rebuilt on the next query.
+ */
+class TreeModelSearchIndex
+{
+private:
+    class ModelNotifier;
+
+    struct Entry
+    {
+        wxDataViewItem item;
+
+        // Lower-case UTF-8 values of all columns, separated by newlines
+        std::string text;
+    };
+
+    TreeModel& _model;
+    std::vector<TreeModel::Column> _columns;
+
+    // Entries are never removed, a changed row gets a new entry, the old one is cleared
+    std::vector<Entry> _entries;
+    std::size_t _numObsoleteEntries;
+
+    std::unordered_map<void*, std::size_t> _entryIndexByItem;
+
+    // Maps each trigram to the (ascending) indices of the entries containing it
+    std::unordered_map<std::uint32_t, std::vector<std::size_t>> _trigrams;
+
+    bool _needsRebuild;
+
+    // Owned by the model
+    ModelNotifier* _notifier;
+
+public:
+    using Ptr = std::shared_ptr<TreeModelSearchIndex>;
+
+    // Indexes the given String or IconText columns of the model.
+    // The model must not be modified by any other thread during construction.
+    TreeModelSearchIndex(TreeModel& model, const std::vector<TreeModel::Column>& columns);
+
+    ~TreeModelSearchIndex();
+
+    // Returns true if this index has been built for the given columns
+    bool IndexesColumns(const std::vector<TreeModel::Column>& columns) const;
+
+    // Returns the items containing the given lower-case string in any
+    // of the indexed columns, in no particular order
+    std::vector<wxDataViewItem> FindItemsContainingString(const wxString& needle);
+
+private:
+    void Rebuild();
+    void AddRow(const wxDataViewItem& item);
+    void RemoveRow(const wxDataViewItem& item);
+};
+
+}
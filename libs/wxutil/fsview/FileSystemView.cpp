@@ -178,6 +178,64 @@ std::string FileSystemView::GetArchivePathOfSelection()
     return row[Columns().archivePath];
 }
 
+void FileSystemView::EnableThumbnails(int size, const ThumbnailRequestFunction& requestThumbnail)
+{
+    bool columnExists = static_cast<bool>(_requestThumbnail);
+
+    _requestThumbnail = requestThumbnail;
+
+    if (columnExists) return;
+
+    // The thumbnails are aligned in the first column, the tree structure stays in the file column
+    auto* fileColumn = GetColumn(0);
+
+    PrependBitmapColumn("", Columns().thumbnail.getColumnIndex(), wxDATAVIEW_CELL_INERT, size + 6);
+
+    SetExpanderColumn(fileColumn);
+    SetRowHeight(size + 2);
+
+    Bind(wxEVT_DATAVIEW_ITEM_EXPANDED, &FileSystemView::OnItemExpanded, this);
+}
+
+void FileSystemView::SetThumbnail(const std::string& path, const wxBitmap& thumbnail)
+{
+    auto item = _treeStore->FindString(path, Columns().vfspath);
+
+    if (!item.IsOk()) return;
+
+    TreeModel::Row row(item, *_treeStore);
+
+    row[Columns().thumbnail] = wxVariant(thumbnail);
+    row.SendItemChanged();
+}
+
+void FileSystemView::RequestThumbnailsOfChildren(const wxDataViewItem& parent)
+{
+    if (!_requestThumbnail) return;
+
+    wxDataViewItemArray children;
+    _treeStore->GetChildren(parent, children);
+
+    // Start at the bottom, thumbnail providers tend to serve the most recent request first
+    for (auto i = children.rbegin(); i != children.rend(); ++i)
+    {
+        TreeModel::Row row(*i, *_treeStore);
+
+        if (row[Columns().isFolder].getBool() || !row[Columns().thumbnail].getVariant().IsNull())
+        {
+            continue;
+        }
+
+        auto thumbnail = _requestThumbnail(row[Columns().vfspath]);
+
+        if (thumbnail.IsOk())
+        {
+            row[Columns().thumbnail] = wxVariant(thumbnail);
+            row.SendItemChanged();
+        }
+    }
+}
+
 void FileSystemView::SelectItem(const wxDataViewItem& item)
 {
     if (!item.IsOk()) return;
@@ -208,6 +266,12 @@ void FileSystemView::OnSelectionChanged(wxDataViewEvent& ev)
     HandleSelectionChange();
 }
 
+void FileSystemView::OnItemExpanded(wxDataViewEvent& ev)
+{
+    RequestThumbnailsOfChildren(ev.GetItem());
+    ev.Skip();
+}
+
 void FileSystemView::OnTreeStorePopulationFinished(TreeModel::PopulationFinishedEvent& ev)
 {
     _treeStore = ev.GetTreeModel();
@@ -232,6 +296,9 @@ void FileSystemView::OnTreeStorePopulationFinished(TreeModel::PopulationFinished
     // Auto-size the first level
     TriggerColumnSizeEvent();
 
+    // Files in the top level are visible right away
+    RequestThumbnailsOfChildren(wxDataViewItem());
+
     // Call client code
     _signalTreePopulated.emit();
 }
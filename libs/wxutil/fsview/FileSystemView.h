@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <sigc++/signal.h>
 #include "../dataview/TreeModel.h"
 #include "../dataview/TreeView.h"
@@ -20,6 +21,11 @@ namespace wxutil
 class FileSystemView :
     public TreeView
 {
+public:
+    // Returns the thumbnail of the file at the given path, or an invalid
+    // bitmap if it's not available (yet), see EnableThumbnails()
+    using ThumbnailRequestFunction = std::function<wxBitmap(const std::string& path)>;
+
 private:
     TreeModel::Ptr _treeStore;
 
@@ -35,6 +41,8 @@ private:
 
     sigc::signal<void> _signalTreePopulated;
 
+    ThumbnailRequestFunction _requestThumbnail;
+
 public:
     class SelectionChangedEvent :
         public wxEvent
@@ -91,6 +99,14 @@ public:
     // Expands the given path, which is relative to the base path (e.g. "maps/")
     void ExpandPath(const std::string& relativePath);
 
+    // Adds a column showing a thumbnail of the given size in front of each file.
+    // The function is invoked for the files becoming visible in the tree, thumbnails
+    // that are not available right away can be assigned later through SetThumbnail().
+    void EnableThumbnails(int size, const ThumbnailRequestFunction& requestThumbnail);
+
+    // Assigns the thumbnail of the file at the given path
+    void SetThumbnail(const std::string& path, const wxBitmap& thumbnail);
+
     sigc::signal<void>& signal_TreePopulated();
 
 private:
@@ -98,7 +114,9 @@ private:
 
     void SelectItem(const wxDataViewItem& item);
     void HandleSelectionChange();
+    void RequestThumbnailsOfChildren(const wxDataViewItem& parent);
     void OnSelectionChanged(wxDataViewEvent& ev);
+    void OnItemExpanded(wxDataViewEvent& ev);
     void OnTreeStorePopulationFinished(TreeModel::PopulationFinishedEvent& ev);
 };
 
@@ -21,7 +21,8 @@ struct TreeColumns :
         size(add(TreeModel::Column::String)),
         isPhysical(add(TreeModel::Column::Boolean)),
         archivePath(add(TreeModel::Column::String)),
-        archiveDisplay(add(TreeModel::Column::String))
+        archiveDisplay(add(TreeModel::Column::String)),
+        thumbnail(add(TreeModel::Column::Icon))
     {}
 
     TreeModel::Column filename;    // e.g. "chair1.pfb"
@@ -31,6 +32,7 @@ struct TreeColumns :
     TreeModel::Column isPhysical;  // file size string
     TreeModel::Column archivePath;  // path to containing archive
     TreeModel::Column archiveDisplay;  // string to display the parent container
+    TreeModel::Column thumbnail;  // preview image, if enabled in the view
 };
 
 class Populator :
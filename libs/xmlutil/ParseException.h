@@ -0,0 +1,22 @@
+#pragma once
+
+#include <stdexcept>
+#include <string>
+
+namespace xml
+{
+
+// Exception to indicate that a malformed XML document has been encountered.
+
+class ParseException:
+    public std::runtime_error
+{
+public:
+
+    // Constructor. Must initialise the parent.
+    ParseException(const std::string& what):
+        std::runtime_error(what) {}
+
+};
+
+}
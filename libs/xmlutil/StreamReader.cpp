@@ -0,0 +1,123 @@
+#include "StreamReader.h"
+#include "ParseException.h"
+
+#include <libxml/xmlreader.h>
+
+namespace xml
+{
+
+StreamReader::StreamReader(std::istream& stream) :
+	_reader(nullptr),
+	_stream(stream),
+	_isStartElement(false),
+	_emptyElementPending(false)
+{
+	// Let libxml2 pull the data from the stream in chunks
+	auto readCallback = [](void* context, char* buffer, int length)
+	{
+		auto& input = *static_cast<std::istream*>(context);
+		input.read(buffer, length);
+		return static_cast<int>(input.gcount());
+	};
+
+	_reader = xmlReaderForIO(readCallback, nullptr, &_stream, "stream", nullptr, 0);
+
+	if (_reader == nullptr)
+	{
+		throw ParseException("Could not create XML reader");
+	}
+
+	// Keep the errors for the exception message instead of printing them to stderr
+	auto errorCallback = [](void* context, const char* message, xmlParserSeverities severity, xmlTextReaderLocatorPtr)
+	{
+		if (severity == XML_PARSER_SEVERITY_ERROR || severity == XML_PARSER_SEVERITY_VALIDITY_ERROR)
+		{
+			auto& lastError = static_cast<StreamReader*>(context)->_lastError;
+			lastError = message;
+
+			// libxml2 messages end with a line break
+			while (!lastError.empty() && (lastError.back() == '\n' || lastError.back() == '\r'))
+			{
+				lastError.pop_back();
+			}
+		}
+	};
+
+	xmlTextReaderSetErrorHandler(_reader, errorCallback, this);
+}
+
+StreamReader::~StreamReader()
+{
+	xmlFreeTextReader(_reader);
+}
+
+bool StreamReader::readNext()
+{
+	if (_emptyElementPending)
+	{
+		_emptyElementPending = false;
+		_isStartElement = false;
+		return true;
+	}
+
+	int result;
+
+	while ((result = xmlTextReaderRead(_reader)) == 1)
+	{
+		switch (xmlTextReaderNodeType(_reader))
+		{
+		case XML_READER_TYPE_ELEMENT:
+			_isStartElement = true;
+			_emptyElementPending = xmlTextReaderIsEmptyElement(_reader) == 1;
+			return true;
+
+		case XML_READER_TYPE_END_ELEMENT:
+			_isStartElement = false;
+			return true;
+
+		default:
+			continue; // skip text, comments, etc.
+		}
+	}
+
+	if (result < 0)
+	{
+		throw ParseException(_lastError.empty() ? "Failed to parse XML document" : _lastError);
+	}
+
+	return false;
+}
+
+bool StreamReader::isStartElement() const
+{
+	return _isStartElement;
+}
+
+std::string StreamReader::getName() const
+{
+	auto name = xmlTextReaderConstName(_reader);
+	return name != nullptr ? reinterpret_cast<const char*>(name) : "";
+}
+
+int StreamReader::getDepth() const
+{
+	return xmlTextReaderDepth(_reader);
+}
+
+void StreamReader::foreachAttribute(const std::function<void(const std::string&, const std::string&)>& functor)
+{
+	if (!_isStartElement) return;
+
+	while (xmlTextReaderMoveToNextAttribute(_reader) == 1)
+	{
+		auto value = xmlTextReaderConstValue(_reader);
+
+		functor(reinterpret_cast<const char*>(xmlTextReaderConstName(_reader)),
+			value != nullptr ? reinterpret_cast<const char*>(value) : "");
+	}
+
+	// Move back from the attributes to the element itself
+	xmlTextReaderMoveToElement(_reader);
+}
+
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <functional>
+#include <istream>
+#include <string>
+
+// Forward declaration to avoid including the whole libxml2 headers
+typedef struct _xmlTextReader xmlTextReader;
+typedef xmlTextReader *xmlTextReaderPtr;
+
+namespace xml
+{
+
+/**
+ * Pull parser reading an XML document from a stream tag by tag,
+ * as opposed to Document which parses the whole stream into a tree.
+ * Only the elements on the path to the current tag are kept in memory.
+ *
+ * Text, comments and processing instructions are skipped.
+ */
+class StreamReader
+{
+private:
+	xmlTextReaderPtr _reader;
+
+	std::istream& _stream;
+
+	// True if the reader is positioned on a start tag, false for an end tag
+	bool _isStartElement;
+
+	// Set after reporting the start of an empty element like <tag/>,
+	// the next call to readNext() will report its end
+	bool _emptyElementPending;
+
+	// The most recent error reported by the parser
+	std::string _lastError;
+
+public:
+	// Prepares the reader, parsing starts with the first call to readNext()
+	StreamReader(std::istream& stream);
+
+	StreamReader(const StreamReader& other) = delete;
+	StreamReader& operator=(const StreamReader& other) = delete;
+
+	~StreamReader();
+
+	// Advances to the next start or end tag. Empty elements are reported
+	// as a start tag immediately followed by an end tag.
+	// Returns false once the end of the document has been reached.
+	// Throws ParseException if the document is not well-formed.
+	bool readNext();
+
+	// Returns true if the reader is positioned on a start tag
+	bool isStartElement() const;
+
+	// Returns the name of the current element
+	std::string getName() const;
+
+	// Returns the nesting level of the current element, the top-level element is at depth 0
+	int getDepth() const;
+
+	// Invokes the given functor with name and value of each attribute of the current start tag
+	void foreachAttribute(const std::function<void(const std::string&, const std::string&)>& functor);
+};
+
+}
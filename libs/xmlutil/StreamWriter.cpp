@@ -0,0 +1,111 @@
+#include "StreamWriter.h"
+
+#include <cassert>
+
+namespace xml
+{
+
+StreamWriter::StreamWriter(std::ostream& stream) :
+	_stream(stream),
+	_startTagPending(false)
+{
+	_stream << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n";
+}
+
+void StreamWriter::startElement(const std::string& name)
+{
+	closePendingStartTag();
+
+	writeIndentation(_openElements.size());
+	_stream << '<' << name;
+
+	_openElements.push_back(name);
+	_startTagPending = true;
+}
+
+void StreamWriter::writeAttribute(const std::string& name, const std::string& value)
+{
+	assert(_startTagPending);
+
+	_stream << ' ' << name << "=\"";
+	writeEscapedAttributeValue(value);
+	_stream << '"';
+}
+
+void StreamWriter::endElement()
+{
+	assert(!_openElements.empty());
+
+	if (_startTagPending)
+	{
+		// No children, write this as empty element
+		_stream << "/>\n";
+		_startTagPending = false;
+	}
+	else
+	{
+		writeIndentation(_openElements.size() - 1);
+		_stream << "</" << _openElements.back() << ">\n";
+	}
+
+	_openElements.pop_back();
+}
+
+void StreamWriter::endDocument()
+{
+	while (!_openElements.empty())
+	{
+		endElement();
+	}
+
+	_stream.flush();
+}
+
+void StreamWriter::closePendingStartTag()
+{
+	if (_startTagPending)
+	{
+		_stream << ">\n";
+		_startTagPending = false;
+	}
+}
+
+void StreamWriter::writeIndentation(std::size_t level)
+{
+	for (std::size_t i = 0; i < level; ++i)
+	{
+		_stream << "  ";
+	}
+}
+
+void StreamWriter::writeEscapedAttributeValue(const std::string& value)
+{
+	// Same set of characters libxml2 escapes when serialising attribute values,
+	// everything else (including UTF-8 sequences) is written as it is
+	std::size_t unescapedStart = 0;
+
+	for (std::size_t i = 0; i < value.size(); ++i)
+	{
+		const char* replacement = nullptr;
+
+		switch (value[i])
+		{
+		case '<': replacement = "&lt;"; break;
+		case '>': replacement = "&gt;"; break;
+		case '&': replacement = "&amp;"; break;
+		case '"': replacement = "&quot;"; break;
+		case '\n': replacement = "&#10;"; break;
+		case '\r': replacement = "&#13;"; break;
+		case '\t': replacement = "&#9;"; break;
+		default: continue;
+		}
+
+		_stream.write(value.data() + unescapedStart, i - unescapedStart);
+		_stream << replacement;
+		unescapedStart = i + 1;
+	}
+
+	_stream.write(value.data() + unescapedStart, value.size() - unescapedStart);
+}
+
+}
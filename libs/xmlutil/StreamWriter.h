@@ -0,0 +1,57 @@
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace xml
+{
+
+/**
+ * Writes an XML document to a stream element by element, without
+ * building the document tree in memory first.
+ *
+ * For documents consisting of elements and attributes only, the output
+ * is identical to what Document::saveToString() produces for the same
+ * tree: XML declaration, two spaces of indentation per level, and
+ * elements without children written as <tag/>.
+ */
+class StreamWriter
+{
+private:
+	std::ostream& _stream;
+
+	// Names of the currently open elements, innermost last
+	std::vector<std::string> _openElements;
+
+	// True while the start tag of the innermost element is still open
+	// (attributes can be added, and it's not known yet whether it has children)
+	bool _startTagPending;
+
+public:
+	// Writes the XML declaration to the given stream
+	StreamWriter(std::ostream& stream);
+
+	StreamWriter(const StreamWriter& other) = delete;
+	StreamWriter& operator=(const StreamWriter& other) = delete;
+
+	// Opens a new child element of the current element
+	void startElement(const std::string& name);
+
+	// Adds an attribute to the current element. This must happen
+	// before any child elements of the current element are started.
+	void writeAttribute(const std::string& name, const std::string& value);
+
+	// Closes the current element
+	void endElement();
+
+	// Closes all elements that are still open
+	void endDocument();
+
+private:
+	void closePendingStartTag();
+	void writeIndentation(std::size_t level);
+	void writeEscapedAttributeValue(const std::string& value);
+};
+
+}
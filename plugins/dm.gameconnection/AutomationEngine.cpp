@@ -1,8 +1,9 @@
 #include "AutomationEngine.h"
 
 #include <cassert>
+#include <thread>
 
-#include "MessageTcp.h"
+#include "MessagePump.h"
 #include "clsocket/ActiveSocket.h"
 
 #include <fmt/format.h>
@@ -47,7 +48,7 @@ bool AutomationEngine::hasLostConnection() const
     return _connection && !_connection->isAlive();
 }
 
-bool AutomationEngine::connect()
+bool AutomationEngine::connect(const char* host, int port)
 {
     if (isAlive())
         return true;    //already connected
@@ -58,13 +59,16 @@ bool AutomationEngine::connect()
     if (
         !connection->Initialize() ||
         !connection->SetNonblocking() ||
-        !connection->Open(DEFAULT_HOST, DEFAULT_PORT))
+        !connection->Open(host ? host : DEFAULT_HOST, port ? port : DEFAULT_PORT))
     {
         return false;
     }
+    //requests are small and every one of them waits for response:
+    //don't let Nagle's algorithm hold them back until previous data is acknowledged
+    connection->DisableNagleAlgoritm();
 
-    _connection.reset(new MessageTcp());
-    _connection->init(std::move(connection));
+    //socket is handed over to I/O thread from now on
+    _connection.reset(new MessagePump(std::move(connection)));
     if (!_connection->isAlive())
         return false;
 
@@ -93,7 +97,7 @@ int AutomationEngine::generateNewSequenceNumber()
     return ++_seqno;
 }
 
-AutomationEngine::Request* AutomationEngine::sendRequest(int tag, const std::string& request) {
+AutomationEngine::Request* AutomationEngine::sendRequest(int tag, const std::string& request, MessagePump::ResponseHandler handler) {
     assert(tag < 31);
     if (!_connection)
         throw DisconnectException();
@@ -105,7 +109,7 @@ AutomationEngine::Request* AutomationEngine::sendRequest(int tag, const std::str
     req._finished = false;
 
     std::string fullMessage = seqnoPreamble(req._seqno) + req._request;
-    _connection->writeMessage(fullMessage.data(), (int)fullMessage.size());
+    _connection->writeMessage(std::move(fullMessage), req._seqno, std::move(handler));
     _requests.push_back(req);
 
     return &_requests.back();
@@ -115,16 +119,14 @@ void AutomationEngine::think() {
     ScopedDepthCounter dc(_thinkDepth);
 
     if (_connection) {
-        _connection->think();
-
-        //check if full response is here
-        std::vector<char> responseBytes;
+        //check if full response has been received by I/O thread
+        std::string responseBytes;
         while (_connection->readMessage(responseBytes)) {
             //validate and remove preamble
             int responseSeqno, lineLen;
-            int ret = sscanf(responseBytes.data(), "response %d\n%n", &responseSeqno, &lineLen);
+            int ret = sscanf(responseBytes.c_str(), "response %d\n%n", &responseSeqno, &lineLen);
             assert(ret == 1); ret;
-            std::string response(responseBytes.begin() + lineLen, responseBytes.end());
+            std::string response = responseBytes.substr(lineLen);
 
             //find request, mark it as "no longer in progress"
             if (Request* req = findRequest(responseSeqno)) {
@@ -244,6 +246,8 @@ void AutomationEngine::wait(const std::vector<int>& reqSeqnos, const std::vector
         if (!isAlive())
             throw DisconnectException();
         think();
+        //give the game (or whoever is running on this core) a chance to respond
+        std::this_thread::yield();
     }
 }
 
@@ -253,6 +257,8 @@ void AutomationEngine::waitForTags(int tagMask)
         if (!isAlive())
             throw DisconnectException();
         think();
+        //give the game (or whoever is running on this core) a chance to respond
+        std::this_thread::yield();
     }
 }
 
@@ -280,6 +286,36 @@ int AutomationEngine::executeRequestAsync(int tag, const std::string& request, c
     return req->_seqno;
 }
 
+std::vector<std::string> AutomationEngine::executeRequestsPipelined(int tag, const std::vector<std::string>& requests)
+{
+    //callbacks of unfinished requests outlive this call if the connection is lost
+    auto responses = std::make_shared<std::vector<std::string>>(requests.size());
+    std::vector<int> seqnos;
+    seqnos.reserve(requests.size());
+
+    for (std::size_t i = 0; i < requests.size(); i++) {
+        Request* req = sendRequest(tag, requests[i]);
+        int seqno = req->_seqno;
+        req->_callback = [this, seqno, responses, i](int num) {
+            Request *req = findRequest(seqno);
+            assert(num == seqno && req && req->_finished);
+            (*responses)[i] = std::move(req->_response);
+        };
+        seqnos.push_back(seqno);
+    }
+
+    wait(seqnos, {});
+
+    return std::move(*responses);
+}
+
+std::future<std::string> AutomationEngine::executeRequestFuture(int tag, const std::string& request)
+{
+    return executeRequestFuture<std::string>(tag, request, [](const std::string& response) {
+        return response;
+    });
+}
+
 int AutomationEngine::executeMultistepProc(int tag, const std::function<MultistepProcReturn(int)>& function, int startStep)
 {
     assert(tag < 31);
@@ -4,12 +4,15 @@
 #include <vector>
 #include <functional>
 #include <stdexcept>
+#include <future>
+#include <thread>
+#include <chrono>
+
+#include "MessagePump.h"
 
 namespace gameconn
 {
 
-class MessageTcp;
-
 // Thrown by some methods of AutomationEngine and GameConnection
 // if connection was lost or was not established at all.
 class DisconnectException : public std::runtime_error {
@@ -46,7 +49,8 @@ public:
 
     // Connect to TDM instance if not connected yet.
     // Returns false if failed to connect, true on success.
-    bool connect();
+    // Host and port can be overridden to connect to a stand-in server (see LoopbackServer).
+    bool connect(const char* host = nullptr, int port = 0);
     // Disconnect from TDM instance if connected.
     // If force = false, then it waits until all pending requests are finished.
     // If force = true, then all pending requests are dropped, no blocking for sure.
@@ -75,6 +79,27 @@ public:
     // May throw DisconnectException if connection is missing (but never throws if isAlive() is true before call).
     int executeRequestAsync(int tag, const std::string& request, const std::function<void(int)>& callback = {});
 
+    // Send all given requests at once (pipelined), then wait until all of them are finished.
+    // The game starts processing the first request while the rest are still in transit.
+    // Returns response contents in the order of requests.
+    // Throws DisconnectException if connection is missing or lost during execution.
+    std::vector<std::string> executeRequestsPipelined(int tag, const std::vector<std::string>& requests);
+
+    // Send request asynchronously and return future for its response content.
+    // The future is fulfilled by I/O thread, so it becomes ready without any think calls,
+    // but the request is considered finished (for tags and callbacks) only on the next think.
+    // The optional convert function is also called on I/O thread, e.g. to parse response.
+    // If connection is lost, the future throws DisconnectException.
+    // May throw DisconnectException if connection is missing (but never throws if isAlive() is true before call).
+    template<typename Result>
+    std::future<Result> executeRequestFuture(int tag, const std::string& request, std::function<Result(const std::string&)> convert);
+    std::future<std::string> executeRequestFuture(int tag, const std::string& request);
+
+    // Wait until the future returned by executeRequestFuture is ready, thinking meanwhile.
+    // Returns its value, throws DisconnectException if connection is lost.
+    template<typename Result>
+    Result waitForFuture(std::future<Result>& future);
+
     // Execute given multistep procedure, starting on the next think.
     // Returns ID of procedure for queries.
     // Multistep procedure is like a DFA of "steps", each step is executed till start to end.
@@ -103,11 +128,11 @@ public:
     std::string getResponse(int seqno) const;
 
 private:
-    // Connection to TDM game (i.e. the socket with custom message framing).
+    // Connection to TDM game (i.e. the socket with custom message framing, served by I/O thread).
     // It can be "dead" in two ways:
     //   _connection is NULL --- no connection
     //   *_connection is dead --- just lost connection
-    std::unique_ptr<MessageTcp> _connection;
+    std::unique_ptr<MessagePump> _connection;
     // Sequence number of the last sent request (incremented sequentally).
     int _seqno = 0;
     // Number of multistep procedures ever seen (incremented sequentally).
@@ -136,7 +161,7 @@ private:
     std::vector<MultistepProcedure> _multistepProcs;
 
     int generateNewSequenceNumber();
-    Request* sendRequest(int tag, const std::string& request);
+    Request* sendRequest(int tag, const std::string& request, MessagePump::ResponseHandler handler = {});
 
     Request* findRequest(int seqno) const;
     MultistepProcedure* findMultistepProc(int id) const;
@@ -145,4 +170,38 @@ private:
     void resumeMultistepProcedure(int id);
 };
 
+template<typename Result>
+std::future<Result> AutomationEngine::executeRequestFuture(int tag, const std::string& request, std::function<Result(const std::string&)> convert)
+{
+    auto promise = std::make_shared<std::promise<Result>>();
+    std::future<Result> future = promise->get_future();
+
+    sendRequest(tag, request, [promise, convert](const std::string* response) {
+        try {
+            if (!response)
+                throw DisconnectException();
+            promise->set_value(convert(*response));
+        }
+        catch (...) {
+            promise->set_exception(std::current_exception());
+        }
+    });
+
+    return future;
+}
+
+template<typename Result>
+Result AutomationEngine::waitForFuture(std::future<Result>& future)
+{
+    while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        if (!isAlive())
+            throw DisconnectException();
+        think();
+        std::this_thread::yield();
+    }
+    //finish the request on engine side too
+    think();
+    return future.get();
+}
+
 }
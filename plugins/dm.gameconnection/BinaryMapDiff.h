@@ -0,0 +1,177 @@
+#pragma once
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include <utility>
+
+namespace gameconn
+{
+
+/**
+ * Compact binary representation of changes in .map file.
+ * It carries the same information as the plaintext diff of DiffDoom3MapWriter,
+ * but nothing has to be quoted, escaped or tokenized on the receiving side,
+ * and the receiver can preallocate everything from the counts.
+ *
+ * Layout (integers are unsigned LEB128 varints, strings are varint length + bytes):
+ *   "DRMD" version:u8 numEntities
+ *   numEntities x { op:u8 name numSpawnargs numSpawnargs x { key value } }
+ *
+ * Removed entities are written without spawnargs.
+ */
+namespace binarydiff
+{
+
+static const char MAGIC[4] = {'D', 'R', 'M', 'D'};
+static const unsigned char VERSION = 1;
+
+// Automation action which accepts binary diff (as opposed to "reloadmap-diff").
+static const char* const ACTION_NAME = "reloadmap-diffbin";
+// Game advertises supported diff formats in this property of "status" query,
+// binary diff is sent only if FORMAT_NAME is listed there.
+static const char* const STATUS_FORMATS_KEY = "hotreloadformats";
+static const char* const FORMAT_NAME = "binary";
+
+enum class EntityOp : unsigned char {
+    Add = 0,
+    Modify = 1,
+    ModifyRespawn = 2,
+    Remove = 3,
+};
+
+struct EntityRecord {
+    EntityOp op = EntityOp::Modify;
+    std::string name;
+    std::vector<std::pair<std::string, std::string>> spawnargs;
+};
+
+namespace detail
+{
+    inline void writeVarint(std::string& out, std::size_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<char>(value));
+    }
+
+    inline void writeString(std::string& out, const std::string& str) {
+        writeVarint(out, str.size());
+        out.append(str);
+    }
+
+    // Bounds-checked reading cursor over binary diff data
+    class Reader {
+        const char* _ptr;
+        const char* _end;
+    public:
+        Reader(const char* data, std::size_t size) : _ptr(data), _end(data + size) {}
+
+        bool readByte(unsigned char& value) {
+            if (_ptr == _end)
+                return false;
+            value = static_cast<unsigned char>(*_ptr++);
+            return true;
+        }
+        bool readVarint(std::size_t& value) {
+            value = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                unsigned char byte;
+                if (!readByte(byte))
+                    return false;
+                value |= static_cast<std::size_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80))
+                    return true;
+            }
+            return false;   //overlong
+        }
+        bool readString(std::string& str) {
+            std::size_t len;
+            if (!readVarint(len) || len > static_cast<std::size_t>(_end - _ptr))
+                return false;
+            str.assign(_ptr, len);
+            _ptr += len;
+            return true;
+        }
+        bool readMagic() {
+            if (_end - _ptr < static_cast<std::ptrdiff_t>(sizeof(MAGIC)) || memcmp(_ptr, MAGIC, sizeof(MAGIC)) != 0)
+                return false;
+            _ptr += sizeof(MAGIC);
+            return true;
+        }
+        std::size_t remains() const {
+            return _end - _ptr;
+        }
+    };
+}
+
+// Serializes given entity records into binary diff.
+inline std::string encode(const std::vector<EntityRecord>& records)
+{
+    std::size_t totalSize = sizeof(MAGIC) + 1 + 10;
+    for (const auto& rec : records) {
+        totalSize += 1 + 10 + rec.name.size() + 10;
+        for (const auto& kv : rec.spawnargs)
+            totalSize += 20 + kv.first.size() + kv.second.size();
+    }
+
+    std::string out;
+    out.reserve(totalSize);
+    out.append(MAGIC, sizeof(MAGIC));
+    out.push_back(static_cast<char>(VERSION));
+    detail::writeVarint(out, records.size());
+
+    for (const auto& rec : records) {
+        out.push_back(static_cast<char>(rec.op));
+        detail::writeString(out, rec.name);
+        detail::writeVarint(out, rec.spawnargs.size());
+        for (const auto& kv : rec.spawnargs) {
+            detail::writeString(out, kv.first);
+            detail::writeString(out, kv.second);
+        }
+    }
+
+    return out;
+}
+
+// Parses binary diff produced by encode.
+// Returns false if data is truncated or malformed.
+inline bool decode(const char* data, std::size_t size, std::vector<EntityRecord>& records)
+{
+    records.clear();
+    detail::Reader reader(data, size);
+
+    unsigned char version;
+    std::size_t numEntities;
+    if (!reader.readMagic() || !reader.readByte(version) || version != VERSION || !reader.readVarint(numEntities))
+        return false;
+    //every record takes at least 3 bytes: don't trust count blindly
+    if (numEntities > reader.remains() / 3)
+        return false;
+
+    records.resize(numEntities);
+    for (auto& rec : records) {
+        unsigned char op;
+        std::size_t numSpawnargs;
+        if (!reader.readByte(op) || op > static_cast<unsigned char>(EntityOp::Remove))
+            return false;
+        rec.op = static_cast<EntityOp>(op);
+        if (!reader.readString(rec.name) || !reader.readVarint(numSpawnargs))
+            return false;
+        if (numSpawnargs > reader.remains() / 2)
+            return false;
+
+        rec.spawnargs.resize(numSpawnargs);
+        for (auto& kv : rec.spawnargs) {
+            if (!reader.readString(kv.first) || !reader.readString(kv.second))
+                return false;
+        }
+    }
+
+    return reader.remains() == 0;
+}
+
+}
+
+}
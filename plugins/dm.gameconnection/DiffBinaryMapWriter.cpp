@@ -0,0 +1,73 @@
+#include "DiffBinaryMapWriter.h"
+
+#include <cassert>
+
+#include "inode.h"
+#include "ientity.h"
+#include "iscenegraph.h"
+
+namespace gameconn
+{
+
+namespace binarydiff
+{
+
+EntityOp getEntityOp(const DiffStatus& status)
+{
+    assert(status.isModified());
+    //same priorities as in DiffDoom3MapWriter::writeEntityPreamble
+    if (status.isRemoved())
+        return EntityOp::Remove;
+    if (status.isAdded())
+        return EntityOp::Add;
+    if (status.needsRespawn())
+        return EntityOp::ModifyRespawn;
+    return EntityOp::Modify;
+}
+
+std::vector<EntityRecord> collectEntityRecords(const DiffEntityStatuses& entityStatuses)
+{
+    std::vector<EntityRecord> records;
+    records.reserve(entityStatuses.size());
+
+    //removal stubs (no actual spawnargs)
+    for (const auto& pNS : entityStatuses) {
+        if (pNS.second.isRemoved()) {
+            EntityRecord rec;
+            rec.op = EntityOp::Remove;
+            rec.name = pNS.first;
+            records.push_back(std::move(rec));
+        }
+    }
+
+    //added/modified entities in scene order
+    GlobalSceneGraph().root()->foreachNode([&](const scene::INodePtr& node) {
+        auto it = entityStatuses.find(node->name());
+        if (it == entityStatuses.end() || it->second.isRemoved())
+            return true;
+
+        Entity* entity = Node_getEntity(node);
+        if (!entity)
+            return true;
+
+        EntityRecord rec;
+        rec.op = getEntityOp(it->second);
+        rec.name = it->first;
+        entity->forEachKeyValue([&](const std::string& key, const std::string& value) {
+            rec.spawnargs.emplace_back(key, value);
+        });
+        records.push_back(std::move(rec));
+        return true;
+    });
+
+    return records;
+}
+
+}
+
+std::string saveBinaryMapDiff(const DiffEntityStatuses& entityStatuses)
+{
+    return binarydiff::encode(binarydiff::collectEntityRecords(entityStatuses));
+}
+
+}
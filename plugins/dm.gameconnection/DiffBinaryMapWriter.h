@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "DiffStatus.h"
+#include "BinaryMapDiff.h"
+
+namespace gameconn
+{
+
+namespace binarydiff
+{
+
+// Returns operation code for entity with given (modified) status.
+EntityOp getEntityOp(const DiffStatus& status);
+
+// Collects current spawnargs of entities with specified names from the scene.
+// Entities are returned in the same order as they would be written by plaintext diff:
+// removal stubs first, then added/modified entities in scene order.
+std::vector<EntityRecord> collectEntityRecords(const DiffEntityStatuses& entityStatuses);
+
+}
+
+// Saves entities with specified statuses to in-memory binary map patch.
+std::string saveBinaryMapDiff(const DiffEntityStatuses& entityStatuses);
+
+}
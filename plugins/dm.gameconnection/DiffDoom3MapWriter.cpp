@@ -2,6 +2,13 @@
 #include "DiffStatus.h"
 
 #include "ientity.h"
+#include "imap.h"
+#include "iscenegraph.h"
+#include "scene/Traverse.h"
+#include "registry/registry.h"
+
+#include <set>
+#include <sstream>
 
 namespace gameconn
 {
@@ -64,4 +71,52 @@ void DiffDoom3MapWriter::beginWritePatch(const IPatchNodePtr&, std::ostream&)
 void DiffDoom3MapWriter::endWritePatch(const IPatchNodePtr&, std::ostream&)
 {}
 
+/**
+ * stgatilov: Saves only entities with specified names to in-memory map patch.
+ * This diff is intended to be consumed by TheDarkMod automation for HotReload purposes.
+ * Brushes and patches are not written: hot reload only updates spawnargs,
+ * changed geometry needs a full map reload in the game.
+ */
+std::string saveMapDiff(const DiffEntityStatuses& entityStatuses)
+{
+    auto root = GlobalSceneGraph().root();
+
+    std::set<scene::INode*> subsetNodes;
+    root->foreachNode([&](const scene::INodePtr& node) {
+        if (entityStatuses.count(node->name()))
+            subsetNodes.insert(node.get());
+        return true;
+    });
+
+    std::ostringstream outStream;
+    outStream << "// diff " << entityStatuses.size() << std::endl;
+
+    DiffDoom3MapWriter writer(entityStatuses);
+
+    //write removal stubs (no actual spawnargs)
+    for (const auto& pNS : entityStatuses) {
+        const auto& name = pNS.first;
+        const auto& status = pNS.second;
+        assert(status.isModified());    //(don't put untouched entities into map)
+        if (status.isRemoved())
+            writer.writeRemoveEntityStub(name, outStream);
+    }
+
+    //write added/modified entities as usual
+    {
+        registry::ScopedKeyChanger progressDisabler(RKEY_MAP_SUPPRESS_LOAD_STATUS_DIALOG, true);
+
+        // Hack: disable recalculateBrushWindings for this export
+        registry::ScopedKeyChanger<std::string> guard("MapExporter_IgnoreBrushes", "yes");
+
+        // Get a scoped exporter class
+        auto exporter = GlobalMapModule().createMapExporter(writer, root, outStream);
+        exporter->exportMap(root, scene::traverseSubset(subsetNodes));
+
+        // end the life of the exporter instance here to finish the scene
+    }
+
+    return outStream.str();
+}
+
 }
@@ -1,14 +1,13 @@
 #pragma once
 
 #include "imapformat.h"
+#include "DiffStatus.h"
 
 #include <map>
 
 namespace gameconn
 {
 
-class DiffStatus;
-
 /**
  * Doom 3 map-patch writer for TheDarkMod hot reload / game connection feature.
  *
@@ -39,4 +38,7 @@ public:
     void endWritePatch(const IPatchNodePtr& patch, std::ostream& stream) override;
 };
 
+// Saves entities with specified statuses to in-memory plaintext map patch.
+std::string saveMapDiff(const DiffEntityStatuses& entityStatuses);
+
 }
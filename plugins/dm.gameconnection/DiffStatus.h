@@ -1,6 +1,10 @@
 #pragma once
 
 #include <map>
+#include <cassert>
+#include <cstdlib>
+#include <vector>
+#include <string>
 
 namespace gameconn
 {
@@ -68,4 +72,15 @@ public:
 
 typedef std::map<std::string, DiffStatus> DiffEntityStatuses;
 
+// Splits entity statuses into consecutive parts of at most batchSize entities each.
+inline std::vector<DiffEntityStatuses> splitDiffEntityStatuses(const DiffEntityStatuses& statuses, std::size_t batchSize) {
+    std::vector<DiffEntityStatuses> batches;
+    for (const auto& pNS : statuses) {
+        if (batches.empty() || batches.back().size() >= batchSize)
+            batches.emplace_back();
+        batches.back().insert(batches.back().end(), pNS);
+    }
+    return batches;
+}
+
 }
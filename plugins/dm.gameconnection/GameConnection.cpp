@@ -1,6 +1,8 @@
 #include "GameConnection.h"
 #include "DiffStatus.h"
 #include "DiffDoom3MapWriter.h"
+#include "DiffBinaryMapWriter.h"
+#include "LoopbackServer.h"
 #include "AutomationEngine.h"
 #include "GameConnectionDialog.h"
 
@@ -40,6 +42,13 @@ namespace
     //multistep procedure for TDM game start/restart
     const int TAG_RESTART = 7;
 
+    //map diff is sent in batches of this many entities, all batches are pipelined
+    const std::size_t MAP_DIFF_BATCH_SIZE = 64;
+
+    //port for stand-in game server of "GameConnectionBenchmark" command
+    //(must differ from the port of real game)
+    const int LOOPBACK_BENCHMARK_PORT = 3880;
+
     inline std::string messagePreamble(const std::string& type) {
         return fmt::format("message \"{}\"\n", type);
     }
@@ -66,12 +75,16 @@ std::string GameConnection::executeGenericRequest(const std::string& request)
 
 bool GameConnection::sendAnyPendingAsync()
 {
-    if (_mapObserver.getChanges().size() && _updateMapAlways) {
+    if (!_engine->areTagsInProgress() && _mapObserver.getChanges().size() && _updateMapAlways) {
         //note: this is blocking
         doUpdateMap();
         return true;
     }
-    return sendPendingCameraUpdate();
+    //camera update only waits for the previous one to finish:
+    //all camera changes arriving in the meantime are coalesced into one update
+    if (!_engine->areTagsInProgress((1 << TAG_CAMERA) | (1 << TAG_GENERIC)))
+        return sendPendingCameraUpdate();
+    return false;
 }
 
 void GameConnection::think()
@@ -89,9 +102,10 @@ void GameConnection::think()
 
     _engine->think();
 
-    if (!_engine->areTagsInProgress()) {
-        //doing nothing now: send async command if present
-        sendAnyPendingAsync();
+    checkReloadMapResult();
+
+    //send async command if present
+    if (sendAnyPendingAsync()) {
         //think now, don't delay to next frame
         _engine->think();
     }
@@ -135,6 +149,9 @@ bool GameConnection::connect()
     if (!_engine->connect())
         return false;       //failed to connect
 
+    //the game on the other side might have been restarted with a different version
+    _binaryMapDiffSupported.reset();
+
     setThinkLoop(true);
 
     _mapEventListener = GlobalMapModule().signal_mapEvent().connect(
@@ -149,6 +166,8 @@ bool GameConnection::connect()
 void GameConnection::disconnect(bool force)
 {
     _autoReloadMap = false;
+    _binaryMapDiffSupported.reset();
+    _reloadMapResult = {};
     setAlwaysUpdateMapEnabled(false);
     setUpdateMapObserverEnabled(false);
     setCameraSyncEnabled(false);
@@ -461,10 +480,20 @@ std::string GameConnection::executeGetCvarValue(const std::string &cvarName, std
 }
 
 std::map<std::string, std::string> GameConnection::executeQueryStatus()
+{
+    _engine->waitForTags(1 << TAG_GENERIC);
+    auto result = executeQueryStatusAsync();
+    return _engine->waitForFuture(result);
+}
+
+std::future<std::map<std::string, std::string>> GameConnection::executeQueryStatusAsync()
 {
     std::string request = queryPreamble("status") + "content:\n";
-    std::string response = executeGenericRequest(request);
+    return _engine->executeRequestFuture<std::map<std::string, std::string>>(TAG_GENERIC, request, parseQueryStatus);
+}
 
+std::map<std::string, std::string> GameConnection::parseQueryStatus(const std::string& response)
+{
     std::map<std::string, std::string> statusProps;
     int pos = 0;
     while (1) {
@@ -508,7 +537,12 @@ void GameConnection::updateCamera()
 
 bool GameConnection::sendPendingCameraUpdate()
 {
-    if (_cameraOutPending) {
+    if (_cameraOutPending && _engine->isAlive()) {
+        _cameraOutPending = false;
+        //camera signal is also emitted when nothing relevant has changed (e.g. view resized)
+        if (_cameraSentValid && _cameraOutData[0] == _cameraSentData[0] && _cameraOutData[1] == _cameraSentData[1])
+            return false;
+
         std::string text = composeConExecRequest(fmt::format(
             "setviewpos  {:0.3f} {:0.3f} {:0.3f}  {:0.3f} {:0.3f} {:0.3f}",
             _cameraOutData[0].x(), _cameraOutData[0].y(), _cameraOutData[0].z(),
@@ -516,7 +550,9 @@ bool GameConnection::sendPendingCameraUpdate()
         ));
 
         _engine->executeRequestAsync(TAG_CAMERA, text);
-        _cameraOutPending = false;
+        _cameraSentData[0] = _cameraOutData[0];
+        _cameraSentData[1] = _cameraOutData[1];
+        _cameraSentValid = true;
 
         return true;
     }
@@ -535,9 +571,12 @@ void GameConnection::setCameraSyncEnabled(bool enable)
     try {
         if (!enable) {
             _cameraChangedSignal.disconnect();
+            _cameraOutPending = false;
         }
         if (enable) {
             enableGhostMode();
+            //game camera could have moved since last sync: resend even if unchanged
+            _cameraSentValid = false;
 
             _cameraChangedSignal.disconnect();
             _cameraChangedSignal = GlobalCameraManager().signal_cameraChanged().connect(
@@ -628,9 +667,25 @@ void GameConnection::reloadMap()
 {
     try {
         std::string text = composeConExecRequest("reloadMap nocheck");
-        executeGenericRequest(text);
+        //reloading takes a while: don't block, the result is handled on think
+        _reloadMapResult = _engine->executeRequestFuture(TAG_GENERIC, text);
+        _reloadMapWithLocalChanges = GlobalMapModule().isModified();
+    }
+    catch (const DisconnectException&) {
+        //disconnected: will be handled during next think
+        return;
+    }
+}
+
+void GameConnection::checkReloadMapResult()
+{
+    if (!_reloadMapResult.valid() || _reloadMapResult.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        return;
+
+    try {
+        _reloadMapResult.get();
 
-        if (!GlobalMapModule().isModified()) {
+        if (!_reloadMapWithLocalChanges) {
             //TDM has reloaded .map file while we have no local changes
             //it means all three version of the map are in sync
             //so we can enable "update map" mode without fear for confusion
@@ -713,51 +768,14 @@ bool GameConnection::isAlwaysUpdateMapEnabled() const
     return _updateMapAlways;
 }
 
-/**
- * stgatilov: Saves only entities with specified names to in-memory map patch.
- * This diff is intended to be consumed by TheDarkMod automation for HotReload purposes.
- * TODO: What about patches and brushes?
- */
-std::string saveMapDiff(const DiffEntityStatuses& entityStatuses)
+bool GameConnection::isBinaryMapDiffSupported()
 {
-    auto root = GlobalSceneGraph().root();
-
-    std::set<scene::INode*> subsetNodes;
-    root->foreachNode([&](const scene::INodePtr& node) {
-        if (entityStatuses.count(node->name()))
-            subsetNodes.insert(node.get());
-        return true;
-    });
-
-    std::ostringstream outStream;
-    outStream << "// diff " << entityStatuses.size() << std::endl;
-
-    DiffDoom3MapWriter writer(entityStatuses);
-
-    //write removal stubs (no actual spawnargs)
-    for (const auto& pNS : entityStatuses) {
-        const auto& name = pNS.first;
-        const auto& status = pNS.second;
-        assert(status.isModified());    //(don't put untouched entities into map)
-        if (status.isRemoved())
-            writer.writeRemoveEntityStub(name, outStream);
+    if (!_binaryMapDiffSupported) {
+        //older game versions don't report formats: they only understand plaintext diff
+        std::string formats = " " + executeQueryStatus()[binarydiff::STATUS_FORMATS_KEY] + " ";
+        _binaryMapDiffSupported = formats.find(fmt::format(" {} ", binarydiff::FORMAT_NAME)) != std::string::npos;
     }
-
-    //write added/modified entities as usual
-    {
-        registry::ScopedKeyChanger progressDisabler(RKEY_MAP_SUPPRESS_LOAD_STATUS_DIALOG, true);
-
-        // Hack: disable recalculateBrushWindings for this export
-        registry::ScopedKeyChanger<std::string> guard("MapExporter_IgnoreBrushes", "yes");
-
-        // Get a scoped exporter class
-        auto exporter = GlobalMapModule().createMapExporter(writer, root, outStream);
-        exporter->exportMap(root, scene::traverseSubset(subsetNodes));
-
-        // end the life of the exporter instance here to finish the scene
-    }
-
-    return outStream.str();
+    return *_binaryMapDiffSupported;
 }
 
 void GameConnection::doUpdateMap()
@@ -766,17 +784,34 @@ void GameConnection::doUpdateMap()
         if (!_engine->isAlive())
             return; //no connection, don't even try
 
-        // Get map diff
-        std::string diff = saveMapDiff(_mapObserver.getChanges());
-        if (diff.empty()) {
-            return; //TODO: fail
-        }
-
-        std::string response = executeGenericRequest(actionPreamble("reloadmap-diff") + "content:\n" + diff);
-        if (response.find("HotReload: SUCCESS") != std::string::npos) {
-            //success: clear current diff, so that we don't reapply it next time
-            _mapObserver.clear();
+        const DiffEntityStatuses& changes = _mapObserver.getChanges();
+        if (changes.empty())
+            return; //nothing to send
+
+        bool binary = isBinaryMapDiffSupported();
+        std::string preamble = actionPreamble(binary ? binarydiff::ACTION_NAME : "reloadmap-diff") + "content:\n";
+
+        // Get map diff in batches: the game starts applying the first one
+        // while we are still serializing and sending the rest
+        std::vector<DiffEntityStatuses> batches = splitDiffEntityStatuses(changes, MAP_DIFF_BATCH_SIZE);
+        std::vector<std::string> requests;
+        for (const auto& batch : batches)
+            requests.push_back(preamble + (binary ? saveBinaryMapDiff(batch) : saveMapDiff(batch)));
+
+        _engine->waitForTags(1 << TAG_GENERIC);
+        std::vector<std::string> responses = _engine->executeRequestsPipelined(TAG_GENERIC, requests);
+
+        //success: clear applied part of diff, so that we don't reapply it next time
+        //(failed batches are kept and sent again on next update)
+        bool allApplied = true;
+        for (std::size_t i = 0; i < batches.size(); i++) {
+            if (responses[i].find("HotReload: SUCCESS") != std::string::npos)
+                _mapObserver.clear(batches[i]);
+            else
+                allApplied = false;
         }
+        if (!allApplied)
+            rWarning() << "GameConnection: game failed to apply part of map diff" << std::endl;
     }
     catch (const DisconnectException&) {
         //disconnected: will be handled during next think
@@ -879,6 +914,16 @@ void GameConnection::initialiseModule(const IApplicationContext& ctx)
         }
     );
 
+    // Measure protocol performance against a stand-in game server
+    GlobalCommandSystem().addCommand(
+        "GameConnectionBenchmark",
+        [](const cmd::ArgumentList& args) {
+            int iterations = args.empty() ? 1000 : args[0].getInt();
+            runLoopbackBenchmark(LOOPBACK_BENCHMARK_PORT, iterations);
+        },
+        { cmd::ARGTYPE_INT | cmd::ARGTYPE_OPTIONAL }
+    );
+
     // Respawn selected
     GlobalCommandSystem().addCommand(
         "GameConnectionRespawnSelected",
@@ -6,6 +6,8 @@
 
 #include "MapObserver.h"
 
+#include <optional>
+#include <future>
 #include <sigc++/connection.h>
 #include <wx/timer.h>
 
@@ -56,6 +58,7 @@ public:
     void backSyncCamera();
 
     // Ask game to reload .map file from disk (right now, once).
+    // Returns immediately, the game's response is handled on think.
     void reloadMap();
     // Enable/disable mode: force game to reload .map from disk every time DarkRadiant saves it.
     void setAutoReloadMapEnabled(bool enable);
@@ -113,6 +116,9 @@ private:
     bool _cameraOutPending = false;
     // Data for camera position (setviewpos format: X Y Z -pitch yaw roll)
     Vector3 _cameraOutData[2];
+    // Camera position sent to game last time (valid only if _cameraSentValid is true).
+    Vector3 _cameraSentData[2];
+    bool _cameraSentValid = false;
     // Signal subscription for when camera of DarkRadiant view changes.
     sigc::connection _cameraChangedSignal;
 
@@ -120,8 +126,14 @@ private:
     MapObserver _mapObserver;
     // True when "setAutoReloadMapEnabled" is enabled.
     bool _autoReloadMap = false;
+    // Response to the last reloadMap request, valid until handled.
+    std::future<std::string> _reloadMapResult;
+    // True if map had unsaved changes when the last reloadMap request was sent.
+    bool _reloadMapWithLocalChanges = false;
     // True when "setAlwaysUpdateMapEnabled" is enabled.
     bool _updateMapAlways = false;
+    // Whether connected game accepts binary map diff (unknown until first map update).
+    std::optional<bool> _binaryMapDiffSupported;
 
     // True when restartGame procedure is executed.
     bool _restartInProgress = false;
@@ -160,14 +172,25 @@ private:
     std::string executeGetCvarValue(const std::string &cvarName, std::string *defaultValue = nullptr);
     // Learn current status: installed mod/map, active gui, etc. (blocking).
     std::map<std::string, std::string> executeQueryStatus();
+    // Same as executeQueryStatus, but returns immediately.
+    std::future<std::map<std::string, std::string>> executeQueryStatusAsync();
+    // Parse response of status query into key-value pairs (called on I/O thread).
+    static std::map<std::string, std::string> parseQueryStatus(const std::string& response);
+    // Learn whether game can apply binary map diff, asking it on first call (blocking).
+    // The answer is cached until the connection is closed or re-established.
+    bool isBinaryMapDiffSupported();
 
     // Called from camera modification callback: schedules async "setviewpos" action for future.
     void updateCamera();
     // Send request for camera update, which is pending yet.
+    // Nothing is sent if camera has not moved since last update.
     bool sendPendingCameraUpdate();
     // Enable notarget/god/noclip to allow player to fly around without problems.
     void enableGhostMode();
 
+    // Enable/disable "update map" observer when game has finished reloading map.
+    void checkReloadMapResult();
+
     // Save map using DarkRadiant command if there are any pending modifications.
     void saveMapIfNeeded();
     // Callback called on map saving, loading and unloading.
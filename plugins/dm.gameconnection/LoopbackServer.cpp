@@ -0,0 +1,337 @@
+#include "LoopbackServer.h"
+#include "AutomationEngine.h"
+#include "MessageTcp.h"
+#include "DiffStatus.h"
+#include "DiffDoom3MapWriter.h"
+#include "DiffBinaryMapWriter.h"
+
+#include "inode.h"
+#include "ientity.h"
+#include "iscenegraph.h"
+#include "itextstream.h"
+#include "clsocket/ActiveSocket.h"
+#include "clsocket/PassiveSocket.h"
+
+#include <chrono>
+#include <deque>
+#include <thread>
+#include <cstring>
+#include <algorithm>
+#include <fmt/format.h>
+
+namespace gameconn
+{
+
+namespace
+{
+    const char* const LOOPBACK_HOST = "127.0.0.1";
+
+    //the server spins while idle for this long, then starts sleeping
+    //(sleeping right away would add scheduler latency to every measured round-trip)
+    const std::chrono::milliseconds IDLE_SPIN_TIME(20);
+
+    //same as in GameConnection
+    const std::size_t MAP_DIFF_BATCH_SIZE = 64;
+
+    using Clock = std::chrono::steady_clock;
+
+    inline double millisecondsSince(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    // Extracts value of header line like: name "value"
+    inline std::string findHeader(const std::string& request, const std::string& name) {
+        std::string prefix = name + " \"";
+        auto pos = request.find(prefix);
+        if (pos == std::string::npos)
+            return "";
+        pos += prefix.size();
+        auto end = request.find('"', pos);
+        return end == std::string::npos ? "" : request.substr(pos, end - pos);
+    }
+
+    // Produces response content for given request (without "response N" preamble), like the game would do.
+    std::string composeResponse(const std::string& request) {
+        static const std::string CONTENT_MARKER = "content:\n";
+        auto contentPos = request.find(CONTENT_MARKER);
+        const char* content = request.data() + request.size();
+        if (contentPos != std::string::npos)
+            content = request.data() + contentPos + CONTENT_MARKER.size();
+        std::size_t contentSize = request.data() + request.size() - content;
+
+        std::string action = findHeader(request, "action");
+        if (action == binarydiff::ACTION_NAME) {
+            std::vector<binarydiff::EntityRecord> records;
+            bool ok = binarydiff::decode(content, contentSize, records);
+            return ok ? "HotReload: SUCCESS\n" : "HotReload: FAILED\n";
+        }
+        if (action == "reloadmap-diff") {
+            //count entity records, which is what tokenizing the diff amounts to
+            std::size_t numEntities = 0;
+            for (const char* ptr = content; (ptr = strstr(ptr, " entity\n")) != nullptr; ptr++)
+                numEntities++;
+            return numEntities > 0 ? "HotReload: SUCCESS\n" : "HotReload: FAILED\n";
+        }
+        if (findHeader(request, "query") == "status") {
+            return fmt::format("{} text {}\n", binarydiff::STATUS_FORMATS_KEY, binarydiff::FORMAT_NAME);
+        }
+        return "";
+    }
+}
+
+LoopbackServer::~LoopbackServer()
+{
+    stop();
+}
+
+bool LoopbackServer::start(int port)
+{
+    stop();
+
+    auto listener = std::make_shared<CPassiveSocket>();
+    if (
+        !listener->Initialize() ||
+        !listener->SetOptionReuseAddr() ||
+        !listener->Listen(LOOPBACK_HOST, port) ||
+        !listener->SetNonblocking())
+    {
+        return false;
+    }
+
+    _stopRequested = false;
+    _numRequests = 0;
+    _worker = std::async(std::launch::async, [this, listener]() { run(listener); });
+
+    return true;
+}
+
+void LoopbackServer::stop()
+{
+    if (!_worker.valid())
+        return;
+
+    _stopRequested = true;
+    _worker.get();
+}
+
+std::size_t LoopbackServer::getNumRequests() const
+{
+    return _numRequests;
+}
+
+void LoopbackServer::setResponseDelay(int milliseconds)
+{
+    _responseDelay = milliseconds;
+}
+
+void LoopbackServer::run(std::shared_ptr<CPassiveSocket> listener)
+{
+    MessageTcp connection;
+    std::vector<char> message;
+    auto lastActivity = Clock::now();
+
+    //responses held back by response delay (in order of due time)
+    std::deque<std::pair<Clock::time_point, std::string>> delayedResponses;
+
+    while (!_stopRequested) {
+        bool active = false;
+
+        if (!connection.isAlive()) {
+            if (CActiveSocket* client = listener->Accept()) {
+                std::unique_ptr<CActiveSocket> socket(client);
+                socket->SetNonblocking();
+                socket->DisableNagleAlgoritm();
+                connection.init(std::move(socket));
+                active = true;
+            }
+        }
+        else {
+            connection.think();
+
+            while (connection.readMessage(message)) {
+                int seqno, lineLen;
+                if (sscanf(message.data(), "seqno %d\n%n", &seqno, &lineLen) != 1)
+                    continue;
+
+                std::string request(message.begin() + lineLen, message.end());
+                std::string response = fmt::format("response {}\n", seqno) + composeResponse(request);
+                auto dueTime = Clock::now() + std::chrono::milliseconds(_responseDelay);
+                delayedResponses.emplace_back(dueTime, std::move(response));
+                active = true;
+            }
+
+            while (!delayedResponses.empty() && delayedResponses.front().first <= Clock::now()) {
+                const std::string& response = delayedResponses.front().second;
+                connection.writeMessage(response.data(), (int)response.size());
+                delayedResponses.pop_front();
+                _numRequests++;
+                active = true;
+            }
+        }
+
+        if (active) {
+            lastActivity = Clock::now();
+        }
+        else if (Clock::now() - lastActivity < IDLE_SPIN_TIME) {
+            std::this_thread::yield();
+        }
+        else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+namespace
+{
+    const int BENCHMARK_TAG = 0;
+
+    void benchmarkCameraUpdates(AutomationEngine& engine, int iterations)
+    {
+        std::string cameraRequest =
+            "message \"action\"\naction \"conexec\"\ncontent:\n"
+            "setviewpos  100.000 200.000 300.000  -10.000 90.000 0.000\n";
+
+        //camera updates sent one by one, waiting for response each time
+        std::vector<double> latencies;
+        for (int i = 0; i < iterations; i++) {
+            auto start = Clock::now();
+            engine.executeRequestBlocking(BENCHMARK_TAG, cameraRequest);
+            latencies.push_back(millisecondsSince(start));
+        }
+        std::sort(latencies.begin(), latencies.end());
+        rMessage() << fmt::format(
+            "GameConnection benchmark: camera round-trip median {:.3f} ms, p95 {:.3f} ms, max {:.3f} ms ({} requests)",
+            latencies[latencies.size() / 2], latencies[latencies.size() * 95 / 100], latencies.back(), iterations
+        ) << std::endl;
+
+        //same amount of camera updates pipelined
+        auto start = Clock::now();
+        engine.executeRequestsPipelined(BENCHMARK_TAG, std::vector<std::string>(iterations, cameraRequest));
+        double pipelinedTime = millisecondsSince(start);
+        rMessage() << fmt::format(
+            "GameConnection benchmark: pipelined camera updates {:.0f} requests/s",
+            iterations / std::max(pipelinedTime, 1e-3) * 1000.0
+        ) << std::endl;
+    }
+
+    void benchmarkMapDiff(AutomationEngine& engine)
+    {
+        //pretend that all entities of the map have been modified
+        DiffEntityStatuses statuses;
+        GlobalSceneGraph().root()->foreachNode([&](const scene::INodePtr& node) {
+            if (Entity* entity = Node_getEntity(node)) {
+                if (!entity->isWorldspawn())
+                    statuses[node->name()] = DiffStatus::modified();
+            }
+            return true;
+        });
+
+        if (statuses.empty()) {
+            rMessage() << "GameConnection benchmark: map has no entities, skipping map diff measurements" << std::endl;
+            return;
+        }
+
+        struct Format {
+            const char* name;
+            const char* action;
+            std::function<std::string(const DiffEntityStatuses&)> save;
+        };
+        Format formats[] = {
+            {"text", "reloadmap-diff", saveMapDiff},
+            {"binary", binarydiff::ACTION_NAME, saveBinaryMapDiff},
+        };
+
+        for (const Format& format : formats) {
+            std::string preamble = fmt::format("message \"action\"\naction \"{}\"\ncontent:\n", format.action);
+
+            //whole diff in one message
+            auto start = Clock::now();
+            std::string request = preamble + format.save(statuses);
+            double saveTime = millisecondsSince(start);
+            start = Clock::now();
+            engine.executeRequestBlocking(BENCHMARK_TAG, request);
+            double singleTime = millisecondsSince(start);
+
+            //diff split into batches which are all sent at once
+            start = Clock::now();
+            std::vector<std::string> batchRequests;
+            for (const auto& batch : splitDiffEntityStatuses(statuses, MAP_DIFF_BATCH_SIZE))
+                batchRequests.push_back(preamble + format.save(batch));
+            engine.executeRequestsPipelined(BENCHMARK_TAG, batchRequests);
+            double batchedTime = millisecondsSince(start);
+
+            rMessage() << fmt::format(
+                "GameConnection benchmark: {} diff of {} entities: {} bytes, "
+                "serialized in {:.2f} ms, single round-trip {:.2f} ms, {} pipelined batches {:.2f} ms total",
+                format.name, statuses.size(), request.size(), saveTime, singleTime, batchRequests.size(), batchedTime
+            ) << std::endl;
+        }
+    }
+
+    void benchmarkSlowServer(LoopbackServer& server, AutomationEngine& engine)
+    {
+        //the game can take a long time to respond (e.g. while reloading map)
+        //measure how long the calling (UI) thread is blocked meanwhile
+        const int SLOW_RESPONSE_DELAY = 200;
+        const std::chrono::milliseconds FRAME_TIME(16);
+        server.setResponseDelay(SLOW_RESPONSE_DELAY);
+
+        std::string request = "message \"action\"\naction \"conexec\"\ncontent:\nreloadMap nocheck\n";
+
+        auto start = Clock::now();
+        engine.executeRequestBlocking(BENCHMARK_TAG, request);
+        double blockingStall = millisecondsSince(start);
+
+        //simulate UI loop: think once per frame until response arrives
+        start = Clock::now();
+        auto future = engine.executeRequestFuture(BENCHMARK_TAG, request);
+        double maxStall = millisecondsSince(start);
+        int frames = 0;
+        while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            std::this_thread::sleep_for(FRAME_TIME);
+            auto frameStart = Clock::now();
+            engine.think();
+            maxStall = std::max(maxStall, millisecondsSince(frameStart));
+            frames++;
+        }
+        future.get();
+        engine.think();
+
+        server.setResponseDelay(0);
+
+        rMessage() << fmt::format(
+            "GameConnection benchmark: with {} ms server delay, blocking request stalls UI for {:.1f} ms, "
+            "future-based request for at most {:.3f} ms per frame ({} frames until response)",
+            SLOW_RESPONSE_DELAY, blockingStall, maxStall, frames
+        ) << std::endl;
+    }
+}
+
+void runLoopbackBenchmark(int port, int iterations)
+{
+    LoopbackServer server;
+    if (!server.start(port)) {
+        rError() << fmt::format("GameConnection benchmark: cannot listen on port {}", port) << std::endl;
+        return;
+    }
+
+    AutomationEngine engine;
+    if (!engine.connect(LOOPBACK_HOST, port)) {
+        rError() << "GameConnection benchmark: cannot connect to loopback server" << std::endl;
+        return;
+    }
+
+    try {
+        benchmarkCameraUpdates(engine, std::max(iterations, 1));
+        benchmarkMapDiff(engine);
+        benchmarkSlowServer(server, engine);
+    }
+    catch (const DisconnectException&) {
+        rError() << "GameConnection benchmark: loopback connection lost" << std::endl;
+    }
+
+    engine.disconnect(true);
+    server.stop();
+}
+
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <future>
+#include <memory>
+
+class CPassiveSocket;
+
+namespace gameconn
+{
+
+/**
+ * Stand-in for TheDarkMod automation, listening on the loopback interface.
+ * It speaks the same framed protocol as the game and answers every request
+ * immediately: map diffs are parsed (like the game would do), everything else
+ * gets an empty response. The status query advertises binary diff support.
+ *
+ * Used to measure round-trip latency and throughput of the protocol
+ * without running the game, see runLoopbackBenchmark.
+ */
+class LoopbackServer
+{
+public:
+    ~LoopbackServer();
+
+    // Start listening on given port and serving on a worker thread.
+    // Returns false if port cannot be bound.
+    bool start(int port);
+    // Close connection and wait for the worker thread to finish.
+    void stop();
+
+    // Total number of requests answered so far.
+    std::size_t getNumRequests() const;
+
+    // Hold every response back for the given time, like a slow or busy game would do.
+    // Applies to requests received after the call.
+    void setResponseDelay(int milliseconds);
+
+private:
+    void run(std::shared_ptr<CPassiveSocket> listener);
+
+    std::future<void> _worker;
+    std::atomic<bool> _stopRequested{ false };
+    std::atomic<std::size_t> _numRequests{ 0 };
+    std::atomic<int> _responseDelay{ 0 };
+};
+
+// Starts LoopbackServer on given port, connects to it and measures latency
+// of camera updates and throughput of map diffs (plaintext vs binary, single vs pipelined batches)
+// using all entities of the current map. Also measures how long the calling (UI) thread is blocked
+// by blocking and future-based requests when the server is slow. Results are printed to console.
+void runLoopbackBenchmark(int port, int iterations);
+
+}
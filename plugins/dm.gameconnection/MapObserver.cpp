@@ -151,6 +151,11 @@ void MapObserver::clear() {
     _entityChanges.clear();
 }
 
+void MapObserver::clear(const DiffEntityStatuses& appliedChanges) {
+    for (const auto& pNS : appliedChanges)
+        _entityChanges.erase(pNS.first);
+}
+
 MapObserver::~MapObserver() {
     setEnabled(false);
 }
@@ -27,6 +27,9 @@ public:
     //consider all pending changed "applied" right now
     //(clears list of pending changes)
     void clear();
+    //consider only the given changes "applied"
+    //(removes them from the list of pending changes)
+    void clear(const DiffEntityStatuses& appliedChanges);
 
     //returns pending entity change since last clear (or since enabled)
     const DiffEntityStatuses& getChanges() const;
@@ -0,0 +1,127 @@
+#include "MessagePump.h"
+#include "MessageTcp.h"
+#include "clsocket/ActiveSocket.h"
+
+#include <map>
+#include <chrono>
+#include <thread>
+#include <cstdio>
+
+namespace gameconn
+{
+
+namespace
+{
+    //the I/O thread spins while idle for this long, then starts sleeping
+    //(sleeping right away would add scheduler latency to every request)
+    const std::chrono::milliseconds IDLE_SPIN_TIME(20);
+    const std::chrono::milliseconds IDLE_SLEEP_TIME(1);
+}
+
+MessagePump::MessagePump(std::unique_ptr<CActiveSocket>&& connection) :
+    _tcp(new MessageTcp())
+{
+    _tcp->init(std::move(connection));
+    _alive = _tcp->isAlive();
+    _worker = std::async(std::launch::async, [this]() { run(); });
+}
+
+MessagePump::~MessagePump()
+{
+    _stopRequested = true;
+    //I/O thread calls handlers of all pending messages before it finishes
+    _worker.get();
+}
+
+void MessagePump::writeMessage(std::string message, int seqno, ResponseHandler handler)
+{
+    {
+        std::lock_guard<std::mutex> lock(_aliveLock);
+        if (_alive) {
+            Outgoing item;
+            item.message = std::move(message);
+            item.seqno = seqno;
+            item.handler = std::move(handler);
+            _outgoing.push(std::move(item));
+            return;
+        }
+    }
+
+    //I/O thread won't pick it up anymore
+    if (handler)
+        handler(nullptr);
+}
+
+bool MessagePump::readMessage(std::string& message)
+{
+    return _incoming.pop(message);
+}
+
+bool MessagePump::isAlive() const
+{
+    return _alive;
+}
+
+void MessagePump::run()
+{
+    //handlers of requests waiting for response
+    std::map<int, ResponseHandler> handlers;
+    std::vector<char> messageBytes;
+    auto lastActivity = std::chrono::steady_clock::now();
+
+    while (!_stopRequested && _tcp->isAlive()) {
+        bool active = false;
+
+        Outgoing item;
+        while (_outgoing.pop(item)) {
+            if (item.handler)
+                handlers[item.seqno] = std::move(item.handler);
+            _tcp->writeMessage(item.message.data(), (int)item.message.size());
+            active = true;
+        }
+
+        _tcp->think();
+
+        while (_tcp->readMessage(messageBytes)) {
+            std::string message(messageBytes.begin(), messageBytes.end());
+
+            int responseSeqno, lineLen;
+            if (sscanf(message.c_str(), "response %d\n%n", &responseSeqno, &lineLen) == 1) {
+                auto it = handlers.find(responseSeqno);
+                if (it != handlers.end()) {
+                    std::string response = message.substr(lineLen);
+                    it->second(&response);
+                    handlers.erase(it);
+                }
+            }
+
+            _incoming.push(std::move(message));
+            active = true;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (active)
+            lastActivity = now;
+        else if (now - lastActivity < IDLE_SPIN_TIME)
+            std::this_thread::yield();
+        else
+            std::this_thread::sleep_for(IDLE_SLEEP_TIME);
+    }
+
+    {
+        //after this point, writeMessage no longer pushes to _outgoing
+        std::lock_guard<std::mutex> lock(_aliveLock);
+        _alive = false;
+    }
+
+    //no response is going to arrive anymore
+    for (auto& pSH : handlers)
+        pSH.second(nullptr);
+    Outgoing item;
+    while (_outgoing.pop(item)) {
+        if (item.handler)
+            item.handler(nullptr);
+    }
+}
+
+}
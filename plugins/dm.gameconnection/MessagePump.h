@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <future>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "SpscQueue.h"
+
+class CActiveSocket;
+
+namespace gameconn {
+
+class MessageTcp;
+
+/**
+ * Runs framed TCP connection (MessageTcp) on a dedicated I/O thread.
+ * The owning thread exchanges whole messages with it via lock-free queues,
+ * so it never touches the socket and is never blocked by a slow or stalled game.
+ * Note: all methods must be called from the same (owning) thread.
+ */
+class MessagePump {
+public:
+    // Called on I/O thread when response to a request arrives.
+    // Receives nullptr if connection is lost before that.
+    using ResponseHandler = std::function<void(const std::string* response)>;
+
+    MessagePump(std::unique_ptr<CActiveSocket>&& connection);
+    // Stops I/O thread, unsent messages are dropped.
+    ~MessagePump();
+
+    // Queue message for sending.
+    // If handler is set, it is called on I/O thread with the content of response
+    // which starts with the given seqno (see AutomationEngine for message format).
+    void writeMessage(std::string message, int seqno = 0, ResponseHandler handler = {});
+    // Fetch next received message, returns false if there is none.
+    bool readMessage(std::string& message);
+
+    // Returns false once connection has been closed or broken.
+    bool isAlive() const;
+
+private:
+    void run();
+
+    struct Outgoing {
+        std::string message;
+        int seqno = 0;
+        ResponseHandler handler;
+    };
+
+    // Owning thread -> I/O thread
+    SpscQueue<Outgoing> _outgoing;
+    // I/O thread -> owning thread
+    SpscQueue<std::string> _incoming;
+
+    // Accessed by I/O thread only (after construction).
+    std::unique_ptr<MessageTcp> _tcp;
+
+    // Set to false by I/O thread once it has stopped consuming _outgoing.
+    // Checked and cleared under _aliveLock, so that no message can be pushed
+    // after the final drain (its handler would never be called otherwise).
+    std::atomic<bool> _alive{ true };
+    std::mutex _aliveLock;
+    std::atomic<bool> _stopRequested{ false };
+    std::future<void> _worker;
+};
+
+}
@@ -105,7 +105,8 @@ void MessageTcp::writeMessage(const char *message, int len) {
 void MessageTcp::think() {
     if (!tcp)
         return;
-    static const int BUFFER_SIZE = 1024;
+    //large enough to receive/send a batch of map diff in few system calls
+    static const int BUFFER_SIZE = 16 * 1024;
 
     //if data in buffer is too far from start, then it is moved to the beginning
     auto compactBuffer = [](std::vector<char>& vec, std::size_t& pos) -> void {
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+namespace gameconn
+{
+
+/**
+ * Unbounded lock-free queue for exactly one producer thread and one consumer thread.
+ * Implemented as a singly-linked list with a dummy head node:
+ * producer only touches the tail, consumer only touches the head,
+ * the only shared state is the "next" pointer of the last node.
+ */
+template<typename T>
+class SpscQueue
+{
+    struct Node {
+        std::atomic<Node*> next{ nullptr };
+        T value;
+    };
+
+    // Dummy node, the values start from its successor (consumer-owned)
+    Node* _head;
+    // Last node in the list (producer-owned)
+    Node* _tail;
+
+public:
+    SpscQueue() {
+        _head = _tail = new Node();
+    }
+    ~SpscQueue() {
+        while (_head) {
+            Node* next = _head->next.load(std::memory_order_relaxed);
+            delete _head;
+            _head = next;
+        }
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Called by producer thread only.
+    void push(T value) {
+        Node* node = new Node();
+        node->value = std::move(value);
+        //publish fully constructed node to consumer
+        _tail->next.store(node, std::memory_order_release);
+        _tail = node;
+    }
+
+    // Called by consumer thread only.
+    // Returns false if queue is empty.
+    bool pop(T& value) {
+        Node* next = _head->next.load(std::memory_order_acquire);
+        if (!next)
+            return false;
+        value = std::move(next->value);
+        //successor becomes new dummy node
+        delete _head;
+        _head = next;
+        return true;
+    }
+};
+
+}
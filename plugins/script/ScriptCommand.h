@@ -24,10 +24,16 @@ private:
 	// The script file name to execute (relative to scripts/ folder)
 	std::string _scriptFilename;
 
+	// Execution mode as declared by the script
+	bool _runsInBackground;
+	bool _isReadOnly;
+
 public:
 	ScriptCommand(const std::string& name,
 				  const std::string& displayName,
-				  const std::string& scriptFilename);
+				  const std::string& scriptFilename,
+				  bool runsInBackground = false,
+				  bool isReadOnly = false);
 
 	virtual ~ScriptCommand();
 
@@ -45,6 +51,18 @@ public:
     {
 		return _displayName;
 	}
+
+	// True if the script declared __commandRunsInBackground__
+	bool runsInBackground() const
+	{
+		return _runsInBackground;
+	}
+
+	// True if the script declared __commandIsReadOnly__, it doesn't modify the scene
+	bool isReadOnly() const
+	{
+		return _isReadOnly;
+	}
 };
 typedef std::shared_ptr<ScriptCommand> ScriptCommandPtr;
 
@@ -0,0 +1,246 @@
+#include "ScriptTask.h"
+
+#include <mutex>
+#include "itextstream.h"
+#include "iradiant.h"
+#include "iundo.h"
+#include "messages/LongRunningOperationMessage.h"
+
+namespace script
+{
+
+namespace
+{
+	// The task being run, there can only be one at a time
+	std::atomic<ScriptTask*> _currentTask(nullptr);
+
+	// Minimum interval between two progress updates sent to the UI thread
+	constexpr std::chrono::milliseconds ProgressUpdateInterval(50);
+
+	// Interval to check for cancellation while waiting for the UI thread
+	constexpr std::chrono::milliseconds CancellationCheckInterval(50);
+
+	// A batch of scene changes, handed over to the UI thread
+	struct SceneBatch
+	{
+		std::mutex lock;
+
+		// Set by the UI thread when it starts executing the batch
+		bool started = false;
+
+		// Set by the worker if the task got cancelled before the batch has been started
+		bool abandoned = false;
+
+		std::promise<void> done;
+	};
+}
+
+ScriptTask::ScriptTask(const std::string& name, bool readOnly, const std::function<void()>& body,
+	const Dispatcher& dispatcher) :
+	_name(name),
+	_readOnly(readOnly),
+	_body(body),
+	_dispatcher(dispatcher),
+	_cancelled(std::make_shared<std::atomic<bool>>(false)),
+	_finished(false),
+	_started(false)
+{}
+
+ScriptTask::~ScriptTask()
+{
+	if (_started)
+	{
+		cancel();
+		wait();
+	}
+}
+
+const std::string& ScriptTask::getName() const
+{
+	return _name;
+}
+
+bool ScriptTask::isReadOnly() const
+{
+	return _readOnly;
+}
+
+void ScriptTask::start(const std::function<void()>& onFinished)
+{
+	ScriptTask* expected = nullptr;
+
+	if (_started || !_currentTask.compare_exchange_strong(expected, this))
+	{
+		rError() << "Cannot run script task " << _name << ", another one is running" << std::endl;
+		return;
+	}
+
+	_started = true;
+
+	// Block any user input until the task is done, but keep the views rendering
+	radiant::LongRunningOperationMessage started(radiant::OperationEvent::Started, _name);
+	started.setBlocksScreenUpdates(false);
+	GlobalRadiantCore().getMessageBus().sendMessage(started);
+
+	if (!_readOnly)
+	{
+		// All batches of the script end up in a single undo step
+		_undoCommand = std::make_unique<UndoableCommand>("runScript " + _name);
+	}
+
+	_worker = std::async(std::launch::async, &ScriptTask::run, this, onFinished);
+}
+
+void ScriptTask::cancel()
+{
+	*_cancelled = true;
+}
+
+bool ScriptTask::isCancelled() const
+{
+	return *_cancelled;
+}
+
+bool ScriptTask::isFinished() const
+{
+	return _finished;
+}
+
+void ScriptTask::wait()
+{
+	if (!_started) return;
+
+	_worker.get();
+
+	_undoCommand.reset();
+
+	radiant::LongRunningOperationMessage finished(radiant::OperationEvent::Finished);
+	GlobalRadiantCore().getMessageBus().sendMessage(finished);
+
+	_started = false;
+	_currentTask = nullptr;
+}
+
+void ScriptTask::setProgress(float fraction, const std::string& text)
+{
+	throwIfCancelled();
+
+	auto now = std::chrono::steady_clock::now();
+
+	// Don't flood the UI thread with progress updates
+	if (now - _lastProgressUpdate < ProgressUpdateInterval)
+	{
+		return;
+	}
+
+	_lastProgressUpdate = now;
+
+	// The task might be gone by the time the UI thread gets to this, only the flag is shared
+	auto cancelled = _cancelled;
+
+	_dispatcher([fraction, text, cancelled]()
+	{
+		radiant::LongRunningOperationMessage progress(radiant::OperationEvent::Progress, text, fraction);
+		GlobalRadiantCore().getMessageBus().sendMessage(progress);
+
+		// The cancel button of the progress dialog has been hit
+		if (progress.isCancellationRequested())
+		{
+			*cancelled = true;
+		}
+	});
+}
+
+void ScriptTask::modifyScene(const std::function<void()>& batch)
+{
+	if (_readOnly)
+	{
+		throw std::logic_error("Read-only script tasks must not modify the scene");
+	}
+
+	throwIfCancelled();
+
+	auto state = std::make_shared<SceneBatch>();
+	auto done = state->done.get_future();
+
+	_dispatcher([state, batch]()
+	{
+		{
+			std::lock_guard<std::mutex> lock(state->lock);
+
+			if (state->abandoned) return;
+
+			state->started = true;
+		}
+
+		try
+		{
+			batch();
+			state->done.set_value();
+		}
+		catch (...)
+		{
+			state->done.set_exception(std::current_exception());
+		}
+	});
+
+	while (done.wait_for(CancellationCheckInterval) != std::future_status::ready)
+	{
+		if (!*_cancelled) continue;
+
+		std::lock_guard<std::mutex> lock(state->lock);
+
+		// Don't wait for a UI thread which is not going to execute the batch anymore (e.g. on shutdown),
+		// a batch that has already been started is waited for
+		if (!state->started)
+		{
+			state->abandoned = true;
+			throw Cancelled();
+		}
+	}
+
+	// Re-throws the exception of the batch, if any
+	done.get();
+
+	throwIfCancelled();
+}
+
+ScriptTask* ScriptTask::GetCurrent()
+{
+	return _currentTask;
+}
+
+void ScriptTask::run(const std::function<void()>& onFinished)
+{
+	try
+	{
+		_body();
+	}
+	catch (const Cancelled&)
+	{
+		// Reported below
+	}
+	catch (const std::exception& ex)
+	{
+		rError() << "Error while executing script " << _name << ": " << ex.what() << std::endl;
+	}
+
+	if (*_cancelled)
+	{
+		rMessage() << "Script " << _name << " has been cancelled" << std::endl;
+	}
+
+	_finished = true;
+
+	_dispatcher(onFinished);
+}
+
+void ScriptTask::throwIfCancelled()
+{
+	if (*_cancelled)
+	{
+		throw Cancelled();
+	}
+}
+
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <string>
+#include <memory>
+#include <future>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <stdexcept>
+
+class UndoableCommand;
+
+namespace script
+{
+
+/**
+ * A long-running script, executed in a worker thread. The task is started
+ * and finished on the UI thread, which keeps processing its events (and
+ * rendering the views) while the script is running.
+ *
+ * A LongRunningOperationMessage blocks any user input for the duration of
+ * the task, the views are kept rendering. The worker thread is only reading
+ * from the scene: changes need to be put into batches passed to modifyScene(),
+ * which are executed on the UI thread while the worker is waiting for them.
+ * The UI thread can't render in the middle of a batch. Read-only tasks
+ * are not allowed to modify the scene at all, the batches of modifying tasks
+ * end up in a single undo step.
+ *
+ * Progress is reported through setProgress(), which forwards the information
+ * to the UI thread. Cancellation is cooperative: setProgress() and modifyScene()
+ * throw a Cancelled exception once the task has been cancelled, either through
+ * cancel() or by the progress dialog's cancel button.
+ *
+ * This class doesn't know about Python: the body is responsible for acquiring
+ * the interpreter lock, the script interface translates the exceptions.
+ */
+class ScriptTask final
+{
+public:
+	// Runs the given functor on the UI thread, at some later point
+	using Dispatcher = std::function<void(const std::function<void()>&)>;
+
+	// Thrown into the body by setProgress() and modifyScene() once the task has been cancelled
+	class Cancelled :
+		public std::runtime_error
+	{
+	public:
+		Cancelled() :
+			std::runtime_error("Script task has been cancelled")
+		{}
+	};
+
+private:
+	std::string _name;
+	bool _readOnly;
+	std::function<void()> _body;
+	Dispatcher _dispatcher;
+
+	// Shared with the progress updates dispatched to the UI thread
+	std::shared_ptr<std::atomic<bool>> _cancelled;
+	std::atomic<bool> _finished;
+	bool _started;
+
+	// Accessed by the worker thread only
+	std::chrono::steady_clock::time_point _lastProgressUpdate;
+
+	// The undo step collecting the batches of modifying tasks, accessed by the UI thread only
+	std::unique_ptr<UndoableCommand> _undoCommand;
+
+	std::future<void> _worker;
+
+public:
+	using Ptr = std::shared_ptr<ScriptTask>;
+
+	// The body is invoked in the worker thread, the dispatcher is used
+	// to send progress updates and scene batches to the UI thread
+	ScriptTask(const std::string& name, bool readOnly, const std::function<void()>& body,
+		const Dispatcher& dispatcher);
+
+	ScriptTask(const ScriptTask& other) = delete;
+	ScriptTask& operator=(const ScriptTask& other) = delete;
+
+	// Cancels the task and waits for the worker to complete
+	~ScriptTask();
+
+	const std::string& getName() const;
+	bool isReadOnly() const;
+
+	// Starts the worker thread, to be called on the UI thread. Only one task can run at a time.
+	// The given functor is dispatched to the UI thread once the body is done, it should call wait().
+	void start(const std::function<void()>& onFinished);
+
+	// Requests cancellation of this task, can be called from any thread
+	void cancel();
+	bool isCancelled() const;
+
+	// True once the body has been completed
+	bool isFinished() const;
+
+	// Blocks until the worker thread has been completed and finishes the undo step.
+	// To be called on the UI thread.
+	void wait();
+
+	// Reports the progress of this task (fraction in [0..1], negative if unknown)
+	// to the UI thread, without waiting for it. Throws Cancelled if the task has been cancelled.
+	void setProgress(float fraction, const std::string& text);
+
+	// Runs the given batch of scene changes on the UI thread and waits for it to complete.
+	// Exceptions thrown by the batch are re-thrown in the calling thread. Throws
+	// Cancelled if the task has been cancelled, and std::logic_error for read-only tasks.
+	void modifyScene(const std::function<void()>& batch);
+
+	// Returns the task being run, or nullptr if there is none
+	static ScriptTask* GetCurrent();
+
+private:
+	void run(const std::function<void()>& onFinished);
+	void throwIfCancelled();
+};
+
+}
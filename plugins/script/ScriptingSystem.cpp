@@ -9,12 +9,15 @@
 #include "iradiant.h"
 #include "ui/imainframe.h"
 #include "ui/igroupdialog.h"
+#include "ui/iuserinterface.h"
 #include "iundo.h"
 
 #include "interfaces/MathInterface.h"
 #include "interfaces/RegistryInterface.h"
 #include "interfaces/RadiantInterface.h"
 #include "interfaces/SceneGraphInterface.h"
+#include "interfaces/BulkAccessInterface.h"
+#include "interfaces/ScriptTaskInterface.h"
 #include "interfaces/EClassInterface.h"
 #include "interfaces/SelectionInterface.h"
 #include "interfaces/BrushInterface.h"
@@ -34,6 +37,7 @@
 #include "interfaces/SelectionGroupInterface.h"
 #include "interfaces/CameraInterface.h"
 #include "interfaces/LayerInterface.h"
+#include "interfaces/MemoryAccountingInterface.h"
 
 #include "PythonModule.h"
 
@@ -59,9 +63,72 @@ void ScriptingSystem::addInterface(const std::string& name, const IScriptInterfa
 
 void ScriptingSystem::executeScriptFile(const std::string& filename)
 {
+	if (isBlockedByBackgroundTask()) return;
+
 	executeScriptFile(filename, false);
 }
 
+void ScriptingSystem::executeScriptFileInBackground(const std::string& filename, bool readOnly)
+{
+	executeScriptFileInBackground(filename, readOnly, false);
+}
+
+void ScriptingSystem::executeScriptFileInBackground(const std::string& filename, bool readOnly, bool setExecuteCommandAttr)
+{
+	if (isBlockedByBackgroundTask()) return;
+
+	// The task takes care of the undo step of modifying scripts
+	_backgroundTask = std::make_shared<ScriptTask>(filename, readOnly, [=]()
+	{
+		py::gil_scoped_acquire acquire;
+		executeScriptFile(filename, setExecuteCommandAttr);
+	},
+	[](const std::function<void()>& functor)
+	{
+		GlobalUserInterface().dispatch(functor);
+	});
+
+	// The worker thread needs the interpreter
+	_interpreterRelease = std::make_unique<py::gil_scoped_release>();
+
+	auto task = _backgroundTask.get();
+
+	_backgroundTask->start([this, task]()
+	{
+		// Ignore stale notifications, the task might have been finished by the shutdown
+		if (_backgroundTask.get() == task && _backgroundTask->isFinished())
+		{
+			finishBackgroundTask();
+		}
+	});
+
+	if (ScriptTask::GetCurrent() != task)
+	{
+		// The task refused to start
+		_interpreterRelease.reset();
+		_backgroundTask.reset();
+	}
+}
+
+void ScriptingSystem::finishBackgroundTask()
+{
+	if (!_backgroundTask) return;
+
+	_backgroundTask->wait();
+	_backgroundTask.reset();
+
+	_interpreterRelease.reset();
+}
+
+bool ScriptingSystem::isBlockedByBackgroundTask()
+{
+	if (!_backgroundTask) return false;
+
+	rError() << "Cannot execute scripts while " << _backgroundTask->getName() <<
+		" is running in the background" << std::endl;
+	return true;
+}
+
 void ScriptingSystem::executeScriptFile(const std::string& filename, bool setExecuteCommandAttr)
 {
 	try
@@ -99,6 +166,14 @@ void ScriptingSystem::executeScriptFile(const std::string& filename, bool setExe
 
 ExecutionResultPtr ScriptingSystem::executeString(const std::string& scriptString)
 {
+    if (isBlockedByBackgroundTask())
+    {
+        auto result = std::make_shared<ExecutionResult>();
+        result->errorOccurred = true;
+        result->output = _("A script is running in the background, please wait or cancel it.") + std::string("\n");
+        return result;
+    }
+
     return _pythonModule->executeString(scriptString);
 }
 
@@ -145,8 +220,18 @@ void ScriptingSystem::runScriptCommand(const cmd::ArgumentList& args)
 	executeCommand(args[0].getString());
 }
 
+void ScriptingSystem::runScriptFileInBackground(const cmd::ArgumentList& args)
+{
+	if (args.empty()) return;
+
+	// The second argument is the read-only flag
+	executeScriptFileInBackground(args[0].getString(), args.size() > 1 && args[1].getInt() != 0);
+}
+
 void ScriptingSystem::reloadScriptsCmd(const cmd::ArgumentList& args) 
 {
+	if (isBlockedByBackgroundTask()) return;
+
 	reloadScripts();
 }
 
@@ -169,6 +254,14 @@ void ScriptingSystem::executeCommand(const std::string& name)
 		return;
 	}
 
+	if (found->second->runsInBackground())
+	{
+		executeScriptFileInBackground(found->second->getFilename(), found->second->isReadOnly(), true);
+		return;
+	}
+
+	if (isBlockedByBackgroundTask()) return;
+
     UndoableCommand cmd("runScriptCommand " + name);
 
 	// Execute the script file behind this command
@@ -190,6 +283,8 @@ void ScriptingSystem::loadCommandScript(const std::string& scriptFilename)
 
 		std::string cmdName;
 		std::string cmdDisplayName;
+		bool runsInBackground = false;
+		bool isReadOnly = false;
 
 		if (locals.contains("__commandName__"))
 		{
@@ -201,6 +296,16 @@ void ScriptingSystem::loadCommandScript(const std::string& scriptFilename)
 			cmdDisplayName = locals["__commandDisplayName__"].cast<std::string>();
 		}
 
+		if (locals.contains("__commandRunsInBackground__"))
+		{
+			runsInBackground = locals["__commandRunsInBackground__"].cast<bool>();
+		}
+
+		if (locals.contains("__commandIsReadOnly__"))
+		{
+			isReadOnly = locals["__commandIsReadOnly__"].cast<bool>();
+		}
+
 		if (!cmdName.empty())
 		{
 			if (cmdDisplayName.empty())
@@ -209,7 +314,8 @@ void ScriptingSystem::loadCommandScript(const std::string& scriptFilename)
 			}
 
 			// Successfully retrieved the command
-			auto cmd = std::make_shared<ScriptCommand>(cmdName, cmdDisplayName, scriptFilename);
+			auto cmd = std::make_shared<ScriptCommand>(cmdName, cmdDisplayName, scriptFilename,
+				runsInBackground, isReadOnly);
 
 			// Try to register this named command
 			auto result = _commands.insert(std::make_pair(cmdName, cmd));
@@ -328,6 +434,9 @@ void ScriptingSystem::initialiseModule(const IApplicationContext& ctx)
 	addInterface("SelectionGroupInterface", std::make_shared<SelectionGroupInterface>());
 	addInterface("CameraInterface", std::make_shared<CameraInterface>());
 	addInterface("LayerInterface", std::make_shared<LayerInterface>());
+	addInterface("MemoryAccounting", std::make_shared<MemoryAccountingInterface>());
+	addInterface("BulkAccess", std::make_shared<BulkAccessInterface>());
+	addInterface("ScriptTask", std::make_shared<ScriptTaskInterface>());
 
 	GlobalCommandSystem().addCommand(
 		"RunScript",
@@ -335,6 +444,12 @@ void ScriptingSystem::initialiseModule(const IApplicationContext& ctx)
 		{ cmd::ARGTYPE_STRING }
 	);
 
+	GlobalCommandSystem().addCommand(
+		"RunScriptInBackground",
+		std::bind(&ScriptingSystem::runScriptFileInBackground, this, std::placeholders::_1),
+		{ cmd::ARGTYPE_STRING, cmd::ARGTYPE_INT | cmd::ARGTYPE_OPTIONAL }
+	);
+
 	GlobalCommandSystem().addCommand(
 		"ReloadScripts",
 		std::bind(&ScriptingSystem::reloadScriptsCmd, this, std::placeholders::_1)
@@ -357,6 +472,13 @@ void ScriptingSystem::shutdownModule()
 
 	_initialised = false;
 
+	// Stop any running script task at its next progress report or scene batch
+	if (_backgroundTask)
+	{
+		_backgroundTask->cancel();
+		finishBackgroundTask();
+	}
+
 	// Clear the buffer so that nodes finally get destructed
 	SceneNodeBuffer::Instance().clear();
 
@@ -10,6 +10,7 @@
 #include "PythonModule.h"
 
 #include "ScriptCommand.h"
+#include "ScriptTask.h"
 
 namespace script 
 {
@@ -33,6 +34,13 @@ private:
 
 	sigc::signal<void> _sigScriptsReloaded;
 
+	// The script task currently running in its worker thread, if any.
+	// No other scripts can be executed while this is set.
+	ScriptTask::Ptr _backgroundTask;
+
+	// The UI thread lets go of the interpreter while the task is running
+	std::unique_ptr<py::gil_scoped_release> _interpreterRelease;
+
 public:
 	ScriptingSystem();
 
@@ -57,9 +65,16 @@ public:
 	// Runs a named script command (command target)
 	void runScriptCommand(const cmd::ArgumentList& args);
 
+	// Runs a script file as long-running task in a worker thread (command target)
+	void runScriptFileInBackground(const cmd::ArgumentList& args);
+
 	// Executes a script file
 	void executeScriptFile(const std::string& filename) override;
 
+	// Starts executing a script file as long-running task in a worker thread and returns immediately.
+	// A progress dialog can be used to cancel it, the views keep rendering. See ScriptTask for details.
+	void executeScriptFileInBackground(const std::string& filename, bool readOnly);
+
 	// Execute the given python script string
 	ExecutionResultPtr executeString(const std::string& scriptString) override;
 
@@ -78,6 +93,13 @@ public:
 
 private:
 	void executeScriptFile(const std::string& filename, bool setExecuteCommandAttr);
+	void executeScriptFileInBackground(const std::string& filename, bool readOnly, bool setExecuteCommandAttr);
+
+	// Returns true (and emits an error) if there's a script running in the background
+	bool isBlockedByBackgroundTask();
+
+	// Waits for the background task to complete and takes back the interpreter
+	void finishBackgroundTask();
 
 	void reloadScripts();
 
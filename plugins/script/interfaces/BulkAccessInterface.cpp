@@ -0,0 +1,281 @@
+#include "BulkAccessInterface.h"
+
+#include <limits>
+#include <stdexcept>
+#include <pybind11/stl.h>
+
+#include "ientity.h"
+#include "ibrush.h"
+#include "iselection.h"
+#include "iundo.h"
+#include "string/convert.h"
+
+namespace script
+{
+
+namespace
+{
+	// Collects all nodes below (and including) the root matching the given predicate
+	template<typename Predicate>
+	std::vector<scene::INodeWeakPtr> collectNodes(const scene::INodePtr& root, const Predicate& predicate)
+	{
+		std::vector<scene::INodeWeakPtr> nodes;
+
+		if (!root) return nodes;
+
+		if (predicate(root))
+		{
+			nodes.emplace_back(root);
+		}
+
+		root->foreachNode([&](const scene::INodePtr& node)
+		{
+			if (predicate(node))
+			{
+				nodes.emplace_back(node);
+			}
+
+			return true;
+		});
+
+		return nodes;
+	}
+}
+
+ScriptNodeList::ScriptNodeList(std::vector<scene::INodeWeakPtr>&& nodes) :
+	_nodes(std::move(nodes))
+{}
+
+std::size_t ScriptNodeList::size() const
+{
+	return _nodes.size();
+}
+
+ScriptSceneNode ScriptNodeList::getItem(std::size_t index) const
+{
+	if (index >= _nodes.size())
+	{
+		throw py::index_error();
+	}
+
+	return ScriptSceneNode(_nodes[index].lock());
+}
+
+scene::INodePtr ScriptNodeList::lock(std::size_t index) const
+{
+	return _nodes[index].lock();
+}
+
+ScriptNodeList BulkAccessInterface::findEntities(const ScriptSceneNode& root)
+{
+	return ScriptNodeList(collectNodes(root, Node_isEntity));
+}
+
+ScriptNodeList BulkAccessInterface::findBrushes(const ScriptSceneNode& root)
+{
+	return ScriptNodeList(collectNodes(root, Node_isBrush));
+}
+
+ScriptNodeList BulkAccessInterface::getSelection()
+{
+	std::vector<scene::INodeWeakPtr> nodes;
+
+	GlobalSelectionSystem().foreachSelected([&](const scene::INodePtr& node)
+	{
+		nodes.emplace_back(node);
+	});
+
+	return ScriptNodeList(std::move(nodes));
+}
+
+py::array_t<double> BulkAccessInterface::getEntityOrigins(const ScriptNodeList& nodes)
+{
+	py::array_t<double> origins({ nodes.size(), static_cast<std::size_t>(3) });
+	auto data = origins.mutable_unchecked<2>();
+
+	for (std::size_t i = 0; i < nodes.size(); ++i)
+	{
+		auto node = nodes.lock(i);
+		auto* entity = node ? Node_getEntity(node) : nullptr;
+
+		auto origin = entity ?
+			string::convert<Vector3>(entity->getKeyValue("origin")) :
+			Vector3(std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN());
+
+		data(i, 0) = origin.x();
+		data(i, 1) = origin.y();
+		data(i, 2) = origin.z();
+	}
+
+	return origins;
+}
+
+std::vector<std::string> BulkAccessInterface::getKeyValues(const ScriptNodeList& nodes, const std::string& key)
+{
+	std::vector<std::string> values(nodes.size());
+
+	for (std::size_t i = 0; i < nodes.size(); ++i)
+	{
+		auto node = nodes.lock(i);
+		auto* entity = node ? Node_getEntity(node) : nullptr;
+
+		if (entity)
+		{
+			values[i] = entity->getKeyValue(key);
+		}
+	}
+
+	return values;
+}
+
+py::tuple BulkAccessInterface::getFacePlanes(const ScriptNodeList& nodes)
+{
+	std::vector<double> planes;
+	std::vector<std::int32_t> brushIndices;
+
+	for (std::size_t i = 0; i < nodes.size(); ++i)
+	{
+		auto node = nodes.lock(i);
+		auto* brush = node ? Node_getIBrush(node) : nullptr;
+
+		if (!brush) continue;
+
+		for (std::size_t f = 0; f < brush->getNumFaces(); ++f)
+		{
+			const auto& plane = brush->getFace(f).getPlane3();
+
+			planes.insert(planes.end(), { plane.normal().x(), plane.normal().y(), plane.normal().z(), plane.dist() });
+			brushIndices.push_back(static_cast<std::int32_t>(i));
+		}
+	}
+
+	py::array_t<double> planeArray({ brushIndices.size(), static_cast<std::size_t>(4) });
+	std::copy(planes.begin(), planes.end(), planeArray.mutable_data());
+
+	py::array_t<std::int32_t> indexArray(brushIndices.size());
+	std::copy(brushIndices.begin(), brushIndices.end(), indexArray.mutable_data());
+
+	return py::make_tuple(planeArray, indexArray);
+}
+
+py::tuple BulkAccessInterface::getFaceVertices(const ScriptNodeList& nodes)
+{
+	std::vector<double> vertices;
+	std::vector<std::int32_t> faceIndices;
+	std::int32_t faceIndex = 0;
+
+	for (std::size_t i = 0; i < nodes.size(); ++i)
+	{
+		auto node = nodes.lock(i);
+		auto* brush = node ? Node_getIBrush(node) : nullptr;
+
+		if (!brush) continue;
+
+		// Make sure the windings are up to date
+		brush->evaluateBRep();
+
+		for (std::size_t f = 0; f < brush->getNumFaces(); ++f, ++faceIndex)
+		{
+			for (const auto& windingVertex : brush->getFace(f).getWinding())
+			{
+				vertices.insert(vertices.end(), { windingVertex.vertex.x(), windingVertex.vertex.y(), windingVertex.vertex.z() });
+				faceIndices.push_back(faceIndex);
+			}
+		}
+	}
+
+	py::array_t<double> vertexArray({ faceIndices.size(), static_cast<std::size_t>(3) });
+	std::copy(vertices.begin(), vertices.end(), vertexArray.mutable_data());
+
+	py::array_t<std::int32_t> indexArray(faceIndices.size());
+	std::copy(faceIndices.begin(), faceIndices.end(), indexArray.mutable_data());
+
+	return py::make_tuple(vertexArray, indexArray);
+}
+
+void BulkAccessInterface::setEntityOrigins(const ScriptNodeList& nodes,
+	const py::array_t<double, py::array::c_style | py::array::forcecast>& origins)
+{
+	if (origins.ndim() != 2 || origins.shape(0) != static_cast<py::ssize_t>(nodes.size()) || origins.shape(1) != 3)
+	{
+		throw std::invalid_argument("The origins array must have the shape (" + std::to_string(nodes.size()) + ", 3)");
+	}
+
+	auto data = origins.unchecked<2>();
+
+	UndoableCommand cmd("setEntityOrigins");
+
+	for (std::size_t i = 0; i < nodes.size(); ++i)
+	{
+		auto node = nodes.lock(i);
+		auto* entity = node ? Node_getEntity(node) : nullptr;
+
+		if (entity)
+		{
+			entity->setKeyValue("origin", string::to_string(Vector3(data(i, 0), data(i, 1), data(i, 2))));
+		}
+	}
+}
+
+void BulkAccessInterface::setKeyValues(const ScriptNodeList& nodes, const std::string& key, const std::vector<std::string>& values)
+{
+	if (values.size() != nodes.size())
+	{
+		throw std::invalid_argument("Expected " + std::to_string(nodes.size()) + " values");
+	}
+
+	UndoableCommand cmd("setKeyValues");
+
+	for (std::size_t i = 0; i < nodes.size(); ++i)
+	{
+		auto node = nodes.lock(i);
+		auto* entity = node ? Node_getEntity(node) : nullptr;
+
+		if (entity)
+		{
+			entity->setKeyValue(key, values[i]);
+		}
+	}
+}
+
+void BulkAccessInterface::setKeyValue(const ScriptNodeList& nodes, const std::string& key, const std::string& value)
+{
+	UndoableCommand cmd("setKeyValues");
+
+	for (std::size_t i = 0; i < nodes.size(); ++i)
+	{
+		auto node = nodes.lock(i);
+		auto* entity = node ? Node_getEntity(node) : nullptr;
+
+		if (entity)
+		{
+			entity->setKeyValue(key, value);
+		}
+	}
+}
+
+void BulkAccessInterface::registerInterface(py::module& scope, py::dict& globals)
+{
+	// Expose the node list, supporting len(), indexing and iteration
+	py::class_<ScriptNodeList> nodeList(scope, "SceneNodeList");
+	nodeList.def(py::init<>());
+	nodeList.def("__len__", &ScriptNodeList::size);
+	nodeList.def("__getitem__", &ScriptNodeList::getItem);
+
+	py::class_<BulkAccessInterface> bulkAccess(scope, "BulkAccess");
+	bulkAccess.def("findEntities", &BulkAccessInterface::findEntities);
+	bulkAccess.def("findBrushes", &BulkAccessInterface::findBrushes);
+	bulkAccess.def("getSelection", &BulkAccessInterface::getSelection);
+	bulkAccess.def("getEntityOrigins", &BulkAccessInterface::getEntityOrigins);
+	bulkAccess.def("getKeyValues", &BulkAccessInterface::getKeyValues);
+	bulkAccess.def("getFacePlanes", &BulkAccessInterface::getFacePlanes);
+	bulkAccess.def("getFaceVertices", &BulkAccessInterface::getFaceVertices);
+	bulkAccess.def("setEntityOrigins", &BulkAccessInterface::setEntityOrigins);
+	bulkAccess.def("setKeyValues", &BulkAccessInterface::setKeyValues);
+	bulkAccess.def("setKeyValue", &BulkAccessInterface::setKeyValue);
+
+	// Now point the Python variable "GlobalBulkAccess" to this instance
+	globals["GlobalBulkAccess"] = this;
+}
+
+} // namespace script
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <vector>
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+#include "iscript.h"
+#include "iscriptinterface.h"
+#include "inode.h"
+
+#include "SceneGraphInterface.h"
+
+namespace script
+{
+
+// A flat list of scene nodes, passed to Python as a single object.
+// Like ScriptSceneNode, it doesn't keep the nodes alive.
+class ScriptNodeList
+{
+private:
+	std::vector<scene::INodeWeakPtr> _nodes;
+
+public:
+	ScriptNodeList() = default;
+	ScriptNodeList(std::vector<scene::INodeWeakPtr>&& nodes);
+
+	std::size_t size() const;
+
+	// Returns the node at the given index, throws py::index_error if out of range
+	ScriptSceneNode getItem(std::size_t index) const;
+
+	// Returns the node at the given index, or an empty reference if it's been deleted
+	scene::INodePtr lock(std::size_t index) const;
+};
+
+/**
+ * Reads and writes properties of many nodes in a single call.
+ *
+ * All numerical data is returned as NumPy arrays, rows are in
+ * the same order as the nodes in the given ScriptNodeList.
+ * The setters are applied in a single undoable operation.
+ */
+class BulkAccessInterface :
+	public IScriptInterface
+{
+public:
+	// Collects all entities below (and including) the given node
+	ScriptNodeList findEntities(const ScriptSceneNode& root);
+
+	// Collects all brushes below (and including) the given node
+	ScriptNodeList findBrushes(const ScriptSceneNode& root);
+
+	// Returns all currently selected nodes
+	ScriptNodeList getSelection();
+
+	// Returns an (N,3) array with the origin of each entity, NaN for non-entities
+	py::array_t<double> getEntityOrigins(const ScriptNodeList& nodes);
+
+	// Returns the value of the given key of each entity, empty for non-entities
+	std::vector<std::string> getKeyValues(const ScriptNodeList& nodes, const std::string& key);
+
+	// Returns a tuple of an (F,4) array containing the plane (normal, dist) of every brush face,
+	// and an (F,) array containing the index of the brush the face belongs to
+	py::tuple getFacePlanes(const ScriptNodeList& nodes);
+
+	// Returns a tuple of a (V,3) array containing all winding vertices of every brush face,
+	// and a (V,) array containing the index of the face (row in getFacePlanes) the vertex belongs to
+	py::tuple getFaceVertices(const ScriptNodeList& nodes);
+
+	// Sets the origin of each entity to the row of the given (N,3) array
+	void setEntityOrigins(const ScriptNodeList& nodes, const py::array_t<double, py::array::c_style | py::array::forcecast>& origins);
+
+	// Assigns each entity the corresponding value of the given key
+	void setKeyValues(const ScriptNodeList& nodes, const std::string& key, const std::vector<std::string>& values);
+
+	// Assigns the same key value to all entities
+	void setKeyValue(const ScriptNodeList& nodes, const std::string& key, const std::string& value);
+
+	// IScriptInterface implementation
+	void registerInterface(py::module& scope, py::dict& globals) override;
+};
+
+} // namespace script
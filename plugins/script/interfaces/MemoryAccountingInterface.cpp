@@ -0,0 +1,43 @@
+#include "MemoryAccountingInterface.h"
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace script
+{
+
+std::vector<memory::SubsystemUsage> MemoryAccountingInterface::getUsage()
+{
+	return GlobalMemoryAccounting().collectUsage();
+}
+
+std::size_t MemoryAccountingInterface::getTotalBytes()
+{
+	std::size_t total = 0;
+
+	for (const auto& subsystem : GlobalMemoryAccounting().collectUsage())
+	{
+		total += subsystem.usage.bytes;
+	}
+
+	return total;
+}
+
+void MemoryAccountingInterface::registerInterface(py::module& scope, py::dict& globals)
+{
+	py::class_<memory::SubsystemUsage> usage(scope, "SubsystemMemoryUsage");
+	usage.def_property_readonly("name", [](const memory::SubsystemUsage& subsystem) { return subsystem.name; });
+	usage.def_property_readonly("bytes", [](const memory::SubsystemUsage& subsystem) { return subsystem.usage.bytes; });
+	usage.def_property_readonly("numItems", [](const memory::SubsystemUsage& subsystem) { return subsystem.usage.numItems; });
+
+	// Add the module declaration to the given python namespace
+	py::class_<MemoryAccountingInterface> accounting(scope, "MemoryAccounting");
+
+	accounting.def("getUsage", &MemoryAccountingInterface::getUsage);
+	accounting.def("getTotalBytes", &MemoryAccountingInterface::getTotalBytes);
+
+	// Now point the Python variable "GlobalMemoryAccounting" to this instance
+	globals["GlobalMemoryAccounting"] = this;
+}
+
+} // namespace script
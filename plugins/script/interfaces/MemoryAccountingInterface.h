@@ -0,0 +1,28 @@
+#pragma once
+
+#include "iscript.h"
+#include "iscriptinterface.h"
+#include "imemoryaccounting.h"
+
+namespace script
+{
+
+/**
+ * Exposes the approximate memory usage of the various subsystems
+ * as collected by the GlobalMemoryAccounting module.
+ */
+class MemoryAccountingInterface :
+	public IScriptInterface
+{
+public:
+	// Returns the usage of each subsystem, sorted by the number of bytes (highest first)
+	std::vector<memory::SubsystemUsage> getUsage();
+
+	// Returns the sum of all bytes reported by the subsystems
+	std::size_t getTotalBytes();
+
+	// IScriptInterface implementation
+	void registerInterface(py::module& scope, py::dict& globals) override;
+};
+
+} // namespace script
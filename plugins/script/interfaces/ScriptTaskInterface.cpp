@@ -0,0 +1,92 @@
+#include "ScriptTaskInterface.h"
+
+#include "../ScriptTask.h"
+
+namespace script
+{
+
+namespace
+{
+	// Turns the cancellation of the task into a KeyboardInterrupt in the script
+	void raiseKeyboardInterrupt()
+	{
+		PyErr_SetString(PyExc_KeyboardInterrupt, "Script task has been cancelled");
+		throw py::error_already_set();
+	}
+}
+
+bool ScriptTaskInterface::isRunningInBackground()
+{
+	return ScriptTask::GetCurrent() != nullptr;
+}
+
+bool ScriptTaskInterface::isReadOnly()
+{
+	auto task = ScriptTask::GetCurrent();
+	return task != nullptr && task->isReadOnly();
+}
+
+bool ScriptTaskInterface::isCancelled()
+{
+	auto task = ScriptTask::GetCurrent();
+	return task != nullptr && task->isCancelled();
+}
+
+void ScriptTaskInterface::setProgress(float fraction, const std::string& text)
+{
+	auto task = ScriptTask::GetCurrent();
+
+	if (task == nullptr) return;
+
+	try
+	{
+		task->setProgress(fraction, text);
+	}
+	catch (const ScriptTask::Cancelled&)
+	{
+		raiseKeyboardInterrupt();
+	}
+}
+
+void ScriptTaskInterface::modifyScene(const py::function& batch)
+{
+	auto task = ScriptTask::GetCurrent();
+
+	if (task == nullptr)
+	{
+		// Already on the UI thread
+		batch();
+		return;
+	}
+
+	try
+	{
+		// Let go of the interpreter while waiting, the UI thread needs it to run the batch
+		py::gil_scoped_release release;
+
+		task->modifyScene([&]()
+		{
+			py::gil_scoped_acquire acquire;
+			batch();
+		});
+	}
+	catch (const ScriptTask::Cancelled&)
+	{
+		raiseKeyboardInterrupt();
+	}
+}
+
+void ScriptTaskInterface::registerInterface(py::module& scope, py::dict& globals)
+{
+	py::class_<ScriptTaskInterface> scriptTask(scope, "ScriptTask");
+	scriptTask.def("isRunningInBackground", &ScriptTaskInterface::isRunningInBackground);
+	scriptTask.def("isReadOnly", &ScriptTaskInterface::isReadOnly);
+	scriptTask.def("isCancelled", &ScriptTaskInterface::isCancelled);
+	scriptTask.def("setProgress", &ScriptTaskInterface::setProgress);
+	scriptTask.def("modifyScene", &ScriptTaskInterface::modifyScene);
+
+	// Now point the Python variable "GlobalScriptTask" to this instance
+	globals["GlobalScriptTask"] = this;
+}
+
+} // namespace script
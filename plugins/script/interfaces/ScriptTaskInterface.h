@@ -0,0 +1,40 @@
+#pragma once
+
+#include <pybind11/pybind11.h>
+
+#include "iscript.h"
+#include "iscriptinterface.h"
+
+namespace script
+{
+
+/**
+ * Gives scripts running as long-running task (in a worker thread) access to that task.
+ * All methods are no-ops when the script is executed directly on the UI thread.
+ */
+class ScriptTaskInterface :
+	public IScriptInterface
+{
+public:
+	// Returns true if the calling script is running as long-running task
+	bool isRunningInBackground();
+
+	// Returns true if the calling script is running as read-only task
+	bool isReadOnly();
+
+	// Returns true if the user requested the task to be cancelled
+	bool isCancelled();
+
+	// Reports the progress of the task (fraction in [0..1], negative if unknown)
+	// to the UI thread, raises KeyboardInterrupt if the task has been cancelled
+	void setProgress(float fraction, const std::string& text);
+
+	// Runs the given callable on the UI thread, which is the only place the scene may be changed.
+	// Raises KeyboardInterrupt if the task has been cancelled, RuntimeError for read-only tasks.
+	void modifyScene(const py::function& batch);
+
+	// IScriptInterface implementation
+	void registerInterface(py::module& scope, py::dict& globals) override;
+};
+
+} // namespace script
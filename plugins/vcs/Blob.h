@@ -0,0 +1,59 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <git2.h>
+
+namespace vcs
+{
+
+namespace git
+{
+
+/**
+ * Read-only git object holding the contents of a file revision.
+ * The contents are inflated when the blob is looked up and stay
+ * in memory (contiguously) until the blob is destroyed.
+ */
+class Blob final
+{
+private:
+    git_blob* _blob;
+    std::string _oid;
+
+public:
+    using Ptr = std::shared_ptr<Blob>;
+
+    Blob(git_blob* blob, const std::string& oid) :
+        _blob(blob),
+        _oid(oid)
+    {}
+
+    Blob(const Blob& other) = delete;
+    Blob& operator=(const Blob& other) = delete;
+
+    ~Blob()
+    {
+        git_blob_free(_blob);
+    }
+
+    // The object ID (hex string) of this blob
+    const std::string& getOid() const
+    {
+        return _oid;
+    }
+
+    const char* getData() const
+    {
+        return reinterpret_cast<const char*>(git_blob_rawcontent(_blob));
+    }
+
+    std::size_t getSize() const
+    {
+        return static_cast<std::size_t>(git_blob_rawsize(_blob));
+    }
+};
+
+}
+
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <memory>
+#include <unordered_map>
+
+namespace vcs
+{
+
+namespace git
+{
+
+/**
+ * Keeps the most recently used blobs in memory, indexed by their object ID.
+ *
+ * Opening the same file revision more than once (like the common ancestor
+ * of repeated merge operations) doesn't need to read and inflate the object
+ * from the database again. The cache is limited by the total size of the blobs,
+ * the least recently used ones are dropped first. Blobs still in use by a client
+ * stay alive even after being dropped from the cache.
+ *
+ * BlobType needs to provide getOid() and getSize(), usually this is git::Blob.
+ */
+template<typename BlobType>
+class BlobCache final
+{
+public:
+    using BlobPtr = std::shared_ptr<BlobType>;
+
+private:
+    std::size_t _maxSize;
+    std::size_t _currentSize;
+
+    // Most recently used blobs come first
+    std::list<BlobPtr> _blobs;
+    std::unordered_map<std::string, typename std::list<BlobPtr>::iterator> _blobsByOid;
+
+    std::mutex _lock;
+
+public:
+    // The default limit is large enough to hold a few revisions of big maps
+    static constexpr std::size_t DefaultMaxSize = 256 * 1024 * 1024;
+
+    BlobCache(std::size_t maxSize = DefaultMaxSize) :
+        _maxSize(maxSize),
+        _currentSize(0)
+    {}
+
+    // The total size of the cached blobs in bytes
+    std::size_t getSize()
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        return _currentSize;
+    }
+
+    std::size_t getBlobCount()
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        return _blobs.size();
+    }
+
+    // Returns the cached blob with the given object ID, or an empty pointer
+    BlobPtr find(const std::string& oid)
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+
+        auto found = _blobsByOid.find(oid);
+
+        if (found == _blobsByOid.end())
+        {
+            return BlobPtr();
+        }
+
+        // Move the blob to the front of the list
+        _blobs.splice(_blobs.begin(), _blobs, found->second);
+
+        return *found->second;
+    }
+
+    // Adds the given blob to the cache, possibly evicting older ones
+    void insert(const BlobPtr& blob)
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+
+        // Blobs exceeding the limit on their own are not cached at all
+        if (blob->getSize() > _maxSize || _blobsByOid.count(blob->getOid()) > 0)
+        {
+            return;
+        }
+
+        _blobs.push_front(blob);
+        _blobsByOid.emplace(blob->getOid(), _blobs.begin());
+        _currentSize += blob->getSize();
+
+        while (_currentSize > _maxSize)
+        {
+            const auto& leastRecentlyUsed = _blobs.back();
+
+            _currentSize -= leastRecentlyUsed->getSize();
+            _blobsByOid.erase(leastRecentlyUsed->getOid());
+            _blobs.pop_back();
+        }
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+
+        _blobs.clear();
+        _blobsByOid.clear();
+        _currentSize = 0;
+    }
+};
+
+}
+
+}
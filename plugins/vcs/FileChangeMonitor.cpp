@@ -0,0 +1,199 @@
+#include "FileChangeMonitor.h"
+
+#include <set>
+#include <system_error>
+#include "itextstream.h"
+#include "os/fs.h"
+#include "os/path.h"
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace vcs
+{
+
+FileChangeMonitor::FileChangeMonitor() :
+    _inotifyFd(-1),
+    _changesPending(true)
+{
+#ifdef __linux__
+    _inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+    if (_inotifyFd == -1)
+    {
+        rWarning() << "Could not initialise inotify, falling back to file polling: " << strerror(errno) << std::endl;
+    }
+#endif
+}
+
+FileChangeMonitor::~FileChangeMonitor()
+{
+    clearWatches();
+
+#ifdef __linux__
+    if (_inotifyFd != -1)
+    {
+        close(_inotifyFd);
+    }
+#endif
+}
+
+void FileChangeMonitor::setFiles(const std::vector<std::string>& files)
+{
+    if (files == _files) return;
+
+    clearWatches();
+
+    _files = files;
+    _fileStates.clear();
+    _changesPending = true;
+
+    if (_inotifyFd != -1 && !addWatches())
+    {
+        // Use the fallback method for this file set
+        clearWatches();
+    }
+}
+
+bool FileChangeMonitor::checkForChanges()
+{
+    auto hasChanges = _watches.empty() ? compareFileStates() : readWatchEvents();
+
+    hasChanges |= _changesPending;
+    _changesPending = false;
+
+    return hasChanges;
+}
+
+void FileChangeMonitor::clearWatches()
+{
+#ifdef __linux__
+    for (const auto& [descriptor, folder] : _watches)
+    {
+        inotify_rm_watch(_inotifyFd, descriptor);
+    }
+#endif
+
+    _watches.clear();
+}
+
+bool FileChangeMonitor::addWatches()
+{
+#ifdef __linux__
+    std::set<std::string> folders;
+
+    for (const auto& file : _files)
+    {
+        folders.insert(os::getDirectory(file));
+    }
+
+    for (const auto& folder : folders)
+    {
+        // Watch the folder rather than the file itself, since files
+        // are usually replaced (not overwritten) by git and the map saver
+        auto descriptor = inotify_add_watch(_inotifyFd, folder.c_str(),
+            IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_CREATE | IN_DELETE | IN_ATTRIB);
+
+        if (descriptor == -1)
+        {
+            rWarning() << "Could not watch folder " << folder << ": " << strerror(errno) << std::endl;
+            return false;
+        }
+
+        _watches[descriptor] = folder;
+    }
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool FileChangeMonitor::readWatchEvents()
+{
+    bool hasChanges = false;
+
+#ifdef __linux__
+    alignas(inotify_event) char buffer[4096];
+
+    while (true)
+    {
+        auto length = read(_inotifyFd, buffer, sizeof(buffer));
+
+        if (length <= 0)
+        {
+            break; // EAGAIN: no more pending events
+        }
+
+        for (auto* pos = buffer; pos < buffer + length;)
+        {
+            const auto* event = reinterpret_cast<const inotify_event*>(pos);
+            pos += sizeof(inotify_event) + event->len;
+
+            auto watch = _watches.find(event->wd);
+
+            if (watch == _watches.end() || event->len == 0) continue;
+
+            // Ignore all the other files in the watched folder
+            auto path = watch->second + event->name;
+
+            for (const auto& file : _files)
+            {
+                if (file == path)
+                {
+                    hasChanges = true;
+                    break;
+                }
+            }
+        }
+    }
+#endif
+
+    return hasChanges;
+}
+
+bool FileChangeMonitor::compareFileStates()
+{
+    bool hasChanges = false;
+
+    for (const auto& file : _files)
+    {
+        auto state = GetFileState(file);
+        auto existing = _fileStates.find(file);
+
+        if (existing == _fileStates.end() || !(existing->second == state))
+        {
+            _fileStates[file] = state;
+            hasChanges = true;
+        }
+    }
+
+    return hasChanges;
+}
+
+FileChangeMonitor::FileState FileChangeMonitor::GetFileState(const std::string& path)
+{
+    std::error_code ec;
+
+    auto size = fs::file_size(path, ec);
+
+    if (ec)
+    {
+        return FileState{ false, 0, 0 };
+    }
+
+    auto modificationTime = fs::last_write_time(path, ec);
+
+    return FileState
+    {
+        true,
+        static_cast<std::int64_t>(size),
+        ec ? 0 : static_cast<std::int64_t>(modificationTime.time_since_epoch().count())
+    };
+}
+
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdint>
+
+namespace vcs
+{
+
+/**
+ * Detects on-disk modifications of a small set of files, without
+ * having to ask the version control system for a status every time.
+ *
+ * On Linux the parent folders of the monitored files are watched using
+ * inotify, checking for changes is a single non-blocking read() call.
+ * On other platforms (or if inotify is unavailable) the modification
+ * time and size of each file is compared to the previous check.
+ */
+class FileChangeMonitor final
+{
+private:
+    struct FileState
+    {
+        bool exists;
+        std::int64_t size;
+        std::int64_t modificationTime;
+
+        bool operator==(const FileState& other) const
+        {
+            return exists == other.exists && size == other.size && modificationTime == other.modificationTime;
+        }
+    };
+
+    std::vector<std::string> _files;
+
+    // Last known state of each file, used when there's no inotify support
+    std::map<std::string, FileState> _fileStates;
+
+    // inotify instance and the watch descriptors, mapped to the folder path
+    int _inotifyFd;
+    std::map<int, std::string> _watches;
+
+    bool _changesPending;
+
+public:
+    FileChangeMonitor();
+    ~FileChangeMonitor();
+
+    FileChangeMonitor(const FileChangeMonitor& other) = delete;
+    FileChangeMonitor& operator=(const FileChangeMonitor& other) = delete;
+
+    // Sets the absolute paths of the files to monitor. If the set differs
+    // from the current one, the next checkForChanges() call will return true.
+    void setFiles(const std::vector<std::string>& files);
+
+    // Returns true if any of the monitored files has been created, modified,
+    // replaced or removed since the last call. Doesn't block.
+    bool checkForChanges();
+
+private:
+    void clearWatches();
+    bool addWatches();
+    bool readWatchEvents();
+    bool compareFileStates();
+
+    static FileState GetFileState(const std::string& path);
+};
+
+}
@@ -1,8 +1,8 @@
 #pragma once
 
-#include "iarchive.h"
-#include <git2.h>
+#include "iversioncontrol.h"
 #include "stream/BufferInputStream.h"
+#include "Blob.h"
 
 namespace vcs
 {
@@ -11,13 +11,12 @@ namespace git
 {
 
 // Adapter class, implementing the ArchiveTextFile interface to a Git BLOB
+// The blob contents are served directly, without copying them
 class GitArchiveTextFile :
-    public ArchiveTextFile
+    public IVersionedTextFile
 {
 private:
-    git_blob* _blob;
-    std::size_t _blobSize;
-    const void* _blobContents;
+    Blob::Ptr _blob;
 
     std::string _path;
 
@@ -26,19 +25,12 @@ private:
 public:
     using Ptr = std::shared_ptr<GitArchiveTextFile>;
 
-    GitArchiveTextFile(git_blob* blob, const std::string& path) :
+    GitArchiveTextFile(const Blob::Ptr& blob, const std::string& path) :
         _blob(blob),
-        _blobSize(git_blob_rawsize(_blob)),
-        _blobContents(git_blob_rawcontent(_blob)),
         _path(path),
-        _stream(reinterpret_cast<const char*>(_blobContents), _blobSize)
+        _stream(_blob->getData(), _blob->getSize())
     {}
 
-    ~GitArchiveTextFile()
-    {
-        git_blob_free(_blob);
-    }
-
     std::string getModName() const override
     {
         return "Git History";
@@ -53,6 +45,16 @@ public:
     {
         return _stream;
     }
+
+    const char* getData() const override
+    {
+        return _blob->getData();
+    }
+
+    std::size_t getSize() const override
+    {
+        return _blob->getSize();
+    }
 };
 
 }
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "iradiant.h"
+#include "imessagebus.h"
+
+namespace vcs
+{
+
+/**
+ * Sent (on the UI thread) when a background status check of the
+ * loaded map file has been completed.
+ */
+class MapFileStatusMessage :
+    public radiant::IMessage
+{
+private:
+    std::string _mapPath;
+    std::string _status;
+
+public:
+    static constexpr std::size_t Id = radiant::IMessage::Type::UserDefinedMessagesGoHigherThanThis + 100;
+
+    MapFileStatusMessage(const std::string& mapPath, const std::string& status) :
+        _mapPath(mapPath),
+        _status(status)
+    {}
+
+    std::size_t getId() const override
+    {
+        return Id;
+    }
+
+    // The absolute path of the map file that has been checked
+    const std::string& getMapPath() const
+    {
+        return _mapPath;
+    }
+
+    // The status text to display
+    const std::string& getStatus() const
+    {
+        return _status;
+    }
+};
+
+}
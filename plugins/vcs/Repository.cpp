@@ -66,6 +66,11 @@ std::string Repository::getRepositoryRelativePath(const std::string& path)
     return relativePath;
 }
 
+std::string Repository::getIndexFilePath()
+{
+    return os::standardPathWithSlash(git_repository_path(_repository)) + "index";
+}
+
 std::shared_ptr<Repository> Repository::clone()
 {
     return std::make_shared<Repository>(_path);
@@ -257,22 +262,17 @@ bool Repository::isUpToDateWithRemote()
 
 unsigned int Repository::getFileStatus(const std::string& relativePath)
 {
-    git_status_options options = GIT_STATUS_OPTIONS_INIT;
-
-    char* paths[] = { const_cast<char*>(relativePath.c_str()) };
-
-    options.pathspec.count = 1;
-    options.pathspec.strings = paths;
-    options.flags |= GIT_STATUS_OPT_INCLUDE_UNTRACKED | GIT_STATUS_OPT_RECURSE_UNTRACKED_DIRS;
-    options.show = GIT_STATUS_SHOW_WORKDIR_ONLY;
-
     unsigned int statusFlags = 0;
 
-    auto error = git_status_foreach_ext(_repository, &options, [](const char* path, unsigned int flags, void* payload)
+    // Query the status of this single file, a git_status_foreach_ext() call
+    // would walk the whole working tree, even if a pathspec is specified
+    auto error = git_status_file(&statusFlags, _repository, relativePath.c_str());
+
+    if (error == GIT_ENOTFOUND)
     {
-        *reinterpret_cast<unsigned int*>(payload) = flags;
-        return 0;
-    }, &statusFlags);
+        return 0; // neither in the index nor in the working tree
+    }
+
     GitException::ThrowOnError(error);
 
     return statusFlags;
@@ -307,6 +307,26 @@ std::shared_ptr<Tree> Repository::getTreeByRevision(const std::string& revision)
     return commit->getTree();
 }
 
+Blob::Ptr Repository::getBlob(const git_oid* oid)
+{
+    auto oidString = Reference::OidToString(oid);
+    auto blob = _blobCache.find(oidString);
+
+    if (blob)
+    {
+        return blob;
+    }
+
+    git_blob* rawBlob;
+    auto error = git_blob_lookup(&rawBlob, _repository, oid);
+    GitException::ThrowOnError(error);
+
+    blob = std::make_shared<Blob>(rawBlob, oidString);
+    _blobCache.insert(blob);
+
+    return blob;
+}
+
 void Repository::createCommit(const CommitMetadata& metadata)
 {
     createCommit(metadata, Reference::Ptr());
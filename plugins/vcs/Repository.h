@@ -5,6 +5,8 @@
 #include "Reference.h"
 #include "CommitMetadata.h"
 #include "Index.h"
+#include "Blob.h"
+#include "BlobCache.h"
 
 struct git_repository;
 
@@ -30,6 +32,9 @@ private:
 
     std::string _path;
 
+    // Recently opened file revisions
+    BlobCache<Blob> _blobCache;
+
 public:
     Repository(const std::string& path);
     ~Repository();
@@ -42,6 +47,9 @@ public:
 
     std::string getRepositoryRelativePath(const std::string& path);
 
+    // Returns the absolute path to the index file of this repository
+    std::string getIndexFilePath();
+
     // Returns the remote with the given name
     std::shared_ptr<Remote> getRemote(const std::string& name);
 
@@ -83,6 +91,9 @@ public:
 
     std::shared_ptr<Tree> getTreeByRevision(const std::string& revision);
 
+    // Returns the blob with the given object ID, served from the blob cache if possible
+    Blob::Ptr getBlob(const git_oid* oid);
+
     // Create a commit with the current repository HEAD as only parent
     void createCommit(const CommitMetadata& metadata);
 
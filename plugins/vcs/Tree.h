@@ -33,18 +33,14 @@ public:
         auto error = git_tree_entry_bypath(&entry, _tree, filePath.c_str());
         GitException::ThrowOnError(error);
 
-        git_blob* blob;
-        error = git_blob_lookup(&blob, repository._get(), git_tree_entry_id(entry));
+        auto blobOid = *git_tree_entry_id(entry);
 
-        // Free the entry before checking for errors
+        // Free the entry before looking up the blob, which might throw
         git_tree_entry_free(entry);
 
-        if (error < 0)
-        {
-            GitException::ThrowOnError(error);
-        }
+        // The blob is shared with the repository's blob cache
+        auto blob = repository.getBlob(&blobOid);
 
-        // GitArchiveTextFile assumes ownership of the blob
         return std::make_shared<GitArchiveTextFile>(blob, filePath);
     }
 
@@ -5,6 +5,7 @@
 #include "ui/iuserinterface.h"
 #include "ui/imainframe.h"
 #include "imapformat.h"
+#include "iradiant.h"
 
 #include <wx/sizer.h>
 #include <wx/bmpbuttn.h>
@@ -32,11 +33,63 @@ namespace vcs
 namespace ui
 {
 
+namespace
+{
+    // Determines the status of the given map file and its info file, runs in a worker thread.
+    // The result is posted to the UI thread as MapFileStatusMessage.
+    void performMapFileStatusCheck(std::shared_ptr<git::Repository> repository,
+        std::string mapPath, std::string infoFilePath)
+    {
+        std::string status;
+
+        try
+        {
+            auto relativePath = repository->getRepositoryRelativePath(mapPath);
+
+            if (relativePath.empty())
+            {
+                status = _("Map not in VCS");
+            }
+            else
+            {
+                // The map is pending commit if either the map or its info file has been changed
+                auto relativeInfoFilePath = !infoFilePath.empty() ?
+                    repository->getRepositoryRelativePath(infoFilePath) : std::string();
+
+                if (repository->fileHasUncommittedChanges(relativePath) ||
+                    (!relativeInfoFilePath.empty() && repository->fileHasUncommittedChanges(relativeInfoFilePath)))
+                {
+                    status = _("Map saved, pending commit");
+                }
+                else if (repository->fileIsIndexed(relativePath))
+                {
+                    status = _("Map committed");
+                }
+                else
+                {
+                    status = _("Map saved");
+                }
+            }
+        }
+        catch (const git::GitException& ex)
+        {
+            status = std::string("ERROR: ") + ex.what();
+        }
+
+        GlobalUserInterface().dispatch([mapPath, status]()
+        {
+            MapFileStatusMessage message(mapPath, status);
+            GlobalRadiantCore().getMessageBus().sendMessage(message);
+        });
+    }
+}
+
 VcsStatus::VcsStatus(wxWindow* parent) :
     _panel(loadNamedPanel(parent, "VcsStatusBar")),
     _fetchTimer(this),
     _statusTimer(this),
     _taskInProgress(false),
+    _mapFileStatusOutdated(true),
     _popupMenu(new wxutil::PopupMenu)
 {
     _mapStatus = findNamedObject<wxStaticText>(_panel, "MapStatusLabel");
@@ -67,6 +120,11 @@ VcsStatus::VcsStatus(wxWindow* parent) :
         sigc::mem_fun(this, &VcsStatus::onMapEvent)
     );
 
+    _mapFileStatusListener = GlobalRadiantCore().getMessageBus().addListener(
+        MapFileStatusMessage::Id,
+        radiant::TypeListener<MapFileStatusMessage>(
+            sigc::mem_fun(this, &VcsStatus::onMapFileStatus)));
+
     createPopupMenu();
 
     _statusTimer.Start(500);
@@ -77,6 +135,8 @@ VcsStatus::~VcsStatus()
     _fetchTimer.Stop();
     _statusTimer.Stop();
 
+    GlobalRadiantCore().getMessageBus().removeListener(_mapFileStatusListener);
+
     if (_repositoryTask.valid())
     {
         _repositoryTask.get(); // Wait for the thread to complete
@@ -119,6 +179,7 @@ void VcsStatus::createPopupMenu()
 void VcsStatus::setRepository(const std::shared_ptr<git::Repository>& repository)
 {
     _repository = repository;
+    updateMonitoredFiles();
 
     findNamedObject<wxBitmapButton>(_panel, "VcsMenuButton")->Show(_repository != nullptr);
 
@@ -158,6 +219,7 @@ void VcsStatus::onMapEvent(IMap::MapEvent ev)
 {
     if (ev == IMap::MapSaved || ev == IMap::MapLoaded)
     {
+        updateMonitoredFiles();
         updateMapFileStatus();
 
         if (_repository)
@@ -252,39 +314,103 @@ void VcsStatus::onIntervalReached(wxTimerEvent& ev)
     }
     else if (ev.GetTimer().GetId() == _statusTimer.GetId())
     {
-        updateMapFileStatus();
+        checkMapFileStatus();
     }
 }
 
 void VcsStatus::updateMapFileStatus()
+{
+    // Query the repository regardless of any file changes
+    _mapFileStatusOutdated = true;
+    checkMapFileStatus();
+}
+
+void VcsStatus::checkMapFileStatus()
 {
     if (GlobalMapModule().isUnnamed())
     {
         setMapFileStatus(_("Map not saved yet"));
+        _mapFileStatusOutdated = true;
         return;
     }
 
     if (GlobalMapModule().getActiveMergeOperation())
     {
         setMapFileStatus(_("Merging"));
+        _mapFileStatusOutdated = true;
         return;
     }
 
     if (GlobalMapModule().isModified())
     {
         _mapStatus->SetLabel(_("Map is modified"));
+        _mapFileStatusOutdated = true;
         return;
     }
 
-    if (_repository)
+    if (!_repository)
     {
-        auto repository = _repository->clone();
-        _mapFileTask = std::async(std::launch::async, std::bind(&VcsStatus::performMapFileStatusCheck, this, repository));
+        _mapStatus->SetLabel(_("Map is saved"));
+        return;
     }
-    else
+
+    // Only ask the repository if the map, its info file or the index changed on disk
+    if (_fileMonitor.checkForChanges())
     {
-        _mapStatus->SetLabel(_("Map is saved"));
+        _mapFileStatusOutdated = true;
+    }
+
+    if (!_mapFileStatusOutdated)
+    {
+        return;
+    }
+
+    // Don't stack up status checks, try again on the next timer event
+    if (_mapFileTask.valid() && _mapFileTask.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+    {
+        return;
     }
+
+    _mapFileStatusOutdated = false;
+
+    auto mapPath = GlobalMapModule().getMapName();
+    auto repository = _repository->clone();
+
+    _mapFileTask = std::async(std::launch::async, performMapFileStatusCheck,
+        repository, mapPath, git::getInfoFilePath(mapPath));
+}
+
+void VcsStatus::updateMonitoredFiles()
+{
+    if (!_repository || GlobalMapModule().isUnnamed())
+    {
+        _fileMonitor.setFiles({});
+        return;
+    }
+
+    auto mapPath = GlobalMapModule().getMapName();
+    std::vector<std::string> files{ mapPath, _repository->getIndexFilePath() };
+
+    auto infoFilePath = git::getInfoFilePath(mapPath);
+
+    if (!infoFilePath.empty())
+    {
+        files.emplace_back(infoFilePath);
+    }
+
+    _fileMonitor.setFiles(files);
+}
+
+void VcsStatus::onMapFileStatus(MapFileStatusMessage& message)
+{
+    // Discard results that are outdated by now
+    if (message.getMapPath() != GlobalMapModule().getMapName() ||
+        GlobalMapModule().isModified() || GlobalMapModule().getActiveMergeOperation())
+    {
+        return;
+    }
+
+    _mapStatus->SetLabel(message.getStatus());
 }
 
 void VcsStatus::onIdle(wxIdleEvent& ev)
@@ -434,37 +560,6 @@ void VcsStatus::setRemoteStatus(const git::RemoteStatus& status)
     });
 }
 
-void VcsStatus::performMapFileStatusCheck(std::shared_ptr<git::Repository> repository)
-{
-    try
-    {
-        auto relativePath = repository->getRepositoryRelativePath(GlobalMapModule().getMapName());
-
-        if (relativePath.empty())
-        {
-            setMapFileStatus(_("Map not in VCS"));
-            return;
-        }
-
-        if (repository->fileHasUncommittedChanges(relativePath))
-        {
-            setMapFileStatus(_("Map saved, pending commit"));
-        }
-        else if (repository->fileIsIndexed(relativePath))
-        {
-            setMapFileStatus(_("Map committed"));
-        }
-        else
-        {
-            setMapFileStatus(_("Map saved"));
-        }
-    }
-    catch (const git::GitException& ex)
-    {
-        setMapFileStatus(std::string("ERROR: ") + ex.what());
-    }
-}
-
 }
 
 }
@@ -10,6 +10,8 @@
 #include "imap.h"
 #include "../Algorithm.h"
 #include "../Repository.h"
+#include "../FileChangeMonitor.h"
+#include "../MapFileStatusMessage.h"
 #include "wxutil/XmlResourceBasedWidget.h"
 #include "wxutil/menu/PopupMenu.h"
 
@@ -34,6 +36,11 @@ private:
     std::future<void> _repositoryTask;
     std::future<void> _mapFileTask;
 
+    // Watches the map, its info file and the repository index
+    FileChangeMonitor _fileMonitor;
+    bool _mapFileStatusOutdated;
+    std::size_t _mapFileStatusListener;
+
     std::shared_ptr<git::Repository> _repository;
 
     wxStaticText* _remoteStatus;
@@ -63,8 +70,10 @@ private:
     bool canSync();
     void performCommit();
     bool canCommit();
-    void performMapFileStatusCheck(std::shared_ptr<git::Repository> repository);
     void updateMapFileStatus();
+    void checkMapFileStatus();
+    void updateMonitoredFiles();
+    void onMapFileStatus(MapFileStatusMessage& message);
     void onMapEvent(IMap::MapEvent ev);
     void setMapFileStatus(const std::string& status);
     void setRemoteStatus(const git::RemoteStatus& status);
@@ -4,13 +4,16 @@
 #include "iradiant.h"
 #include "i18n.h"
 #include "UserInterfaceModule.h"
+#include "wxutil/ModalProgressDialog.h"
 #include <wx/app.h>
 
 namespace ui
 {
 
 LongRunningOperationHandler::LongRunningOperationHandler() :
-	_level(0)
+	_level(0),
+	_cancellationRequested(false),
+	_keepScreenUpdates(false)
 {
 	GlobalRadiantCore().getMessageBus().addListener(radiant::IMessage::Type::LongRunningOperation,
 		radiant::TypeListener<radiant::LongRunningOperationMessage>(
@@ -34,6 +37,9 @@ void LongRunningOperationHandler::onMessage(radiant::LongRunningOperationMessage
 
 		if (++_level == 1)
 		{
+			_cancellationRequested = false;
+			_keepScreenUpdates = !message.blocksScreenUpdates();
+
 			GetUserInterfaceModule().dispatch([description, this]()
 			{
 				std::lock_guard<std::mutex> lock(_lock);
@@ -42,10 +48,49 @@ void LongRunningOperationHandler::onMessage(radiant::LongRunningOperationMessage
 				if (_level > 0)
 				{
 					_blocker = GlobalMainFrame().getScopedScreenUpdateBlocker(_("Processing..."), description);
+
+					// The dialog keeps blocking the user input, but the views continue to render
+					if (_keepScreenUpdates)
+					{
+						GlobalMainFrame().enableScreenUpdates();
+					}
 				}
 			});
 		}
 	}
+	else if (message.getType() == radiant::OperationEvent::Progress)
+	{
+		auto text = message.getMessage();
+		auto progress = message.getProgress();
+
+		GetUserInterfaceModule().dispatch([text, progress, this]()
+		{
+			std::lock_guard<std::mutex> lock(_lock);
+
+			if (!_blocker) return;
+
+			try
+			{
+				if (!text.empty())
+				{
+					_blocker->setMessage(text);
+				}
+
+				if (progress < 0)
+				{
+					_blocker->pulse();
+				}
+				else
+				{
+					_blocker->setProgress(progress);
+				}
+			}
+			catch (const wxutil::ModalProgressDialog::OperationAbortedException&)
+			{
+				_cancellationRequested = true;
+			}
+		});
+	}
 	else if (message.getType() == radiant::OperationEvent::Finished)
 	{
 		assert(_level > 0);
@@ -56,6 +101,14 @@ void LongRunningOperationHandler::onMessage(radiant::LongRunningOperationMessage
 			{
 				std::lock_guard<std::mutex> lock(_lock);
 
+				if (!_blocker) return;
+
+				// Leave the flag as the blocker expects it to be
+				if (_keepScreenUpdates)
+				{
+					GlobalMainFrame().disableScreenUpdates();
+				}
+
 				_blocker.reset();
 			});
 		}
@@ -63,6 +116,18 @@ void LongRunningOperationHandler::onMessage(radiant::LongRunningOperationMessage
 
 	lock.reset();
 	wxTheApp->Yield();
+
+	// The progress dialog has been updated while processing the pending events,
+	// report a click on its cancel button to the sender right away
+	if (message.getType() == radiant::OperationEvent::Progress)
+	{
+		std::lock_guard<std::mutex> progressLock(_lock);
+
+		if (_cancellationRequested)
+		{
+			message.requestCancellation();
+		}
+	}
 }
 
 }
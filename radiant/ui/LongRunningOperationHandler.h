@@ -18,6 +18,12 @@ class LongRunningOperationHandler
 private:
 	std::size_t _level;
 
+	// Set when the user hits the cancel button of the progress dialog
+	bool _cancellationRequested;
+
+	// True if the operation asked to keep the views rendering
+	bool _keepScreenUpdates;
+
 	IScopedScreenUpdateBlockerPtr _blocker;
 
 	std::mutex _lock;
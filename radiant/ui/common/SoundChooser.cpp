@@ -2,6 +2,7 @@
 
 #include "i18n.h"
 #include "isound.h"
+#include "ifilesystem.h"
 #include "ui/imainframe.h"
 #include "ifavourites.h"
 #include "registry/registry.h"
@@ -38,6 +39,13 @@ namespace
 
     const char* const RKEY_WINDOW_STATE = "user/ui/soundChooser/window";
     const char* const RKEY_LAST_SELECTED_SHADER = "user/ui/soundChooser/lastSelectedShader";
+
+    // The cached tree model is referencing the columns, they need to stay around
+    const wxutil::ResourceTreeView::Columns& getTreeColumns()
+    {
+        static wxutil::ResourceTreeView::Columns _columns;
+        return _columns;
+    }
 }
 
 /**
@@ -115,7 +123,13 @@ public:
     ThreadedSoundShaderLoader(const wxutil::ResourceTreeView::Columns& columns) :
         ThreadedResourceTreePopulator(columns),
         _columns(columns)
-    {}
+    {
+        // All sound choosers are sharing the same tree, until the shaders are reloaded
+        EnableModelCache("SoundShaders", {
+            GlobalFileSystem().signal_Initialised(),
+            GlobalSoundManager().signal_soundShadersReloaded()
+        });
+    }
 
     ~ThreadedSoundShaderLoader()
     {
@@ -147,6 +161,7 @@ public:
 // Constructor
 SoundChooser::SoundChooser(wxWindow* parent) :
 	DialogBase(_("Choose sound"), parent),
+    _columns(getTreeColumns()),
 	_treeView(nullptr),
 	_preview(new SoundShaderPreview(this))
 {
@@ -22,7 +22,7 @@ class SoundChooser :
 	public IResourceChooser
 {
 private:
-    wxutil::ResourceTreeView::Columns _columns;
+    const wxutil::ResourceTreeView::Columns& _columns;
 	wxutil::ResourceTreeView* _treeView;
 
 	// The preview widget group
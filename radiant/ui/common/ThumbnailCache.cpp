@@ -0,0 +1,305 @@
+#include "ThumbnailCache.h"
+
+#include "imodule.h"
+#include "ifilesystem.h"
+#include "itextstream.h"
+#include "ui/iwxgl.h"
+
+#include "os/fs.h"
+#include "os/dir.h"
+#include "os/file.h"
+#include "os/path.h"
+#include "math/Hash.h"
+
+#include "ThumbnailRenderer.h"
+#include "ui/UserInterfaceModule.h"
+
+#include <chrono>
+#include <wx/app.h>
+
+namespace ui
+{
+
+namespace
+{
+    const char* const THUMBNAIL_FOLDER = "thumbnails/";
+
+    // Rendering stops after this amount of time, to keep the UI responsive.
+    // The remaining requests are processed in the following idle events.
+    const std::chrono::milliseconds RENDER_TIME_PER_IDLE_EVENT(20);
+
+    // Returns the modification time of the given file, or 0 if it doesn't exist
+    std::size_t getModificationTime(const std::string& path)
+    {
+        try
+        {
+            auto time = fs::last_write_time(path);
+#ifdef DR_USE_STD_FILESYSTEM
+            return static_cast<std::size_t>(time.time_since_epoch().count());
+#else
+            return static_cast<std::size_t>(time);
+#endif
+        }
+        catch (const fs::filesystem_error&)
+        {
+            return 0;
+        }
+    }
+
+    // Returns the modification time of the physical file or the archive
+    // containing the given VFS file. Absolute paths are used directly.
+    std::size_t getFileModificationTime(const std::string& path)
+    {
+        if (path_is_absolute(path.c_str()))
+        {
+            return getModificationTime(path);
+        }
+
+        auto root = GlobalFileSystem().findFile(path);
+
+        if (!root.empty())
+        {
+            return getModificationTime(root + path);
+        }
+
+        // Not a physical file, use the time stamp of the archive
+        auto archivePath = GlobalFileSystem().getFileInfo(path).getArchivePath();
+
+        return !archivePath.empty() ? getModificationTime(archivePath) : 0;
+    }
+}
+
+ThumbnailCache::ThumbnailCache(int size) :
+    _size(size),
+    _cachePath(module::GlobalModuleRegistry().getApplicationContext().getCacheDataPath() + THUMBNAIL_FOLDER),
+    _isShuttingDown(false),
+    _idleHandlerConnected(false)
+{
+    if (!os::makeDirectory(_cachePath))
+    {
+        // Thumbnails will be rendered each time
+        rWarning() << "Cannot create thumbnail folder " << _cachePath << std::endl;
+        _cachePath.clear();
+    }
+}
+
+ThumbnailCache::~ThumbnailCache()
+{
+    _isShuttingDown = true;
+    _fileQueue.clear();
+
+    disconnectIdleHandler();
+}
+
+int ThumbnailCache::getSize() const
+{
+    return _size;
+}
+
+wxBitmap ThumbnailCache::getThumbnail(const Request& request)
+{
+    auto existing = _thumbnails.find(request.key);
+
+    if (existing != _thumbnails.end())
+    {
+        return existing->second;
+    }
+
+    if (_pendingKeys.count(request.key) > 0)
+    {
+        return wxNullBitmap; // already on its way
+    }
+
+    _pendingKeys.insert(request.key);
+
+    auto cacheFile = getCacheFileName(request.key, request.filePath);
+
+    if (!cacheFile.empty())
+    {
+        loadFileAsync(request, cacheFile);
+    }
+    else
+    {
+        queueRender(request, cacheFile);
+    }
+
+    return wxNullBitmap;
+}
+
+void ThumbnailCache::cancelPendingRequests()
+{
+    _fileQueue.clearPendingTasks();
+    _pendingRenders.clear();
+
+    // Requests being loaded right now will be ignored, unless they are issued again
+    _pendingKeys.clear();
+
+    disconnectIdleHandler();
+}
+
+void ThumbnailCache::clear()
+{
+    cancelPendingRequests();
+
+    _thumbnails.clear();
+}
+
+sigc::signal<void, const std::string&, const wxBitmap&>& ThumbnailCache::signal_thumbnailReady()
+{
+    return _sigThumbnailReady;
+}
+
+std::string ThumbnailCache::getCacheFileName(const std::string& key, const std::string& filePath)
+{
+    if (_cachePath.empty()) return std::string();
+
+    auto modificationTime = getFileModificationTime(filePath);
+
+    // Without a time stamp the file on disk can't be validated
+    if (modificationTime == 0) return std::string();
+
+    math::Hash hash;
+    hash.addString(key);
+    hash.addSizet(static_cast<std::size_t>(_size));
+    hash.addSizet(modificationTime);
+
+    return _cachePath + static_cast<std::string>(hash) + ".png";
+}
+
+void ThumbnailCache::loadFileAsync(const Request& request, const std::string& cacheFile)
+{
+    std::weak_ptr<ThumbnailCache> weakSelf = shared_from_this();
+
+    _fileQueue.enqueue([this, weakSelf, request, cacheFile] // copy strings into lambda
+    {
+        if (_isShuttingDown) return;
+
+        auto image = std::make_shared<wxImage>();
+
+        if (os::fileOrDirExists(cacheFile))
+        {
+            image->LoadFile(cacheFile, wxBITMAP_TYPE_PNG);
+        }
+
+        // Dispatch to UI thread, the thumbnail is rendered there if the file could not be loaded
+        GetUserInterfaceModule().dispatch([weakSelf, request, cacheFile, image]()
+        {
+            if (auto self = weakSelf.lock())
+            {
+                self->onFileLoaded(request, cacheFile, image);
+            }
+        });
+    });
+}
+
+void ThumbnailCache::saveFileAsync(const wxImage& image, const std::string& cacheFile)
+{
+    // Pass an unshared copy to the worker thread, wxImage's ref counting isn't thread-safe
+    auto imageCopy = std::make_shared<wxImage>(image.Copy());
+
+    _fileQueue.enqueue([imageCopy, cacheFile]
+    {
+        if (!imageCopy->SaveFile(cacheFile, wxBITMAP_TYPE_PNG))
+        {
+            rWarning() << "Failed to save thumbnail " << cacheFile << std::endl;
+        }
+    });
+}
+
+void ThumbnailCache::onFileLoaded(const Request& request, const std::string& cacheFile,
+    const std::shared_ptr<wxImage>& image)
+{
+    // Ignore results of cancelled requests
+    if (_pendingKeys.count(request.key) == 0) return;
+
+    if (image->IsOk() && image->GetWidth() == _size && image->GetHeight() == _size)
+    {
+        setThumbnail(request.key, *image);
+        return;
+    }
+
+    queueRender(request, cacheFile);
+}
+
+void ThumbnailCache::queueRender(const Request& request, const std::string& cacheFile)
+{
+    _pendingRenders.push_front(PendingRender{ request, cacheFile });
+
+    connectIdleHandler();
+}
+
+void ThumbnailCache::setThumbnail(const std::string& key, const wxImage& image)
+{
+    _pendingKeys.erase(key);
+
+    auto& thumbnail = _thumbnails[key];
+    thumbnail = image.IsOk() ? wxBitmap(image) : wxNullBitmap;
+
+    _sigThumbnailReady.emit(key, thumbnail);
+}
+
+void ThumbnailCache::connectIdleHandler()
+{
+    if (_idleHandlerConnected || !wxTheApp) return;
+
+    _idleHandlerConnected = true;
+    wxTheApp->Bind(wxEVT_IDLE, &ThumbnailCache::onIdle, this);
+}
+
+void ThumbnailCache::disconnectIdleHandler()
+{
+    if (!_idleHandlerConnected) return;
+
+    _idleHandlerConnected = false;
+
+    if (wxTheApp)
+    {
+        wxTheApp->Unbind(wxEVT_IDLE, &ThumbnailCache::onIdle, this);
+    }
+}
+
+void ThumbnailCache::onIdle(wxIdleEvent& ev)
+{
+    ev.Skip();
+
+    // Rendering requires a shown GL widget, try again with the next request
+    if (_pendingRenders.empty() || !GlobalWxGlWidgetManager().makeSharedContextCurrent())
+    {
+        disconnectIdleHandler();
+        return;
+    }
+
+    if (!_renderer)
+    {
+        _renderer = std::make_unique<ThumbnailRenderer>(_size);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    while (!_pendingRenders.empty() &&
+           std::chrono::steady_clock::now() - start < RENDER_TIME_PER_IDLE_EVENT)
+    {
+        auto pending = std::move(_pendingRenders.front());
+        _pendingRenders.pop_front();
+
+        auto image = pending.request.render(*_renderer);
+
+        if (image.IsOk() && !pending.cacheFile.empty())
+        {
+            saveFileAsync(image, pending.cacheFile);
+        }
+
+        setThumbnail(pending.request.key, image);
+    }
+
+    if (_pendingRenders.empty())
+    {
+        disconnectIdleHandler();
+    }
+    else
+    {
+        ev.RequestMore();
+    }
+}
+
+}
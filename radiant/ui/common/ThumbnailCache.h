@@ -0,0 +1,135 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <sigc++/signal.h>
+#include "SequentialTaskQueue.h"
+
+#include <wx/bitmap.h>
+#include <wx/image.h>
+#include <wx/event.h>
+
+namespace ui
+{
+
+class ThumbnailRenderer;
+
+/**
+ * Provides small preview images of assets like models and prefabs, to be
+ * shown next to their names in tree views.
+ *
+ * Thumbnails are rendered offscreen on the main thread during idle time
+ * (rendering needs the shared GL context), a few of them per idle event.
+ * Rendered images are stored in the user's cache folder, keyed by the
+ * asset and the modification time of the file defining it, such that they
+ * are only rendered once. The image files are read and written in a
+ * worker thread.
+ *
+ * The most recent requests are served first. Once a thumbnail is
+ * available, the ready signal is emitted with the key of its request.
+ * Assets that failed to render are reported with an invalid bitmap.
+ */
+class ThumbnailCache final :
+    public wxEvtHandler,
+    public std::enable_shared_from_this<ThumbnailCache>
+{
+public:
+    using Ptr = std::shared_ptr<ThumbnailCache>;
+
+    // Renders the image of a request, returns an invalid image on failure
+    using RenderFunction = std::function<wxImage(ThumbnailRenderer&)>;
+
+    struct Request
+    {
+        // The key identifying this thumbnail, e.g. the asset path
+        std::string key;
+
+        // The VFS or absolute path of the file defining the asset,
+        // its modification time is part of the key on disk
+        std::string filePath;
+
+        RenderFunction render;
+    };
+
+private:
+    // Width and height of the thumbnails
+    int _size;
+
+    // The folder containing the image files, ending with a slash
+    std::string _cachePath;
+
+    // The thumbnails available in memory. Invalid bitmaps
+    // are stored for the assets that could not be rendered.
+    std::map<std::string, wxBitmap> _thumbnails;
+
+    // The keys of all requests which are being loaded or rendered
+    std::set<std::string> _pendingKeys;
+
+    struct PendingRender
+    {
+        Request request;
+        std::string cacheFile;
+    };
+
+    // The requests waiting to be rendered, most recent ones first
+    std::list<PendingRender> _pendingRenders;
+
+    std::unique_ptr<ThumbnailRenderer> _renderer;
+
+    // Image files are loaded and saved asynchronously
+    util::SequentialTaskQueue _fileQueue;
+
+    std::atomic<bool> _isShuttingDown;
+
+    bool _idleHandlerConnected;
+
+    sigc::signal<void, const std::string&, const wxBitmap&> _sigThumbnailReady;
+
+public:
+    // Use std::make_shared to construct instances of this class,
+    // the asynchronous tasks are tracking it through weak pointers
+    ThumbnailCache(int size);
+
+    ~ThumbnailCache();
+
+    int getSize() const;
+
+    // Returns the thumbnail if it is available in memory. Otherwise it is
+    // loaded from disk or rendered in the background and an invalid bitmap
+    // is returned, the ready signal is emitted once it is available.
+    // Returns an invalid bitmap for assets that failed to render.
+    wxBitmap getThumbnail(const Request& request);
+
+    // Discards all requests that have not been processed yet
+    void cancelPendingRequests();
+
+    // Releases the thumbnails held in memory, e.g. after the assets have
+    // been reloaded. The image files on disk are kept.
+    void clear();
+
+    // Emitted with the key of the request and the thumbnail once it is available
+    sigc::signal<void, const std::string&, const wxBitmap&>& signal_thumbnailReady();
+
+private:
+    std::string getCacheFileName(const std::string& key, const std::string& filePath);
+
+    void loadFileAsync(const Request& request, const std::string& cacheFile);
+    void saveFileAsync(const wxImage& image, const std::string& cacheFile);
+
+    void onFileLoaded(const Request& request, const std::string& cacheFile,
+        const std::shared_ptr<wxImage>& image);
+
+    void queueRender(const Request& request, const std::string& cacheFile);
+    void setThumbnail(const std::string& key, const wxImage& image);
+
+    void connectIdleHandler();
+    void disconnectIdleHandler();
+    void onIdle(wxIdleEvent& ev);
+};
+
+}
@@ -0,0 +1,268 @@
+#include "ThumbnailRenderer.h"
+
+#include "igl.h"
+#include "ieclass.h"
+#include "ientity.h"
+#include "ifilter.h"
+#include "imodel.h"
+#include "imodelcache.h"
+#include "modelskin.h"
+#include "iscenegraphfactory.h"
+#include "irendersystemfactory.h"
+#include "itextstream.h"
+
+#include "render/CameraView.h"
+#include "render/NopRenderView.h"
+#include "render/SceneRenderWalker.h"
+#include "scene/Node.h"
+#include "scene/BasicRootNode.h"
+#include "scene/PrefabBoundsAccumulator.h"
+
+#include <cstdlib>
+
+namespace ui
+{
+
+namespace
+{
+    const GLfloat THUMBNAIL_FOV = 60;
+
+    // Images are rendered at a multiple of the requested size
+    // and scaled down afterwards, to smooth the edges
+    const int SUPERSAMPLING = 2;
+
+    // Looking down the (1,1,1) diagonal, like the model preview does
+    const Vector3 VIEW_DIRECTION(1, 1, 1);
+    const Vector3 VIEW_ANGLES(-35.26, 225, 0);
+
+    const char* const FUNC_STATIC_CLASS = "func_static";
+
+    // Framebuffer object with a colour and a depth buffer attached,
+    // it is bound during the lifetime of this object
+    class ScopedFramebuffer
+    {
+    private:
+        GLuint _fbo;
+        GLuint _colourBuffer;
+        GLuint _depthBuffer;
+        GLint _previousFbo;
+
+    public:
+        ScopedFramebuffer(int size) :
+            _fbo(0),
+            _colourBuffer(0),
+            _depthBuffer(0),
+            _previousFbo(0)
+        {
+            glGetIntegerv(GL_FRAMEBUFFER_BINDING, &_previousFbo);
+
+            glGenFramebuffers(1, &_fbo);
+            glBindFramebuffer(GL_FRAMEBUFFER, _fbo);
+
+            glGenRenderbuffers(1, &_colourBuffer);
+            glBindRenderbuffer(GL_RENDERBUFFER, _colourBuffer);
+            glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, size, size);
+            glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, _colourBuffer);
+
+            glGenRenderbuffers(1, &_depthBuffer);
+            glBindRenderbuffer(GL_RENDERBUFFER, _depthBuffer);
+            glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, size, size);
+            glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, _depthBuffer);
+
+            glBindRenderbuffer(GL_RENDERBUFFER, 0);
+        }
+
+        ~ScopedFramebuffer()
+        {
+            glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(_previousFbo));
+
+            glDeleteRenderbuffers(1, &_depthBuffer);
+            glDeleteRenderbuffers(1, &_colourBuffer);
+            glDeleteFramebuffers(1, &_fbo);
+        }
+
+        bool isComplete() const
+        {
+            return glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+        }
+    };
+}
+
+ThumbnailRenderer::ThumbnailRenderer(int size) :
+    _size(size),
+    _renderSystem(GlobalRenderSystemFactory().createRenderSystem()),
+    _scene(GlobalSceneGraphFactory().createSceneGraph())
+{}
+
+ThumbnailRenderer::~ThumbnailRenderer()
+{
+    _modelEntity.reset();
+    _modelRoot.reset();
+    _scene.reset();
+    _renderSystem.reset();
+}
+
+int ThumbnailRenderer::getSize() const
+{
+    return _size;
+}
+
+bool ThumbnailRenderer::ensureModelScene()
+{
+    if (_modelEntity) return true;
+
+    try
+    {
+        _modelRoot = std::make_shared<scene::BasicRootNode>();
+
+        _modelEntity = GlobalEntityModule().createEntity(
+            GlobalEntityClassManager().findClass(FUNC_STATIC_CLASS));
+
+        _modelRoot->addChildNode(_modelEntity);
+
+        _modelEntity->enable(scene::Node::eHidden);
+    }
+    catch (std::runtime_error&)
+    {
+        rError() << "Unable to set up the thumbnail scene, could not find the entity class "
+            << FUNC_STATIC_CLASS << std::endl;
+
+        _modelEntity.reset();
+        _modelRoot.reset();
+    }
+
+    return _modelEntity != nullptr;
+}
+
+wxImage ThumbnailRenderer::renderModel(const std::string& model, const std::string& skin)
+{
+    if (!ensureModelScene()) return wxImage();
+
+    auto modelNode = GlobalModelCache().getUncachedModelNode(model);
+
+    if (!modelNode) return wxImage();
+
+    _modelEntity->addChildNode(modelNode);
+
+    // Apply the skin
+    auto modelInterface = Node_getModel(modelNode);
+
+    if (modelInterface)
+    {
+        modelInterface->getIModel().applySkin(GlobalModelSkinCache().capture(skin));
+    }
+
+    auto image = renderScene(_modelRoot);
+
+    _modelEntity->removeChildNode(modelNode);
+
+    return image;
+}
+
+wxImage ThumbnailRenderer::renderScene(const scene::IMapRootNodePtr& root)
+{
+    if (!root) return wxImage();
+
+    _scene->setRoot(root);
+    root->setRenderSystem(_renderSystem);
+
+    GlobalFilterSystem().updateSubgraph(root);
+
+    scene::PrefabBoundsAccumulator accumulator;
+    root->traverseChildren(accumulator);
+
+    const auto& bounds = accumulator.getBounds();
+
+    wxImage image;
+
+    if (bounds.isValid() && bounds.getRadius() > 0)
+    {
+        auto size = _size * SUPERSAMPLING;
+
+        ScopedFramebuffer framebuffer(size);
+
+        if (framebuffer.isComplete())
+        {
+            renderSceneToFramebuffer(bounds, size);
+
+            // wxImage takes ownership of the malloc'ed buffer
+            auto* pixels = static_cast<unsigned char*>(malloc(size * size * 3));
+
+            glPixelStorei(GL_PACK_ALIGNMENT, 1);
+            glReadPixels(0, 0, size, size, GL_RGB, GL_UNSIGNED_BYTE, pixels);
+
+            // GL rows are starting at the bottom
+            image = wxImage(size, size, pixels).Mirror(false);
+            image.Rescale(_size, _size, wxIMAGE_QUALITY_HIGH);
+        }
+        else
+        {
+            rWarning() << "Cannot render thumbnails, framebuffer is incomplete" << std::endl;
+        }
+    }
+
+    // Detach the nodes from our scene, they might be rendered elsewhere
+    root->setRenderSystem(RenderSystemPtr());
+    _scene->setRoot(scene::IMapRootNodePtr());
+
+    return image;
+}
+
+void ThumbnailRenderer::renderSceneToFramebuffer(const AABB& bounds, int size)
+{
+    // In case it didn't happen until now, make sure the rendersystem is realised
+    _renderSystem->realise();
+    _renderSystem->startFrame();
+
+    glViewport(0, 0, size, size);
+
+    glDepthMask(GL_TRUE);
+    glClearColor(0.3f, 0.3f, 0.3f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    // Move the camera away far enough for the bounding sphere to fit into the view
+    auto radius = bounds.getRadius();
+    auto distance = radius / sin(degrees_to_radians(THUMBNAIL_FOV / 2));
+    auto viewOrigin = bounds.getOrigin() + VIEW_DIRECTION.getNormalised() * distance;
+
+    auto farClip = static_cast<float>(std::max(distance + radius * 2, 10000.0));
+    auto projection = camera::calculateProjectionMatrix(0.1f, farClip, THUMBNAIL_FOV, size, size);
+
+    render::NopRenderView view;
+    view.construct(projection, camera::calculateModelViewMatrix(viewOrigin, VIEW_ANGLES), size, size);
+    view.setViewer(viewOrigin);
+
+    glMatrixMode(GL_PROJECTION);
+    glLoadMatrixd(projection);
+
+    glMatrixMode(GL_MODELVIEW);
+    glLoadMatrixd(view.GetModelview());
+
+    // Front-end render phase, collect OpenGLRenderable objects from the scene
+    render::CamRenderer renderer(view, _shaders);
+    render::SceneRenderWalker sceneWalker(renderer, view);
+    _scene->foreachVisibleNodeInVolume(view, sceneWalker);
+
+    RenderStateFlags flags = RENDER_MASKCOLOUR |
+        RENDER_ALPHATEST |
+        RENDER_BLEND |
+        RENDER_CULLFACE |
+        RENDER_OFFSETLINE |
+        RENDER_VERTEX_COLOUR |
+        RENDER_FILL |
+        RENDER_LIGHTING |
+        RENDER_TEXTURE_2D |
+        RENDER_SMOOTH |
+        RENDER_SCALED |
+        RENDER_TEXTURE_CUBEMAP |
+        RENDER_BUMP |
+        RENDER_PROGRAM |
+        RENDER_DEPTHWRITE |
+        RENDER_DEPTHTEST;
+
+    _renderSystem->renderFullBrightScene(RenderViewType::Camera, flags, view);
+
+    _renderSystem->endFrame();
+}
+
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <string>
+#include "inode.h"
+#include "irender.h"
+#include "iscenegraph.h"
+#include "math/AABB.h"
+#include "render/CamRenderer.h"
+
+#include <wx/image.h>
+
+namespace ui
+{
+
+/**
+ * Renders small preview images of models and map subgraphs into an offscreen
+ * framebuffer, using its own scene graph and render system.
+ *
+ * All methods are issuing GL calls, the caller needs to make sure that the
+ * shared GL context is current (see IWxGLWidgetManager::makeSharedContextCurrent).
+ */
+class ThumbnailRenderer
+{
+private:
+    // Width and height of the produced images
+    int _size;
+
+    RenderSystemPtr _renderSystem;
+    scene::GraphPtr _scene;
+
+    render::CamRenderer::HighlightShaders _shaders;
+
+    // The func_static entity carrying the model to render
+    scene::IMapRootNodePtr _modelRoot;
+    scene::INodePtr _modelEntity;
+
+public:
+    ThumbnailRenderer(int size);
+
+    ~ThumbnailRenderer();
+
+    int getSize() const;
+
+    // Renders the given model (path or modelDef name) with the given skin.
+    // The model data is not added to the ModelCache.
+    // Returns an invalid image if the model could not be rendered.
+    wxImage renderModel(const std::string& model, const std::string& skin);
+
+    // Renders the given root node, fitting the view to the bounds of its children.
+    // Returns an invalid image if there's nothing to render.
+    wxImage renderScene(const scene::IMapRootNodePtr& root);
+
+private:
+    bool ensureModelScene();
+    void renderSceneToFramebuffer(const AABB& bounds, int size);
+};
+
+}
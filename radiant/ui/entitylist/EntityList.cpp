@@ -314,11 +314,10 @@ void EntityList::onSelection(wxDataViewEvent& ev)
 
 	for (std::vector<wxDataViewItem>::iterator i = diff.begin(); i != end; ++i)
 	{
-		// Load the instance pointer from the columns
-		wxutil::TreeModel::Row row(*i, *_treeModel.getModel());
-		scene::INode* node = static_cast<scene::INode*>(row[_treeModel.getColumns().node].getPointer());
+		// Look up the node, the row might belong to a node that has just been removed
+		scene::INodePtr node = _treeModel.findNode(*i);
 
-		ISelectable* selectable = dynamic_cast<ISelectable*>(node);
+		ISelectable* selectable = dynamic_cast<ISelectable*>(node.get());
 
 		if (selectable != NULL)
 		{
@@ -1,14 +1,23 @@
 #include "GraphTreeModel.h"
 
 #include <iostream>
+#include <unordered_set>
 #include "iselectable.h"
 #include "iselection.h"
+#include "entitylib.h"
 
 #include "GraphTreeModelPopulator.h"
 
 namespace ui
 {
 
+namespace
+{
+	// Up to this number of removals the rows are looked up and removed one by one,
+	// larger batches are removed in a single pass through the tree
+	const std::size_t MAX_SINGLE_ROW_REMOVALS = 16;
+}
+
 GraphTreeModel::GraphTreeModel() :
 	_model(new wxutil::TreeModel(_columns)),
 	_visibleNodesOnly(false)
@@ -29,9 +38,12 @@ void GraphTreeModel::connectToSceneGraph()
 void GraphTreeModel::disconnectFromSceneGraph()
 {
 	GlobalSceneGraph().removeSceneObserver(this);
+
+	// Changes we don't hear about anymore are of no use, the tree is refreshed on reconnection
+	clearPendingChanges();
 }
 
-const GraphTreeNodePtr& GraphTreeModel::insert(const scene::INodePtr& node)
+const GraphTreeNodePtr& GraphTreeModel::insert(const scene::INodePtr& node, bool notifyView)
 {
 	// Create a new GraphTreeNode
 	GraphTreeNodePtr gtNode(new GraphTreeNode(node));
@@ -46,11 +58,14 @@ const GraphTreeNodePtr& GraphTreeModel::insert(const scene::INodePtr& node)
 	row[_columns.node] = wxVariant(static_cast<void*>(node.get()));
 	row[_columns.name] = node->name();
 
-	row.SendItemAdded();
+	if (notifyView)
+	{
+		row.SendItemAdded();
+	}
 
 	// Insert this iterator into the node map to facilitate lookups
 	std::pair<NodeMap::iterator, bool> result = _nodemap.insert(
-		NodeMap::value_type(scene::INodeWeakPtr(node), gtNode)
+		NodeMap::value_type(node.get(), gtNode)
 	);
 
 	// Return the GraphTreeNode reference
@@ -59,7 +74,7 @@ const GraphTreeNodePtr& GraphTreeModel::insert(const scene::INodePtr& node)
 
 void GraphTreeModel::erase(const scene::INodePtr& node)
 {
-	NodeMap::iterator found = _nodemap.find(scene::INodeWeakPtr(node));
+	NodeMap::iterator found = _nodemap.find(node.get());
 
 	if (found != _nodemap.end())
 	{
@@ -73,12 +88,47 @@ void GraphTreeModel::erase(const scene::INodePtr& node)
 
 const GraphTreeNodePtr& GraphTreeModel::find(const scene::INodePtr& node) const
 {
-	NodeMap::const_iterator found = _nodemap.find(scene::INodeWeakPtr(node));
+	NodeMap::const_iterator found = _nodemap.find(node.get());
 	return (found != _nodemap.end()) ? found->second : _nullTreeNode;
 }
 
+scene::INodePtr GraphTreeModel::findNode(const wxDataViewItem& item) const
+{
+	if (!item.IsOk()) return scene::INodePtr();
+
+	wxutil::TreeModel::Row row(item, *_model);
+	NodeMap::const_iterator found = _nodemap.find(static_cast<const scene::INode*>(row[_columns.node].getPointer()));
+
+	if (found == _nodemap.end()) return scene::INodePtr();
+
+	// The row might still be around while its erasure is pending
+	scene::INodePtr node = found->second->getNode();
+
+	return node && node->inScene() ? node : scene::INodePtr();
+}
+
+bool GraphTreeModel::isListed(const scene::INodePtr& node) const
+{
+	if (node->getNodeType() == scene::INode::Type::EntityConnection)
+	{
+		return false;
+	}
+
+	if (_visibleNodesOnly && !node->visible())
+	{
+		return false;
+	}
+
+	// Don't accumulate the worldspawn brushes
+	scene::INodePtr parent = node->getParent();
+
+	return !parent || !Node_isWorldspawn(parent);
+}
+
 void GraphTreeModel::clear()
 {
+	clearPendingChanges();
+
 	// Remove everything, wx plus nodemap
 	_nodemap.clear();
 	_model->Clear();
@@ -86,6 +136,9 @@ void GraphTreeModel::clear()
 
 void GraphTreeModel::refresh()
 {
+	// The rebuild covers anything that might still be pending
+	clearPendingChanges();
+
 #if defined(__linux__)
     _model->Clear();
 #else
@@ -95,11 +148,14 @@ void GraphTreeModel::refresh()
 
 	// Instantiate a scenegraph walker and visit every node in the graph
 	// The walker also clears the graph in its constructor
-	GraphTreeModelPopulator populator(*this, _visibleNodesOnly);
+	GraphTreeModelPopulator populator(*this);
 	GlobalSceneGraph().root()->traverse(populator);
 
     // Now sort the model once we have all nodes in the tree
     _model->SortModelByColumn(_columns.name);
+
+	// The rows have been added silently, let the view pick them up in one go
+	_model->Cleared();
 }
 
 void GraphTreeModel::setConsiderVisibleNodesOnly(bool visibleOnly)
@@ -109,6 +165,9 @@ void GraphTreeModel::setConsiderVisibleNodesOnly(bool visibleOnly)
 
 void GraphTreeModel::updateSelectionStatus(const NotifySelectionUpdateFunc& notifySelectionChanged)
 {
+	// Selected nodes might still be waiting for their rows
+	flushPendingChanges();
+
     // Don't traverse the entire scenegraph, visit selected nodes only
     GlobalSelectionSystem().foreachSelected([&](const scene::INodePtr& node)
     {
@@ -119,7 +178,9 @@ void GraphTreeModel::updateSelectionStatus(const NotifySelectionUpdateFunc& noti
 void GraphTreeModel::updateSelectionStatus(const scene::INodePtr& node,
 										   const NotifySelectionUpdateFunc& notifySelectionChanged)
 {
-	NodeMap::const_iterator found = _nodemap.find(scene::INodeWeakPtr(node));
+	flushPendingChanges();
+
+	NodeMap::const_iterator found = _nodemap.find(node.get());
 
 	GraphTreeNodePtr foundNode;
 
@@ -153,7 +214,7 @@ const GraphTreeNodePtr& GraphTreeModel::findParentNode(const scene::INodePtr& no
 	}
 
 	// Try to find the node
-	NodeMap::const_iterator found = _nodemap.find(scene::INodeWeakPtr(parent));
+	NodeMap::const_iterator found = _nodemap.find(parent.get());
 
 	// Return NULL (empty shared_ptr) if not found
 	return (found != _nodemap.end()) ? found->second : _nullTreeNode;
@@ -178,16 +239,151 @@ wxutil::TreeModel::Ptr GraphTreeModel::getModel()
 	return _model;
 }
 
+void GraphTreeModel::flushPendingChanges()
+{
+	flushIdleCallback();
+}
+
+void GraphTreeModel::clearPendingChanges()
+{
+	cancelCallbacks();
+
+	_pendingInsertions.clear();
+	_pendingErasures.clear();
+}
+
+void GraphTreeModel::onIdle()
+{
+	// Erasures go first, a node might have been removed and re-inserted
+	// (undo/redo), in which case it needs a fresh row at its new place
+	processPendingErasures();
+	processPendingInsertions();
+}
+
+void GraphTreeModel::processPendingErasures()
+{
+	if (_pendingErasures.empty()) return;
+
+	if (_pendingErasures.size() <= MAX_SINGLE_ROW_REMOVALS)
+	{
+		for (const scene::INode* node : _pendingErasures)
+		{
+			NodeMap::iterator found = _nodemap.find(node);
+
+			// Nodes that never made it into the tree are ignored
+			if (found != _nodemap.end())
+			{
+				_model->RemoveItem(found->second->getIter());
+				_nodemap.erase(found);
+			}
+		}
+	}
+	else
+	{
+		std::unordered_set<const scene::INode*> nodesToRemove(_pendingErasures.begin(), _pendingErasures.end());
+
+		_model->RemoveItems([&](const wxutil::TreeModel::Row& row)
+		{
+			return nodesToRemove.count(static_cast<const scene::INode*>(row[_columns.node].getPointer())) > 0;
+		});
+
+		for (const scene::INode* node : nodesToRemove)
+		{
+			_nodemap.erase(node);
+		}
+	}
+
+	_pendingErasures.clear();
+}
+
+void GraphTreeModel::processPendingInsertions()
+{
+	if (_pendingInsertions.empty()) return;
+
+	std::vector<GraphTreeNodePtr> newNodes;
+
+	for (const scene::INodeWeakPtr& weakNode : _pendingInsertions)
+	{
+		scene::INodePtr node = weakNode.lock();
+
+		// Skip the nodes that have been removed again in the meantime
+		if (node && node->inScene())
+		{
+			insertWithParents(node, newNodes);
+		}
+	}
+
+	_pendingInsertions.clear();
+
+	// Collect the parents which received new children, in the order of their first
+	// new child. Since parents are inserted before their children, a new parent
+	// is always listed before the new rows below it.
+	std::vector<wxDataViewItem> parents;
+	std::unordered_set<void*> knownParents;
+	std::unordered_set<void*> newItems;
+
+	for (const GraphTreeNodePtr& gtNode : newNodes)
+	{
+		newItems.insert(gtNode->getIter().GetID());
+
+		wxDataViewItem parent = _model->GetParent(gtNode->getIter());
+
+		if (knownParents.insert(parent.GetID()).second)
+		{
+			parents.push_back(parent);
+		}
+	}
+
+	// Sort each affected set of siblings once, then notify the view
+	// about the new rows in their sorted order
+	for (const wxDataViewItem& parent : parents)
+	{
+		_model->SortChildrenByColumn(parent, _columns.name);
+
+		wxDataViewItemArray children;
+		_model->GetChildren(parent, children);
+
+		for (const wxDataViewItem& child : children)
+		{
+			if (newItems.count(child.GetID()) > 0)
+			{
+				_model->ItemAdded(parent, child);
+			}
+		}
+	}
+}
+
+void GraphTreeModel::insertWithParents(const scene::INodePtr& node, std::vector<GraphTreeNodePtr>& newNodes)
+{
+	if (_nodemap.find(node.get()) != _nodemap.end() || !isListed(node))
+	{
+		return;
+	}
+
+	// The parent needs its row first, it might be queued for insertion too
+	scene::INodePtr parent = node->getParent();
+
+	if (parent && _nodemap.find(parent.get()) == _nodemap.end())
+	{
+		insertWithParents(parent, newNodes);
+	}
+
+	newNodes.push_back(insert(node, false));
+}
+
 // Gets called when a new <instance> is inserted into the scenegraph
 void GraphTreeModel::onSceneNodeInsert(const scene::INodePtr& node)
 {
-	insert(node); // wrap to the actual insert() method
+	_pendingInsertions.emplace_back(node);
+	requestIdleCallback();
 }
 
 // Gets called when <instance> is removed from the scenegraph
 void GraphTreeModel::onSceneNodeErase(const scene::INodePtr& node)
 {
-	erase(node); // wrap to the actual erase() method
+	// A pending insertion of this node is skipped once it's found to be out of the scene
+	_pendingErasures.push_back(node.get());
+	requestIdleCallback();
 }
 
 } // namespace ui
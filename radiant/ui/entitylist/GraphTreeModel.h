@@ -1,11 +1,13 @@
 #pragma once
 
 #include <memory>
-#include <map>
+#include <vector>
+#include <unordered_map>
 #include "iscenegraph.h"
 #include "GraphTreeNode.h"
 
 #include "wxutil/dataview/TreeModel.h"
+#include "wxutil/event/SingleIdleCallback.h"
 
 namespace ui
 {
@@ -16,9 +18,15 @@ namespace ui
  *
  * The class provides basic routines to insert/remove scene::INodePtrs
  * into the model (the lookup should be performed fast).
+ *
+ * Insertions and removals reported by the scenegraph are not applied
+ * right away, they are collected and processed in one batch when the
+ * application is idle, such that loading or pasting large amounts of
+ * nodes doesn't cause a view update (and sort) per node.
  */
 class GraphTreeModel :
-	public scene::Graph::Observer
+	public scene::Graph::Observer,
+	private wxutil::SingleIdleCallback
 {
 public:
 	struct TreeColumns :
@@ -34,10 +42,17 @@ public:
 	};
 
 private:
-	// This maps scene::Nodes to TreeNode structures to allow fast lookups in the tree
-    typedef std::map<scene::INodeWeakPtr, GraphTreeNodePtr, std::owner_less<scene::INodeWeakPtr> > NodeMap;
+	// This maps scene::Nodes to TreeNode structures to allow fast lookups in the tree.
+	// The raw pointer is used as key only, it is never dereferenced, since
+	// the node might already be gone when its erasure is processed.
+	typedef std::unordered_map<const scene::INode*, GraphTreeNodePtr> NodeMap;
 	NodeMap _nodemap;
 
+	// Scene changes waiting to be processed in the next idle cycle,
+	// both are kept in the order they have been reported
+	std::vector<scene::INodeWeakPtr> _pendingInsertions;
+	std::vector<const scene::INode*> _pendingErasures;
+
 	// The NULL treenode, must always be empty
 	const GraphTreeNodePtr _nullTreeNode;
 
@@ -52,21 +67,32 @@ public:
 	GraphTreeModel();
 	~GraphTreeModel();
 
-	// Inserts the instance into the tree, returns the GtkTreeIter*
-	const GraphTreeNodePtr& insert(const scene::INodePtr& node);
+	// Inserts the instance into the tree, returns the GraphTreeNode.
+	// The view is not notified if notifyView is false, this is up to the caller then.
+	const GraphTreeNodePtr& insert(const scene::INodePtr& node, bool notifyView = true);
 	// Removes the given instance from the tree
 	void erase(const scene::INodePtr& node);
 
 	// Tries to lookup the given node in the tree, can return the NULL node
 	const GraphTreeNodePtr& find(const scene::INodePtr& node) const;
 
+	// Returns the node displayed in the given row, or an empty pointer
+	// if the node has been removed from the scene in the meantime
+	scene::INodePtr findNode(const wxDataViewItem& item) const;
+
+	// Returns true if the given node should be listed in the tree
+	bool isListed(const scene::INodePtr& node) const;
+
+	// Applies all pending scene changes right now
+	void flushPendingChanges();
+
 	// Remove everything from the TreeModel
 	void clear();
 
 	// Set whether invisible nodes should be considered, does NOT trigger a refresh!
 	void setConsiderVisibleNodesOnly(bool visibleOnly);
 
-	// Rebuilds the entire tree using a scene::Graph::Walker
+	// Rebuilds the entire tree using a scene::Graph::Walker, discarding any pending changes.
     // This will clear the internal wxutil::TreeModel and create a new one, so be 
     // sure to associate the TreeView with the new model by calling getModel()
 	void refresh();
@@ -101,6 +127,18 @@ private:
 	// Tries to lookup the iterator to the parent item of the given node,
 	// returns NULL if not found
 	wxDataViewItem findParentIter(const scene::INodePtr& node) const;
+
+	void clearPendingChanges();
+	void processPendingErasures();
+	void processPendingInsertions();
+
+	// Creates the row for the given node, which is assumed to be in the scene
+	// but not yet present in the tree. Parents waiting in the insertion
+	// queue are inserted first, the new rows are added to the given list.
+	void insertWithParents(const scene::INodePtr& node, std::vector<GraphTreeNodePtr>& newNodes);
+
+	// SingleIdleCallback implementation
+	void onIdle() override;
 };
 
 } // namespace ui
@@ -19,12 +19,9 @@ private:
 	// The model to be populated
 	GraphTreeModel& _model;
 
-	bool _visibleNodesOnly;
-
 public:
-	GraphTreeModelPopulator(GraphTreeModel& model, bool visibleNodesOnly) :
-		_model(model),
-		_visibleNodesOnly(visibleNodesOnly)
+	GraphTreeModelPopulator(GraphTreeModel& model) :
+		_model(model)
 	{
 		// Clear out the model before traversal
 		_model.clear();
@@ -33,10 +30,10 @@ public:
 	// NodeVisitor implementation
 	bool pre(const scene::INodePtr& node)
 	{
-		if ((!_visibleNodesOnly || node->visible()) && node->getNodeType() != scene::INode::Type::EntityConnection)
+		if (_model.isListed(node))
 		{
-			// Insert this node into the GraphTreeModel
-			_model.insert(node);
+			// Insert this node into the GraphTreeModel, the view is notified after population
+			_model.insert(node, false);
 		}
 
 		Entity* ent = Node_getEntity(node);
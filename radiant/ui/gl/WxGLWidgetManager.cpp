@@ -33,6 +33,19 @@ void WxGLWidgetManager::unregisterGLWidget(wxutil::GLWidget* widget)
 	}
 }
 
+bool WxGLWidgetManager::makeSharedContextCurrent()
+{
+	for (auto widget : _wxGLWidgets)
+	{
+		if (widget->MakeSharedContextCurrent())
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
 const std::string& WxGLWidgetManager::getName() const
 {
 	static std::string _name(MODULE_WXGLWIDGET_MANAGER);
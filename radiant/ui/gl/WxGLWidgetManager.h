@@ -15,6 +15,7 @@ private:
 public:
 	void registerGLWidget(wxutil::GLWidget* widget) override;
 	void unregisterGLWidget(wxutil::GLWidget* widget) override;
+	bool makeSharedContextCurrent() override;
 
 	// RegisterableModule implementation
 	const std::string& getName() const override;
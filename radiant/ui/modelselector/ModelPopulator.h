@@ -8,6 +8,8 @@
 
 #include "ifilesystem.h"
 #include "ieclass.h"
+#include "imodelcache.h"
+#include "modelskin.h"
 #include "i18n.h"
 #include "string/string.h"
 #include "os/path.h"
@@ -42,6 +44,8 @@ private:
 	std::set<std::string> _allowedExtensions;
 
 public:
+    // The key of the model tree in the ResourceTreeModelCache
+    static constexpr const char* const CACHE_KEY = "Models";
 
 	// Constructor sets the populator
     ModelPopulator(const ModelTreeView::TreeColumns& columns) :
@@ -53,6 +57,14 @@ public:
 		// Load the allowed extensions
 		std::string extensions = GlobalGameManager().currentGame()->getKeyValue("modeltypes");
 		string::split(_allowedExtensions, extensions, " ");
+
+        // The tree is listing model files, skins and modelDefs, anything reloading these invalidates it
+        EnableModelCache(CACHE_KEY, {
+            GlobalFileSystem().signal_Initialised(),
+            GlobalModelCache().signal_modelsReloaded(),
+            GlobalModelSkinCache().signal_skinsReloaded(),
+            GlobalEntityClassManager().defsReloadedSignal()
+        });
 	}
 
     ~ModelPopulator()
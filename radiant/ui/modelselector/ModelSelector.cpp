@@ -389,7 +389,7 @@ void ModelSelector::onRescanFolders(wxCommandEvent& ev)
     findNamedObject<wxButton>(this, "ModelSelectorRescanFoldersButton")->Enable(false);
 
     // This will fire the onTreeViewPopulationFinished event when done
-    populateModels();
+    _treeView->Rescan();
 }
 
 } // namespace ui
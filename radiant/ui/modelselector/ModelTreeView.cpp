@@ -1,21 +1,44 @@
 #include "ModelTreeView.h"
 
+#include "ieclass.h"
 #include "ModelPopulator.h"
+#include "ui/common/ThumbnailRenderer.h"
+#include "wxutil/dataview/ResourceTreeModelCache.h"
 
 namespace ui
 {
 
+namespace
+{
+    const int THUMBNAIL_SIZE = 40;
+}
+
 ModelTreeView::ModelTreeView(wxWindow* parent) :
     ResourceTreeView(parent, Columns(), wxBORDER_STATIC | wxDV_NO_HEADER),
-    _showSkins(true)
+    _showSkins(true),
+    _thumbnails(std::make_shared<ThumbnailCache>(THUMBNAIL_SIZE))
 {
-    // Single visible column, containing the directory/shader name and the icon
-    AppendIconTextColumn(
+    // The thumbnails are aligned in the first column
+    AppendBitmapColumn(
+        "", Columns().thumbnail.getColumnIndex(),
+        wxDATAVIEW_CELL_INERT, THUMBNAIL_SIZE + 6
+    );
+
+    // Column containing the directory/shader name and the icon, showing the tree structure
+    auto* nameColumn = AppendIconTextColumn(
         _("Model Path"), Columns().iconAndName.getColumnIndex(),
         wxDATAVIEW_CELL_INERT, wxCOL_WIDTH_AUTOSIZE,
         wxALIGN_NOT, wxDATAVIEW_COL_SORTABLE
     );
 
+    SetExpanderColumn(nameColumn);
+    SetRowHeight(THUMBNAIL_SIZE + 2);
+
+    // Thumbnails are requested for the items becoming visible
+    Bind(wxEVT_DATAVIEW_ITEM_EXPANDED, &ModelTreeView::_onItemExpanded, this);
+    _thumbnails->signal_thumbnailReady().connect(
+        sigc::mem_fun(this, &ModelTreeView::_onThumbnailReady));
+
     // Use the TreeModel's full string search function
     AddSearchColumn(Columns().iconAndName);
     EnableFavouriteManagement(decl::Type::Model);
@@ -34,9 +57,22 @@ std::string ModelTreeView::GetResourcePath(const wxutil::TreeModel::Row& row)
 
 void ModelTreeView::Populate()
 {
+    // A new tree is populated after models or skins have been reloaded,
+    // the thumbnails need to be rendered again in this case
+    if (!wxutil::ResourceTreeModelCache::Get(ModelPopulator::CACHE_KEY))
+    {
+        _thumbnails->clear();
+    }
+
     ResourceTreeView::Populate(std::make_shared<ModelPopulator>(Columns()));
 }
 
+void ModelTreeView::Rescan()
+{
+    wxutil::ResourceTreeModelCache::Invalidate(ModelPopulator::CACHE_KEY);
+    Populate();
+}
+
 void ModelTreeView::SetShowSkins(bool showSkins)
 {
     if (_showSkins == showSkins)
@@ -110,4 +146,76 @@ std::string ModelTreeView::GetColumnValue(const wxutil::TreeModel::Column& colum
     return row[column];
 }
 
+void ModelTreeView::RequestThumbnailsOfChildren(const wxDataViewItem& parent)
+{
+    wxDataViewItemArray children;
+    GetModel()->GetChildren(parent, children);
+
+    // The most recent request is served first, start at the bottom
+    for (auto i = children.rbegin(); i != children.rend(); ++i)
+    {
+        RequestThumbnail(*i);
+    }
+}
+
+void ModelTreeView::RequestThumbnail(const wxDataViewItem& item)
+{
+    wxutil::TreeModel::Row row(item, *GetTreeModel());
+
+    if (row[Columns().isFolder].getBool() || !row[Columns().thumbnail].getVariant().IsNull())
+    {
+        return;
+    }
+
+    std::string modelPath = row[Columns().modelPath];
+    std::string skin = row[Columns().skin];
+
+    if (modelPath.empty()) return;
+
+    // The thumbnail of a modelDef is outdated when its mesh changes
+    auto modelDef = GlobalEntityClassManager().findModel(modelPath);
+
+    ThumbnailCache::Request request;
+    request.key = row[Columns().fullName];
+    request.filePath = modelDef ? modelDef->mesh : modelPath;
+    request.render = [modelPath, skin](ThumbnailRenderer& renderer)
+    {
+        return renderer.renderModel(modelPath, skin);
+    };
+
+    auto thumbnail = _thumbnails->getThumbnail(request);
+
+    if (thumbnail.IsOk())
+    {
+        SetThumbnail(item, thumbnail);
+    }
+}
+
+void ModelTreeView::SetThumbnail(const wxDataViewItem& item, const wxBitmap& thumbnail)
+{
+    // The tree model might be shared with other views, they'll get the thumbnail too
+    wxutil::TreeModel::Row row(item, *GetTreeModel());
+
+    row[Columns().thumbnail] = wxVariant(thumbnail);
+    row.SendItemChanged();
+}
+
+void ModelTreeView::_onItemExpanded(wxDataViewEvent& ev)
+{
+    RequestThumbnailsOfChildren(ev.GetItem());
+    ev.Skip();
+}
+
+void ModelTreeView::_onThumbnailReady(const std::string& fullName, const wxBitmap& thumbnail)
+{
+    if (!thumbnail.IsOk()) return;
+
+    auto item = GetTreeModel()->FindString(fullName, Columns().fullName);
+
+    if (item.IsOk())
+    {
+        SetThumbnail(item, thumbnail);
+    }
+}
+
 }
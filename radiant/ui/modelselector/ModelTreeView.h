@@ -1,6 +1,7 @@
 #pragma once
 
 #include "wxutil/dataview/ResourceTreeView.h"
+#include "ui/common/ThumbnailCache.h"
 
 namespace ui
 {
@@ -17,7 +18,8 @@ public:
             modelPath(add(wxutil::TreeModel::Column::String)),
             skin(add(wxutil::TreeModel::Column::String)),
             isSkin(add(wxutil::TreeModel::Column::Boolean)),
-            isModelDefFolder(add(wxutil::TreeModel::Column::Boolean))
+            isModelDefFolder(add(wxutil::TreeModel::Column::Boolean)),
+            thumbnail(add(wxutil::TreeModel::Column::Icon))
         {}
 
         // iconAndName column contains the filename, e.g. "chair1.lwo"
@@ -26,6 +28,7 @@ public:
         wxutil::TreeModel::Column modelPath;// e.g. "models/darkmod/props/chair1.lwo"
         wxutil::TreeModel::Column isSkin;	// TRUE if this is a skin entry, FALSE if actual model or folder
         wxutil::TreeModel::Column isModelDefFolder;	// TRUE if this is the model def folder, which should sort last
+        wxutil::TreeModel::Column thumbnail;	// Preview image, assigned when the item's parent is expanded
     };
 
 private:
@@ -34,12 +37,19 @@ private:
     wxDataViewItem _progressItem;
     wxIcon _modelIcon;
 
+    // Renders the thumbnails of the models and skins listed in the tree
+    ThumbnailCache::Ptr _thumbnails;
+
 public:
     ModelTreeView(wxWindow* parent);
 
-    // Start populating the model tree in the background
+    // Start populating the model tree in the background. The tree is shared
+    // by all views until the VFS, the skins or the decls are reloaded.
     void Populate();
 
+    // Discards the shared tree and populates it again
+    void Rescan();
+
     void SetShowSkins(bool showSkins);
 
     std::string GetSelectedModelPath();
@@ -58,6 +68,13 @@ protected:
 
 private:
     std::string GetColumnValue(const wxutil::TreeModel::Column& column);
+
+    void RequestThumbnailsOfChildren(const wxDataViewItem& parent);
+    void RequestThumbnail(const wxDataViewItem& item);
+    void SetThumbnail(const wxDataViewItem& item, const wxBitmap& thumbnail);
+
+    void _onItemExpanded(wxDataViewEvent& ev);
+    void _onThumbnailReady(const std::string& fullName, const wxBitmap& thumbnail);
 };
 
 }
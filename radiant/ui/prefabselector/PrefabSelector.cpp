@@ -26,6 +26,7 @@
 #include <wx/radiobut.h>
 
 #include "entitylib.h"
+#include "ui/common/ThumbnailRenderer.h"
 
 #include "string/trim.h"
 #include "string/case_conv.h"
@@ -50,6 +51,8 @@ namespace
     const std::string RKEY_RECENT_PREFAB_PATHS = RKEY_BASE + "recentPaths";
 	const std::string RKEY_INSERT_AS_GROUP = RKEY_BASE + "insertAsGroup";
 	const std::string RKEY_RECALCULATE_PREFAB_ORIGIN = RKEY_BASE + "recalculatePrefabOrigin";
+
+    const int THUMBNAIL_SIZE = 40;
 }
 
 // Constructor.
@@ -349,6 +352,43 @@ void PrefabSelector::setupTreeView(wxWindow* parent)
 
     _treeView->SetFileExtensions(fileExtensions);
     _treeView->SetDefaultFileIcon(PREFAB_FILE_ICON);
+
+    _thumbnails = std::make_shared<ThumbnailCache>(THUMBNAIL_SIZE);
+    _thumbnails->signal_thumbnailReady().connect([this](const std::string& prefabPath, const wxBitmap& thumbnail)
+    {
+        if (thumbnail.IsOk())
+        {
+            _treeView->SetThumbnail(prefabPath, thumbnail);
+        }
+    });
+
+    _treeView->EnableThumbnails(THUMBNAIL_SIZE, [this](const std::string& prefabPath)
+    {
+        return requestThumbnail(prefabPath);
+    });
+}
+
+wxBitmap PrefabSelector::requestThumbnail(const std::string& prefabPath)
+{
+    ThumbnailCache::Request request;
+
+    request.key = prefabPath;
+    request.filePath = prefabPath;
+    request.render = [prefabPath](ThumbnailRenderer& renderer)
+    {
+        // Use a separate resource, the one of the preview is attached to its own scene
+        auto resource = GlobalMapResourceManager().createFromPath(prefabPath);
+
+        if (!resource) return wxImage();
+
+        registry::ScopedKeyChanger<bool> changer(
+            RKEY_MAP_SUPPRESS_LOAD_STATUS_DIALOG, true
+        );
+
+        return resource->load() ? renderer.renderScene(resource->getRootNode()) : wxImage();
+    };
+
+    return _thumbnails->getThumbnail(request);
 }
 
 std::string PrefabSelector::getPrefabFolder()
@@ -379,6 +419,9 @@ void PrefabSelector::populatePrefabs()
 
 void PrefabSelector::onRescanPrefabs(wxCommandEvent& ev)
 {
+	// Prefabs might have changed on disk, their thumbnails will be looked up again
+	_thumbnails->clear();
+
 	populatePrefabs();
 }
 
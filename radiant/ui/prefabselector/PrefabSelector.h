@@ -9,6 +9,7 @@
 #include "wxutil/fsview/FileSystemView.h"
 #include "wxutil/PathEntry.h"
 #include "ui/common/MapPreview.h"
+#include "ui/common/ThumbnailCache.h"
 
 #include <memory>
 #include <string>
@@ -47,6 +48,9 @@ private:
 	// Main tree view with the folder hierarchy
 	wxutil::FileSystemView* _treeView;
 
+	// Preview images shown next to the prefab names
+	ThumbnailCache::Ptr _thumbnails;
+
 	// The window position tracker
 	wxutil::WindowPosition _position;
 	wxutil::PanedPosition _panedPosition;
@@ -54,6 +58,8 @@ private:
 	// Last selected prefab, 
 	std::string _lastPrefab;
 
+	// The previewed prefab, stays loaded after the dialog has been closed:
+	// inserting the chosen prefab copies its nodes instead of parsing the file again
 	IMapResourcePtr _mapResource;
 
 	wxTextCtrl* _description;
@@ -87,6 +93,9 @@ private:
 	// Populate the tree view with prefabs
 	void populatePrefabs();
 
+	// Returns the thumbnail of the given prefab, or an invalid bitmap if it is not available yet
+	wxBitmap requestThumbnail(const std::string& prefabPath);
+
     // Get the path that should be used for prefab population
     // This reflects the settings made by the user on the top of the selector window
     std::string getPrefabFolder();
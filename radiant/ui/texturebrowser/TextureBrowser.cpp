@@ -52,6 +52,13 @@ namespace
 
     const int VIEWPORT_BORDER = 12;
     const int TILE_BORDER = 2;
+
+    // Textures of tiles within this many viewport heights above or below the
+    // visible area are loaded in advance, to have them ready when scrolling
+    const int PREFETCH_VIEWPORTS = 1;
+
+    // Textures of tiles further away than this are released again
+    const int RELEASE_VIEWPORTS = 4;
 }
 
 class TextureBrowser::TextureTile
@@ -63,8 +70,12 @@ public:
     Vector2i position;
     MaterialPtr material;
 
+    // True if this tile requested the material's editor image
+    bool textureLoaded;
+
     TextureTile(TextureBrowser& owner) :
-        _owner(owner)
+        _owner(owner),
+        textureLoaded(false)
     {}
 
     bool isVisible()
@@ -72,25 +83,46 @@ public:
         return _owner.materialIsVisible(material);
     }
 
+    // Returns true if this tile is less than <margin> pixels away from the visible area
+    bool isNearViewport(int margin)
+    {
+        return position.y() - size.y() - FONT_HEIGHT() < _owner.getOriginY() + margin &&
+            position.y() > _owner.getOriginY() - _owner.getViewportHeight() - margin;
+    }
+
+    void loadTexture()
+    {
+        if (textureLoaded) return;
+
+        material->getEditorImage();
+        textureLoaded = true;
+    }
+
+    void releaseTexture()
+    {
+        if (!textureLoaded) return;
+
+        material->releaseEditorImage();
+        textureLoaded = false;
+    }
+
     void render(bool drawName)
     {
-        if (!isVisible())
+        // Is this texture visible?
+        if (!isNearViewport(0) || !isVisible())
         {
             return;
         }
 
         TexturePtr texture = material->getEditorImage();
+        textureLoaded = true;
+
         if (!texture) return;
 
-        // Is this texture visible?
-        if ((position.y() - size.y() - FONT_HEIGHT() < _owner.getOriginY()) &&
-            (position.y() > _owner.getOriginY() - _owner.getViewportHeight()))
-        {
-            drawBorder();
-            drawTextureQuad(texture->getGLTexNum());
-            if (drawName)
-                drawTextureName();
-        }
+        drawBorder();
+        drawTextureQuad(texture->getGLTexNum());
+        if (drawName)
+            drawTextureName();
     }
 
 private:
@@ -461,14 +493,14 @@ void TextureBrowser::onFavouritesChanged()
 }
 
 // Return the display width of a texture in the texture browser
-int TextureBrowser::getTextureWidth(const Texture& tex) const
+int TextureBrowser::getTextureWidth(std::size_t width, std::size_t height) const
 {
     if (!_useUniformScale)
     {
         // Don't use uniform scale
-        return static_cast<int>(tex.getWidth() * (static_cast<float>(_textureScale) / 100));
+        return static_cast<int>(width * (static_cast<float>(_textureScale) / 100));
     }
-    else if (tex.getWidth() >= tex.getHeight())
+    else if (width >= height)
     {
         // Texture is square, or wider than it is tall
         return _uniformTextureSize;
@@ -477,19 +509,19 @@ int TextureBrowser::getTextureWidth(const Texture& tex) const
     {
         // Otherwise, preserve the texture's aspect ratio
         return static_cast<int>(_uniformTextureSize *
-            (static_cast<float>(tex.getWidth()) / tex.getHeight())
+            (static_cast<float>(width) / height)
         );
     }
 }
 
-int TextureBrowser::getTextureHeight(const Texture& tex) const
+int TextureBrowser::getTextureHeight(std::size_t width, std::size_t height) const
 {
     if (!_useUniformScale)
     {
         // Don't use uniform scale
-        return static_cast<int>(tex.getHeight() * (static_cast<float>(_textureScale) / 100));
+        return static_cast<int>(height * (static_cast<float>(_textureScale) / 100));
     }
-    else if (tex.getHeight() >= tex.getWidth())
+    else if (height >= width)
     {
         // Texture is square, or taller than it is wide
         return _uniformTextureSize;
@@ -499,7 +531,7 @@ int TextureBrowser::getTextureHeight(const Texture& tex) const
         // Otherwise, preserve the texture's aspect ratio
         return static_cast<int>(
             _uniformTextureSize
-            * (static_cast<float>(tex.getHeight()) / tex.getWidth())
+            * (static_cast<float>(height) / width)
         );
     }
 }
@@ -536,10 +568,10 @@ public:
 };
 
 Vector2i TextureBrowser::getPositionForTexture(CurrentPosition& currentPos,
-                                               const Texture& tex) const
+                                               const Vector2i& tileSize) const
 {
-    int nWidth = getTextureWidth(tex);
-    int nHeight = getTextureHeight(tex);
+    int nWidth = tileSize.x();
+    int nHeight = tileSize.y();
 
     // Wrap to the next row if there is not enough horizontal space for this
     // texture
@@ -684,6 +716,18 @@ void TextureBrowser::performUpdate()
 
     _updateNeeded = false;
 
+    // Remember the materials whose textures have been loaded by the old tiles,
+    // the new tiles are taking over or these are released below
+    std::set<MaterialPtr> loadedMaterials;
+
+    for (const auto& tile : _tiles)
+    {
+        if (tile.textureLoaded)
+        {
+            loadedMaterials.insert(tile.material);
+        }
+    }
+
     // Update all renderable items
     _tiles.clear();
 
@@ -704,12 +748,26 @@ void TextureBrowser::performUpdate()
         TextureTile& tile = _tiles.back();
 
         tile.material = mat;
+        tile.textureLoaded = loadedMaterials.erase(mat) > 0;
 
-        Texture& texture = *tile.material->getEditorImage();
+        // The layout only needs the image dimensions, which can usually be read
+        // from the file header. The texture itself is loaded once the tile is
+        // scrolled into view.
+        std::size_t width = 0;
+        std::size_t height = 0;
 
-        tile.position = getPositionForTexture(layout, texture);
-        tile.size.x() = getTextureWidth(texture);
-        tile.size.y() = getTextureHeight(texture);
+        if (!mat->getEditorImageDimensions(width, height))
+        {
+            auto texture = mat->getEditorImage();
+            tile.textureLoaded = true;
+
+            width = texture->getWidth();
+            height = texture->getHeight();
+        }
+
+        tile.size.x() = getTextureWidth(width, height);
+        tile.size.y() = getTextureHeight(width, height);
+        tile.position = getPositionForTexture(layout, tile.size);
 
         _entireSpaceHeight = std::max(
             _entireSpaceHeight,
@@ -717,10 +775,34 @@ void TextureBrowser::performUpdate()
         );
     });
 
+    // Materials that are no longer shown don't need their textures anymore
+    for (const auto& material : loadedMaterials)
+    {
+        material->releaseEditorImage();
+    }
+
     updateScroll();
     clampOriginY(); // scroll value might be out of range after the update
 }
 
+void TextureBrowser::updateTileTextures()
+{
+    int prefetchMargin = getViewportHeight() * PREFETCH_VIEWPORTS;
+    int releaseMargin = getViewportHeight() * RELEASE_VIEWPORTS;
+
+    for (TextureTile& tile : _tiles)
+    {
+        if (tile.isNearViewport(prefetchMargin))
+        {
+            tile.loadTexture();
+        }
+        else if (!tile.isNearViewport(releaseMargin))
+        {
+            tile.releaseTexture();
+        }
+    }
+}
+
 void TextureBrowser::onActiveShadersChanged()
 {
     queueUpdate();
@@ -821,6 +903,8 @@ void TextureBrowser::draw()
     glEnable (GL_TEXTURE_2D);
 	glPolygonMode (GL_FRONT_AND_BACK, GL_FILL);
 
+    updateTileTextures();
+
     for (TextureTile& tile : _tiles)
     {
         tile.render(_showNamesKey.get());
@@ -163,15 +163,19 @@ private:
     // This gets called by the ShaderSystem
     void onActiveShadersChanged();
 
-    // Return the display width/height of a texture in the texture browser
-    int getTextureWidth(const Texture& tex) const;
-    int getTextureHeight(const Texture& tex) const;
+    // Return the display width/height of a texture with the given image size in the texture browser
+    int getTextureWidth(std::size_t width, std::size_t height) const;
+    int getTextureHeight(std::size_t width, std::size_t height) const;
 
-    // Get a new position for the given texture, and advance the CurrentPosition
+    // Get a new position for a tile of the given size, and advance the CurrentPosition
     // state object.
     class CurrentPosition;
     Vector2i getPositionForTexture(CurrentPosition& layout,
-                                   const Texture& texture) const;
+                                   const Vector2i& tileSize) const;
+
+    // Loads the textures of the tiles in and around the visible area,
+    // and releases the ones of tiles which are far off-screen
+    void updateTileTextures();
 
     bool checkSeekInMediaBrowser(); // sensitivity check
     void onSeekInMediaBrowser();
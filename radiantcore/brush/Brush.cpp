@@ -10,6 +10,7 @@
 #include "Face.h"
 #include "FixedWinding.h"
 #include "math/Ray.h"
+#include "time/ProfilingSession.h"
 
 #include <functional>
 
@@ -319,6 +320,21 @@ void Brush::undoSave()
     }
 }
 
+std::size_t Brush::getMemoryUsage() const
+{
+    auto total = util::getHeapSize(m_faces) + util::getHeapSize(_faceCentroidPoints) +
+        util::getHeapSize(_uniqueVertexPoints) + util::getHeapSize(_uniqueEdgePoints) +
+        util::getHeapSize(m_select_vertices) + util::getHeapSize(m_select_edges) +
+        util::getHeapSize(_edgeIndices) + util::getHeapSize(_edgeFaces);
+
+    for (const auto& face : m_faces)
+    {
+        total += face->getMemoryUsage();
+    }
+
+    return total;
+}
+
 IUndoMementoPtr Brush::exportState() const
 {
     return IUndoMementoPtr(new BrushUndoMemento(m_faces, _detailFlag));
@@ -1158,6 +1174,8 @@ std::size_t ProximalVertexArray_index(const ProximalVertexArray& array, const Pr
 
 /// \brief Constructs the face windings and updates anything that depends on them.
 void Brush::buildBRep() {
+  util::ScopedProfilingStage stage("Brush B-rep construction");
+
   bool degenerate = buildWindings();
 
   static const Vector3& colourVertexVec = GlobalBrush().getSettings().getVertexColour();
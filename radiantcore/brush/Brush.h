@@ -10,6 +10,7 @@
 
 #include <sigc++/signal.h>
 #include "util/Noncopyable.h"
+#include "util/MemoryUsage.h"
 
 class IRenderableCollector;
 class Ray;
@@ -153,6 +154,12 @@ public:
 
 		virtual ~BrushUndoMemento() {}
 
+		// The faces are shared with the brush, they submit their own mementos
+		std::size_t getMemoryUsage() const override
+		{
+			return sizeof(*this) + util::getHeapSize(_faces);
+		}
+
 		Faces _faces;
 		DetailFlag _detailFlag;
 	};
@@ -239,6 +246,9 @@ public:
 	IUndoMementoPtr exportState() const override;
 	void importState(const IUndoMementoPtr& state) override;
 
+	// The approximate heap memory held by the faces, windings and cached vertex data of this brush
+	std::size_t getMemoryUsage() const;
+
 	/// \brief Appends a copy of \p face to the end of the face list.
 	FacePtr addFace(const Face& face);
 
@@ -7,10 +7,12 @@
 #include "ifilter.h"
 #include "igame.h"
 #include "ilayer.h"
+#include "iscenegraph.h"
 #include "brush/BrushNode.h"
 #include "brush/BrushClipPlane.h"
 #include "brush/BrushVisit.h"
 #include "gamelib.h"
+#include "util/PoolAllocator.h"
 
 #include "registry/registry.h"
 #include "ipreferencesystem.h"
@@ -71,7 +73,8 @@ void BrushModuleImpl::toggleTextureLock() {
 
 scene::INodePtr BrushModuleImpl::createBrush()
 {
-	scene::INodePtr node = std::make_shared<BrushNode>();
+	// Brushes come in large numbers, allocate them from a pool to keep them close together
+	scene::INodePtr node = util::makePooledShared<BrushNode>();
 
 	if (GlobalMapModule().getRoot())
 	{
@@ -100,6 +103,7 @@ const StringSet& BrushModuleImpl::getDependencies() const {
 		_dependencies.insert(MODULE_GAMEMANAGER);
 		_dependencies.insert(MODULE_XMLREGISTRY);
 		_dependencies.insert(MODULE_PREFERENCESYSTEM);
+		_dependencies.insert(MODULE_MEMORY_ACCOUNTING);
 	}
 
 	return _dependencies;
@@ -127,18 +131,58 @@ void BrushModuleImpl::initialiseModule(const IApplicationContext& ctx) {
 
 	_faceTexDefChanged = Face::signal_texdefChanged().connect(
 		[] { radiant::TextureChangedMessage::Send(); });
+
+	_memoryReporter = GlobalMemoryAccounting().addReporter("Brushes",
+		std::bind(&BrushModuleImpl::getMemoryUsage, this));
+	_nodePoolMemoryReporter = GlobalMemoryAccounting().addReporter("Brushes (node pool)",
+		std::bind(&BrushModuleImpl::getNodePoolMemoryUsage, this));
 }
 
 void BrushModuleImpl::shutdownModule()
 {
 	rMessage() << "BrushModuleImpl::shutdownModule called." << std::endl;
 
+	GlobalMemoryAccounting().removeReporter(_memoryReporter);
+	GlobalMemoryAccounting().removeReporter(_nodePoolMemoryReporter);
+
 	_brushFaceShaderChanged.disconnect();
 	_faceTexDefChanged.disconnect();
 
 	destroy();
 }
 
+memory::Usage BrushModuleImpl::getMemoryUsage()
+{
+	memory::Usage usage;
+
+	// Brushes which have been removed from the scene but are kept alive by the
+	// undo history are reported by the UndoSystem, along with their mementos
+	GlobalSceneGraph().foreachNode([&](const scene::INodePtr& node)
+	{
+		if (Node_isBrush(node))
+		{
+			usage.bytes += Node_getBrush(node)->getMemoryUsage();
+			++usage.numItems;
+		}
+
+		return true;
+	});
+
+	return usage;
+}
+
+memory::Usage BrushModuleImpl::getNodePoolMemoryUsage()
+{
+	memory::Usage usage;
+
+	// The nodes themselves are living in the pool, this includes the ones referenced
+	// by the undo history, plus the released blocks kept for re-use
+	usage.bytes = util::PoolGroup<BrushNode>::GetReservedBytes();
+	usage.numItems = util::PoolGroup<BrushNode>::GetNumAllocatedBlocks();
+
+	return usage;
+}
+
 void BrushModuleImpl::registerBrushCommands()
 {
 	GlobalCommandSystem().addCommand("BrushMakePrefab", selection::algorithm::brushMakePrefab, { cmd::ARGTYPE_INT, cmd::ARGTYPE_INT | cmd::ARGTYPE_OPTIONAL });
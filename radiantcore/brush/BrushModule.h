@@ -4,6 +4,7 @@
 
 #include "iregistry.h"
 #include "imodule.h"
+#include "imemoryaccounting.h"
 
 #include "ibrush.h"
 #include "BrushSettings.h"
@@ -22,11 +23,20 @@ private:
 	sigc::connection _brushFaceShaderChanged;
 	sigc::connection _faceTexDefChanged;
 
+	IMemoryAccounting::ReporterHandle _memoryReporter = 0;
+	IMemoryAccounting::ReporterHandle _nodePoolMemoryReporter = 0;
+
 private:
 	void keyChanged();
 
 	void registerBrushCommands();
 
+	// The heap memory held by the brushes in the scene (faces and windings), the nodes are counted by the pool
+	memory::Usage getMemoryUsage();
+
+	// The memory of the pool the brush nodes are allocated from, including the unused blocks
+	memory::Usage getNodePoolMemoryUsage();
+
 public:
 	// destructor
 	virtual ~BrushModuleImpl() {}
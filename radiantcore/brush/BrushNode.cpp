@@ -9,6 +9,7 @@
 #include "ientity.h"
 #include "math/Frustum.h"
 #include "math/Hash.h"
+#include "util/PoolAllocator.h"
 #include <functional>
 
 // Constructor
@@ -285,6 +286,11 @@ Brush& BrushNode::getBrush() {
 	return m_brush;
 }
 
+std::size_t BrushNode::getMemoryUsage() const
+{
+	return m_brush.getMemoryUsage();
+}
+
 IBrush& BrushNode::getIBrush() {
 	return m_brush;
 }
@@ -295,7 +301,7 @@ void BrushNode::translate(const Vector3& translation)
 }
 
 scene::INodePtr BrushNode::clone() const {
-	return std::make_shared<BrushNode>(*this);
+	return util::makePooledShared<BrushNode>(*this);
 }
 
 void BrushNode::onInsertIntoScene(scene::IMapRootNode& root)
@@ -83,6 +83,8 @@ public:
 
 	Type getNodeType() const override;
 
+	std::size_t getMemoryUsage() const override;
+
     // IComparable implementation
     std::string getFingerprint() override;
 
@@ -8,6 +8,7 @@
 #include "math/Matrix3.h"
 #include "shaderlib.h"
 #include "texturelib.h"
+#include "util/MemoryUsage.h"
 #include "Winding.h"
 #include "selection/algorithm/Texturing.h"
 
@@ -29,6 +30,11 @@ public:
         _texdefState(face.getProjection()),
         _materialName(face.getShader())
     {}
+
+    std::size_t getMemoryUsage() const override
+    {
+        return sizeof(*this) + util::getHeapSize(_materialName);
+    }
 };
 
 Face::Face(Brush& owner) :
@@ -198,6 +204,11 @@ void Face::undoSave()
     }
 }
 
+std::size_t Face::getMemoryUsage() const
+{
+    return sizeof(Face) + m_winding.getMemoryUsage();
+}
+
 // undoable
 IUndoMementoPtr Face::exportState() const
 {
@@ -100,6 +100,9 @@ public:
 	IUndoMementoPtr exportState() const override;
 	void importState(const IUndoMementoPtr& data) override;
 
+	// The approximate number of bytes held by this face, including its winding
+	std::size_t getMemoryUsage() const;
+
     /// Translate the face by the given vector
     void translate(const Vector3& translation);
 
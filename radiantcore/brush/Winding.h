@@ -69,6 +69,12 @@ public:
 	// For debugging purposes: prints the vertices and their adjacents to the console
 	void printConnectivity();
 
+	// The heap memory held by the vertices and indices of this winding
+	std::size_t getMemoryUsage() const
+	{
+		return capacity() * sizeof(WindingVertex) + _indices.capacity() * sizeof(unsigned int);
+	}
+
 	/// \brief Returns true if any point in \p w1 is in front of plane2, or any point in \p w2 is in front of plane1
 	static bool planesConcave(const Winding& w1, const Winding& w2, const Plane3& plane1, const Plane3& plane2);
 };
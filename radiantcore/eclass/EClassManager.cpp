@@ -13,6 +13,8 @@
 #include "Doom3ModelDef.h"
 
 #include "string/case_conv.h"
+#include "time/ProfilingSession.h"
+#include "util/MemoryUsage.h"
 #include <functional>
 
 #include "module/StaticModule.h"
@@ -21,7 +23,8 @@ namespace eclass {
 
 EClassManager::EClassManager() :
     _realised(false),
-    _defLoader(*this, _entityClasses, _models)
+    _defLoader(*this, _entityClasses, _models),
+    _memoryReporter(0)
 {}
 
 sigc::signal<void>& EClassManager::defsLoadingSignal()
@@ -42,6 +45,8 @@ sigc::signal<void>& EClassManager::defsReloadedSignal()
 // Get a named entity class, creating if necessary
 IEntityClassPtr EClassManager::findOrInsert(const std::string& name, bool has_brushes)
 {
+    util::ScopedProfilingStage stage("Entity class lookup");
+
     ensureDefsLoaded();
 
     // Return an error if no name is given
@@ -104,6 +109,8 @@ void EClassManager::realise()
 
 IEntityClassPtr EClassManager::findClass(const std::string& className)
 {
+    util::ScopedProfilingStage stage("Entity class lookup");
+
     ensureDefsLoaded();
 
 	// greebo: Convert the lookup className string to lowercase first
@@ -188,7 +195,8 @@ const StringSet& EClassManager::getDependencies() const
         MODULE_VIRTUALFILESYSTEM,
         MODULE_XMLREGISTRY,
         MODULE_COMMANDSYSTEM,
-        MODULE_ECLASS_COLOUR_MANAGER
+        MODULE_ECLASS_COLOUR_MANAGER,
+        MODULE_MEMORY_ACCOUNTING,
     };
 
 	return _dependencies;
@@ -209,6 +217,9 @@ void EClassManager::initialiseModule(const IApplicationContext& ctx)
 
     _eclassColoursChanged = GlobalEclassColourManager().sig_overrideColourChanged().connect(
         sigc::mem_fun(this, &EClassManager::onEclassOverrideColourChanged));
+
+    _memoryReporter = GlobalMemoryAccounting().addReporter("EClassManager",
+        std::bind(&EClassManager::getMemoryUsage, this));
 }
 
 void EClassManager::shutdownModule()
@@ -217,6 +228,8 @@ void EClassManager::shutdownModule()
 
     _eclassColoursChanged.disconnect();
 
+    GlobalMemoryAccounting().removeReporter(_memoryReporter);
+
 	GlobalFileSystem().removeObserver(*this);
 
 	// Unrealise ourselves and wait for threads to finish
@@ -232,6 +245,39 @@ void EClassManager::shutdownModule()
 	_models.clear();
 }
 
+memory::Usage EClassManager::getMemoryUsage()
+{
+    memory::Usage usage;
+
+    // The containers are filled by the parser thread, only report what's there once it is done.
+    // Waiting for it would block everyone else querying the memory usage.
+    if (!_defLoader.isFinished())
+    {
+        return usage;
+    }
+
+    for (const auto& [name, eclass] : _entityClasses)
+    {
+        usage.bytes += util::getContainerNodeSize<EntityClasses::value_type>() + util::getHeapSize(name);
+        usage.bytes += eclass->getMemoryUsage();
+    }
+
+    for (const auto& [name, modelDef] : _models)
+    {
+        usage.bytes += util::getContainerNodeSize<Models::value_type>() + sizeof(Doom3ModelDef) + util::getHeapSize(name);
+
+        for (const auto& [animName, animPath] : modelDef->anims)
+        {
+            usage.bytes += util::getContainerNodeSize<IModelDef::Anims::value_type>() +
+                util::getHeapSize(animName) + util::getHeapSize(animPath);
+        }
+    }
+
+    usage.numItems = _entityClasses.size() + _models.size();
+
+    return usage;
+}
+
 void EClassManager::onEclassOverrideColourChanged(const std::string& eclass, bool overrideRemoved)
 {
     // An override colour in the IColourManager instance has changed
@@ -6,6 +6,7 @@
 #include "icommandsystem.h"
 #include "ifilesystem.h"
 #include "itextstream.h"
+#include "imemoryaccounting.h"
 
 #include "EntityClass.h"
 #include "EClassParser.h"
@@ -53,6 +54,8 @@ private:
 
     sigc::connection _eclassColoursChanged;
 
+    IMemoryAccounting::ReporterHandle _memoryReporter;
+
 public:
 	EClassManager();
 
@@ -96,6 +99,9 @@ private:
 
 	void reloadDefsCmd(const cmd::ArgumentList& args);
 
+    // The approximate memory held by the entity classes and model defs, nothing while they are being parsed
+    memory::Usage getMemoryUsage();
+
     void onEclassOverrideColourChanged(const std::string& eclass, bool overrideRemoved);
 };
 
@@ -6,6 +6,7 @@
 #include "string/convert.h"
 
 #include "string/predicate.h"
+#include "util/MemoryUsage.h"
 #include <functional>
 
 namespace eclass
@@ -507,4 +508,19 @@ void EntityClass::parseFromTokens(parser::DefTokeniser& tokeniser)
     emitChangedSignal();
 }
 
+std::size_t EntityClass::getMemoryUsage() const
+{
+    auto total = sizeof(EntityClass) + util::getHeapSize(_name) +
+        util::getHeapSize(_model) + util::getHeapSize(_skin) + util::getHeapSize(_modName);
+
+    for (const auto& [key, attribute] : _attributes)
+    {
+        total += util::getContainerNodeSize<EntityAttributeMap::value_type>() + util::getHeapSize(key);
+        total += util::getHeapSize(attribute.getType()) + util::getHeapSize(attribute.getName()) +
+            util::getHeapSize(attribute.getValue()) + util::getHeapSize(attribute.getDescription());
+    }
+
+    return total;
+}
+
 } // namespace eclass
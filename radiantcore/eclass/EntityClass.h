@@ -195,6 +195,9 @@ public:
     {
         _blockChangeSignal = block;
     }
+
+    // The approximate number of bytes held by this class and its attributes
+    std::size_t getMemoryUsage() const;
 };
 
 }
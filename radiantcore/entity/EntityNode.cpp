@@ -6,8 +6,7 @@
 #include "imodel.h"
 #include "imap.h"
 #include "itransformable.h"
-#include "math/Hash.h"
-#include "string/case_conv.h"
+#include "scene/EntityFingerprint.h"
 
 #include "EntitySettings.h"
 
@@ -254,24 +253,6 @@ bool EntityNode::isShadowCasting() const
 
 std::string EntityNode::getFingerprint()
 {
-    std::map<std::string, std::string> sortedKeyValues;
-
-    // Entities are just a collection of key/value pairs,
-    // use them in lower case form, ignore inherited keys, sort before hashing
-    _spawnArgs.forEachKeyValue([&](const std::string& key, const std::string& value)
-    {
-        sortedKeyValues.emplace(string::to_lower_copy(key), string::to_lower_copy(value));
-    }, false);
-
-    math::Hash hash;
-
-    for (const auto& pair : sortedKeyValues)
-    {
-        hash.addString(pair.first);
-        hash.addString(pair.second);
-    }
-
-    // Entities need to include any child hashes, but be insensitive to their order
     std::set<std::string> childFingerprints;
 
     foreachNode([&](const scene::INodePtr& child)
@@ -286,12 +267,7 @@ std::string EntityNode::getFingerprint()
         return true;
     });
 
-    for (auto childFingerprint : childFingerprints)
-    {
-        hash.addString(childFingerprint);
-    }
-
-    return hash;
+    return scene::calculateEntityFingerprint(_spawnArgs, childFingerprints);
 }
 
 void EntityNode::testSelect(Selector& selector, SelectionTest& test)
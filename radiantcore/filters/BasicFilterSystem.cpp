@@ -1,6 +1,7 @@
 #include "BasicFilterSystem.h"
 
 #include <functional>
+#include <set>
 
 #include "iradiant.h"
 #include "itextstream.h"
@@ -8,9 +9,11 @@
 #include "iregistry.h"
 #include "igame.h"
 #include "ishaders.h"
+#include "ientity.h"
+#include "ieclass.h"
 
 #include "module/StaticModule.h"
-#include "InstanceUpdateWalker.h"
+#include "SceneFilterUpdater.h"
 #include "SetObjectSelectionByFilterWalker.h"
 
 namespace filters
@@ -30,6 +33,39 @@ namespace
 	const std::string RKEY_USER_ACTIVE_FILTERS = RKEY_USER_FILTER_BASE + "//activeFilter";
 }
 
+BasicFilterSystem::BasicFilterSystem() :
+	_activeEntityKeysNeedUpdate(true)
+{}
+
+void BasicFilterSystem::invalidateVisibilityCache()
+{
+	std::lock_guard<std::mutex> lock(_cacheLock);
+
+	_visibilityCache.clear();
+	_entityKeyValueCache.clear();
+	_activeEntityKeysNeedUpdate = true;
+}
+
+// Must be called with the cache lock held
+void BasicFilterSystem::ensureActiveEntityKeys()
+{
+	if (!_activeEntityKeysNeedUpdate) return;
+
+	_activeEntityKeysNeedUpdate = false;
+
+	std::set<std::string> keys;
+
+	for (const auto& active : _activeFilters)
+	{
+		active.second->foreachEntityKey([&](const std::string& key)
+		{
+			keys.insert(key);
+		});
+	}
+
+	_activeEntityKeys = std::make_shared<std::vector<std::string>>(keys.begin(), keys.end());
+}
+
 void BasicFilterSystem::setAllFilterStates(bool state)
 {
 	if (state)
@@ -43,15 +79,12 @@ void BasicFilterSystem::setAllFilterStates(bool state)
 
 	// Invalidate the visibility cache to force new values to be
 	// loaded from the filters themselves
-	_visibilityCache.clear();
+	invalidateVisibilityCache();
 
 	// Update the scenegraph instances
 	update();
 
 	_filterConfigChangedSignal.emit();
-
-	// Trigger an immediate scene redraw
-	GlobalSceneGraph().sceneChanged();
 }
 
 void BasicFilterSystem::setAllFilterStatesCmd(const cmd::ArgumentList& args)
@@ -323,7 +356,7 @@ void BasicFilterSystem::shutdownModule()
 		}
 	}
 
-	_visibilityCache.clear();
+	invalidateVisibilityCache();
 	_eventAdapters.clear();
 	_activeFilters.clear();
 	_availableFilters.clear();
@@ -345,10 +378,10 @@ sigc::signal<void> BasicFilterSystem::filterCollectionChangedSignal() const
 void BasicFilterSystem::update()
 {
 	// Update shaders first, so that nodes can judge whether they're hidden on basis of their texture
-	updateShaders();
+	auto materialVisibilityChanged = updateShaders();
 
 	// Now update the scene
-	updateScene();
+	updateScene(materialVisibilityChanged);
 }
 
 void BasicFilterSystem::forEachFilter(const std::function<void(const std::string & name)>& func)
@@ -391,15 +424,12 @@ void BasicFilterSystem::setFilterState(const std::string& filter, bool state)
 
 	// Invalidate the visibility cache to force new values to be
 	// loaded from the filters themselves
-	_visibilityCache.clear();
+	invalidateVisibilityCache();
 
 	// Update the scenegraph instances
 	update();
 
 	_filterConfigChangedSignal.emit();
-
-	// Trigger an immediate scene redraw
-	GlobalSceneGraph().sceneChanged();
 }
 
 bool BasicFilterSystem::filterIsReadOnly(const std::string& filter)
@@ -462,7 +492,7 @@ bool BasicFilterSystem::removeFilter(const std::string& filter)
 	if (wasActive)
 	{
 		// Clear the cache, the rules have changed
-		_visibilityCache.clear();
+		invalidateVisibilityCache();
 
 		_filterConfigChangedSignal.emit();
 
@@ -540,11 +570,16 @@ bool BasicFilterSystem::isVisible(const FilterRule::Type type, const std::string
 {
 	// Check if this item is in the visibility cache, returning
 	// its cached value if found
-	auto cacheIter = _visibilityCache.find(name);
-
-	if (cacheIter != _visibilityCache.end())
 	{
-		return cacheIter->second;
+		std::lock_guard<std::mutex> lock(_cacheLock);
+
+		auto& cache = _visibilityCache[type];
+		auto cacheIter = cache.find(name);
+
+		if (cacheIter != cache.end())
+		{
+			return cacheIter->second;
+		}
 	}
 
 	// Otherwise, walk the list of active filters to find a value for
@@ -564,13 +599,60 @@ bool BasicFilterSystem::isVisible(const FilterRule::Type type, const std::string
 	}
 
 	// Cache the result and return to caller
-	_visibilityCache.emplace(name, visFlag);
+	std::lock_guard<std::mutex> lock(_cacheLock);
+	_visibilityCache[type].emplace(name, visFlag);
 
 	return visFlag;
 }
 
 bool BasicFilterSystem::isEntityVisible(const FilterRule::Type type, const Entity& entity)
 {
+	// The entity class verdict is the same for all entities of that class
+	if (type == FilterRule::TYPE_ENTITYCLASS)
+	{
+		return isVisible(type, entity.getEntityClass()->getName());
+	}
+
+	if (type != FilterRule::TYPE_ENTITYKEYVALUE)
+	{
+		return true;
+	}
+
+	std::shared_ptr<const std::vector<std::string>> activeEntityKeys;
+
+	{
+		std::lock_guard<std::mutex> lock(_cacheLock);
+		ensureActiveEntityKeys();
+		activeEntityKeys = _activeEntityKeys;
+	}
+
+	// No spawnarg rules active, nothing to check
+	if (activeEntityKeys->empty())
+	{
+		return true;
+	}
+
+	// The verdict only depends on the values of the keys the rules are
+	// looking at, use them to look up a previously calculated result
+	std::string cacheKey;
+
+	for (const auto& key : *activeEntityKeys)
+	{
+		cacheKey.append(entity.getKeyValue(key));
+		cacheKey.push_back('\0');
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(_cacheLock);
+
+		auto cacheIter = _entityKeyValueCache.find(cacheKey);
+
+		if (cacheIter != _entityKeyValueCache.end())
+		{
+			return cacheIter->second;
+		}
+	}
+
 	// Otherwise, walk the list of active filters to find a value for
 	// this item.
 	bool visFlag = true; // default if no filters modify it
@@ -587,6 +669,9 @@ bool BasicFilterSystem::isEntityVisible(const FilterRule::Type type, const Entit
 		}
 	}
 
+	std::lock_guard<std::mutex> lock(_cacheLock);
+	_entityKeyValueCache.emplace(std::move(cacheKey), visFlag);
+
 	return visFlag;
 }
 
@@ -607,7 +692,7 @@ bool BasicFilterSystem::setFilterRules(const std::string& filter, const FilterRu
 		f->second->setRules(ruleSet);
 
 		// Clear the cache, the ruleset has changed
-		_visibilityCache.clear();
+		invalidateVisibilityCache();
 
 		_filterConfigChangedSignal.emit();
 
@@ -621,30 +706,43 @@ bool BasicFilterSystem::setFilterRules(const std::string& filter, const FilterRu
 
 void BasicFilterSystem::updateSubgraph(const scene::INodePtr& root)
 {
-	// Construct an InstanceUpdateWalker and traverse the scenegraph to update
-	// all instances
-	InstanceUpdateWalker walker(*this);
-	root->traverse(walker);
+	// The faces of the subgraph might not have seen the current material visibility yet
+	SceneFilterUpdater updater(*this, true);
+	updater.update(root);
 }
 
 // Update scenegraph instances with filtered status
-void BasicFilterSystem::updateScene()
+void BasicFilterSystem::updateScene(bool materialVisibilityChanged)
 {
-	// pass scenegraph root to specialised routine
-	updateSubgraph(GlobalSceneGraph().root());
+	auto root = GlobalSceneGraph().root();
+
+	if (!root) return;
+
+	SceneFilterUpdater updater(*this, materialVisibilityChanged);
+	updater.update(root);
+
+	// Trigger an immediate scene redraw
+	GlobalSceneGraph().sceneChanged();
 }
 
 // Update scenegraph instances with filtered status
-void BasicFilterSystem::updateShaders()
+bool BasicFilterSystem::updateShaders()
 {
-	// Construct a ShaderVisitor to traverse the shaders
-    GlobalMaterialManager().foreachMaterial([this] (const MaterialPtr& material)
+	bool visibilityChanged = false;
+
+    GlobalMaterialManager().foreachMaterial([&] (const MaterialPtr& material)
     {
         // Set the shader's visibility based on the current filter settings
-        material->setVisible(
-            isVisible(FilterRule::TYPE_TEXTURE, material->getName())
-        );
+        auto visible = isVisible(FilterRule::TYPE_TEXTURE, material->getName());
+
+        if (material->isVisible() != visible)
+        {
+            material->setVisible(visible);
+            visibilityChanged = true;
+        }
     });
+
+	return visibilityChanged;
 }
 
 // RegisterableModule implementation
@@ -5,6 +5,9 @@
 #include "icommandsystem.h"
 
 #include <map>
+#include <memory>
+#include <unordered_map>
+#include <mutex>
 #include <vector>
 #include <string>
 #include <iostream>
@@ -29,10 +32,25 @@ private:
 	// Second table containing just the active filters
 	FilterTable _activeFilters;
 
+	// Guards the caches below, visibility queries might be issued
+	// from worker threads during scene updates
+	std::mutex _cacheLock;
+
 	// Cache of visibility flags for item names, to avoid having to
 	// traverse the active filter list for each lookup
-	typedef std::map<std::string, bool> StringFlagCache;
-	StringFlagCache _visibilityCache;
+	typedef std::unordered_map<std::string, bool> StringFlagCache;
+	std::map<FilterRule::Type, StringFlagCache> _visibilityCache;
+
+	// The spawnarg keys referenced by the active entitykeyvalue rules,
+	// in a stable order. The key/value verdict of an entity depends only
+	// on the values of these keys. The list is replaced (never modified)
+	// while holding the cache lock, readers take a reference under the lock.
+	std::shared_ptr<const std::vector<std::string>> _activeEntityKeys;
+	bool _activeEntityKeysNeedUpdate;
+
+	// Cache of entitykeyvalue verdicts, indexed by the concatenated
+	// values of all keys in _activeEntityKeys
+	StringFlagCache _entityKeyValueCache;
 
     sigc::signal<void> _filterConfigChangedSignal;
     sigc::signal<void> _filterCollectionChangedSignal;
@@ -41,12 +59,20 @@ private:
 	FilterAdapters _eventAdapters;
 
 private:
+	// Clears all cached verdicts, to be called whenever the active filters
+	// or their rules have been changed
+	void invalidateVisibilityCache();
 
-	// Perform a traversal of the scenegraph, setting or clearing the filtered
-	// flag on Nodes depending on their entity class
-	void updateScene();
+	void ensureActiveEntityKeys();
 
-	void updateShaders();
+	// Update the filtered flag of all nodes in the scenegraph
+	// depending on the currently active filters. The face visibility
+	// of brushes is only updated if materialVisibilityChanged is true.
+	void updateScene(bool materialVisibilityChanged);
+
+	// Applies the texture rules to all materials, returns true
+	// if the visibility of at least one material has been changed
+	bool updateShaders();
 
 	void addFiltersFromXML(const xml::NodeList& nodes, bool readOnly);
 
@@ -62,6 +88,8 @@ private:
 	void setObjectSelectionByFilter(const std::string& filterName, bool select);
 
 public:
+	BasicFilterSystem();
+
     // FilterSystem implementation
     sigc::signal<void> filterConfigChangedSignal() const override;
     sigc::signal<void> filterCollectionChangedSignal() const override;
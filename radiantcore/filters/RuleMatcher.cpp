@@ -0,0 +1,82 @@
+#include "RuleMatcher.h"
+
+#include "itextstream.h"
+
+namespace filters
+{
+
+namespace
+{
+	// Characters carrying a special meaning in ECMAScript regular expressions
+	const char* const REGEX_META_CHARACTERS = "\\^$.|?*+()[]{}";
+
+	inline bool isLiteral(const std::string& str)
+	{
+		return str.find_first_of(REGEX_META_CHARACTERS) == std::string::npos;
+	}
+
+	// The "." wildcard doesn't match line terminators
+	inline bool isMatchedByWildcard(const std::string& str, std::size_t offset)
+	{
+		return str.find_first_of("\r\n", offset) == std::string::npos;
+	}
+}
+
+RuleMatcher::RuleMatcher(const std::string& expression) :
+	_kind(Kind::Regex)
+{
+	if (expression == ".*")
+	{
+		_kind = Kind::Any;
+		return;
+	}
+
+	if (isLiteral(expression))
+	{
+		_kind = Kind::Literal;
+		_literal = expression;
+		return;
+	}
+
+	if (expression.size() > 2 && expression.compare(expression.size() - 2, 2, ".*") == 0)
+	{
+		auto prefix = expression.substr(0, expression.size() - 2);
+
+		if (isLiteral(prefix))
+		{
+			_kind = Kind::Prefix;
+			_literal = std::move(prefix);
+			return;
+		}
+	}
+
+	try
+	{
+		_regex = std::regex(expression);
+	}
+	catch (const std::regex_error& ex)
+	{
+		rWarning() << "Invalid filter expression " << expression << ": " << ex.what() << std::endl;
+		_kind = Kind::Invalid;
+	}
+}
+
+bool RuleMatcher::matches(const std::string& candidate) const
+{
+	switch (_kind)
+	{
+	case Kind::Any:
+		return isMatchedByWildcard(candidate, 0);
+	case Kind::Literal:
+		return candidate == _literal;
+	case Kind::Prefix:
+		return candidate.compare(0, _literal.size(), _literal) == 0 &&
+			isMatchedByWildcard(candidate, _literal.size());
+	case Kind::Regex:
+		return std::regex_match(candidate, _regex);
+	default:
+		return false;
+	}
+}
+
+}
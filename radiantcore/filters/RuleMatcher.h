@@ -0,0 +1,52 @@
+#pragma once
+
+#include <string>
+#include <regex>
+
+namespace filters
+{
+
+/**
+ * Pre-compiled form of a filter rule's match expression.
+ *
+ * The match expressions are regular expressions, but the vast majority
+ * of them are either plain names ("worldspawn", "textures/common/nodraw"),
+ * simple prefix patterns ("light_.*") or the catch-all ".*". These are
+ * recognised when the matcher is constructed and tested without involving
+ * the regex engine at all. Everything else is compiled into a std::regex
+ * exactly once, instead of on every visibility query.
+ */
+class RuleMatcher
+{
+public:
+	enum class Kind
+	{
+		Any,		// ".*", matches everything
+		Literal,	// no regex meta characters, exact string comparison
+		Prefix,		// literal followed by ".*"
+		Regex,		// anything else, uses the compiled regex
+		Invalid,	// expression failed to compile, never matches
+	};
+
+private:
+	Kind _kind;
+
+	// The literal (or the prefix) for the fast path kinds
+	std::string _literal;
+
+	std::regex _regex;
+
+public:
+	explicit RuleMatcher(const std::string& expression);
+
+	Kind getKind() const
+	{
+		return _kind;
+	}
+
+	// Returns true if the whole candidate string matches the expression
+	// (same semantics as std::regex_match)
+	bool matches(const std::string& candidate) const;
+};
+
+}
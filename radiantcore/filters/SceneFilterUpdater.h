@@ -0,0 +1,153 @@
+#pragma once
+
+#include <cstdint>
+#include "inode.h"
+#include "ientity.h"
+#include "iselectable.h"
+#include "ipatch.h"
+#include "ibrush.h"
+#include "ifilter.h"
+#include "scene/ParallelEvaluation.h"
+
+namespace filters 
+{
+
+/**
+ * Updates the filtered status of all nodes in a subgraph based on the
+ * currently active set of filters.
+ *
+ * The update runs in two phases: the verdicts of all nodes are evaluated
+ * in parallel first (without touching the scene), then the flags are
+ * applied to the nodes in a single pass on the calling thread. A hidden
+ * node hides its complete subgraph, regardless of the children's verdicts.
+ *
+ * Only nodes whose filtered state actually changes are touched, such that
+ * nodes which stay hidden are not deselected over and over again. The
+ * face visibility of brushes is only refreshed if the visibility of
+ * any material has been changed before this update.
+ */
+class SceneFilterUpdater
+{
+private:
+	enum Verdict : std::uint8_t
+	{
+		Hidden,
+		Visible,
+		VisibleBrush, // needs a fine-grained face visibility update
+	};
+
+	IFilterSystem& _filterSystem;
+
+	// Cached boolean to avoid FilterSystem queries for each node
+	bool _patchesAreVisible;
+	bool _brushesAreVisible;
+
+	// Whether the face visibility of the brushes needs to be re-evaluated
+	bool _materialVisibilityChanged;
+
+public:
+	SceneFilterUpdater(IFilterSystem& filterSystem, bool materialVisibilityChanged) :
+		_filterSystem(filterSystem),
+		_patchesAreVisible(_filterSystem.isVisible(FilterRule::TYPE_OBJECT, "patch")),
+		_brushesAreVisible(_filterSystem.isVisible(FilterRule::TYPE_OBJECT, "brush")),
+		_materialVisibilityChanged(materialVisibilityChanged)
+	{}
+
+	// Updates the given node and all its children
+	void update(const scene::INodePtr& root)
+	{
+		auto nodes = scene::flattenSubgraph(root, true);
+
+		auto verdicts = scene::evaluateInParallel<Verdict>(nodes, [this](const scene::INodePtr& node)
+		{
+			return evaluate(node);
+		});
+
+		// The depth of the hidden node whose subgraph we're currently in
+		std::size_t hiddenDepth = 0;
+		bool insideHiddenSubgraph = false;
+
+		for (std::size_t i = 0; i < nodes.size(); ++i)
+		{
+			const auto& [node, depth] = nodes[i];
+
+			if (insideHiddenSubgraph && depth > hiddenDepth)
+			{
+				hide(node);
+				continue;
+			}
+
+			insideHiddenSubgraph = false;
+
+			switch (verdicts[i])
+			{
+			case Hidden:
+				hide(node);
+				insideHiddenSubgraph = true;
+				hiddenDepth = depth;
+				break;
+
+			case VisibleBrush:
+				show(node);
+
+				// The brush has at least one visible material, trigger a fine-grained update
+				if (_materialVisibilityChanged)
+				{
+					Node_getIBrush(node)->updateFaceVisibility();
+				}
+				break;
+
+			default:
+				show(node);
+			}
+		}
+	}
+
+private:
+	// Evaluates the verdict of a single node, this is called from worker threads
+	Verdict evaluate(const scene::INodePtr& node)
+	{
+		// Check entity eclass and spawnargs
+		if (Node_isEntity(node))
+		{
+			Entity* entity = Node_getEntity(node);
+
+			return _filterSystem.isEntityVisible(FilterRule::TYPE_ENTITYCLASS, *entity) &&
+				_filterSystem.isEntityVisible(FilterRule::TYPE_ENTITYKEYVALUE, *entity) ? Visible : Hidden;
+		}
+
+		// greebo: Check visibility of Patches
+		if (Node_isPatch(node))
+		{
+			return _patchesAreVisible && Node_getIPatch(node)->hasVisibleMaterial() ? Visible : Hidden;
+		}
+
+		// greebo: Check visibility of Brushes
+		if (Node_isBrush(node))
+		{
+			return _brushesAreVisible && Node_getIBrush(node)->hasVisibleMaterial() ? VisibleBrush : Hidden;
+		}
+
+		// Any other node is not subject to filtering by itself
+		return Visible;
+	}
+
+	void hide(const scene::INodePtr& node)
+	{
+		// Nodes that have been hidden before are left alone
+		if (node->isFiltered()) return;
+
+		node->setFiltered(true);
+		Node_setSelected(node, false);
+	}
+
+	void show(const scene::INodePtr& node)
+	{
+		if (node->isFiltered())
+		{
+			node->setFiltered(false);
+		}
+	}
+};
+
+} // namespace filters
@@ -3,7 +3,6 @@
 #include "ientity.h"
 #include "ieclass.h"
 #include "ifilter.h"
-#include <regex>
 #include <algorithm>
 
 namespace filters
@@ -25,24 +24,21 @@ bool XMLFilter::isVisible(const FilterRule::Type type, const std::string& name)
 
 	bool visible = true; // default if unmodified by rules
 
-	for (FilterRules::const_iterator ruleIter = _rules.begin();
-		 ruleIter != _rules.end();
-		 ++ruleIter)
+	for (std::size_t i = 0; i < _rules.size(); ++i)
 	{
+		const auto& rule = _rules[i];
+
 		// Check the item type.
-		if (ruleIter->type != type)
+		if (rule.type != type)
 		{
 			continue;
 		}
 
-		// If we have a rule for this item, use a regex to match the query name
-		// against the "match" parameter
-		std::regex ex(ruleIter->match);
-
-		if (std::regex_match(name, ex))
+		// The rule is only able to change the outcome if its action differs
+		if (rule.show != visible && _matchers[i].matches(name))
 		{
 			// Overwrite the visible flag with the value from the rule.
-			visible = ruleIter->show;
+			visible = rule.show;
 		}
 	}
 
@@ -52,36 +48,30 @@ bool XMLFilter::isVisible(const FilterRule::Type type, const std::string& name)
 
 bool XMLFilter::isEntityVisible(const FilterRule::Type type, const Entity& entity) const
 {
+	if (type == FilterRule::TYPE_ENTITYCLASS)
+	{
+		return isVisible(type, entity.getEntityClass()->getName());
+	}
+
 	bool visible = true; // default if unmodified by rules
 
-	IEntityClassConstPtr eclass = entity.getEntityClass();
-	
-	for (FilterRules::const_iterator ruleIter = _rules.begin();
-		 ruleIter != _rules.end();
-		 ++ruleIter)
+	if (type != FilterRule::TYPE_ENTITYKEYVALUE)
+	{
+		return visible;
+	}
+
+	for (std::size_t i = 0; i < _rules.size(); ++i)
 	{
-		if (ruleIter->type != type)
+		const auto& rule = _rules[i];
+
+		if (rule.type != type || rule.show == visible)
 		{
 			continue;
 		}
 
-		if (type == FilterRule::TYPE_ENTITYCLASS)
+		if (_matchers[i].matches(entity.getKeyValue(rule.entityKey)))
 		{
-			std::regex ex(ruleIter->match);
-
-			if (std::regex_match(eclass->getName(), ex))
-			{
-				visible = ruleIter->show;
-			}
-		}
-		else if (type == FilterRule::TYPE_ENTITYKEYVALUE)
-		{
-			std::regex ex(ruleIter->match);
-
-			if (std::regex_match(entity.getKeyValue(ruleIter->entityKey), ex))
-			{
-				visible = ruleIter->show;
-			}
+			visible = rule.show;
 		}
 	}
 
@@ -114,8 +104,39 @@ const FilterRules& XMLFilter::getRuleSet() const
 	return _rules;
 }
 
+bool XMLFilter::hasRulesOfType(const FilterRule::Type type) const
+{
+	return std::any_of(_rules.begin(), _rules.end(), [&](const FilterRule& rule)
+	{
+		return rule.type == type;
+	});
+}
+
+void XMLFilter::foreachEntityKey(const std::function<void(const std::string&)>& functor) const
+{
+	for (const auto& rule : _rules)
+	{
+		if (rule.type == FilterRule::TYPE_ENTITYKEYVALUE)
+		{
+			functor(rule.entityKey);
+		}
+	}
+}
+
 void XMLFilter::setRules(const FilterRules& rules) {
 	_rules = rules;
+	compileRules();
+}
+
+void XMLFilter::compileRules()
+{
+	_matchers.clear();
+	_matchers.reserve(_rules.size());
+
+	for (const auto& rule : _rules)
+	{
+		_matchers.emplace_back(rule.match);
+	}
 }
 
 void XMLFilter::updateEventName() {
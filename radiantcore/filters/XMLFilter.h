@@ -2,7 +2,9 @@
 
 #include <string>
 #include <vector>
+#include <functional>
 #include "ifilter.h"
+#include "RuleMatcher.h"
 
 namespace filters
 {
@@ -24,6 +26,9 @@ private:
 	// Ordered list of rule objects
 	FilterRules _rules;
 
+	// The compiled match expressions, one per rule (same order as _rules)
+	std::vector<RuleMatcher> _matchers;
+
 	// True if this filter can't be changed
 	bool _readonly;
 
@@ -55,6 +60,7 @@ public:
 	void addRule(const FilterRule::Type type, const std::string& match, bool show)
 	{
 		_rules.push_back(FilterRule::Create(type, match, show));
+		_matchers.emplace_back(match);
 	}
 
 	/** Add an entitykeyvalue rule to this filter.
@@ -72,6 +78,7 @@ public:
 	void addEntityKeyValueRule(const std::string& key, const std::string& match, bool show)
 	{
 		_rules.push_back(FilterRule::CreateEntityKeyValueRule(key, match, show));
+		_matchers.emplace_back(match);
 	}
 
 	/** Test a given item for visibility against all of the rules
@@ -116,11 +123,18 @@ public:
 	// Returns the ruleset
 	const FilterRules& getRuleSet() const;
 
+	// Returns true if this filter has at least one rule of the given type
+	bool hasRulesOfType(const FilterRule::Type type) const;
+
+	// Invokes the functor with the key of every entitykeyvalue rule
+	void foreachEntityKey(const std::function<void(const std::string&)>& functor) const;
+
 	// Applies the given ruleset, replacing the existing one.
 	void setRules(const FilterRules& rules);
 
 private:
 	void updateEventName();
+	void compileRules();
 };
 
 }
@@ -1,5 +1,7 @@
 #include "BMPLoader.h"
 
+#include <cstdlib>
+
 #include "itextstream.h"
 #include "ifilesystem.h"
 
@@ -197,4 +199,30 @@ ImageTypeLoader::Extensions BMPLoader::getExtensions() const
     return extensions;
 }
 
+bool BMPLoader::getDimensions(ArchiveFile& file, std::size_t& width, std::size_t& height) const
+{
+    // 14 bytes file header, followed by the size of the bitmap header and the dimensions
+    uint8_t header[26];
+
+    if (!readHeader(file, header, sizeof(header)) || header[0] != 'B' || header[1] != 'M')
+    {
+        return false;
+    }
+
+    if (decodeLittleEndian<4>(header + 14) == 12)
+    {
+        // Old OS/2 bitmap header using 16 bit dimensions
+        width = decodeLittleEndian<2>(header + 18);
+        height = decodeLittleEndian<2>(header + 20);
+    }
+    else
+    {
+        // The height is negative for top-down bitmaps
+        width = decodeLittleEndian<4>(header + 18);
+        height = std::abs(static_cast<int32_t>(decodeLittleEndian<4>(header + 22)));
+    }
+
+    return width > 0 && height > 0;
+}
+
 }
@@ -15,6 +15,7 @@ public:
     // ImageTypeLoader implementation
     ImagePtr load(ArchiveFile& file) const override;
     Extensions getExtensions() const override;
+    bool getDimensions(ArchiveFile& file, std::size_t& width, std::size_t& height) const override;
 };
 
 }
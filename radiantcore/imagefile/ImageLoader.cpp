@@ -53,14 +53,8 @@ ImageLoader::ImageLoader()
     addLoaderToMap(std::make_shared<DDSLoader>());
 }
 
-// Load image from VFS
-ImagePtr ImageLoader::imageFromVFS(const std::string& rawName) const
+ArchiveFilePtr ImageLoader::findImageFile(const std::string& name, ImageTypeLoader::Ptr& loader) const
 {
-    // Replace backslashes with forward slashes and strip of
-    // the file extension of the provided token, and store
-    // the result in the provided string.
-    auto name  = os::standardPath(rawName).substr(0, rawName.rfind("."));
-
 	for (const auto& extension : _extensions)
 	{
         // Find the loader for this extension
@@ -73,26 +67,78 @@ ImagePtr ImageLoader::imageFromVFS(const std::string& rawName) const
             continue;
         }
 
-        ImageTypeLoader& ldr = *loaderIter->second;
-
 		// Construct the full name of the image to load, including the
 		// prefix (e.g. "dds/") and the file extension.
-		std::string fullName = ldr.getPrefix() + name + "." + extension;
+		std::string fullName = loaderIter->second->getPrefix() + name + "." + extension;
 
 		// Try to open the file (will fail if the extension does not fit)
 		auto file = GlobalFileSystem().openFile(fullName);
 
-		// Has the file been loaded?
 		if (file)
         {
-			// Try to invoke the imageloader with a reference to the
-			// ArchiveFile
-			return ldr.load(*file);
+            loader = loaderIter->second;
+			return file;
 		}
 	}
 
     // File not found
-	return ImagePtr();
+	return ArchiveFilePtr();
+}
+
+// Load image from VFS
+ImagePtr ImageLoader::imageFromVFS(const std::string& rawName) const
+{
+    // Replace backslashes with forward slashes and strip of
+    // the file extension of the provided token, and store
+    // the result in the provided string.
+    auto name  = os::standardPath(rawName).substr(0, rawName.rfind("."));
+
+    ImageTypeLoader::Ptr loader;
+    auto file = findImageFile(name, loader);
+
+    // Try to invoke the imageloader with a reference to the ArchiveFile
+	return file ? loader->load(*file) : ImagePtr();
+}
+
+bool ImageLoader::getImageDimensionsFromVFS(const std::string& rawName,
+    std::size_t& width, std::size_t& height) const
+{
+    auto name = os::standardPath(rawName).substr(0, rawName.rfind("."));
+
+    {
+        std::lock_guard<std::mutex> lock(_dimensionCacheLock);
+
+        auto cached = _dimensionCache.find(name);
+
+        if (cached != _dimensionCache.end())
+        {
+            if (cached->second.first == 0) return false;
+
+            width = cached->second.first;
+            height = cached->second.second;
+            return true;
+        }
+    }
+
+    std::size_t headerWidth = 0;
+    std::size_t headerHeight = 0;
+
+    ImageTypeLoader::Ptr loader;
+    auto file = findImageFile(name, loader);
+
+    if (!file || !loader->getDimensions(*file, headerWidth, headerHeight))
+    {
+        headerWidth = headerHeight = 0;
+    }
+
+    std::lock_guard<std::mutex> lock(_dimensionCacheLock);
+    _dimensionCache[name] = std::make_pair(headerWidth, headerHeight);
+
+    if (headerWidth == 0) return false;
+
+    width = headerWidth;
+    height = headerHeight;
+    return true;
 }
 
 ImagePtr ImageLoader::imageFromFile(const std::string& filename) const
@@ -136,6 +182,7 @@ const StringSet& ImageLoader::getDependencies() const
     if (_dependencies.empty())
     {
         _dependencies.insert(MODULE_GAMEMANAGER);
+        _dependencies.insert(MODULE_VIRTUALFILESYSTEM);
     }
 
     return _dependencies;
@@ -152,6 +199,20 @@ void ImageLoader::initialiseModule(const IApplicationContext&)
         std::string extension = node.getContent();
         _extensions.emplace_back(string::to_lower_copy(extension));
     }
+
+    GlobalFileSystem().addObserver(*this);
+}
+
+void ImageLoader::shutdownModule()
+{
+    GlobalFileSystem().removeObserver(*this);
+}
+
+void ImageLoader::onFileSystemShutdown()
+{
+    // The files might be different after the VFS has been re-initialised
+    std::lock_guard<std::mutex> lock(_dimensionCacheLock);
+    _dimensionCache.clear();
 }
 
 // Static module instance
@@ -1,16 +1,19 @@
 #pragma once
 
 #include "iimage.h"
+#include "ifilesystem.h"
 #include "ImageTypeLoader.h"
 
 #include <map>
+#include <mutex>
 
 namespace image
 {
 
 /// ImageLoader implementing module
 class ImageLoader: 
-    public IImageLoader
+    public IImageLoader,
+    public vfs::VirtualFileSystem::Observer
 {
 private:
     // Map of image extension to loader class. Multiple image extensions may
@@ -20,9 +23,18 @@ private:
 
     ImageTypeLoader::Extensions _extensions;
 
+    // Image dimensions per VFS path (without extension), a size of 0x0 marks
+    // images which could not be found or parsed
+    mutable std::map<std::string, std::pair<std::size_t, std::size_t>> _dimensionCache;
+    mutable std::mutex _dimensionCacheLock;
+
 private:
     void addLoaderToMap(const ImageTypeLoader::Ptr& loader);
 
+    // Locates the image file for the given VFS path (without extension) by trying
+    // all registered extensions. Returns an empty file if nothing was found.
+    ArchiveFilePtr findImageFile(const std::string& name, ImageTypeLoader::Ptr& loader) const;
+
 public:
 
     // Construct and initialise loaders
@@ -31,11 +43,17 @@ public:
     // ImageLoader implementation
     ImagePtr imageFromVFS(const std::string& vfsPath) const override;
 	ImagePtr imageFromFile(const std::string& filename) const override;
+    bool getImageDimensionsFromVFS(const std::string& vfsPath,
+        std::size_t& width, std::size_t& height) const override;
 
     // RegisterableModule implementation
     const std::string& getName() const override;
     const StringSet& getDependencies() const override;
     void initialiseModule(const IApplicationContext&) override;
+    void shutdownModule() override;
+
+    // VirtualFileSystem::Observer implementation
+    void onFileSystemShutdown() override;
 };
 
 }
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "iimage.h"
+#include "iarchive.h"
+#include "idatastream.h"
 
 namespace image
 {
@@ -32,6 +34,65 @@ public:
 	 * @returns: the lowercase prefix (e.g. "dds/").
 	 */
 	virtual std::string getPrefix() const { return ""; }
+
+    /**
+     * \brief
+     * Read the dimensions of the image from the file header without decoding
+     * the pixel data. Returns false if the header could not be parsed or if the
+     * loader doesn't support this (which is the default).
+     */
+    virtual bool getDimensions(ArchiveFile& file, std::size_t& width, std::size_t& height) const
+    {
+        return false;
+    }
+
+protected:
+    // Fills the buffer with the first <length> bytes of the file,
+    // returns false if the file is shorter than that
+    static bool readHeader(ArchiveFile& file, uint8_t* buffer, std::size_t length)
+    {
+        auto& stream = file.getInputStream();
+        std::size_t bytesRead = 0;
+
+        while (bytesRead < length)
+        {
+            auto result = stream.read(buffer + bytesRead, length - bytesRead);
+
+            if (result == 0) return false;
+
+            bytesRead += result;
+        }
+
+        return true;
+    }
+
+    // Decodes an unsigned integer of the given size from the little endian bytes
+    template<std::size_t NumBytes>
+    static uint32_t decodeLittleEndian(const uint8_t* bytes)
+    {
+        uint32_t value = 0;
+
+        for (std::size_t i = NumBytes; i > 0; --i)
+        {
+            value = (value << 8) | bytes[i - 1];
+        }
+
+        return value;
+    }
+
+    // Decodes an unsigned integer of the given size from the big endian bytes
+    template<std::size_t NumBytes>
+    static uint32_t decodeBigEndian(const uint8_t* bytes)
+    {
+        uint32_t value = 0;
+
+        for (std::size_t i = 0; i < NumBytes; ++i)
+        {
+            value = (value << 8) | bytes[i];
+        }
+
+        return value;
+    }
 };
 
 }
@@ -4,6 +4,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <algorithm>
 
 #include <jpeglib.h>
 #include <jerror.h>
@@ -377,4 +378,66 @@ ImageTypeLoader::Extensions JPEGLoader::getExtensions() const
     return extensions;
 }
 
+bool JPEGLoader::getDimensions(ArchiveFile& file, std::size_t& width, std::size_t& height) const
+{
+    uint8_t buffer[256];
+
+    // Start of image marker
+    if (!readHeader(file, buffer, 2) || buffer[0] != 0xFF || buffer[1] != 0xD8)
+    {
+        return false;
+    }
+
+    // Walk the segments until we hit a start of frame marker (SOF0..SOF15,
+    // except DHT, JPG and DAC which share the same range)
+    while (readHeader(file, buffer, 1))
+    {
+        if (buffer[0] != 0xFF) return false;
+
+        // Any number of 0xFF fill bytes may precede the marker byte
+        do
+        {
+            if (!readHeader(file, buffer, 1)) return false;
+        }
+        while (buffer[0] == 0xFF);
+
+        auto marker = buffer[0];
+
+        // Standalone markers don't have a length field
+        if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD7)) continue;
+
+        // Start of scan or end of image, no frame header found
+        if (marker == 0xDA || marker == 0xD9) return false;
+
+        if (!readHeader(file, buffer, 2)) return false;
+
+        auto length = decodeBigEndian<2>(buffer);
+
+        if (length < 2) return false;
+
+        if (marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC)
+        {
+            // Sample precision, followed by the number of lines and samples per line
+            if (!readHeader(file, buffer, 5)) return false;
+
+            height = decodeBigEndian<2>(buffer + 1);
+            width = decodeBigEndian<2>(buffer + 3);
+
+            return width > 0 && height > 0;
+        }
+
+        // Skip the payload of this segment, the stream can only be read forwards
+        for (std::size_t remaining = length - 2; remaining > 0;)
+        {
+            auto chunkSize = std::min(remaining, sizeof(buffer));
+
+            if (!readHeader(file, buffer, chunkSize)) return false;
+
+            remaining -= chunkSize;
+        }
+    }
+
+    return false;
+}
+
 }
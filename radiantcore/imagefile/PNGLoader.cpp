@@ -183,4 +183,22 @@ ImageTypeLoader::Extensions PNGLoader::getExtensions() const
     return extensions;
 }
 
+bool PNGLoader::getDimensions(ArchiveFile& file, std::size_t& width, std::size_t& height) const
+{
+    // 8 bytes signature, followed by the IHDR chunk which is always the first one
+    uint8_t header[24];
+
+    if (!readHeader(file, header, sizeof(header)) ||
+        png_sig_cmp(header, 0, 8) != 0 ||
+        std::memcmp(header + 12, "IHDR", 4) != 0)
+    {
+        return false;
+    }
+
+    width = decodeBigEndian<4>(header + 16);
+    height = decodeBigEndian<4>(header + 20);
+
+    return width > 0 && height > 0;
+}
+
 }
@@ -432,4 +432,27 @@ ImageTypeLoader::Extensions TGALoader::getExtensions() const
     return extensions;
 }
 
+bool TGALoader::getDimensions(ArchiveFile& file, std::size_t& width, std::size_t& height) const
+{
+    uint8_t header[18];
+
+    if (!readHeader(file, header, sizeof(header)))
+    {
+        return false;
+    }
+
+    // Only the image types supported by the loader
+    auto imageType = header[2];
+
+    if (imageType != 2 && imageType != 3 && imageType != 10)
+    {
+        return false;
+    }
+
+    width = decodeLittleEndian<2>(header + 12);
+    height = decodeLittleEndian<2>(header + 14);
+
+    return width > 0 && height > 0;
+}
+
 }
@@ -19,6 +19,7 @@ public:
     // ImageTypeLoader implementation
 	ImagePtr load(ArchiveFile& file) const;
 	Extensions getExtensions() const;
+	bool getDimensions(ArchiveFile& file, std::size_t& width, std::size_t& height) const;
 };
 
 }
@@ -23,6 +23,7 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
 #include <stdlib.h>
 #include <algorithm>
+#include <cstring>
 #include <map>
 
 #include "ifilesystem.h"
@@ -316,4 +317,20 @@ ImageTypeLoader::Extensions DDSLoader::getExtensions() const
     return extensions;
 }
 
+bool DDSLoader::getDimensions(ArchiveFile& file, std::size_t& width, std::size_t& height) const
+{
+    // The magic number followed by the size, flags, height and width of the surface
+    uint8_t header[20];
+
+    if (!readHeader(file, header, sizeof(header)) || std::memcmp(header, "DDS ", 4) != 0)
+    {
+        return false;
+    }
+
+    height = decodeLittleEndian<4>(header + 12);
+    width = decodeLittleEndian<4>(header + 16);
+
+    return width > 0 && height > 0;
+}
+
 }
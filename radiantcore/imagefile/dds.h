@@ -15,6 +15,8 @@ public:
 
 	Extensions getExtensions() const;
 
+	bool getDimensions(ArchiveFile& file, std::size_t& width, std::size_t& height) const;
+
 	/* greebo: Returns the prefix that is necessary to construct the
 	 * path to the dds files.
 	 */
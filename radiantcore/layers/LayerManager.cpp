@@ -6,6 +6,7 @@
 #include "icommandsystem.h"
 #include "scene/Node.h"
 #include "scenelib.h"
+#include "scene/ParallelEvaluation.h"
 #include "module/StaticModule.h"
 
 #include "AddToLayerWalker.h"
@@ -16,6 +17,8 @@
 
 #include <functional>
 #include <climits>
+#include <cassert>
+#include <cstdint>
 
 namespace scene
 {
@@ -52,14 +55,8 @@ int LayerManager::createLayer(const std::string& name, int layerID)
 		return -1;
 	}
 
-	// Update the visibility cache, so get the highest ID
-	int highestID = getHighestLayerID();
-
-	// Make sure the vector has allocated enough memory
-	_layerVisibility.resize(highestID+1);
-
 	// Set the newly created layer to "visible"
-	_layerVisibility[result.first->first] = true;
+	_visibleLayers.insert(result.first->first);
 
 	// Layers have changed
 	onLayersChanged();
@@ -106,7 +103,7 @@ void LayerManager::deleteLayer(const std::string& name)
 	_layers.erase(layerID);
 
 	// Reset the visibility flag to TRUE
-	_layerVisibility[layerID] = true;
+	_visibleLayers.insert(layerID);
 
 	if (layerID == _activeLayer)
 	{
@@ -137,8 +134,10 @@ void LayerManager::reset()
 	_layers.clear();
 	_layers.insert(LayerMap::value_type(DEFAULT_LAYER, _(DEFAULT_LAYER_NAME)));
 
-	_layerVisibility.resize(1);
-	_layerVisibility[DEFAULT_LAYER] = true;
+	_visibleLayers.clear();
+	_visibleLayers.insert(DEFAULT_LAYER);
+
+	_memberCounts.clear();
 
 	// Update the LayerControlDialog
 	_layersChangedSignal.emit();
@@ -172,7 +171,7 @@ int LayerManager::getFirstVisibleLayer() const
 	// Iterate over all IDs and check the visibility status, return the first visible
 	for (LayerMap::const_iterator i = _layers.begin(); i != _layers.end(); ++i)
 	{
-		if (_layerVisibility[i->first])
+		if (_visibleLayers.contains(i->first))
 		{
 			return i->first;
 		}
@@ -211,23 +210,23 @@ bool LayerManager::layerIsVisible(const std::string& layerName)
 		return false;
 	}
 
-	return _layerVisibility[layerID];
+	return _visibleLayers.contains(layerID);
 }
 
 bool LayerManager::layerIsVisible(int layerID) {
 	// Sanity check
-	if (layerID < 0 || layerID >= static_cast<int>(_layerVisibility.size())) {
+	if (layerID < 0 || layerID > getHighestLayerID()) {
 		rMessage() << "LayerSystem: Querying invalid layer ID: " << layerID << std::endl;
 		return false;
 	}
 
-	return _layerVisibility[layerID];
+	return _visibleLayers.contains(layerID);
 }
 
 void LayerManager::setLayerVisibility(int layerID, bool visible)
 {
 	// Sanity check
-	if (layerID < 0 || layerID >= static_cast<int>(_layerVisibility.size()))
+	if (layerID < 0 || layerID > getHighestLayerID())
 	{
 		rMessage() <<
 			"LayerSystem: Setting visibility of invalid layer ID: " <<
@@ -236,7 +235,14 @@ void LayerManager::setLayerVisibility(int layerID, bool visible)
 	}
 
 	// Set the visibility
-	_layerVisibility[layerID] = visible;
+	if (visible)
+	{
+		_visibleLayers.insert(layerID);
+	}
+	else
+	{
+		_visibleLayers.erase(layerID);
+	}
 
 	if (!visible && layerID == _activeLayer)
 	{
@@ -246,8 +252,7 @@ void LayerManager::setLayerVisibility(int layerID, bool visible)
     
     // If the active layer is hidden (which can occur after "hide all")
     // re-set the active layer to this one as it has been made visible
-    if (visible && _activeLayer < static_cast<int>(_layerVisibility.size()) && 
-        !_layerVisibility[_activeLayer])
+    if (visible && !_visibleLayers.contains(_activeLayer))
     {
         _activeLayer = layerID;
     }
@@ -273,8 +278,52 @@ void LayerManager::setLayerVisibility(const std::string& layerName, bool visible
 
 void LayerManager::updateSceneGraphVisibility()
 {
-	UpdateNodeVisibilityWalker walker(GlobalSceneGraph().root());
-	GlobalSceneGraph().root()->traverseChildren(walker);
+	auto root = GlobalSceneGraph().root();
+
+	if (!root) return;
+
+	// Evaluate the layer visibility of every node in parallel, this doesn't
+	// change any state, the flags are applied in a second pass below
+	auto nodes = flattenSubgraph(root, false);
+
+	auto ownVisibility = evaluateInParallel<std::uint8_t>(nodes, [this](const INodePtr& node)
+	{
+		return nodeIsOnVisibleLayer(*node) ? 1 : 0;
+	});
+
+	// A node stays visible as long as one of its descendants is visible.
+	// Walking the pre-ordered list backwards, all descendants of a node
+	// are processed before the node itself, collecting their visibility
+	// in the slot of the depth level below the node.
+	std::vector<bool> descendantIsVisible(1, false);
+
+	for (auto i = nodes.size(); i-- > 0;)
+	{
+		const auto& [node, depth] = nodes[i];
+
+		if (descendantIsVisible.size() < depth + 2)
+		{
+			descendantIsVisible.resize(depth + 2, false);
+		}
+
+		bool isVisible = ownVisibility[i] != 0 || descendantIsVisible[depth + 1];
+
+		// The slot is re-used by the next subtree on this level
+		descendantIsVisible[depth + 1] = false;
+
+		if (isVisible)
+		{
+			descendantIsVisible[depth] = true;
+			node->disable(Node::eLayered);
+		}
+		else
+		{
+			node->enable(Node::eLayered);
+
+			// Node is hidden by layers after update (and no children are visible), de-select
+			Node_setSelected(node, false);
+		}
+	}
 
 	// Redraw
 	SceneChangeNotify();
@@ -382,30 +431,24 @@ void LayerManager::removeSelectionFromLayer(int layerID) {
 	onNodeMembershipChanged();
 }
 
-bool LayerManager::updateNodeVisibility(const scene::INodePtr& node)
+bool LayerManager::nodeIsOnVisibleLayer(const INode& node) const
 {
-    if (!node->supportsStateFlag(Node::eLayered))
+    if (!node.supportsStateFlag(Node::eLayered))
     {
         return true; // doesn't support layers, return true for visible
     }
 
-	// Get the list of layers the node is associated with
-	const auto& layers = node->getLayers();
+	return node.getLayers().intersects(_visibleLayers);
+}
 
-	// We start with the assumption that a node is hidden
-    bool isHidden = true;
+bool LayerManager::updateNodeVisibility(const scene::INodePtr& node)
+{
+    if (!node->supportsStateFlag(Node::eLayered))
+    {
+        return true; // doesn't support layers, return true for visible
+    }
 
-	// Cycle through the Node's layers, and show the node as soon as
-	// a visible layer is found.
-	for (int layerId : layers)
-	{
-		if (_layerVisibility[layerId])
-		{
-			// The layer is visible, set the visibility to true and quit
-            isHidden = false;
-			break;
-		}
-	}
+    bool isHidden = !nodeIsOnVisibleLayer(*node);
 
     if (isHidden)
     {
@@ -420,6 +463,35 @@ bool LayerManager::updateNodeVisibility(const scene::INodePtr& node)
 	return !isHidden;
 }
 
+std::size_t LayerManager::getLayerMemberCount(int layerID) const
+{
+	auto found = _memberCounts.find(layerID);
+	return found != _memberCounts.end() ? found->second : 0;
+}
+
+void LayerManager::updateLayerMemberCounts(const LayerList& oldLayers, const LayerList& newLayers)
+{
+	for (int layerId : oldLayers)
+	{
+		auto found = _memberCounts.find(layerId);
+
+		// Nodes added before the last reset() are not counted
+		if (found == _memberCounts.end()) continue;
+
+		if (--found->second == 0)
+		{
+			_memberCounts.erase(found);
+		}
+	}
+
+	for (int layerId : newLayers)
+	{
+		if (layerId < 0) continue; // we assume positive layer IDs here
+
+		++_memberCounts[layerId];
+	}
+}
+
 void LayerManager::setSelected(int layerID, bool selected)
 {
 	SetLayerSelectedWalker walker(layerID, selected);
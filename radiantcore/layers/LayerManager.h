@@ -12,11 +12,13 @@ class LayerManager :
 	public ILayerManager
 {
 private:
-	// greebo: An array of booleans reflects the visibility status
-	// of all layers. Indexed by the layer id, it can be used to
-	// quickly check whether a layer is visible or not.
-	typedef std::vector<bool> LayerVisibilityList;
-	LayerVisibilityList _layerVisibility;
+	// The set of visible layer IDs, a node is visible if its own
+	// layer set intersects with this one.
+	LayerList _visibleLayers;
+
+	// The number of entities and primitives in each layer, indexed by layer ID.
+	// Only non-zero counts are stored, layer IDs can be arbitrarily large.
+	std::map<int, std::size_t> _memberCounts;
 
 	// The list of named layers, indexed by an integer ID
 	typedef std::map<int, std::string> LayerMap;
@@ -111,6 +113,9 @@ public:
 
 	bool updateNodeVisibility(const scene::INodePtr& node) override;
 
+	std::size_t getLayerMemberCount(int layerID) const override;
+	void updateLayerMemberCounts(const LayerList& oldLayers, const LayerList& newLayers) override;
+
 	// Selects/unselects an entire layer
 	void setSelected(int layerID, bool selected) override;
 
@@ -131,6 +136,10 @@ private:
 	// Updates the visibility state of the entire scenegraph
 	void updateSceneGraphVisibility();
 
+	// Returns true if the node is member of at least one visible layer.
+	// This doesn't change any state and is safe to call from worker threads.
+	bool nodeIsOnVisibleLayer(const INode& node) const;
+
 	// Returns the highest used layer Id
 	int getHighestLayerID() const;
 
@@ -35,7 +35,7 @@ public:
 
 		const auto& layers = node->getLayers();
 
-		if (layers.find(_layer) != layers.end())
+		if (layers.contains(_layer))
 		{
 			Node_setSelected(node, _selected);
 		}
@@ -0,0 +1,112 @@
+#include "TracingModule.h"
+
+#include <fstream>
+#include "itextstream.h"
+#include "iregistry.h"
+
+#include "registry/registry.h"
+#include "registry/adaptors.h"
+#include "module/StaticModule.h"
+#include "os/path.h"
+#include "time/Tracing.h"
+
+namespace applog
+{
+
+namespace
+{
+	const char* const RKEY_TRACING_ENABLED = "debug/tracing/enabled";
+	const char* const DEFAULT_TRACE_FILENAME = "trace.json";
+}
+
+const std::string& TracingModule::getName() const
+{
+	static std::string _name("Tracing");
+	return _name;
+}
+
+const StringSet& TracingModule::getDependencies() const
+{
+	static StringSet _dependencies;
+
+	if (_dependencies.empty())
+	{
+		_dependencies.insert(MODULE_XMLREGISTRY);
+		_dependencies.insert(MODULE_COMMANDSYSTEM);
+	}
+
+	return _dependencies;
+}
+
+void TracingModule::initialiseModule(const IApplicationContext& ctx)
+{
+	_defaultTracePath = os::standardPathWithSlash(ctx.getSettingsPath()) + DEFAULT_TRACE_FILENAME;
+
+	// Modules are initialised by the main thread
+	util::TraceRecorder::Instance().setCurrentThreadName("Main thread");
+
+	registry::observeBooleanKey(
+		RKEY_TRACING_ENABLED,
+		sigc::mem_fun(this, &TracingModule::onTracingEnabled),
+		sigc::mem_fun(this, &TracingModule::onTracingDisabled)
+	);
+
+	if (registry::getValue<bool>(RKEY_TRACING_ENABLED))
+	{
+		onTracingEnabled();
+	}
+
+	GlobalCommandSystem().addCommand("ToggleTracing",
+		std::bind(&TracingModule::toggleTracingCmd, this, std::placeholders::_1));
+	GlobalCommandSystem().addCommand("SaveTrace",
+		std::bind(&TracingModule::saveTraceCmd, this, std::placeholders::_1),
+		{ cmd::ARGTYPE_STRING | cmd::ARGTYPE_OPTIONAL });
+}
+
+void TracingModule::shutdownModule()
+{
+	util::TraceRecorder::SetEnabled(false);
+}
+
+void TracingModule::onTracingEnabled()
+{
+	// Start with a clean slate
+	util::TraceRecorder::Instance().clear();
+	util::TraceRecorder::SetEnabled(true);
+
+	rMessage() << "Tracing enabled, use SaveTrace to write the recorded events to a file" << std::endl;
+}
+
+void TracingModule::onTracingDisabled()
+{
+	util::TraceRecorder::SetEnabled(false);
+	rMessage() << "Tracing disabled" << std::endl;
+}
+
+void TracingModule::toggleTracingCmd(const cmd::ArgumentList& args)
+{
+	registry::setValue(RKEY_TRACING_ENABLED, !registry::getValue<bool>(RKEY_TRACING_ENABLED));
+}
+
+void TracingModule::saveTraceCmd(const cmd::ArgumentList& args)
+{
+	auto path = !args.empty() && !args[0].getString().empty() ? args[0].getString() : _defaultTracePath;
+
+	std::ofstream stream(path);
+
+	if (!stream.good())
+	{
+		rError() << "Could not open " << path << " for writing the trace" << std::endl;
+		return;
+	}
+
+	auto& recorder = util::TraceRecorder::Instance();
+	recorder.writeChromeTrace(stream);
+
+	rMessage() << "Wrote " << recorder.getNumEvents() << " trace events to " << path << std::endl;
+}
+
+// Static module instance
+module::StaticModuleRegistration<TracingModule> tracingModule;
+
+} // namespace applog
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "imodule.h"
+#include "icommandsystem.h"
+
+namespace applog
+{
+
+/**
+ * Controls the util::TraceRecorder of the core module. Tracing is toggled
+ * through the registry key (or the ToggleTracing command), enabling it
+ * discards any previous events. The events recorded so far can be written
+ * to a file in Chrome trace format using the SaveTrace command.
+ */
+class TracingModule :
+	public RegisterableModule
+{
+private:
+	std::string _defaultTracePath;
+
+public:
+	const std::string& getName() const override;
+	const StringSet& getDependencies() const override;
+	void initialiseModule(const IApplicationContext& ctx) override;
+	void shutdownModule() override;
+
+private:
+	void onTracingEnabled();
+	void onTracingDisabled();
+
+	void toggleTracingCmd(const cmd::ArgumentList& args);
+	void saveTraceCmd(const cmd::ArgumentList& args);
+};
+
+} // namespace applog
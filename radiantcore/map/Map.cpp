@@ -27,6 +27,8 @@
 #include "os/path.h"
 #include "os/file.h"
 #include "time/ScopeTimer.h"
+#include "time/ProfilingSession.h"
+#include "time/Tracing.h"
 
 #include "brush/BrushModule.h"
 #include "scene/BasicRootNode.h"
@@ -67,6 +69,29 @@ namespace map
 namespace
 {
     const char* const MAP_UNNAMED_STRING = N_("unnamed.map");
+
+    // Debug settings to get a breakdown of the time spent in the map loading stages
+    const char* const RKEY_MAP_LOAD_PROFILING = "debug/map/profileLoading";
+    const char* const RKEY_MAP_LOAD_TRACE_FILE = "debug/map/loadProfileTraceFile";
+
+    void reportLoadProfile(const util::ProfilingSession& profile, const std::string& traceFile)
+    {
+        rMessage() << profile.getSummary();
+
+        if (traceFile.empty()) return;
+
+        std::ofstream stream(traceFile);
+
+        if (!stream.good())
+        {
+            rError() << "Could not open " << traceFile << " for writing the map load trace" << std::endl;
+            return;
+        }
+
+        profile.writeChromeTrace(stream);
+
+        rMessage() << "Map load trace written to " << traceFile << std::endl;
+    }
 }
 
 Map::Map() :
@@ -137,9 +162,20 @@ void Map::loadMapResourceFromArchive(const std::string& archive, const std::stri
 
 void Map::loadMapResourceFromLocation(const MapLocation& location)
 {
+    util::ScopedTrace trace("map", "Load map", location.path);
+
     rMessage() << "Loading map from " << location.path <<
         (location.isArchive ? " [" + location.archiveRelativePath + "]" : "") << std::endl;
 
+    // Optional profiling of the loading stages
+    std::unique_ptr<util::ProfilingSession> profile;
+    auto traceFile = registry::getValue<std::string>(RKEY_MAP_LOAD_TRACE_FILE);
+
+    if (registry::getValue<bool>(RKEY_MAP_LOAD_PROFILING) || !traceFile.empty())
+    {
+        profile = std::make_unique<util::ProfilingSession>("Map load", !traceFile.empty());
+    }
+
 	// Map loading started
 	emitMapEvent(MapLoading);
 
@@ -154,7 +190,7 @@ void Map::loadMapResourceFromLocation(const MapLocation& location)
 
     try
     {
-        util::ScopeTimer timer("map load");
+        util::ScopedProfilingStage stage("Map resource loading");
 
         if (isUnnamed() || !_resource->load())
         {
@@ -170,7 +206,10 @@ void Map::loadMapResourceFromLocation(const MapLocation& location)
     connectToUndoSystem();
 
     // Take the new node and insert it as map root
-    GlobalSceneGraph().setRoot(_resource->getRootNode());
+    {
+        util::ScopedProfilingStage stage("Scene insertion");
+        GlobalSceneGraph().setRoot(_resource->getRootNode());
+    }
 
 	// Traverse the scenegraph and find the worldspawn
 	findWorldspawn();
@@ -179,6 +218,7 @@ void Map::loadMapResourceFromLocation(const MapLocation& location)
     // This usually takes a while since all editor textures are loaded - display a dialog to inform the user
     {
         radiant::ScopedLongRunningOperation blocker(_("Loading textures..."));
+        util::ScopedProfilingStage stage("Render system attachment");
 
         GlobalSceneGraph().root()->setRenderSystem(std::dynamic_pointer_cast<RenderSystem>(
             module::GlobalModuleRegistry().getModule(MODULE_RENDERSYSTEM)));
@@ -197,10 +237,19 @@ void Map::loadMapResourceFromLocation(const MapLocation& location)
     rMessage() << GlobalCounters().getCounter(counterEntities).get() << " entities\n";
 
     // Let the filtersystem update the filtered status of all instances
-    GlobalFilterSystem().update();
+    {
+        util::ScopedProfilingStage stage("Filter update");
+        GlobalFilterSystem().update();
+    }
 
     // Clear the modified flag
     setModified(false);
+
+    if (profile)
+    {
+        profile->stop();
+        reportLoadProfile(*profile, traceFile);
+    }
 }
 
 void Map::finishMergeOperation()
@@ -684,7 +733,13 @@ bool Map::import(const std::string& filename)
 {
     bool success = false;
 
-    IMapResourcePtr resource = GlobalMapResourceManager().createFromPath(filename);
+    // Re-use the nodes if the file is still loaded elsewhere (e.g. in the prefab preview)
+    auto resource = GlobalMapResourceManager().createFromLoadedResource(filename);
+
+    if (!resource)
+    {
+        resource = GlobalMapResourceManager().createFromPath(filename);
+    }
 
     try
     {
@@ -21,6 +21,7 @@
 #include "os/fs.h"
 #include "scene/Traverse.h"
 #include "scenelib.h"
+#include "time/Tracing.h"
 
 #include <functional>
 #include <fmt/format.h>
@@ -405,6 +406,8 @@ void MapResource::throwIfNotWriteable(const fs::path& path)
 void MapResource::saveFile(const MapFormat& format, const scene::IMapRootNodePtr& root,
 						   const GraphTraversalFunc& traverse, const std::string& filename)
 {
+	util::ScopedTrace trace("map", "Save map", filename);
+
 	// Actual output file paths
 	fs::path outFile = filename;
 	fs::path auxFile = outFile;
@@ -4,6 +4,7 @@
 #include "fmt/format.h"
 #include "scene/ChildPrimitives.h"
 #include "scenelib.h"
+#include "time/ProfilingSession.h"
 #include "algorithm/MapImporter.h"
 #include "messages/MapFileOperation.h"
 
@@ -30,11 +31,14 @@ RootNodePtr MapResourceLoader::load()
 
         rMessage() << "Using " << _format.getMapFormatName() << " format to load the data." << std::endl;
 
-        // Start parsing
-        reader->readFromStream(_stream);
+        // Start parsing, the tokeniser is running on a worker thread
+        importFilter.parse(*reader);
 
         // Prepare child primitives
-        scene::addOriginToChildPrimitives(root);
+        {
+            util::ScopedProfilingStage stage("Child primitive preparation");
+            scene::addOriginToChildPrimitives(root);
+        }
 
         // Move the index mapping to this class before destroying the import filter
         _indexMapping.swap(importFilter.getNodeMap());
@@ -70,6 +74,8 @@ void MapResourceLoader::loadInfoFile(std::istream& stream, const RootNodePtr& ro
 
     rMessage() << "Parsing info file..." << std::endl;
 
+    util::ScopedProfilingStage stage("Info file parsing");
+
     try
     {
         // Read the infofile
@@ -3,8 +3,10 @@
 #include "ifilesystem.h"
 #include "ifiletypes.h"
 #include "itextstream.h"
+#include "imapfilechangetracker.h"
 #include "os/path.h"
 #include "module/StaticModule.h"
+#include "scene/Clone.h"
 #include "MapResource.h"
 #include "ArchivedMapResource.h"
 #include "VersionControlLib.h"
@@ -13,6 +15,42 @@
 namespace map
 {
 
+namespace
+{
+    // Creates a new root node holding a copy of the given root's nodes, layers and properties
+    RootNodePtr copyRootNode(const scene::IMapRootNodePtr& source)
+    {
+        auto root = std::make_shared<RootNode>(source->name());
+
+        source->foreachProperty([&](const std::string& key, const std::string& value)
+        {
+            root->setProperty(key, value);
+        });
+
+        // The cloned nodes keep their layer assignments, the layers need to exist
+        source->getLayerManager().foreachLayer([&](int layerId, const std::string& layerName)
+        {
+            if (!root->getLayerManager().layerExists(layerId))
+            {
+                root->getLayerManager().createLayer(layerName, layerId);
+            }
+        });
+
+        scene::SubgraphCloner cloner(root);
+        source->traverseChildren(cloner);
+
+        // The source nodes might have been filtered (e.g. in a preview),
+        // the copies start out unfiltered like freshly parsed nodes do
+        root->foreachNode([](const scene::INodePtr& node)
+        {
+            node->setFiltered(false);
+            return true;
+        });
+
+        return root;
+    }
+}
+
 IMapResourcePtr MapResourceManager::createFromPath(const std::string& path)
 {
     if (vcs::pathIsVcsUri(path))
@@ -20,7 +58,55 @@ IMapResourcePtr MapResourceManager::createFromPath(const std::string& path)
         return std::make_shared<VcsMapResource>(path);
     }
 
-	return std::make_shared<MapResource>(path);
+    removeExpiredResources();
+
+	auto resource = std::make_shared<MapResource>(path);
+    _resources.emplace(os::standardPath(path), resource);
+
+    return resource;
+}
+
+IMapResourcePtr MapResourceManager::createFromLoadedResource(const std::string& path)
+{
+    removeExpiredResources();
+
+    auto range = _resources.equal_range(os::standardPath(path));
+
+    for (auto i = range.first; i != range.second; ++i)
+    {
+        auto loaded = i->second.lock();
+
+        if (!loaded || !loaded->getRootNode() ||
+            !loaded->getRootNode()->getUndoChangeTracker().isAtSavedPosition() ||
+            loaded->fileOnDiskHasBeenModifiedSinceLastSave())
+        {
+            continue;
+        }
+
+        auto resource = std::make_shared<MapResource>(path);
+        resource->setRootNode(copyRootNode(loaded->getRootNode()));
+
+        _resources.emplace(os::standardPath(path), resource);
+
+        return resource;
+    }
+
+    return IMapResourcePtr();
+}
+
+void MapResourceManager::removeExpiredResources()
+{
+    for (auto i = _resources.begin(); i != _resources.end();)
+    {
+        if (i->second.expired())
+        {
+            i = _resources.erase(i);
+        }
+        else
+        {
+            ++i;
+        }
+    }
 }
 
 IMapResourcePtr MapResourceManager::createFromArchiveFile(const std::string& archivePath,
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <map>
 #include "imapresource.h"
 #include "map/MapResource.h"
 
@@ -13,10 +14,14 @@ private:
 	ExportEvent _resourceExporting;
 	ExportEvent _resourceExported;
 
+	// The resources created from (non-VCS) paths, to find already loaded ones
+	std::multimap<std::string, std::weak_ptr<MapResource>> _resources;
+
 public:
 	IMapResourcePtr createFromPath(const std::string& path) override;
     IMapResourcePtr createFromArchiveFile(const std::string& archivePath,
         const std::string& filePathWithinArchive) override;
+    IMapResourcePtr createFromLoadedResource(const std::string& path) override;
 
 	ExportEvent& signal_onResourceExporting() override;
 	ExportEvent& signal_onResourceExported() override;
@@ -25,6 +30,9 @@ public:
 	virtual const std::string& getName() const override;
 	virtual const StringSet& getDependencies() const override;
 	virtual void initialiseModule(const IApplicationContext& ctx) override;
+
+private:
+	void removeExpiredResources();
 };
 
 }
@@ -18,6 +18,8 @@
 #include "scenelib.h"
 #include "entitylib.h"
 #include "command/ExecutionFailure.h"
+#include "messages/MapFileOperation.h"
+#include "MapImporter.h"
 
 #include "string/join.h"
 
@@ -301,46 +303,12 @@ MapFormatPtr determineMapFormat(std::istream& stream)
 	return determineMapFormat(stream, std::string());
 }
 
-class SimpleMapImportFilter :
-    public IMapImportFilter
-{
-private:
-    scene::IMapRootNodePtr _root;
-
-public:
-    SimpleMapImportFilter() :
-        _root(std::make_shared<scene::BasicRootNode>())
-    {}
-
-    const scene::IMapRootNodePtr& getRootNode() const
-    {
-        return _root;
-    }
-
-    bool addEntity(const scene::INodePtr& entityNode)
-    {
-        _root->addChildNode(entityNode);
-        return true;
-    }
-
-    bool addPrimitiveToEntity(const scene::INodePtr& primitive, const scene::INodePtr& entity)
-    {
-        if (Node_getEntity(entity)->isContainer())
-        {
-            entity->addChildNode(primitive);
-            return true;
-        }
-        
-        return false;
-    }
-};
-
 void importFromStream(std::istream& stream)
 {
 	GlobalSelectionSystem().setSelectedAll(false);
 
-    // Instantiate the default import filter
-    SimpleMapImportFilter importFilter;
+    // The nodes are parsed into a detached root first
+    auto root = std::make_shared<scene::BasicRootNode>();
 
     try
     {
@@ -351,24 +319,37 @@ void importFromStream(std::istream& stream)
             throw IMapReader::FailureException(_("Unknown map format"));
         }
 
-        auto reader = format->getMapReader(importFilter);
+        {
+            // Instantiate the default import filter
+            MapImporter importFilter(root, stream);
+
+            auto reader = format->getMapReader(importFilter);
 
-        // Start parsing
-        reader->readFromStream(stream);
+            // Parse the stream into the detached root
+            importFilter.parse(*reader);
+        }
 
         // Prepare child primitives
-        scene::addOriginToChildPrimitives(importFilter.getRootNode());
+        scene::addOriginToChildPrimitives(root);
+
+        // Only the name adjustment and the insertion happen in the scene
 
         // Adjust all new names to fit into the existing map namespace
-        prepareNamesForImport(GlobalMap().getRoot(), importFilter.getRootNode());
+        prepareNamesForImport(GlobalMap().getRoot(), root);
 
-        importMap(importFilter.getRootNode());
+        importMap(root);
+    }
+    catch (FileOperation::OperationCancelled&)
+    {
+        // Nothing has been imported, discard the parsed nodes
+        scene::NodeRemover remover;
+        root->traverseChildren(remover);
     }
     catch (IMapReader::FailureException& ex)
     {
         // Clear out the root node, otherwise we end up with half a map
         scene::NodeRemover remover;
-        importFilter.getRootNode()->traverseChildren(remover);
+        root->traverseChildren(remover);
         
 		throw cmd::ExecutionFailure(fmt::format(_("Failure reading map from clipboard:\n{0}"), ex.what()));
     }
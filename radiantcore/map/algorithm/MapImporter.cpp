@@ -5,9 +5,12 @@
 #include "imap.h"
 #include "iradiant.h"
 
+#include <istream>
+#include <streambuf>
 #include <fmt/format.h>
 #include "registry/registry.h"
 #include "string/string.h"
+#include "time/ProfilingSession.h"
 #include "messages/MapFileOperation.h"
 
 namespace map
@@ -17,6 +20,45 @@ namespace
 {
 	const char* const RKEY_MAP_LOAD_STATUS_INTERLEAVE = "user/ui/map/loadStatusInterleave";
 	std::size_t EMPTY_PRIMITVE_NUM = std::numeric_limits<std::size_t>::max();
+
+	// Reads from another stream buffer, counting the bytes passing through.
+	// The counter can be queried from other threads than the reading one.
+	class CountingStreamBuf :
+		public std::streambuf
+	{
+	private:
+		std::streambuf& _source;
+		std::atomic<std::size_t>& _bytesRead;
+
+		char _buffer[16384];
+
+	public:
+		CountingStreamBuf(std::streambuf& source, std::atomic<std::size_t>& bytesRead) :
+			_source(source),
+			_bytesRead(bytesRead)
+		{}
+
+	protected:
+		int_type underflow() override
+		{
+			if (gptr() < egptr())
+			{
+				return traits_type::to_int_type(*gptr());
+			}
+
+			auto count = _source.sgetn(_buffer, sizeof(_buffer));
+
+			if (count <= 0)
+			{
+				return traits_type::eof();
+			}
+
+			_bytesRead += static_cast<std::size_t>(count);
+			setg(_buffer, _buffer, _buffer + count);
+
+			return traits_type::to_int_type(*gptr());
+		}
+	};
 }
 
 MapImporter::MapImporter(const scene::IMapRootNodePtr& root, std::istream& inputStream) :
@@ -25,7 +67,8 @@ MapImporter::MapImporter(const scene::IMapRootNodePtr& root, std::istream& input
 	_entityCount(0),
 	_primitiveCount(0),
 	_inputStream(inputStream),
-	_fileSize(0)
+	_fileSize(0),
+	_bytesRead(0)
 {
 	// Get the file size, for handling the progress dialog
 	_inputStream.seekg(0, std::ios::end);
@@ -66,9 +109,7 @@ bool MapImporter::addEntity(const scene::INodePtr& entityNode)
 
 	if (_dialogEventLimiter.readyForEvent())
 	{
-		FileOperation msg(FileOperation::Type::Import, FileOperation::Progress, _fileSize > 0, getProgressFraction());
-		msg.setText(_dlgEntityText);
-		GlobalRadiantCore().getMessageBus().sendMessage(msg);
+		sendProgressMessage(_dlgEntityText);
 	}
 
 	_root->addChildNode(entityNode);
@@ -86,9 +127,7 @@ bool MapImporter::addPrimitiveToEntity(const scene::INodePtr& primitive, const s
 	if (_dialogEventLimiter.readyForEvent())
 	{
 		// Update the dialog text
-		FileOperation msg(FileOperation::Type::Import, FileOperation::Progress, _fileSize > 0, getProgressFraction());
-		msg.setText(_dlgEntityText + fmt::format(_("Primitive {0:d}"), _primitiveCount));
-		GlobalRadiantCore().getMessageBus().sendMessage(msg);
+		sendProgressMessage(_dlgEntityText + fmt::format(_("Primitive {0:d}"), _primitiveCount));
 	}
 
 	if (Node_getEntity(entity)->isContainer())
@@ -114,8 +153,33 @@ NodeIndexMap& MapImporter::getNodeMap()
 
 float MapImporter::getProgressFraction()
 {
-	long readBytes = static_cast<long>(_inputStream.tellg());
-	return static_cast<float>(readBytes) / _fileSize;
+	// The stream itself is owned by the tokeniser thread
+	return static_cast<float>(_bytesRead.load()) / _fileSize;
+}
+
+void MapImporter::sendProgressMessage(const std::string& text)
+{
+	FileOperation msg(FileOperation::Type::Import, FileOperation::Progress, _fileSize > 0, getProgressFraction());
+	msg.setText(text);
+
+	// The progress dialog is processing the pending UI events while handling this
+	GlobalRadiantCore().getMessageBus().sendMessage(msg);
+}
+
+void MapImporter::parse(IMapReader& reader)
+{
+	{
+		util::ScopedProfilingStage stage("Map parsing");
+
+		CountingStreamBuf countingBuffer(*_inputStream.rdbuf(), _bytesRead);
+		std::istream countingStream(&countingBuffer);
+
+		reader.readFromStream(countingStream);
+	}
+
+	util::addProfilingCount("Bytes parsed", _fileSize);
+	util::addProfilingCount("Entities created", _entityCount);
+	util::addProfilingCount("Primitives created", _primitiveCount);
 }
 
 } // namespace
@@ -4,6 +4,7 @@
 #include "imapformat.h"
 #include "imapinfofile.h"
 #include <map>
+#include <atomic>
 
 #include "EventRateLimiter.h"
 
@@ -19,6 +20,13 @@ namespace map
  *
  * This IMapImportFilter implementation will be sending messages across
  * the wire for the UI to react to, displaying progress, etc.
+ *
+ * The readers split the stream into tokens on a worker thread, while the
+ * nodes are constructed on the calling thread (the UI thread), since the
+ * entities, models and brushes are created through modules which are not
+ * thread-safe. The nodes are added to the detached root passed to the
+ * constructor. Handling the progress messages gives the UI a chance to
+ * process its events, and to cancel the operation by throwing OperationCancelled.
  */
 class MapImporter :
 	public IMapImportFilter
@@ -40,6 +48,10 @@ private:
 	std::istream& _inputStream;
 	std::size_t _fileSize;
 
+	// The number of bytes consumed by the reader's tokeniser so far,
+	// updated by the tokeniser thread while parse() is running
+	std::atomic<std::size_t> _bytesRead;
+
 	// Keep track of all the entities and primitives for later retrieval
 	NodeIndexMap _nodes;
 
@@ -55,8 +67,20 @@ public:
 	const NodeIndexMap& getNodeMap() const;
 	NodeIndexMap& getNodeMap();
 
+	/**
+	 * Parses the stream passed to the constructor using the given reader,
+	 * recording the parse statistics in the active profiling session.
+	 * The stream is read through a wrapper counting the consumed bytes,
+	 * the progress is derived from that count.
+	 * A cancellation request is reported as FileOperation::OperationCancelled.
+	 */
+	void parse(IMapReader& reader);
+
 private:
 	float getProgressFraction();
+
+	// Sends a progress message, any listener might cancel the operation by throwing
+	void sendProgressMessage(const std::string& text);
 };
 
 } // namespace
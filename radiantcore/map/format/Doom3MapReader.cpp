@@ -5,6 +5,8 @@
 #include "igame.h"
 #include "ientity.h"
 #include "string/string.h"
+#include "parser/ThreadedDefTokeniser.h"
+#include "time/ProfilingSession.h"
 
 #include "Doom3MapFormat.h"
 
@@ -29,8 +31,9 @@ void Doom3MapReader::readFromStream(std::istream& stream)
 	// Call the virtual method to initialise the primitve parser map (if not done yet)
 	initPrimitiveParsers();
 
-	// The tokeniser used to split the stream into pieces
-	parser::BasicDefTokeniser<std::istream> tok(stream);
+	// The tokeniser used to split the stream into pieces, this is running
+	// on a worker thread while the nodes are constructed on this one
+	parser::ThreadedDefTokeniser tok(stream);
 
 	// Try to parse the map version (throws on failure)
 	parseMapVersion(tok);
@@ -136,6 +139,8 @@ void Doom3MapReader::parsePrimitive(parser::DefTokeniser& tok, const scene::INod
 	// Try to parse the primitive, throwing exception if failed
 	try
 	{
+		util::ScopedProfilingStage stage("Primitive parsing");
+
 		scene::INodePtr primitive = parser->parse(tok);
 
 		if (!primitive)
@@ -157,6 +162,8 @@ void Doom3MapReader::parsePrimitive(parser::DefTokeniser& tok, const scene::INod
 
 scene::INodePtr Doom3MapReader::createEntity(const EntityKeyValues& keyValues)
 {
+    util::ScopedProfilingStage stage("Entity creation");
+
     // Get the classname from the EntityKeyValues
     EntityKeyValues::const_iterator found = keyValues.find("classname");
 
@@ -5,6 +5,8 @@
 #include "igame.h"
 #include "ientity.h"
 #include "string/string.h"
+#include "parser/ThreadedDefTokeniser.h"
+#include "time/ProfilingSession.h"
 
 #include "i18n.h"
 #include <fmt/format.h>
@@ -27,8 +29,9 @@ void Quake3MapReader::readFromStream(std::istream& stream)
 	// Call the virtual method to initialise the primitve parser map (if not done yet)
 	initPrimitiveParsers();
 
-	// The tokeniser used to split the stream into pieces
-	parser::BasicDefTokeniser<std::istream> tok(stream);
+	// The tokeniser used to split the stream into pieces, this is running
+	// on a worker thread while the nodes are constructed on this one
+	parser::ThreadedDefTokeniser tok(stream);
 
 	// Read each entity in the map, until EOF is reached
 	while (tok.hasMoreTokens())
@@ -94,6 +97,8 @@ void Quake3MapReader::parsePrimitive(parser::DefTokeniser& tok, const scene::INo
 	// Try to parse the primitive, throwing exception if failed
 	try
 	{
+		util::ScopedProfilingStage stage("Primitive parsing");
+
 		scene::INodePtr primitive = parser->parse(tok);
 
 		if (!primitive)
@@ -115,6 +120,8 @@ void Quake3MapReader::parsePrimitive(parser::DefTokeniser& tok, const scene::INo
 
 scene::INodePtr Quake3MapReader::createEntity(const EntityKeyValues& keyValues)
 {
+    util::ScopedProfilingStage stage("Entity creation");
+
     // Get the classname from the EntityKeyValues
     EntityKeyValues::const_iterator found = keyValues.find("classname");
 
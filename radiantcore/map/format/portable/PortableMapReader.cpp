@@ -14,7 +14,9 @@
 
 #include "scenelib.h"
 #include "string/convert.h"
-#include "xmlutil/Document.h"
+#include "time/ProfilingSession.h"
+#include "xmlutil/StreamReader.h"
+#include "xmlutil/ParseException.h"
 
 namespace map
 {
@@ -33,21 +35,60 @@ namespace
 		{}
 	};
 
-	// Retrieves the first named child - will throw BadDocumentFormatException if there are 0 or 2+ matching nodes
-	inline xml::Node getNamedChild(const xml::Node& node, const std::string& tagName)
+}
+
+using namespace map::format::constants;
+
+struct PortableMapReader::Tag
+{
+	std::string name;
+	std::vector<std::pair<std::string, std::string>> attributes;
+	std::vector<Tag> children;
+
+	// Return the value of the given attribute, or an empty string if it is not present
+	const std::string& getAttributeValue(const std::string& key) const
 	{
-		auto children = node.getNamedChildren(tagName);
+		static const std::string EMPTY;
 
-		if (children.size() != 1)
+		for (const auto& attribute : attributes)
 		{
-			throw BadDocumentFormatException("Odd number of " + tagName + " nodes encountered.");
+			if (attribute.first == key)
+			{
+				return attribute.second;
+			}
 		}
 
-		return children.front();
+		return EMPTY;
 	}
-}
 
-using namespace map::format::constants;
+	std::vector<const Tag*> getNamedChildren(const std::string& childName) const
+	{
+		std::vector<const Tag*> result;
+
+		for (const auto& child : children)
+		{
+			if (child.name == childName)
+			{
+				result.push_back(&child);
+			}
+		}
+
+		return result;
+	}
+
+	// Retrieves the first named child - will throw BadDocumentFormatException if there are 0 or 2+ matching nodes
+	const Tag& getNamedChild(const std::string& childName) const
+	{
+		auto namedChildren = getNamedChildren(childName);
+
+		if (namedChildren.size() != 1)
+		{
+			throw BadDocumentFormatException("Odd number of " + childName + " nodes encountered.");
+		}
+
+		return *namedChildren.front();
+	}
+};
 
 PortableMapReader::PortableMapReader(IMapImportFilter& importFilter) :
 	_importFilter(importFilter)
@@ -55,163 +96,218 @@ PortableMapReader::PortableMapReader(IMapImportFilter& importFilter) :
 
 void PortableMapReader::readFromStream(std::istream& stream)
 {
-	xml::Document doc(stream);
+	// The tags from the top-level map tag down to the current one. Tags below the
+	// entity primitives and the header tags collect their children until they're
+	// closed, at which point they are read and discarded.
+	std::vector<Tag> openTags;
 
-	auto mapNode = doc.getTopLevelNode();
+	// Number of occurrences of the header tags below the map tag
+	std::map<std::string, std::size_t> headerTagCount =
+	{
+		{ TAG_MAP_LAYERS, 0 }, { TAG_SELECTIONGROUPS, 0 }, { TAG_SELECTIONSETS, 0 }, { TAG_MAP_PROPERTIES, 0 }
+	};
 
-	if (string::convert<std::size_t>(mapNode.getAttributeValue(ATTR_VERSION)) != PortableMapFormat::Version)
+	try
 	{
-		throw FailureException("Unsupported format version.");
-	}
+		xml::StreamReader reader(stream);
 
-	readLayers(mapNode);
-	readSelectionGroups(mapNode);
-	readSelectionSets(mapNode);
-	readMapProperties(mapNode);
+		while (reader.readNext())
+		{
+			if (reader.isStartElement())
+			{
+				openTags.emplace_back();
+				openTags.back().name = reader.getName();
 
-	readEntities(mapNode);
-}
+				reader.foreachAttribute([&](const std::string& name, const std::string& value)
+				{
+					openTags.back().attributes.emplace_back(name, value);
+				});
 
-void PortableMapReader::readLayers(const xml::Node& mapNode)
-{
-	try
-	{
-		_importFilter.getRootNode()->getLayerManager().reset();
+				if (openTags.size() == 1)
+				{
+					beginMap(openTags.front());
+				}
 
-		auto mapLayers = getNamedChild(mapNode, TAG_MAP_LAYERS);
+				continue;
+			}
 
-		auto layers = mapLayers.getNamedChildren(TAG_MAP_LAYER);
+			auto tag = std::move(openTags.back());
+			openTags.pop_back();
 
-		for (const auto& layer : layers)
-		{
-			auto id = string::convert<int>(layer.getAttributeValue(ATTR_MAP_LAYER_ID));
-			auto name = layer.getAttributeValue(ATTR_MAP_LAYER_NAME);
+			// The nesting level of the tag just closed, the map tag is at level 0
+			auto level = openTags.size();
 
-			_importFilter.getRootNode()->getLayerManager().createLayer(name, id);
+			if (level == 1 && tag.name == TAG_ENTITY)
+			{
+				try
+				{
+					readEntity(tag);
+				}
+				catch (const BadDocumentFormatException& ex)
+				{
+					rError() << "PortableMapReader: Failed to parse entity: " << ex.what() << std::endl;
+				}
+			}
+			else if (level == 1)
+			{
+				auto count = headerTagCount.find(tag.name);
+
+				if (count == headerTagCount.end()) continue;
+
+				if (count->second++ > 0)
+				{
+					rError() << "PortableMapReader: Odd number of " << tag.name << " nodes encountered." << std::endl;
+					continue;
+				}
+
+				if (tag.name == TAG_MAP_LAYERS)
+				{
+					readLayers(tag);
+				}
+				else if (tag.name == TAG_SELECTIONGROUPS)
+				{
+					readSelectionGroups(tag);
+				}
+				else if (tag.name == TAG_SELECTIONSETS)
+				{
+					readSelectionSets(tag);
+				}
+				else if (tag.name == TAG_MAP_PROPERTIES)
+				{
+					readMapProperties(tag);
+				}
+			}
+			else if (level == 2 && openTags[1].name == TAG_ENTITY && tag.name == TAG_ENTITY_PRIMITIVES)
+			{
+				continue; // the primitives have been read already
+			}
+			else if (level == 3 && openTags[1].name == TAG_ENTITY && openTags[2].name == TAG_ENTITY_PRIMITIVES)
+			{
+				readPrimitive(tag, openTags[1].getAttributeValue(ATTR_ENTITY_NUMBER));
+			}
+			else if (level > 1)
+			{
+				openTags.back().children.emplace_back(std::move(tag));
+			}
 		}
 	}
-	catch (const BadDocumentFormatException& ex)
+	catch (const xml::ParseException& ex)
 	{
-		rError() << "PortableMapReader: " << ex.what() << std::endl;
+		throw FailureException(std::string("Failed to parse XML: ") + ex.what());
 	}
-}
 
-void PortableMapReader::readSelectionGroups(const xml::Node& mapNode)
-{
-	try
+	for (const auto& pair : headerTagCount)
 	{
-		assert(_importFilter.getRootNode());
-		_importFilter.getRootNode()->getSelectionGroupManager().deleteAllSelectionGroups();
-
-		auto mapSelGroups = getNamedChild(mapNode, TAG_SELECTIONGROUPS);
-
-		auto groups = mapSelGroups.getNamedChildren(TAG_SELECTIONGROUP);
-
-		for (const auto& group : groups)
+		if (pair.second == 0)
 		{
-			auto id = string::convert<std::size_t>(group.getAttributeValue(ATTR_SELECTIONGROUP_ID));
-			auto name = group.getAttributeValue(ATTR_SELECTIONGROUP_NAME);
-
-			auto newGroup = _importFilter.getRootNode()->getSelectionGroupManager().createSelectionGroup(id);
-			newGroup->setName(name);
+			rError() << "PortableMapReader: Odd number of " << pair.first << " nodes encountered." << std::endl;
 		}
 	}
-	catch (const BadDocumentFormatException & ex)
-	{
-		rError() << "PortableMapReader: " << ex.what() << std::endl;
-	}
 }
 
-void PortableMapReader::readSelectionSets(const xml::Node& mapNode)
+void PortableMapReader::beginMap(const Tag& mapTag)
 {
-	try
+	if (string::convert<std::size_t>(mapTag.getAttributeValue(ATTR_VERSION)) != PortableMapFormat::Version)
 	{
-		_selectionSets.clear();
+		throw FailureException("Unsupported format version.");
+	}
 
-		assert(_importFilter.getRootNode());
-		_importFilter.getRootNode()->getSelectionSetManager().deleteAllSelectionSets();
+	assert(_importFilter.getRootNode());
+	const auto& root = _importFilter.getRootNode();
 
-		auto mapSelSets = getNamedChild(mapNode, TAG_SELECTIONSETS);
+	// Start with a clean slate, the header tags will fill in the map's information
+	root->getLayerManager().reset();
+	root->getSelectionGroupManager().deleteAllSelectionGroups();
 
-		auto setNodes = mapSelSets.getNamedChildren(TAG_SELECTIONSET);
+	_selectionSets.clear();
+	root->getSelectionSetManager().deleteAllSelectionSets();
 
-		for (const auto& setNode : setNodes)
-		{
-			auto id = string::convert<std::size_t>(setNode.getAttributeValue(ATTR_SELECTIONSET_ID));
-			auto name = setNode.getAttributeValue(ATTR_SELECTIONSET_NAME);
+	root->clearProperties();
 
-			auto set = _importFilter.getRootNode()->getSelectionSetManager().createSelectionSet(name);
-			_selectionSets[id] = set;
-		}
-	}
-	catch (const BadDocumentFormatException & ex)
-	{
-		rError() << "PortableMapReader: " << ex.what() << std::endl;
-	}
+	_entityPrimitives.clear();
 }
 
-void PortableMapReader::readMapProperties(const xml::Node& mapNode)
+void PortableMapReader::readLayers(const Tag& layersTag)
 {
-	try
+	for (const auto& layer : layersTag.getNamedChildren(TAG_MAP_LAYER))
 	{
-		_importFilter.getRootNode()->clearProperties();
+		auto id = string::convert<int>(layer->getAttributeValue(ATTR_MAP_LAYER_ID));
+		const auto& name = layer->getAttributeValue(ATTR_MAP_LAYER_NAME);
 
-		auto mapProperties = getNamedChild(mapNode, TAG_MAP_PROPERTIES);
-
-		auto propertyNodes = mapProperties.getNamedChildren(TAG_MAP_PROPERTY);
+		_importFilter.getRootNode()->getLayerManager().createLayer(name, id);
+	}
+}
 
-		for (const auto& propertyNode : propertyNodes)
-		{
-			auto key = propertyNode.getAttributeValue(ATTR_MAP_PROPERTY_KEY);
-			auto value = propertyNode.getAttributeValue(ATTR_MAP_PROPERTY_VALUE);
+void PortableMapReader::readSelectionGroups(const Tag& selectionGroupsTag)
+{
+	for (const auto& group : selectionGroupsTag.getNamedChildren(TAG_SELECTIONGROUP))
+	{
+		auto id = string::convert<std::size_t>(group->getAttributeValue(ATTR_SELECTIONGROUP_ID));
+		const auto& name = group->getAttributeValue(ATTR_SELECTIONGROUP_NAME);
 
-			_importFilter.getRootNode()->setProperty(key, value);
-		}
+		auto newGroup = _importFilter.getRootNode()->getSelectionGroupManager().createSelectionGroup(id);
+		newGroup->setName(name);
 	}
-	catch (const BadDocumentFormatException & ex)
+}
+
+void PortableMapReader::readSelectionSets(const Tag& selectionSetsTag)
+{
+	for (const auto& setTag : selectionSetsTag.getNamedChildren(TAG_SELECTIONSET))
 	{
-		rError() << "PortableMapReader: " << ex.what() << std::endl;
+		auto id = string::convert<std::size_t>(setTag->getAttributeValue(ATTR_SELECTIONSET_ID));
+		const auto& name = setTag->getAttributeValue(ATTR_SELECTIONSET_NAME);
+
+		auto set = _importFilter.getRootNode()->getSelectionSetManager().createSelectionSet(name);
+		_selectionSets[id] = set;
 	}
 }
 
-void PortableMapReader::readEntities(const xml::Node& mapNode)
+void PortableMapReader::readMapProperties(const Tag& propertiesTag)
 {
-	auto entityNodes = mapNode.getNamedChildren(TAG_ENTITY);
-
-	for (const auto& entityNode : entityNodes)
+	for (const auto& propertyTag : propertiesTag.getNamedChildren(TAG_MAP_PROPERTY))
 	{
-		try
-		{
-			readEntity(entityNode);
-		}
-		catch (const BadDocumentFormatException & ex)
-		{
-			rError() << "PortableMapReader: Failed to parse entity: " << ex.what() << std::endl;
-			continue;
-		}
+		const auto& key = propertyTag->getAttributeValue(ATTR_MAP_PROPERTY_KEY);
+		const auto& value = propertyTag->getAttributeValue(ATTR_MAP_PROPERTY_VALUE);
+
+		_importFilter.getRootNode()->setProperty(key, value);
 	}
 }
 
-void PortableMapReader::readPrimitives(const xml::Node& primitivesNode, const scene::INodePtr& entity)
+void PortableMapReader::readPrimitive(const Tag& primitiveTag, const std::string& entityNumber)
 {
-	auto childNodes = primitivesNode.getChildren();
-	
-	for (const auto childNode : childNodes)
+	util::ScopedProfilingStage stage("Primitive parsing");
+
+	try
 	{
-		const std::string name = childNode.getName();
+		scene::INodePtr node;
 
-		if (name == TAG_BRUSH)
+		if (primitiveTag.name == TAG_BRUSH)
+		{
+			node = readBrush(primitiveTag, entityNumber);
+		}
+		else if (primitiveTag.name == TAG_PATCH)
 		{
-			readBrush(childNode, entity);
+			node = readPatch(primitiveTag);
 		}
-		else if (name == TAG_PATCH)
+		else
 		{
-			readPatch(childNode, entity);
+			return;
 		}
+
+		_entityPrimitives.push_back(node);
+
+		readLayerInformation(primitiveTag, node);
+		readSelectionGroupInformation(primitiveTag, node);
+		readSelectionSetInformation(primitiveTag, node);
+	}
+	catch (const BadDocumentFormatException& ex)
+	{
+		rError() << "PortableMapReader: Entity " << entityNumber << ", " << primitiveTag.name << " " <<
+			primitiveTag.getAttributeValue(ATTR_BRUSH_NUMBER) << ": " << ex.what() << std::endl;
 	}
 }
 
-void PortableMapReader::readBrush(const xml::Node& brushTag, const scene::INodePtr& entity)
+scene::INodePtr PortableMapReader::readBrush(const Tag& brushTag, const std::string& entityNumber)
 {
 	// Create a new brush
 	auto node = GlobalBrushCreator().createBrush();
@@ -222,14 +318,13 @@ void PortableMapReader::readBrush(const xml::Node& brushTag, const scene::INodeP
 
 	IBrush& brush = brushNode->getIBrush();
 
-	auto facesTag = getNamedChild(brushTag, TAG_FACES);
-	auto faceTags = facesTag.getNamedChildren(TAG_FACE);
+	const auto& facesTag = brushTag.getNamedChild(TAG_FACES);
 
-	for (const auto& faceTag : faceTags)
+	for (const auto& faceTag : facesTag.getNamedChildren(TAG_FACE))
 	{
 		try
 		{
-			auto planeTag = getNamedChild(faceTag, TAG_FACE_PLANE);
+			const auto& planeTag = faceTag->getNamedChild(TAG_FACE_PLANE);
 
 			// Construct a plane and parse its values
 			Plane3 plane;
@@ -239,7 +334,7 @@ void PortableMapReader::readBrush(const xml::Node& brushTag, const scene::INodeP
 			plane.normal().z() = string::to_float(planeTag.getAttributeValue(ATTR_FACE_PLANE_Z));
 			plane.dist() = -string::to_float(planeTag.getAttributeValue(ATTR_FACE_PLANE_D)); // negate d
 
-			auto texProjTag = getNamedChild(faceTag, TAG_FACE_TEXPROJ);
+			const auto& texProjTag = faceTag->getNamedChild(TAG_FACE_TEXPROJ);
 
 			// Parse TexDef
 			Matrix3 texdef;
@@ -252,11 +347,11 @@ void PortableMapReader::readBrush(const xml::Node& brushTag, const scene::INodeP
 			texdef.zy() = string::to_float(texProjTag.getAttributeValue(ATTR_FACE_TEXTPROJ_TY));
 
 			// Parse Shader
-			auto shaderTag = getNamedChild(faceTag, TAG_FACE_MATERIAL);
-			std::string shader = shaderTag.getAttributeValue(ATTR_FACE_MATERIAL_NAME);
+			const auto& shaderTag = faceTag->getNamedChild(TAG_FACE_MATERIAL);
+			const auto& shader = shaderTag.getAttributeValue(ATTR_FACE_MATERIAL_NAME);
 
 			// Parse Flags (usually each brush has all faces detail or all faces structural)
-			auto detailTag = getNamedChild(faceTag, TAG_FACE_CONTENTSFLAG);
+			const auto& detailTag = faceTag->getNamedChild(TAG_FACE_CONTENTSFLAG);
 
 			IBrush::DetailFlag flag = static_cast<IBrush::DetailFlag>(
 				string::convert<std::size_t>(detailTag.getAttributeValue(ATTR_FACE_CONTENTSFLAG_VALUE), IBrush::Structural));
@@ -267,7 +362,7 @@ void PortableMapReader::readBrush(const xml::Node& brushTag, const scene::INodeP
 		}
 		catch (const BadDocumentFormatException& ex)
 		{
-			rError() << "PortableMapReader: Entity " << entity->name() << ", Brush " << 
+			rError() << "PortableMapReader: Entity " << entityNumber << ", Brush " <<
 				brushTag.getAttributeValue(ATTR_BRUSH_NUMBER) << ": " << ex.what() << std::endl;
 		}
 	}
@@ -275,14 +370,10 @@ void PortableMapReader::readBrush(const xml::Node& brushTag, const scene::INodeP
     // Cleanup redundant face planes
     brush.removeRedundantFaces();
 
-	_importFilter.addPrimitiveToEntity(node, entity);
-
-	readLayerInformation(brushTag, node);
-	readSelectionGroupInformation(brushTag, node);
-	readSelectionSetInformation(brushTag, node);
+	return node;
 }
 
-void PortableMapReader::readPatch(const xml::Node& patchTag, const scene::INodePtr& entity)
+scene::INodePtr PortableMapReader::readPatch(const Tag& patchTag)
 {
 	bool isFixedSubdiv = patchTag.getAttributeValue(ATTR_PATCH_FIXED_SUBDIV) == ATTR_VALUE_TRUE;
 
@@ -296,7 +387,7 @@ void PortableMapReader::readPatch(const xml::Node& patchTag, const scene::INodeP
 	IPatch& patch = patchNode->getPatch();
 
 	// Parse shader
-	auto shaderTag = getNamedChild(patchTag, TAG_PATCH_MATERIAL);
+	const auto& shaderTag = patchTag.getNamedChild(TAG_PATCH_MATERIAL);
 	patch.setShader(shaderTag.getAttributeValue(ATTR_PATCH_MATERIAL_NAME));
 
 	std::size_t cols = string::convert<std::size_t>(patchTag.getAttributeValue(ATTR_PATCH_WIDTH));
@@ -313,44 +404,44 @@ void PortableMapReader::readPatch(const xml::Node& patchTag, const scene::INodeP
 		patch.setFixedSubdivisions(true, Subdivisions(subdivX, subdivY));
 	}
 
-	auto cvTag = getNamedChild(patchTag, TAG_PATCH_CONTROL_VERTICES);
-	auto cvTags = cvTag.getNamedChildren(TAG_PATCH_CONTROL_VERTEX);
+	const auto& cvTag = patchTag.getNamedChild(TAG_PATCH_CONTROL_VERTICES);
 
-	for (const auto& vertexTag : cvTags)
+	for (const auto& vertexTag : cvTag.getNamedChildren(TAG_PATCH_CONTROL_VERTEX))
 	{
-		std::size_t row = string::convert<std::size_t>(vertexTag.getAttributeValue(ATTR_PATCH_CONTROL_VERTEX_ROW));
-		std::size_t col = string::convert<std::size_t>(vertexTag.getAttributeValue(ATTR_PATCH_CONTROL_VERTEX_COL));
+		std::size_t row = string::convert<std::size_t>(vertexTag->getAttributeValue(ATTR_PATCH_CONTROL_VERTEX_ROW));
+		std::size_t col = string::convert<std::size_t>(vertexTag->getAttributeValue(ATTR_PATCH_CONTROL_VERTEX_COL));
 
 		auto& ctrl = patch.ctrlAt(row, col);
 
-		ctrl.vertex[0] = string::to_float(vertexTag.getAttributeValue(ATTR_PATCH_CONTROL_VERTEX_X));
-		ctrl.vertex[1] = string::to_float(vertexTag.getAttributeValue(ATTR_PATCH_CONTROL_VERTEX_Y));
-		ctrl.vertex[2] = string::to_float(vertexTag.getAttributeValue(ATTR_PATCH_CONTROL_VERTEX_Z));
+		ctrl.vertex[0] = string::to_float(vertexTag->getAttributeValue(ATTR_PATCH_CONTROL_VERTEX_X));
+		ctrl.vertex[1] = string::to_float(vertexTag->getAttributeValue(ATTR_PATCH_CONTROL_VERTEX_Y));
+		ctrl.vertex[2] = string::to_float(vertexTag->getAttributeValue(ATTR_PATCH_CONTROL_VERTEX_Z));
 
-		ctrl.texcoord[0] = string::to_float(vertexTag.getAttributeValue(ATTR_PATCH_CONTROL_VERTEX_U));
-		ctrl.texcoord[1] = string::to_float(vertexTag.getAttributeValue(ATTR_PATCH_CONTROL_VERTEX_V));
+		ctrl.texcoord[0] = string::to_float(vertexTag->getAttributeValue(ATTR_PATCH_CONTROL_VERTEX_U));
+		ctrl.texcoord[1] = string::to_float(vertexTag->getAttributeValue(ATTR_PATCH_CONTROL_VERTEX_V));
 	}
 
 	patch.controlPointsChanged();
 
-	_importFilter.addPrimitiveToEntity(node, entity);
-
-	readLayerInformation(patchTag, node);
-	readSelectionGroupInformation(patchTag, node);
-	readSelectionSetInformation(patchTag, node);
+	return node;
 }
 
-void PortableMapReader::readEntity(const xml::Node& entityTag)
+void PortableMapReader::readEntity(const Tag& entityTag)
 {
+	util::ScopedProfilingStage stage("Entity creation");
+
+	// Take the primitives read so far, they belong to this entity
+	auto primitives = std::move(_entityPrimitives);
+	_entityPrimitives.clear();
+
 	std::map<std::string, std::string> entityKeyValues{};
 
-	auto keyValuesTag = getNamedChild(entityTag, TAG_ENTITY_KEYVALUES);
-	auto keyValueTags = keyValuesTag.getNamedChildren(TAG_ENTITY_KEYVALUE);
+	const auto& keyValuesTag = entityTag.getNamedChild(TAG_ENTITY_KEYVALUES);
 
-	for (const auto& keyValue : keyValueTags)
+	for (const auto& keyValue : keyValuesTag.getNamedChildren(TAG_ENTITY_KEYVALUE))
 	{
-		auto key = keyValue.getAttributeValue(ATTR_ENTITY_PROPERTY_KEY);
-		auto value = keyValue.getAttributeValue(ATTR_ENTITY_PROPERTY_VALUE);
+		const auto& key = keyValue->getAttributeValue(ATTR_ENTITY_PROPERTY_KEY);
+		const auto& value = keyValue->getAttributeValue(ATTR_ENTITY_PROPERTY_VALUE);
 
 		entityKeyValues[key] = value;
 	}
@@ -389,27 +480,22 @@ void PortableMapReader::readEntity(const xml::Node& entityTag)
 
 	_importFilter.addEntity(entityNode);
 
-	try
-	{
-		readPrimitives(getNamedChild(entityTag, TAG_ENTITY_PRIMITIVES), entityNode);
-	}
-	catch (const BadDocumentFormatException & ex)
+	for (const auto& primitive : primitives)
 	{
-		rError() << "PortableMapReader: Entity " << entityNode->name() << ": " << ex.what() << std::endl;
+		_importFilter.addPrimitiveToEntity(primitive, entityNode);
 	}
 }
 
-void PortableMapReader::readLayerInformation(const xml::Node& tag, const scene::INodePtr& sceneNode)
+void PortableMapReader::readLayerInformation(const Tag& tag, const scene::INodePtr& sceneNode)
 {
-	auto layersTag = getNamedChild(tag, TAG_OBJECT_LAYERS);
+	const auto& layersTag = tag.getNamedChild(TAG_OBJECT_LAYERS);
 
-	auto layerTags = layersTag.getNamedChildren(TAG_OBJECT_LAYER);
 	auto layers = scene::LayerList{};
 
 	// Read the list of node IDs
-	for (const auto& layerTag : layerTags)
+	for (const auto& layerTag : layersTag.getNamedChildren(TAG_OBJECT_LAYER))
 	{
-		layers.insert(string::convert<int>(layerTag.getAttributeValue(ATTR_OBJECT_LAYER_ID)));
+		layers.insert(string::convert<int>(layerTag->getAttributeValue(ATTR_OBJECT_LAYER_ID)));
 	}
 
 	sceneNode->assignToLayers(layers);
@@ -425,18 +511,17 @@ void PortableMapReader::readLayerInformation(const xml::Node& tag, const scene::
 	});
 }
 
-void PortableMapReader::readSelectionGroupInformation(const xml::Node& tag, const scene::INodePtr& sceneNode)
+void PortableMapReader::readSelectionGroupInformation(const Tag& tag, const scene::INodePtr& sceneNode)
 {
-    auto groupsTag = getNamedChild(tag, TAG_OBJECT_SELECTIONGROUPS);
-    auto groupTags = groupsTag.getNamedChildren(TAG_OBJECT_SELECTIONGROUP);
+    const auto& groupsTag = tag.getNamedChild(TAG_OBJECT_SELECTIONGROUPS);
 
     auto& groupManager = _importFilter.getRootNode()->getSelectionGroupManager();
 
     // Read the list of group IDs
-    for (const auto& groupTag : groupTags)
+    for (const auto& groupTag : groupsTag.getNamedChildren(TAG_OBJECT_SELECTIONGROUP))
     {
         auto groupId = string::convert<IGroupSelectable::GroupIds::value_type>(
-            groupTag.getAttributeValue(ATTR_OBJECT_SELECTIONGROUP_ID)
+            groupTag->getAttributeValue(ATTR_OBJECT_SELECTIONGROUP_ID)
         );
 
         auto group = groupManager.getSelectionGroup(groupId);
@@ -448,16 +533,15 @@ void PortableMapReader::readSelectionGroupInformation(const xml::Node& tag, cons
     }
 }
 
-void PortableMapReader::readSelectionSetInformation(const xml::Node& tag, const scene::INodePtr& sceneNode)
+void PortableMapReader::readSelectionSetInformation(const Tag& tag, const scene::INodePtr& sceneNode)
 {
-	auto setsTag = getNamedChild(tag, TAG_OBJECT_SELECTIONSETS);
-	auto setTags = setsTag.getNamedChildren(TAG_OBJECT_SELECTIONSET);
+	const auto& setsTag = tag.getNamedChild(TAG_OBJECT_SELECTIONSETS);
 
 	// Read the list of set indices
-	for (const auto& setTag : setTags)
+	for (const auto& setTag : setsTag.getNamedChildren(TAG_OBJECT_SELECTIONSET))
 	{
 		auto id = string::convert<std::size_t>(
-			setTag.getAttributeValue(ATTR_OBJECT_SELECTIONSET_ID)
+			setTag->getAttributeValue(ATTR_OBJECT_SELECTIONSET_ID)
 		);
 
 		auto setIter = _selectionSets.find(id);
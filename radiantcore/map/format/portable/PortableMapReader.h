@@ -1,19 +1,24 @@
 #pragma once
 
 #include <map>
+#include <vector>
 #include "inode.h"
 #include "imapformat.h"
 #include "iselectionset.h"
 #include "parser/DefTokeniser.h"
 
-namespace xml { class Node; }
-
 namespace map 
 {
 
 namespace format
 {
 
+/**
+ * Reader for the XML-based portable map format. The document is parsed
+ * as a stream: the tags of one primitive (or of the map header) are
+ * collected at a time and turned into scene nodes right away,
+ * the document tree as a whole is never held in memory.
+ */
 class PortableMapReader :
 	public IMapReader
 {
@@ -32,6 +37,14 @@ protected:
 	typedef std::map<std::size_t, selection::ISelectionSetPtr> SelectionSets;
 	SelectionSets _selectionSets;
 
+	// Lightweight element (name, attributes, child elements), see the .cpp file
+	struct Tag;
+
+	// The primitives of the currently parsed entity. The entity's keyvalues
+	// follow its primitives in the file, so they're added to the entity
+	// once it has been created at the end of its tag.
+	std::vector<scene::INodePtr> _entityPrimitives;
+
 public:
 	PortableMapReader(IMapImportFilter& importFilter);
 
@@ -41,18 +54,18 @@ public:
 	static bool CanLoad(std::istream& stream);
 
 private:
-	void readLayers(const xml::Node& mapNode);
-	void readSelectionGroups(const xml::Node& mapNode);
-	void readSelectionSets(const xml::Node& mapNode);
-	void readMapProperties(const xml::Node& mapNode);
-	void readEntities(const xml::Node& mapNode);
-	void readEntity(const xml::Node& entityNode);
-	void readPrimitives(const xml::Node& primitivesNode, const scene::INodePtr& entity);
-	void readBrush(const xml::Node& brushNode, const scene::INodePtr& entity);
-	void readPatch(const xml::Node& patchNode, const scene::INodePtr& entity);
-	void readLayerInformation(const xml::Node& parentTag, const scene::INodePtr& sceneNode);
-	void readSelectionGroupInformation(const xml::Node& parentTag, const scene::INodePtr& sceneNode);
-	void readSelectionSetInformation(const xml::Node& parentTag, const scene::INodePtr& sceneNode);
+	void beginMap(const Tag& mapTag);
+	void readLayers(const Tag& layersTag);
+	void readSelectionGroups(const Tag& selectionGroupsTag);
+	void readSelectionSets(const Tag& selectionSetsTag);
+	void readMapProperties(const Tag& propertiesTag);
+	void readEntity(const Tag& entityTag);
+	void readPrimitive(const Tag& primitiveTag, const std::string& entityNumber);
+	scene::INodePtr readBrush(const Tag& brushTag, const std::string& entityNumber);
+	scene::INodePtr readPatch(const Tag& patchTag);
+	void readLayerInformation(const Tag& parentTag, const scene::INodePtr& sceneNode);
+	void readSelectionGroupInformation(const Tag& parentTag, const scene::INodePtr& sceneNode);
+	void readSelectionSetInformation(const Tag& parentTag, const scene::INodePtr& sceneNode);
 };
 
 }
@@ -3,7 +3,8 @@
 #include "imapformat.h"
 #include "iselectionset.h"
 
-#include "xmlutil/Document.h"
+#include <memory>
+#include "xmlutil/StreamWriter.h"
 
 namespace map
 {
@@ -13,6 +14,8 @@ namespace format
 
 /**
  * Exporter class writing the map data into an XML-based file format.
+ * The XML is written to the stream while the scene is traversed,
+ * the document is never held in memory as a whole.
  */
 class PortableMapWriter :
 	public IMapWriter
@@ -22,10 +25,8 @@ protected:
 	std::size_t _entityCount;
 	std::size_t _primitiveCount;
 
-	xml::Document _document;
-
-	xml::Node _map;
-	xml::Node _curEntityPrimitives;
+	// Created in beginWriteMap, writing to the export stream
+	std::unique_ptr<xml::StreamWriter> _writer;
 
 	struct SelectionSetExportInfo
 	{
@@ -58,9 +59,9 @@ public:
 	virtual void endWritePatch(const IPatchNodePtr& patch, std::ostream& stream) override;
 
 private:
-	void appendLayerInformation(xml::Node& xmlNode, const scene::INodePtr& sceneNode);
-	void appendSelectionGroupInformation(xml::Node& xmlNode, const scene::INodePtr& sceneNode);
-	void appendSelectionSetInformation(xml::Node& xmlNode, const scene::INodePtr& sceneNode);
+	void appendLayerInformation(const scene::INodePtr& sceneNode);
+	void appendSelectionGroupInformation(const scene::INodePtr& sceneNode);
+	void appendSelectionSetInformation(const scene::INodePtr& sceneNode);
 };
 
 }
@@ -1,10 +1,8 @@
 #pragma once
 
 #include <string>
-#include <set>
 
-/// Set of unique postfixes, e.g. "1", "6" or "04"
-typedef std::set<std::string> PostfixSet;
+#include "PostfixSet.h"
 
 /// Name consisting of initial text and optional unique-making number-postfix 
 /// e.g. "Carl" + "6", or "Mary" + "03"
@@ -280,11 +280,11 @@ void Namespace::ensureNoConflicts(const scene::INodePtr& foreignRoot, const std:
     rDebug() << "Namespace::ensureNoConflicts(): importing set of "
         << foreignNodes.size() << " namespaced nodes" << std::endl;
 
-    // Build a union set containing all imported names and all existing names.
-    // We need to know all existing names to ensure that newly created names are
-    // unique in *both* namespaces
-    UniqueNameSet allNames = _uniqueNames;
-    allNames.merge(foreignNamespace._uniqueNames);
+    // Build a union set containing all imported names and all existing names
+    // sharing a prefix with them. New names are derived from the imported names,
+    // we need to know these existing names to ensure that they are unique in
+    // *both* namespaces
+    auto allNames = _uniqueNames.getUnionForPrefixesOf(foreignNamespace._uniqueNames);
 
     // Process each object in the to-be-imported tree of nodes, ensuring that it
     // has a unique name
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <climits>
+#include <string>
+#include <unordered_set>
+
+#include "string/convert.h"
+
+/**
+ * Set of unique postfixes, e.g. "1", "6" or "04".
+ *
+ * Remembers the lowest number which might still be unused, such that
+ * handing out postfixes in sequence ("1", "2", "3", ...) doesn't need to
+ * test all the numbers used so far each time.
+ */
+class PostfixSet
+{
+private:
+    std::unordered_set<std::string> _postfixes;
+
+    // All numbers below this one are known to be in the set
+    mutable int _lowestUnusedCandidate;
+
+public:
+    PostfixSet() :
+        _lowestUnusedCandidate(1)
+    {}
+
+    bool empty() const
+    {
+        return _postfixes.empty();
+    }
+
+    bool contains(const std::string& postfix) const
+    {
+        return _postfixes.count(postfix) > 0;
+    }
+
+    /// Returns true if the postfix was not in the set before
+    bool insert(const std::string& postfix)
+    {
+        return _postfixes.insert(postfix).second;
+    }
+
+    /// Returns true if the postfix was in the set
+    bool erase(const std::string& postfix)
+    {
+        if (_postfixes.erase(postfix) == 0)
+        {
+            return false;
+        }
+
+        // If this was a number below the candidate, it's now the lowest unused one
+        auto number = string::convert<int>(postfix, 0);
+
+        if (number > 0 && number < _lowestUnusedCandidate && string::to_string(number) == postfix)
+        {
+            _lowestUnusedCandidate = number;
+        }
+
+        return true;
+    }
+
+    /// Adds all postfixes of the other set to this one
+    void merge(const PostfixSet& other)
+    {
+        _postfixes.insert(other._postfixes.begin(), other._postfixes.end());
+    }
+
+    /// Returns the lowest positive number (in string form) not present in this set
+    std::string findFirstUnusedNumber() const
+    {
+        for (; _lowestUnusedCandidate < INT_MAX; ++_lowestUnusedCandidate)
+        {
+            auto testPostfix = string::to_string(_lowestUnusedCandidate);
+
+            if (_postfixes.count(testPostfix) == 0)
+            {
+                // Found an unused value
+                return testPostfix;
+            }
+        }
+
+        // Pathological case, could not find a value
+        return string::to_string(INT_MAX);
+    }
+};
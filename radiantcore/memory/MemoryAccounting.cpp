@@ -0,0 +1,115 @@
+#include "MemoryAccounting.h"
+
+#include <algorithm>
+#include "itextstream.h"
+
+#include "module/StaticModule.h"
+#include "string/format.h"
+
+namespace memory
+{
+
+MemoryAccounting::MemoryAccounting() :
+	_nextHandle(1)
+{}
+
+IMemoryAccounting::ReporterHandle MemoryAccounting::addReporter(const std::string& subsystem,
+	const IMemoryAccounting::Reporter& reporter)
+{
+	std::lock_guard<std::mutex> lock(_lock);
+
+	auto handle = _nextHandle++;
+	_reporters.emplace(handle, Reporter{ subsystem, reporter });
+
+	return handle;
+}
+
+void MemoryAccounting::removeReporter(ReporterHandle handle)
+{
+	std::lock_guard<std::mutex> lock(_lock);
+	_reporters.erase(handle);
+}
+
+std::vector<SubsystemUsage> MemoryAccounting::collectUsage()
+{
+	std::map<std::string, Usage> usagePerSubsystem;
+
+	{
+		// Keep the lock while calling the reporters, such that they can't be removed in the meantime
+		std::lock_guard<std::mutex> lock(_lock);
+
+		for (const auto& [handle, reporter] : _reporters)
+		{
+			usagePerSubsystem[reporter.subsystem] += reporter.function();
+		}
+	}
+
+	std::vector<SubsystemUsage> result;
+	result.reserve(usagePerSubsystem.size());
+
+	for (const auto& [subsystem, usage] : usagePerSubsystem)
+	{
+		result.push_back(SubsystemUsage{ subsystem, usage });
+	}
+
+	std::stable_sort(result.begin(), result.end(), [](const SubsystemUsage& a, const SubsystemUsage& b)
+	{
+		return a.usage.bytes > b.usage.bytes;
+	});
+
+	return result;
+}
+
+const std::string& MemoryAccounting::getName() const
+{
+	static std::string _name(MODULE_MEMORY_ACCOUNTING);
+	return _name;
+}
+
+const StringSet& MemoryAccounting::getDependencies() const
+{
+	static StringSet _dependencies{ MODULE_COMMANDSYSTEM };
+	return _dependencies;
+}
+
+void MemoryAccounting::initialiseModule(const IApplicationContext& ctx)
+{
+	GlobalCommandSystem().addCommand("ShowMemoryUsage",
+		std::bind(&MemoryAccounting::showMemoryUsageCmd, this, std::placeholders::_1));
+}
+
+void MemoryAccounting::shutdownModule()
+{
+	std::lock_guard<std::mutex> lock(_lock);
+
+	if (!_reporters.empty())
+	{
+		rWarning() << getName() << ": " << _reporters.size() << " reporters have not been removed" << std::endl;
+	}
+
+	_reporters.clear();
+}
+
+void MemoryAccounting::showMemoryUsageCmd(const cmd::ArgumentList& args)
+{
+	auto usages = collectUsage();
+
+	Usage total;
+
+	rMessage() << "-- Approximate Memory Usage --" << std::endl;
+
+	for (const auto& subsystem : usages)
+	{
+		rMessage() << fmt::format("{0:<20} {1:>12} {2:>10} items", subsystem.name,
+			string::getFormattedByteSize(subsystem.usage.bytes), subsystem.usage.numItems) << std::endl;
+
+		total += subsystem.usage;
+	}
+
+	rMessage() << fmt::format("{0:<20} {1:>12}", "Total", string::getFormattedByteSize(total.bytes)) << std::endl;
+}
+
+// Static module instance
+module::StaticModuleRegistration<MemoryAccounting> memoryAccountingModule;
+
+} // namespace memory
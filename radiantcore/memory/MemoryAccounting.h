@@ -0,0 +1,48 @@
+#pragma once
+
+#include <map>
+#include <mutex>
+#include "imemoryaccounting.h"
+#include "icommandsystem.h"
+
+namespace memory
+{
+
+/**
+ * Keeps track of the reporters registered by the subsystems. The reporters
+ * are only invoked when the usage is queried, e.g. by the ShowMemoryUsage
+ * command or through the script interface.
+ */
+class MemoryAccounting final :
+	public IMemoryAccounting
+{
+private:
+	struct Reporter
+	{
+		std::string subsystem;
+		IMemoryAccounting::Reporter function;
+	};
+
+	// Reporters might be added and removed by worker threads
+	std::mutex _lock;
+
+	std::map<ReporterHandle, Reporter> _reporters;
+	ReporterHandle _nextHandle;
+
+public:
+	MemoryAccounting();
+
+	ReporterHandle addReporter(const std::string& subsystem, const IMemoryAccounting::Reporter& reporter) override;
+	void removeReporter(ReporterHandle handle) override;
+	std::vector<SubsystemUsage> collectUsage() override;
+
+	const std::string& getName() const override;
+	const StringSet& getDependencies() const override;
+	void initialiseModule(const IApplicationContext& ctx) override;
+	void shutdownModule() override;
+
+private:
+	void showMemoryUsageCmd(const cmd::ArgumentList& args);
+};
+
+} // namespace memory
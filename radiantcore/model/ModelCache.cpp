@@ -11,6 +11,9 @@
 #include <iostream>
 #include "os/path.h"
 #include "os/file.h"
+#include "time/ProfilingSession.h"
+#include "util/MemoryUsage.h"
+#include "render/MeshVertex.h"
 
 #include "module/StaticModule.h"
 #include <functional>
@@ -21,11 +24,24 @@ namespace model
 {
 
 ModelCache::ModelCache() :
-	_enabled(true)
+	_enabled(true),
+	_memoryReporter(0)
 {}
 
 scene::INodePtr ModelCache::getModelNode(const std::string& modelPath)
 {
+	return loadModelNode(modelPath, true);
+}
+
+scene::INodePtr ModelCache::getUncachedModelNode(const std::string& modelPath)
+{
+	return loadModelNode(modelPath, false);
+}
+
+scene::INodePtr ModelCache::loadModelNode(const std::string& modelPath, bool insertIntoCache)
+{
+	util::ScopedProfilingStage stage("Model loading");
+
 	// Check if we have a reference to a modeldef
 	IModelDefPtr modelDef = GlobalEntityClassManager().findModel(modelPath);
 
@@ -51,7 +67,7 @@ scene::INodePtr ModelCache::getModelNode(const std::string& modelPath)
 	IModelImporterPtr modelLoader = GlobalModelFormatManager().getImporter(type);
 
 	// Try to construct a model node using the suitable loader
-	auto node =  modelLoader->loadModel(actualModelPath);
+	auto node = modelLoader->loadModel(actualModelPath, insertIntoCache);
 
 	if (node)
 	{
@@ -99,14 +115,18 @@ scene::INodePtr ModelCache::getModelNode(const std::string& modelPath)
 	return loadNullModel(actualModelPath);
 }
 
-IModelPtr ModelCache::getModel(const std::string& modelPath)
+IModelPtr ModelCache::getModel(const std::string& modelPath, bool insertIntoCache)
 {
 	// Try to lookup the existing model
-	auto found = _modelMap.find(modelPath);
-
-	if (_enabled && found != _modelMap.end())
 	{
-		return found->second;
+		std::lock_guard<std::mutex> lock(_modelMapLock);
+
+		auto found = _modelMap.find(modelPath);
+
+		if (_enabled && found != _modelMap.end())
+		{
+			return found->second;
+		}
 	}
 
 	// The model is not cached or the cache is disabled, load afresh
@@ -121,8 +141,14 @@ IModelPtr ModelCache::getModel(const std::string& modelPath)
 
 	if (model)
 	{
+		util::addProfilingCount("Models loaded");
+
 		// Model successfully loaded, insert a reference into the map
-		_modelMap.emplace(modelPath, model);
+		if (insertIntoCache)
+		{
+			std::lock_guard<std::mutex> lock(_modelMapLock);
+			_modelMap.emplace(modelPath, model);
+		}
 	}
 
 	return model;
@@ -157,13 +183,23 @@ void ModelCache::removeModel(const std::string& modelPath)
 	// get cleared, which might trigger a loopback to insert().
 	_enabled = false;
 
-	ModelMap::iterator found = _modelMap.find(modelPath);
+	IModelPtr removed;
 
-	if (found != _modelMap.end())
 	{
-		_modelMap.erase(found);
+		std::lock_guard<std::mutex> lock(_modelMapLock);
+
+		ModelMap::iterator found = _modelMap.find(modelPath);
+
+		if (found != _modelMap.end())
+		{
+			removed = std::move(found->second);
+			_modelMap.erase(found);
+		}
 	}
 
+	// The model is destroyed outside the lock
+	removed.reset();
+
 	// Allow usage of the modelnodemap again.
 	_enabled = true;
 }
@@ -174,7 +210,15 @@ void ModelCache::clear()
 	// get cleared, which might trigger a loopback to insert().
 	_enabled = false;
 
-	_modelMap.clear();
+	ModelMap removed;
+
+	{
+		std::lock_guard<std::mutex> lock(_modelMapLock);
+		removed.swap(_modelMap);
+	}
+
+	// The models are destroyed outside the lock
+	removed.clear();
 
 	// Allow usage of the modelnodemap again.
 	_enabled = true;
@@ -200,6 +244,7 @@ const StringSet& ModelCache::getDependencies() const
 	{
 		_dependencies.insert(MODULE_MODELFORMATMANAGER);
 		_dependencies.insert(MODULE_COMMANDSYSTEM);
+		_dependencies.insert(MODULE_MEMORY_ACCOUNTING);
 	}
 
 	return _dependencies;
@@ -213,13 +258,39 @@ void ModelCache::initialiseModule(const IApplicationContext& ctx)
 		std::bind(&ModelCache::refreshModelsCmd, this, std::placeholders::_1));
 	GlobalCommandSystem().addCommand("RefreshSelectedModels",
 		std::bind(&ModelCache::refreshSelectedModelsCmd, this, std::placeholders::_1));
+
+	_memoryReporter = GlobalMemoryAccounting().addReporter("ModelCache",
+		std::bind(&ModelCache::getMemoryUsage, this));
 }
 
 void ModelCache::shutdownModule()
 {
+	GlobalMemoryAccounting().removeReporter(_memoryReporter);
+
 	clear();
 }
 
+memory::Usage ModelCache::getMemoryUsage() const
+{
+	memory::Usage usage;
+
+	std::lock_guard<std::mutex> lock(_modelMapLock);
+
+	for (const auto& [path, model] : _modelMap)
+	{
+		usage.bytes += util::getContainerNodeSize<ModelMap::value_type>() + util::getHeapSize(path);
+
+		if (model)
+		{
+			usage.bytes += model->getVertexCount() * sizeof(MeshVertex) + model->getPolyCount() * 3 * sizeof(unsigned int);
+		}
+	}
+
+	usage.numItems = _modelMap.size();
+
+	return usage;
+}
+
 void ModelCache::refreshModels(bool blockScreenUpdates)
 {
 	map::algorithm::refreshModels(blockScreenUpdates);
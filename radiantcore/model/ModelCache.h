@@ -1,9 +1,11 @@
 #pragma once
 
 #include <map>
+#include <mutex>
 #include <string>
 #include "imodelcache.h"
 #include "icommandsystem.h"
+#include "imemoryaccounting.h"
 
 namespace model
 {
@@ -16,11 +18,16 @@ private:
 	typedef std::map<std::string, IModelPtr> ModelMap;
 	ModelMap _modelMap;
 
+	// Models can be requested from worker threads, this is guarding the map
+	mutable std::mutex _modelMapLock;
+
 	// Flag to disable the cache on demand (used during clear())
 	bool _enabled;
 
 	sigc::signal<void> _sigModelsReloaded;
 
+	IMemoryAccounting::ReporterHandle _memoryReporter;
+
 public:
 	ModelCache();
 
@@ -28,7 +35,10 @@ public:
 	scene::INodePtr getModelNode(const std::string& modelPath) override;
 
 	// greebo: For documentation, see the abstract base class.
-	IModelPtr getModel(const std::string& modelPath) override;
+	scene::INodePtr getUncachedModelNode(const std::string& modelPath) override;
+
+	// greebo: For documentation, see the abstract base class.
+	IModelPtr getModel(const std::string& modelPath, bool insertIntoCache = true) override;
 
     scene::INodePtr getModelNodeForStaticResource(const std::string& resourcePath) override;
 
@@ -49,8 +59,13 @@ public:
 	void shutdownModule() override;
 
 private:
+    // Shared implementation of getModelNode() and getUncachedModelNode()
+    scene::INodePtr loadModelNode(const std::string& modelPath, bool insertIntoCache);
     scene::INodePtr loadNullModel(const std::string& modelPath);
 
+	// The approximate memory held by the vertices and indices of the cached models
+	memory::Usage getMemoryUsage() const;
+
 	// Command targets
 	void refreshModelsCmd(const cmd::ArgumentList& args);
 	void refreshSelectedModelsCmd(const cmd::ArgumentList& args);
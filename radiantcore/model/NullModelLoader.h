@@ -34,7 +34,7 @@ public:
 		return _ext;
 	}
 
-	scene::INodePtr loadModel(const std::string& modelName) override
+	scene::INodePtr loadModel(const std::string& modelName, bool insertIntoCache = true) override
 	{
 		// Initialise the paths, this is all needed for realisation
 		std::string path = rootPath(modelName);
@@ -33,7 +33,7 @@ const std::string& ModelImporterBase::getExtension() const
     return _extension;
 }
 
-scene::INodePtr ModelImporterBase::loadModel(const std::string& modelName)
+scene::INodePtr ModelImporterBase::loadModel(const std::string& modelName, bool insertIntoCache)
 {
     // Initialise the paths, this is all needed for realisation
     std::string path = rootPath(modelName);
@@ -42,7 +42,7 @@ scene::INodePtr ModelImporterBase::loadModel(const std::string& modelName)
     // greebo: Path is empty for models in PK4 files, don't check this
 
     // Try to load the model from the given VFS path
-    IModelPtr model = GlobalModelCache().getModel(name);
+    IModelPtr model = GlobalModelCache().getModel(name, insertIntoCache);
 
     if (!model)
     {
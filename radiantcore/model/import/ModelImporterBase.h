@@ -18,7 +18,7 @@ public:
     const std::string& getExtension() const override;
 
     // Returns a new ModelNode for the given model name
-    scene::INodePtr loadModel(const std::string& modelName) override;
+    scene::INodePtr loadModel(const std::string& modelName, bool insertIntoCache = true) override;
 };
 
 }
@@ -31,7 +31,7 @@ const std::string& MD5ModelLoader::getExtension() const
 	return _ext;
 }
 
-scene::INodePtr MD5ModelLoader::loadModel(const std::string& modelName)
+scene::INodePtr MD5ModelLoader::loadModel(const std::string& modelName, bool insertIntoCache)
 {
 	// Initialise the paths, this is all needed for realisation
 	auto path = rootPath(modelName);
@@ -40,7 +40,7 @@ scene::INodePtr MD5ModelLoader::loadModel(const std::string& modelName)
 	// greebo: Path is empty for models in PK4 files, don't check for that
 
 	// Try to load the model from the given VFS path
-	model::IModelPtr model = GlobalModelCache().getModel(name);
+	model::IModelPtr model = GlobalModelCache().getModel(name, insertIntoCache);
 
 	if (!model)
 	{
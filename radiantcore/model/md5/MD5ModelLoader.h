@@ -17,7 +17,7 @@ public:
 
 	// ModelLoader implementation
 	// Returns a new ModelNode for the given model name
-	scene::INodePtr loadModel(const std::string& modelName) override;
+	scene::INodePtr loadModel(const std::string& modelName, bool insertIntoCache = true) override;
 
 	// Documentation: See imodel.h
 	model::IModelPtr loadModelFromPath(const std::string& name) override;
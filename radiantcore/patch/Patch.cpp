@@ -10,6 +10,7 @@
 #include "registry/registry.h"
 #include "math/Frustum.h"
 #include "math/Ray.h"
+#include "time/ProfilingSession.h"
 #include "texturelib.h"
 #include "brush/TextureProjection.h"
 #include "brush/Winding.h"
@@ -380,6 +381,12 @@ void Patch::undoSave()
     }
 }
 
+std::size_t Patch::getMemoryUsage() const
+{
+    return util::getHeapSize(_ctrl) + util::getHeapSize(_ctrlTransformed) +
+        util::getHeapSize(_mesh.vertices) + util::getHeapSize(_mesh.indices);
+}
+
 // Save the current patch state into a new UndoMemento instance (allocated on heap) and return it to the undo observer
 IUndoMementoPtr Patch::exportState() const
 {
@@ -486,6 +493,8 @@ void Patch::updateTesselation(bool force)
 
     _tesselationChanged = false;
 
+    util::ScopedProfilingStage stage("Patch tesselation");
+
     if (!isValid())
     {
         _mesh.clear();
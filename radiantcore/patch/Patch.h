@@ -301,6 +301,9 @@ public:
 	// Save the current patch state into a new UndoMemento instance (allocated on heap) and return it to the undo observer
 	IUndoMementoPtr exportState() const override;
 
+	// The approximate heap memory held by the control points and the tesselation of this patch
+	std::size_t getMemoryUsage() const;
+
 	// Revert the state of this patch to the one that has been saved in the UndoMemento
 	void importState(const IUndoMementoPtr& state) override;
 
@@ -4,10 +4,12 @@
 #include "ilayer.h"
 #include "imap.h"
 #include "ipreferencesystem.h"
+#include "iscenegraph.h"
 #include "itextstream.h"
 #include "i18n.h"
 
 #include "PatchNode.h"
+#include "util/PoolAllocator.h"
 
 #include "patch/algorithm/Prefab.h"
 #include "patch/algorithm/General.h"
@@ -26,7 +28,8 @@ namespace
 
 scene::INodePtr PatchModule::createPatch(PatchDefType type)
 {
-	scene::INodePtr node = std::make_shared<PatchNode>(type);
+	// Allocate patches from a pool to keep them close together in memory
+	scene::INodePtr node = util::makePooledShared<PatchNode>(type);
 
 	if (GlobalMapModule().getRoot())
 	{
@@ -56,6 +59,7 @@ const StringSet& PatchModule::getDependencies() const
 	{
 		_dependencies.insert(MODULE_PREFERENCESYSTEM);
 		_dependencies.insert(MODULE_RENDERSYSTEM);
+		_dependencies.insert(MODULE_MEMORY_ACCOUNTING);
 	}
 
 	return _dependencies;
@@ -75,13 +79,53 @@ void PatchModule::initialiseModule(const IApplicationContext& ctx)
 
 	_patchTextureChanged = Patch::signal_patchTextureChanged().connect(
 		[] { radiant::TextureChangedMessage::Send(); });
+
+	_memoryReporter = GlobalMemoryAccounting().addReporter("Patches",
+		std::bind(&PatchModule::getMemoryUsage, this));
+	_nodePoolMemoryReporter = GlobalMemoryAccounting().addReporter("Patches (node pool)",
+		std::bind(&PatchModule::getNodePoolMemoryUsage, this));
 }
 
 void PatchModule::shutdownModule()
 {
+	GlobalMemoryAccounting().removeReporter(_memoryReporter);
+	GlobalMemoryAccounting().removeReporter(_nodePoolMemoryReporter);
+
 	_patchTextureChanged.disconnect();
 }
 
+memory::Usage PatchModule::getMemoryUsage()
+{
+	memory::Usage usage;
+
+	// Patches which have been removed from the scene but are kept alive by the
+	// undo history are reported by the UndoSystem, along with their mementos
+	GlobalSceneGraph().foreachNode([&](const scene::INodePtr& node)
+	{
+		if (Node_isPatch(node))
+		{
+			usage.bytes += Node_getPatch(node)->getMemoryUsage();
+			++usage.numItems;
+		}
+
+		return true;
+	});
+
+	return usage;
+}
+
+memory::Usage PatchModule::getNodePoolMemoryUsage()
+{
+	memory::Usage usage;
+
+	// The nodes themselves are living in the pool, this includes the ones referenced
+	// by the undo history, plus the released blocks kept for re-use
+	usage.bytes = util::PoolGroup<PatchNode>::GetReservedBytes();
+	usage.numItems = util::PoolGroup<PatchNode>::GetNumAllocatedBlocks();
+
+	return usage;
+}
+
 void PatchModule::registerPatchCommands()
 {
 	// First connect the commands to the code
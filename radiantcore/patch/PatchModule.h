@@ -2,6 +2,7 @@
 
 #include <sigc++/connection.h>
 #include "ipatch.h"
+#include "imemoryaccounting.h"
 #include "PatchSettings.h"
 
 namespace patch
@@ -15,6 +16,9 @@ private:
 
 	sigc::connection _patchTextureChanged;
 
+	IMemoryAccounting::ReporterHandle _memoryReporter = 0;
+	IMemoryAccounting::ReporterHandle _nodePoolMemoryReporter = 0;
+
 public:
 	// PatchCreator implementation
 	scene::INodePtr createPatch(PatchDefType type) override;
@@ -29,6 +33,12 @@ public:
 
 private:
 	void registerPatchCommands();
+
+	// The heap memory held by the patches in the scene (control points and tesselation), the nodes are counted by the pool
+	memory::Usage getMemoryUsage();
+
+	// The memory of the pool the patch nodes are allocated from, including the unused blocks
+	memory::Usage getNodePoolMemoryUsage();
 };
 
 }
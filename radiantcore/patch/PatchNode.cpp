@@ -6,6 +6,7 @@
 #include "icounter.h"
 #include "math/Frustum.h"
 #include "math/Hash.h"
+#include "util/PoolAllocator.h"
 
 PatchNode::PatchNode(patch::PatchDefType type) :
 	scene::SelectableNode(),
@@ -114,6 +115,11 @@ Patch& PatchNode::getPatchInternal() {
 	return m_patch;
 }
 
+std::size_t PatchNode::getMemoryUsage() const
+{
+	return m_patch.getMemoryUsage();
+}
+
 IPatch& PatchNode::getPatch() {
 	return m_patch;
 }
@@ -275,7 +281,7 @@ void PatchNode::selectedChangedComponent(const ISelectable& selectable)
 // Clones this node, allocates a new Node on the heap and passes itself to the constructor of the new node
 scene::INodePtr PatchNode::clone() const
 {
-	return std::make_shared<PatchNode>(*this);
+	return util::makePooledShared<PatchNode>(*this);
 }
 
 void PatchNode::updateAllRenderables()
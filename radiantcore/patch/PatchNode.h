@@ -59,6 +59,8 @@ public:
 	std::string name() const override;
 	Type getNodeType() const override;
 
+	std::size_t getMemoryUsage() const override;
+
     // IComparableNode implementation
     std::string getFingerprint() override;
 
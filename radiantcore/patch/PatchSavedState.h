@@ -1,6 +1,7 @@
 #pragma once
 
 #include "PatchControl.h"
+#include "util/MemoryUsage.h"
 
 /* greebo: This is a structure that is allocated on the heap and contains all the state
  * information of a patch. This information is used by the UndoSystem to save the current
@@ -36,4 +37,9 @@ public:
 		m_subdivisions_y(subdivisions_y),
         _materialName(materialName)
     {}
+
+	std::size_t getMemoryUsage() const override
+	{
+		return sizeof(*this) + util::getHeapSize(m_ctrl) + util::getHeapSize(_materialName);
+	}
 };
@@ -15,6 +15,7 @@
 #include "backend/FullBrightRenderer.h"
 #include "backend/ObjectRenderer.h"
 #include "debugging/debugging.h"
+#include "time/Tracing.h"
 
 #include <functional>
 
@@ -32,6 +33,7 @@ OpenGLRenderSystem::OpenGLRenderSystem() :
     _time(0),
     _geometryStore(_syncObjectProvider, _bufferObjectProvider),
     _objectRenderer(_geometryStore),
+    _geometryStoreMemoryReporter(0),
     m_traverseRenderablesMutex(false)
 {
     bool shouldRealise = false;
@@ -170,15 +172,24 @@ IRenderResult::Ptr OpenGLRenderSystem::renderLitScene(RenderStateFlags globalFla
 
 IRenderResult::Ptr OpenGLRenderSystem::render(SceneRenderer& renderer, RenderStateFlags globalFlagsMask, const IRenderView& view)
 {
+    util::ScopedTrace trace("render", "Render scene");
+
     // Make sure all shaders are ready for rendering, submitting their data to the store
-    for (const auto& [_, shader] : _shaders)
     {
-        shader->prepareForRendering();
+        util::ScopedTrace prepareTrace("render", "Prepare shaders");
+
+        for (const auto& [_, shader] : _shaders)
+        {
+            shader->prepareForRendering();
+        }
     }
 
     auto result = renderer.render(globalFlagsMask, view, _time);
 
-    renderText();
+    {
+        util::ScopedTrace textTrace("render", "Render text");
+        renderText();
+    }
 
     return result;
 }
@@ -393,6 +404,7 @@ const StringSet& OpenGLRenderSystem::getDependencies() const
         MODULE_SHADERSYSTEM,
         MODULE_XMLREGISTRY,
         MODULE_SHARED_GL_CONTEXT,
+        MODULE_MEMORY_ACCOUNTING,
     };
 
     return _dependencies;
@@ -423,10 +435,15 @@ void OpenGLRenderSystem::initialiseModule(const IApplicationContext& ctx)
 
     GlobalCommandSystem().addCommand("ShowRenderMemoryStats",
         sigc::mem_fun(*this, &OpenGLRenderSystem::showMemoryStats));
+
+    _geometryStoreMemoryReporter = GlobalMemoryAccounting().addReporter("GeometryStore",
+        [this]() { return _geometryStore.getMemoryUsage(); });
 }
 
 void OpenGLRenderSystem::shutdownModule()
 {
+    GlobalMemoryAccounting().removeReporter(_geometryStoreMemoryReporter);
+
     _orthoRenderer.reset();
     _editorPreviewRenderer.reset();
     _lightingModeRenderer.reset();
@@ -2,6 +2,7 @@
 
 #include "irender.h"
 #include "icommandsystem.h"
+#include "imemoryaccounting.h"
 #include <sigc++/connection.h>
 #include <map>
 #include "imodule.h"
@@ -70,6 +71,8 @@ class OpenGLRenderSystem final
     GeometryStore _geometryStore;
     ObjectRenderer _objectRenderer;
 
+    IMemoryAccounting::ReporterHandle _geometryStoreMemoryReporter;
+
     // Renderer implementations, one for each view type/purpose
 
     std::unique_ptr<SceneRenderer> _orthoRenderer;
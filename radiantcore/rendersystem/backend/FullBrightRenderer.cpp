@@ -2,6 +2,7 @@
 
 #include "OpenGLShaderPass.h"
 #include "OpenGLShader.h"
+#include "time/Tracing.h"
 
 namespace render
 {
@@ -30,6 +31,8 @@ public:
 
 IRenderResult::Ptr FullBrightRenderer::render(RenderStateFlags globalstate, const IRenderView& view, std::size_t time)
 {
+    util::ScopedTrace trace("render", "Full bright render");
+
     // Make sure all the data is uploaded
     _geometryStore.syncToBufferObjects();
 
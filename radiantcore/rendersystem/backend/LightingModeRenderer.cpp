@@ -11,6 +11,7 @@
 #include "glprogram/DepthFillAlphaProgram.h"
 #include "glprogram/InteractionProgram.h"
 #include "glprogram/RegularStageProgram.h"
+#include "time/Tracing.h"
 
 namespace render
 {
@@ -62,6 +63,8 @@ void LightingModeRenderer::ensureShadowMapSetup()
 IRenderResult::Ptr LightingModeRenderer::render(RenderStateFlags globalFlagsMask, 
     const IRenderView& view, std::size_t time)
 {
+    util::ScopedTrace trace("render", "Lighting mode render");
+
     _result = std::make_shared<LightingModeRenderResult>();
 
     ensureShadowMapSetup();
@@ -185,6 +188,8 @@ void LightingModeRenderer::addToShadowLights(InteractingLight& light, const Vect
 void LightingModeRenderer::drawInteractingLights(OpenGLState& current, RenderStateFlags globalFlagsMask,
     const IRenderView& view, std::size_t renderTime)
 {
+    util::ScopedTrace trace("render", "Interaction pass");
+
     // Draw the surfaces per light and material
     auto interactionState = InteractionPass::GenerateInteractionState(_programFactory);
 
@@ -230,6 +235,8 @@ void LightingModeRenderer::drawInteractingLights(OpenGLState& current, RenderSta
 
 void LightingModeRenderer::drawShadowMaps(OpenGLState& current,std::size_t renderTime)
 {
+    util::ScopedTrace trace("render", "Shadow map pass");
+
     if (!_shadowMappingEnabled.get()) return;
 
     // Draw the shadow maps of each light
@@ -292,6 +299,8 @@ void LightingModeRenderer::drawShadowMaps(OpenGLState& current,std::size_t rende
 void LightingModeRenderer::drawDepthFillPass(OpenGLState& current, RenderStateFlags globalFlagsMask,
     const IRenderView& view, std::size_t renderTime)
 {
+    util::ScopedTrace trace("render", "Depth fill pass");
+
     // Run the depth fill pass
     auto depthFillState = DepthFillPass::GenerateDepthFillState(_programFactory);
 
@@ -329,6 +338,8 @@ void LightingModeRenderer::drawDepthFillPass(OpenGLState& current, RenderStateFl
 void LightingModeRenderer::drawNonInteractionPasses(OpenGLState& current, RenderStateFlags globalFlagsMask, 
     const IRenderView& view, std::size_t time)
 {
+    util::ScopedTrace trace("render", "Non-interaction pass");
+
     glUseProgram(0);
     glActiveTexture(GL_TEXTURE0);
     glClientActiveTexture(GL_TEXTURE0);
@@ -11,6 +11,7 @@
 #include "irender.h"
 #include "texturelib.h"
 #include "string/predicate.h"
+#include "time/ProfilingSession.h"
 
 #include <functional>
 
@@ -86,6 +87,7 @@ void OpenGLShader::destroy()
     _enabledViewTypes = 0;
     _materialChanged.disconnect();
     _material.reset();
+    _editorTexture.reset();
     clearPasses();
 }
 
@@ -312,6 +314,9 @@ bool OpenGLShader::isRealised()
 
 void OpenGLShader::realise()
 {
+    util::ScopedProfilingStage stage("Shader realisation");
+    util::addProfilingCount("Shaders realised");
+
     // Construct the shader passes based on the name
     construct();
 
@@ -623,8 +628,8 @@ void OpenGLShader::constructEditorPreviewPassFromMaterial()
     OpenGLState& previewPass = appendDefaultPass();
 
     // Render the editor texture in legacy mode
-    auto editorTex = _material->getEditorImage();
-    previewPass.texture0 = editorTex ? editorTex->getGLTexNum() : 0;
+    _editorTexture = _material->getEditorImage();
+    previewPass.texture0 = _editorTexture ? _editorTexture->getGLTexNum() : 0;
 
     previewPass.setRenderFlag(RENDER_FILL);
     previewPass.setRenderFlag(RENDER_TEXTURE_2D);
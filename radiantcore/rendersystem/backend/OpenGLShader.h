@@ -47,6 +47,10 @@ private:
 	MaterialPtr _material;
     sigc::connection _materialChanged;
 
+    // The editor image used by the preview pass, which only stores the GL texture number.
+    // Holding on to it keeps the texture alive when the material releases its reference.
+    TexturePtr _editorTexture;
+
     // Visibility flag
     bool _isVisible;
 
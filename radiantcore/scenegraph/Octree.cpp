@@ -1,6 +1,7 @@
 #include "Octree.h"
 
 #include "inode.h"
+#include "time/ProfilingSession.h"
 
 #include "OctreeNode.h"
 
@@ -28,6 +29,8 @@ Octree::~Octree()
 
 void Octree::link(const scene::INodePtr& sceneNode)
 {
+	util::ScopedProfilingStage stage("Octree linking");
+
 	// Make sure we don't do double-links
 	assert(_nodeMapping.find(sceneNode) == _nodeMapping.end());
 
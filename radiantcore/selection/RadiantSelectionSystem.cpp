@@ -12,10 +12,12 @@
 #include "selection/algorithm/General.h"
 #include "selection/algorithm/Primitives.h"
 #include "selection/algorithm/Transformation.h"
+#include "selection/clipboard/Clipboard.h"
 #include "SceneWalkers.h"
 #include "SelectionTestWalkers.h"
 #include "command/ExecutionFailure.h"
 #include "string/case_conv.h"
+#include "time/Tracing.h"
 #include "messages/UnselectSelectionRequest.h"
 #include "messages/ManipulatorModeToggleRequest.h"
 #include "messages/ComponentSelectionModeToggleRequest.h"
@@ -575,6 +577,8 @@ void RadiantSelectionSystem::deselectAll() {
 
 void RadiantSelectionSystem::selectPoint(SelectionTest& test, EModifier modifier, bool face)
 {
+    util::ScopedTrace trace("selection", "Select point");
+
     // If the user is holding the replace modifiers (default: Alt-Shift), deselect the current selection
     if (modifier == SelectionSystem::eReplace) {
         if (face) {
@@ -704,6 +708,8 @@ void RadiantSelectionSystem::performPointSelection(const SelectablesList& candid
 
 void RadiantSelectionSystem::selectArea(SelectionTest& test, SelectionSystem::EModifier modifier, bool face)
 {
+    util::ScopedTrace trace("selection", "Select area");
+
     // If we are in replace mode, deselect all the components or previous selections
     if (modifier == SelectionSystem::eReplace)
     {
@@ -1020,6 +1026,9 @@ void RadiantSelectionSystem::shutdownModule()
     setSelectedAll(false);
     setSelectedAllComponents(false);
 
+    // Release the nodes kept for pasting within this instance
+    clipboard::clearCache();
+
 	// In pathological cases this list might contain remnants. First, give each
 	// selectable node a chance to remove itself from the container by setting
 	// its own selected state to false (rather than waiting for this to happen
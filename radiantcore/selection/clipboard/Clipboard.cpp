@@ -7,7 +7,11 @@
 #include "imapformat.h"
 #include "iclipboard.h"
 #include "ishaderclipboard.h"
+#include "iselectiongroup.h"
 #include "string/trim.h"
+#include "scene/BasicRootNode.h"
+#include "scene/Clone.h"
+#include "scene/Traverse.h"
 
 #include "map/Map.h"
 #include "brush/FaceInstance.h"
@@ -24,6 +28,43 @@ namespace selection
 namespace clipboard
 {
 
+namespace
+{
+
+/**
+ * The map elements most recently copied to the clipboard by this instance,
+ * together with the text that has been sent to the system clipboard.
+ * As long as the clipboard still holds this text, pasting can clone the
+ * cached nodes instead of parsing the text again.
+ */
+struct CachedClipboardContents
+{
+    std::string text;
+
+    // Clones of the copied entities and primitives, in world space
+    scene::IMapRootNodePtr root;
+};
+
+CachedClipboardContents _cachedContents;
+
+// Clones the cached nodes and imports them like importFromStream() would do
+void pasteCachedContents()
+{
+    GlobalSelectionSystem().setSelectedAll(false);
+
+    // Clone the cache once more, it can be pasted any number of times
+    auto root = std::make_shared<scene::BasicRootNode>();
+
+    scene::SubgraphCloner cloner(root);
+    _cachedContents.root->traverseChildren(cloner);
+
+    // The clones are already in world space, no need to add origins to child primitives
+    map::algorithm::prepareNamesForImport(GlobalMap().getRoot(), root);
+    map::algorithm::importMap(root);
+}
+
+}
+
 void pasteToMap()
 {
 	if (!module::GlobalModuleRegistry().moduleExists(MODULE_CLIPBOARD))
@@ -31,7 +72,16 @@ void pasteToMap()
 		throw cmd::ExecutionNotPossible(_("No clipboard module attached, cannot perform this action."));
 	}
 
-    std::stringstream stream(GlobalClipboard().getString());
+    auto contents = GlobalClipboard().getString();
+
+    // If the clipboard still holds what we copied, the map data doesn't need to be parsed
+    if (_cachedContents.root && contents == _cachedContents.text)
+    {
+        pasteCachedContents();
+        return;
+    }
+
+    std::stringstream stream(contents);
 	map::algorithm::importFromStream(stream);
 }
 
@@ -44,8 +94,23 @@ void copySelectedMapElementsToClipboard()
     std::stringstream out;
     GlobalMap().exportSelected(out, format);
 
+    // Keep a copy of the exported nodes for pasting into this instance,
+    // traversing them the same way the exporter did
+    auto root = std::make_shared<scene::BasicRootNode>();
+
+    scene::SubgraphCloner cloner(root);
+    scene::traverseSelected(GlobalSceneGraph().root(), cloner);
+
+    _cachedContents.text = out.str();
+    _cachedContents.root = root;
+
     // Copy the resulting string to the clipboard
-    GlobalClipboard().setString(out.str());
+    GlobalClipboard().setString(_cachedContents.text);
+}
+
+void clearCache()
+{
+    _cachedContents = CachedClipboardContents();
 }
 
 void copy(const cmd::ArgumentList& args)
@@ -9,7 +9,9 @@ namespace clipboard
 {
 
 /**
- * De-selects everything and pastes the clipboard contents to the global map
+ * De-selects everything and pastes the clipboard contents to the global map.
+ * If the clipboard still holds the text of the last copy operation of this
+ * instance, the copied nodes are cloned directly instead of parsing the text.
  */
 void pasteToMap();
 
@@ -42,6 +44,12 @@ void pasteToCamera(const cmd::ArgumentList& args);
 // Returns empty in case none was found.
 std::string getMaterialNameFromClipboard();
 
+/**
+ * Releases the copy of the map elements kept for pasting them within this instance.
+ * Pasting will parse the clipboard text until the next copy operation.
+ */
+void clearCache();
+
 } // namespace
 
 } // namespace
@@ -76,33 +76,61 @@ void CShader::setPolygonOffset(float offset)
     _template->setPolygonOffset(offset);
 }
 
-TexturePtr CShader::getEditorImage()
+MapExpressionPtr CShader::getEditorImageSource()
 {
-    if (!_editorTexture)
-    {
-        auto editorTex = _template->getEditorTexture();
+    auto editorTex = _template->getEditorTexture();
 
-        if (!editorTex)
+    if (!editorTex)
+    {
+        // If there is no editor expression defined, use the an image from a layer, but no Bump or speculars
+        for (const auto& layer : _layers)
         {
-            // If there is no editor expression defined, use the an image from a layer, but no Bump or speculars
-            for (const auto& layer : _layers)
+            if (layer->getType() != IShaderLayer::BUMP && layer->getType() != IShaderLayer::SPECULAR &&
+                std::dynamic_pointer_cast<MapExpression>(layer->getMapExpression()))
             {
-                if (layer->getType() != IShaderLayer::BUMP && layer->getType() != IShaderLayer::SPECULAR &&
-                    std::dynamic_pointer_cast<MapExpression>(layer->getMapExpression()))
-                {
-                    editorTex = std::static_pointer_cast<MapExpression>(layer->getMapExpression());
-                    break;
-                }
+                return std::static_pointer_cast<MapExpression>(layer->getMapExpression());
             }
         }
+    }
+
+    return editorTex;
+}
 
+TexturePtr CShader::getEditorImage()
+{
+    if (!_editorTexture)
+    {
         // Pass the call to the GLTextureManager to realise this image
-        _editorTexture = GetTextureManager().getBinding(editorTex);
+        _editorTexture = GetTextureManager().getBinding(getEditorImageSource());
     }
 
     return _editorTexture;
 }
 
+bool CShader::getEditorImageDimensions(std::size_t& width, std::size_t& height)
+{
+    if (_editorTexture)
+    {
+        width = _editorTexture->getWidth();
+        height = _editorTexture->getHeight();
+        return true;
+    }
+
+    auto editorTex = getEditorImageSource();
+
+    return editorTex && editorTex->getImageDimensions(width, height);
+}
+
+void CShader::releaseEditorImage()
+{
+    if (!_editorTexture) return;
+
+    _editorTexture.reset();
+
+    // Let the texture manager free the texture if this was the last reference
+    GetTextureManager().checkBindings();
+}
+
 IMapExpression::Ptr CShader::getEditorImageExpression()
 {
     return _template->getEditorTexture();
@@ -68,6 +68,8 @@ public:
     IMapExpression::Ptr getEditorImageExpression() override;
     void setEditorImageExpressionFromString(const std::string& editorImagePath) override;
 	bool isEditorImageNoTex() override;
+    bool getEditorImageDimensions(std::size_t& width, std::size_t& height) override;
+    void releaseEditorImage() override;
 	TexturePtr lightFalloffImage() override;
 	std::string getName() const override;
 	bool IsInUse() const override;
@@ -163,6 +165,10 @@ private:
     void ensureTemplateCopy();
     void subscribeToTemplateChanges();
     void updateEditorImage();
+
+    // The expression the editor image is generated from, falls back to the
+    // diffuse map if there is no qer_editorimage
+    MapExpressionPtr getEditorImageSource();
 };
 typedef std::shared_ptr<CShader> CShaderPtr;
 
@@ -517,6 +517,7 @@ const StringSet& Doom3ShaderSystem::getDependencies() const
         _dependencies.insert(MODULE_XMLREGISTRY);
         _dependencies.insert(MODULE_GAMEMANAGER);
         _dependencies.insert(MODULE_FILETYPES);
+        _dependencies.insert(MODULE_MEMORY_ACCOUNTING);
     }
 
     return _dependencies;
@@ -535,6 +536,12 @@ void Doom3ShaderSystem::initialiseModule(const IApplicationContext& ctx)
 
     // Register the mtr file extension
     GlobalFiletypes().registerPattern("material", FileTypePattern(_("Material File"), "mtr", "*.mtr"));
+
+    // The library is not waited for, a pending parser thread doesn't count yet
+    _memoryReporters.push_back(GlobalMemoryAccounting().addReporter("ShaderLibrary",
+        [this]() { return _library->getMemoryUsage(); }));
+    _memoryReporters.push_back(GlobalMemoryAccounting().addReporter("GLTextureManager",
+        [this]() { return _textureManager->getMemoryUsage(); }));
 }
 
 // Horrible evil macro to avoid assertion failures if expr is NULL
@@ -702,6 +709,13 @@ void Doom3ShaderSystem::shutdownModule()
 {
     rMessage() << "Doom3ShaderSystem::shutdownModule called" << std::endl;
 
+    for (auto handle : _memoryReporters)
+    {
+        GlobalMemoryAccounting().removeReporter(handle);
+    }
+
+    _memoryReporters.clear();
+
     destroy();
     unrealise();
 }
@@ -5,6 +5,7 @@
 #include "imodule.h"
 #include "iradiant.h"
 #include "icommandsystem.h"
+#include "imemoryaccounting.h"
 
 #include <functional>
 
@@ -51,6 +52,9 @@ class Doom3ShaderSystem :
     sigc::signal<void, const std::string&, const std::string&> _sigMaterialRenamed;
     sigc::signal<void, const std::string&> _sigMaterialRemoved;
 
+    // Reporting the size of the library and the texture cache
+    std::vector<IMemoryAccounting::ReporterHandle> _memoryReporters;
+
 public:
 
 	// Constructor, allocates the library
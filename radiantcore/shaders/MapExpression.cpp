@@ -174,6 +174,11 @@ std::string HeightMapExpression::getExpressionString()
     return fmt::format("heightmap({0}, {1})", heightMapExp->getExpressionString(), scale);
 }
 
+bool HeightMapExpression::getImageDimensions(std::size_t& width, std::size_t& height) const
+{
+    return heightMapExp->getImageDimensions(width, height);
+}
+
 AddNormalsExpression::AddNormalsExpression (DefTokeniser& token) {
 	token.assertNextToken("(");
 	mapExpOne = createForToken(token);
@@ -253,6 +258,12 @@ std::string AddNormalsExpression::getExpressionString()
     return fmt::format("addnormals({0}, {1})", mapExpOne->getExpressionString(), mapExpTwo->getExpressionString());
 }
 
+bool AddNormalsExpression::getImageDimensions(std::size_t& width, std::size_t& height) const
+{
+    // The result has the size of the first operand
+    return mapExpOne->getImageDimensions(width, height);
+}
+
 SmoothNormalsExpression::SmoothNormalsExpression (DefTokeniser& token) {
 	token.assertNextToken("(");
 	mapExp = createForToken(token);
@@ -340,6 +351,11 @@ std::string SmoothNormalsExpression::getExpressionString()
     return fmt::format("smoothnormals({0})", mapExp->getExpressionString());
 }
 
+bool SmoothNormalsExpression::getImageDimensions(std::size_t& width, std::size_t& height) const
+{
+    return mapExp->getImageDimensions(width, height);
+}
+
 AddExpression::AddExpression (DefTokeniser& token) {
 	token.assertNextToken("(");
 	mapExpOne = createForToken(token);
@@ -407,6 +423,12 @@ std::string AddExpression::getExpressionString()
     return fmt::format("add({0}, {1})", mapExpOne->getExpressionString(), mapExpTwo->getExpressionString());
 }
 
+bool AddExpression::getImageDimensions(std::size_t& width, std::size_t& height) const
+{
+    // The result has the size of the first operand
+    return mapExpOne->getImageDimensions(width, height);
+}
+
 ScaleExpression::ScaleExpression(DefTokeniser& token) : 
     scaleGreen(0),
     scaleBlue(0),
@@ -497,6 +519,11 @@ std::string ScaleExpression::getExpressionString()
     return fmt::format("scale({0}, {1}{2}{3}{4})", mapExp->getExpressionString(), scaleRed, scaleGreenStr, scaleBlueStr, scaleAlphaStr);
 }
 
+bool ScaleExpression::getImageDimensions(std::size_t& width, std::size_t& height) const
+{
+    return mapExp->getImageDimensions(width, height);
+}
+
 InvertAlphaExpression::InvertAlphaExpression (DefTokeniser& token) {
 	token.assertNextToken("(");
 	mapExp = createForToken(token);
@@ -552,6 +579,11 @@ std::string InvertAlphaExpression::getExpressionString()
     return fmt::format("invertAlpha({0})", mapExp->getExpressionString());
 }
 
+bool InvertAlphaExpression::getImageDimensions(std::size_t& width, std::size_t& height) const
+{
+    return mapExp->getImageDimensions(width, height);
+}
+
 InvertColorExpression::InvertColorExpression (DefTokeniser& token) {
 	token.assertNextToken("(");
 	mapExp = createForToken(token);
@@ -605,6 +637,11 @@ std::string InvertColorExpression::getExpressionString()
     return fmt::format("invertColor({0})", mapExp->getExpressionString());
 }
 
+bool InvertColorExpression::getImageDimensions(std::size_t& width, std::size_t& height) const
+{
+    return mapExp->getImageDimensions(width, height);
+}
+
 MakeIntensityExpression::MakeIntensityExpression (DefTokeniser& token) {
 	token.assertNextToken("(");
 	mapExp = createForToken(token);
@@ -661,6 +698,11 @@ std::string MakeIntensityExpression::getExpressionString()
     return fmt::format("makeIntensity({0})", mapExp->getExpressionString());
 }
 
+bool MakeIntensityExpression::getImageDimensions(std::size_t& width, std::size_t& height) const
+{
+    return mapExp->getImageDimensions(width, height);
+}
+
 MakeAlphaExpression::MakeAlphaExpression(DefTokeniser& token)
 {
 	token.assertNextToken("(");
@@ -719,6 +761,11 @@ std::string MakeAlphaExpression::getExpressionString()
     return fmt::format("makeAlpha({0})", mapExp->getExpressionString());
 }
 
+bool MakeAlphaExpression::getImageDimensions(std::size_t& width, std::size_t& height) const
+{
+    return mapExp->getImageDimensions(width, height);
+}
+
 /* ImageExpression */
 
 ImageExpression::ImageExpression(const std::string& imgName) :
@@ -818,4 +865,15 @@ std::string ImageExpression::getExpressionString()
     return _imgName;
 }
 
+bool ImageExpression::getImageDimensions(std::size_t& width, std::size_t& height) const
+{
+    // The built-in images like _black are loaded from the bitmaps path, they are small anyway
+    if (string::starts_with(_imgName, "_"))
+    {
+        return false;
+    }
+
+    return GlobalImageLoader().getImageDimensionsFromVFS(_imgName, width, height);
+}
+
 } // namespace shaders
@@ -49,6 +49,13 @@ public:
     // Abstract method to be implemented
     virtual ImagePtr getImage() const = 0;
 
+    /**
+     * Determine the dimensions of the image this expression produces, without
+     * evaluating it. This only reads the header of the image files involved,
+     * returns false if the dimensions cannot be determined that way.
+     */
+    virtual bool getImageDimensions(std::size_t& width, std::size_t& height) const = 0;
+
 public: /* STATIC CONSTRUCTION METHODS */
 
 	/** Creates the a MapExpression out of the given token. Nested mapexpressions
@@ -83,6 +90,7 @@ public:
 	ImagePtr getImage() const override;
 	std::string getIdentifier() const override;
     std::string getExpressionString() override;
+	bool getImageDimensions(std::size_t& width, std::size_t& height) const override;
 };
 
 class AddNormalsExpression :
@@ -95,6 +103,7 @@ public:
 	ImagePtr getImage() const override;
 	std::string getIdentifier() const override;
     std::string getExpressionString() override;
+	bool getImageDimensions(std::size_t& width, std::size_t& height) const override;
 };
 
 class SmoothNormalsExpression :
@@ -106,6 +115,7 @@ public:
 	ImagePtr getImage() const override;
 	std::string getIdentifier() const override;
     std::string getExpressionString() override;
+	bool getImageDimensions(std::size_t& width, std::size_t& height) const override;
 };
 
 class AddExpression : public MapExpression {
@@ -116,6 +126,7 @@ public:
 	ImagePtr getImage() const override;
 	std::string getIdentifier() const override;
     std::string getExpressionString() override;
+	bool getImageDimensions(std::size_t& width, std::size_t& height) const override;
 };
 
 class ScaleExpression :
@@ -131,6 +142,7 @@ public:
 	ImagePtr getImage() const override;
 	std::string getIdentifier() const override;
     std::string getExpressionString() override;
+	bool getImageDimensions(std::size_t& width, std::size_t& height) const override;
 };
 
 class InvertAlphaExpression :
@@ -142,6 +154,7 @@ public:
 	ImagePtr getImage() const override;
 	std::string getIdentifier() const override;
     std::string getExpressionString() override;
+	bool getImageDimensions(std::size_t& width, std::size_t& height) const override;
 };
 
 class InvertColorExpression :
@@ -153,6 +166,7 @@ public:
 	ImagePtr getImage() const;
 	std::string getIdentifier() const;
     std::string getExpressionString() override;
+	bool getImageDimensions(std::size_t& width, std::size_t& height) const override;
 };
 
 class MakeIntensityExpression :
@@ -164,6 +178,7 @@ public:
 	ImagePtr getImage() const override;
 	std::string getIdentifier() const override;
     std::string getExpressionString() override;
+	bool getImageDimensions(std::size_t& width, std::size_t& height) const override;
 };
 
 class MakeAlphaExpression :
@@ -175,6 +190,7 @@ public:
 	ImagePtr getImage() const override;
 	std::string getIdentifier() const override;
     std::string getExpressionString() override;
+	bool getImageDimensions(std::size_t& width, std::size_t& height) const override;
 };
 
 /**
@@ -195,6 +211,7 @@ public:
 	ImagePtr getImage() const override;
 	std::string getIdentifier() const override;
     std::string getExpressionString() override;
+	bool getImageDimensions(std::size_t& width, std::size_t& height) const override;
 };
 
 } // namespace shaders
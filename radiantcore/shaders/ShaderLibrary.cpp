@@ -5,6 +5,7 @@
 #include "iimage.h"
 #include "itextstream.h"
 #include "ShaderTemplate.h"
+#include "util/MemoryUsage.h"
 
 namespace shaders 
 {
@@ -191,6 +192,30 @@ std::size_t ShaderLibrary::getNumDefinitions()
 	return _definitions.size();
 }
 
+memory::Usage ShaderLibrary::getMemoryUsage() const
+{
+	memory::Usage usage;
+
+	for (const auto& [name, definition] : _definitions)
+	{
+		usage.bytes += util::getContainerNodeSize<ShaderDefinitionMap::value_type>() + util::getHeapSize(name);
+		usage.bytes += util::getHeapSize(definition.file.topDir) + util::getHeapSize(definition.file.name);
+
+		if (definition.shaderTemplate)
+		{
+			usage.bytes += definition.shaderTemplate->getMemoryUsage();
+		}
+	}
+
+	// The shaders are sharing the templates of the definitions
+	usage.bytes += _shaders.size() * (util::getContainerNodeSize<ShaderMap::value_type>() + sizeof(CShader));
+	usage.bytes += _tables.size() * (util::getContainerNodeSize<TableDefinitions::value_type>() + sizeof(TableDefinition));
+
+	usage.numItems = _definitions.size();
+
+	return usage;
+}
+
 void ShaderLibrary::foreachShaderName(const ShaderNameCallback& callback)
 {
     for (const auto& pair : _definitions)
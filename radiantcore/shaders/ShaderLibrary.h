@@ -3,6 +3,7 @@
 #include <string>
 #include <map>
 #include <memory>
+#include "imemoryaccounting.h"
 #include "CShader.h"
 #include "TableDefinition.h"
 
@@ -63,6 +64,10 @@ public:
 	// Get the number of known shaders
 	std::size_t getNumDefinitions();
 
+	// The approximate memory held by the definitions, shaders and tables,
+	// the number of items is the number of definitions
+	memory::Usage getMemoryUsage() const;
+
 	/* greebo: Retrieves the shader with the given name.
 	 *
 	 * @returns: the according CShaderPtr, this may also
@@ -19,6 +19,7 @@
 
 #include "ShaderExpression.h"
 #include "util/ScopedBoolLock.h"
+#include "util/MemoryUsage.h"
 #include "materials/ParseLib.h"
 
 namespace shaders
@@ -1471,5 +1472,16 @@ const std::string& ShaderTemplate::getBlockContents()
     return _blockContents;
 }
 
+std::size_t ShaderTemplate::getMemoryUsage() const
+{
+    auto total = sizeof(ShaderTemplate) + util::getHeapSize(_name) + util::getHeapSize(_blockContents) +
+        util::getHeapSize(description) + util::getHeapSize(_layers);
+
+    // The layers are only present after parsing
+    total += _layers.size() * sizeof(Doom3ShaderLayer);
+
+    return total;
+}
+
 } // namespace
 
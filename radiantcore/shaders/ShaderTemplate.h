@@ -427,6 +427,9 @@ public:
 
     const std::string& getBlockContents();
 
+    // The approximate number of bytes held by this template (doesn't trigger parsing)
+    std::size_t getMemoryUsage() const;
+
     /**
      * \brief
      * Return the named bindable corresponding to the editor preview texture
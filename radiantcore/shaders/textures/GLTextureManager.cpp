@@ -8,6 +8,7 @@
 #include "../MapExpression.h"
 #include "TextureManipulator.h"
 #include "parser/DefTokeniser.h"
+#include "time/ProfilingSession.h"
 
 namespace
 {
@@ -38,6 +39,23 @@ void GLTextureManager::checkBindings()
     }
 }
 
+memory::Usage GLTextureManager::getMemoryUsage() const
+{
+    memory::Usage usage;
+
+    for (const auto& [key, texture] : _textures)
+    {
+        if (!texture) continue;
+
+        // A full mipmap chain adds another third to the base level
+        auto baseLevelSize = texture->getWidth() * texture->getHeight() * 4;
+        usage.bytes += baseLevelSize + baseLevelSize / 3;
+        ++usage.numItems;
+    }
+
+    return usage;
+}
+
 TexturePtr GLTextureManager::getBinding(const NamedBindablePtr& bindable,
                                         BindableTexture::Role role)
 {
@@ -58,9 +76,12 @@ TexturePtr GLTextureManager::getBinding(const NamedBindablePtr& bindable,
     }
 
     // Create and insert texture object, if it is valid
+    util::ScopedProfilingStage stage("Texture binding");
+
     auto texture = bindable->bindTexture(identifier, role);
     if (texture)
     {
+        util::addProfilingCount("Textures bound");
         _textures.emplace(identifier, texture);
         return texture;
     }
@@ -76,6 +97,8 @@ TexturePtr GLTextureManager::getBinding(const std::string& fullPath)
 
     if (i == _textures.end())
     {
+        util::ScopedProfilingStage stage("Texture binding");
+
         ImagePtr img = GlobalImageLoader().imageFromFile(fullPath);
 
         // see if the MapExpression returned a valid image
@@ -84,6 +107,8 @@ TexturePtr GLTextureManager::getBinding(const std::string& fullPath)
             // Constructor returned a valid image, now create the texture object
             TexturePtr texture = img->bindTexture(fullPath);
             _textures[fullPath] = texture;
+
+            util::addProfilingCount("Textures bound");
         }
         else
         {
@@ -2,6 +2,7 @@
 #define GLTEXTUREMANAGER_H_
 
 #include "ishaders.h"
+#include "imemoryaccounting.h"
 #include <map>
 #include "../MapExpression.h"
 #include "texturelib.h"
@@ -53,6 +54,11 @@ public:
 	 */
 	void checkBindings();
 
+	/* greebo: The approximate memory held by the cached textures, assuming
+	 * 32 bits per pixel plus the mipmap chain. The texture data itself
+	 * lives in the GL driver, which might keep a copy in system memory.
+	 */
+	memory::Usage getMemoryUsage() const;
 };
 
 typedef std::shared_ptr<GLTextureManager> GLTextureManagerPtr;
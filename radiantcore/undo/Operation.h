@@ -1,6 +1,7 @@
 #pragma once
 
 #include "iundo.h"
+#include "util/MemoryUsage.h"
 
 #include <list>
 #include <memory>
@@ -44,6 +45,11 @@ private:
         {
             _undoable.onOperationRestored();
         }
+
+        std::size_t getMemoryUsage() const
+        {
+            return _data ? _data->getMemoryUsage() : 0;
+        }
 	};
 
 	// The Snapshot (the list of structs containing Undoable+Data)
@@ -81,6 +87,19 @@ public:
 		_snapshot.emplace_front(undoable);
 	}
 
+	// The approximate number of bytes held by this operation, including the saved states
+	std::size_t getMemoryUsage() const
+	{
+		auto total = sizeof(Operation) + util::getHeapSize(_command);
+
+		for (const auto& state : _snapshot)
+		{
+			total += util::getContainerNodeSize<UndoableState>() + state.getMemoryUsage();
+		}
+
+		return total;
+	}
+
 	void restoreSnapshot()
 	{
         // Walk through the snapshot front-to-back, the most recently added one is at the front
@@ -65,6 +65,19 @@ public:
 		_stack.clear();
 	}
 
+	// The approximate number of bytes held by the recorded operations
+	std::size_t getMemoryUsage() const
+	{
+		std::size_t total = 0;
+
+		for (const auto& operation : _stack)
+		{
+			total += operation->getMemoryUsage();
+		}
+
+		return total;
+	}
+
 	// Allocate a new Operation to work with
 	void start(const std::string& command)
 	{
@@ -3,6 +3,7 @@
 #include "itextstream.h"
 
 #include <iostream>
+#include "time/Tracing.h"
 
 #include "Operation.h"
 #include "StackFiller.h"
@@ -64,6 +65,8 @@ void UndoSystem::cancel()
 
 void UndoSystem::finish(const std::string& command)
 {
+	util::ScopedTrace trace("undo", "Finish operation", command);
+
 	if (finishUndo(command))
     {
 		rMessage() << command << std::endl;
@@ -89,6 +92,8 @@ void UndoSystem::undo()
     auto operationName = operation->getName(); // copy this name, we need it after op destruction
 	rMessage() << "Undo: " << operationName << std::endl;
 
+	util::ScopedTrace trace("undo", "Undo", operationName);
+
 	startRedo();
 	operation->restoreSnapshot();
 	finishRedo(operationName);
@@ -114,6 +119,8 @@ void UndoSystem::redo()
     auto operationName = operation->getName(); // copy this name, we need it after op destruction
 	rMessage() << "Redo: " << operationName << std::endl;
 
+	util::ScopedTrace trace("undo", "Redo", operationName);
+
 	startUndo();
 	operation->restoreSnapshot();
 	finishUndo(operationName);
@@ -137,6 +144,16 @@ sigc::signal<void(IUndoSystem::EventType, const std::string&)>& UndoSystem::sign
     return _eventSignal;
 }
 
+memory::Usage UndoSystem::getMemoryUsage() const
+{
+	memory::Usage usage;
+
+	usage.bytes = sizeof(UndoSystem) + _undoStack.getMemoryUsage() + _redoStack.getMemoryUsage();
+	usage.numItems = _undoStack.size() + _redoStack.size();
+
+	return usage;
+}
+
 void UndoSystem::startUndo()
 {
 	_undoStack.start("unnamedCommand");
@@ -6,6 +6,7 @@
 
 #include "iundo.h"
 #include "icommandsystem.h"
+#include "imemoryaccounting.h"
 
 #include "Stack.h"
 #include "StackFiller.h"
@@ -70,6 +71,9 @@ public:
 
     sigc::signal<void(EventType, const std::string&)>& signal_undoEvent() override;
 
+	// The memory held by the undo and redo stacks, the number of items is the number of operations
+	memory::Usage getMemoryUsage() const;
+
 private:
 	void startUndo();
 	bool finishUndo(const std::string& command);
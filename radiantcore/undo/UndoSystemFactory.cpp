@@ -1,7 +1,11 @@
 #include "iundo.h"
 
+#include <algorithm>
+#include <mutex>
+#include <vector>
 #include "i18n.h"
 #include "ipreferencesystem.h"
+#include "imemoryaccounting.h"
 #include "UndoSystem.h"
 #include "module/StaticModule.h"
 
@@ -11,6 +15,14 @@ namespace undo
 class UndoSystemFactory final :
     public IUndoSystemFactory
 {
+private:
+    // The undo systems handed out so far, used for memory accounting.
+    // Map roots might be created by worker threads, hence the lock.
+    std::mutex _undoSystemsLock;
+    std::vector<std::weak_ptr<UndoSystem>> _undoSystems;
+
+    IMemoryAccounting::ReporterHandle _memoryReporter = 0;
+
 public:
     const std::string& getName() const override
     {
@@ -20,7 +32,7 @@ public:
 
     const StringSet& getDependencies() const override
     {
-        static StringSet _dependencies{ MODULE_PREFERENCESYSTEM };
+        static StringSet _dependencies{ MODULE_PREFERENCESYSTEM, MODULE_MEMORY_ACCOUNTING };
         return _dependencies;
     }
 
@@ -30,14 +42,49 @@ public:
 
         // add the preference settings
         constructPreferences();
+
+        _memoryReporter = GlobalMemoryAccounting().addReporter("UndoSystem",
+            std::bind(&UndoSystemFactory::getMemoryUsage, this));
+    }
+
+    void shutdownModule() override
+    {
+        GlobalMemoryAccounting().removeReporter(_memoryReporter);
     }
 
     IUndoSystem::Ptr createUndoSystem() override
     {
-        return std::make_shared<UndoSystem>();
+        auto undoSystem = std::make_shared<UndoSystem>();
+
+        std::lock_guard<std::mutex> lock(_undoSystemsLock);
+
+        // Forget about the undo systems of the roots that are gone
+        _undoSystems.erase(std::remove_if(_undoSystems.begin(), _undoSystems.end(),
+            [](const std::weak_ptr<UndoSystem>& candidate) { return candidate.expired(); }), _undoSystems.end());
+
+        _undoSystems.push_back(undoSystem);
+
+        return undoSystem;
     }
 
 private:
+    memory::Usage getMemoryUsage()
+    {
+        memory::Usage usage;
+
+        std::lock_guard<std::mutex> lock(_undoSystemsLock);
+
+        for (const auto& candidate : _undoSystems)
+        {
+            if (auto undoSystem = candidate.lock(); undoSystem)
+            {
+                usage += undoSystem->getMemoryUsage();
+            }
+        }
+
+        return usage;
+    }
+
     void constructPreferences()
     {
         IPreferencePage& page = GlobalPreferenceSystem().getPage(_("Settings/Undo System"));
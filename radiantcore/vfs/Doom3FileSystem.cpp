@@ -34,6 +34,7 @@
 
 #include "string/split.h"
 #include "debugging/ScopedDebugTimer.h"
+#include "time/Tracing.h"
 
 #include "DirectoryArchive.h"
 #include "DirectoryArchiveFile.h"
@@ -143,6 +144,8 @@ void Doom3FileSystem::initialise(const SearchPaths& vfsSearchPaths, const Extens
     {
         observer->onFileSystemInitialise();
     }
+
+    _sigInitialised.emit();
 }
 
 bool Doom3FileSystem::isInitialised() const
@@ -181,6 +184,11 @@ void Doom3FileSystem::removeObserver(Observer& observer)
     _observers.erase(&observer);
 }
 
+sigc::signal<void>& Doom3FileSystem::signal_Initialised()
+{
+    return _sigInitialised;
+}
+
 int Doom3FileSystem::getFileCount(const std::string& filename)
 {
     int count = 0;
@@ -227,6 +235,8 @@ FileInfo Doom3FileSystem::getFileInfo(const std::string& vfsRelativePath)
 
 ArchiveFilePtr Doom3FileSystem::openFile(const std::string& filename)
 {
+    util::ScopedTrace trace("vfs", "Open file", filename);
+
     if (filename.find("\\") != std::string::npos)
     {
         rError() << "Filename contains backslash: " << filename << std::endl;
@@ -262,6 +272,8 @@ ArchiveFilePtr Doom3FileSystem::openFileInAbsolutePath(const std::string& filena
 
 ArchiveTextFilePtr Doom3FileSystem::openTextFile(const std::string& filename)
 {
+    util::ScopedTrace trace("vfs", "Open text file", filename);
+
     for (const ArchiveDescriptor& descriptor : _archives)
     {
         ArchiveTextFilePtr file = descriptor.archive->openTextFile(filename);
@@ -32,6 +32,8 @@ private:
 	typedef std::set<Observer*> ObserverList;
 	ObserverList _observers;
 
+	sigc::signal<void> _sigInitialised;
+
 public:
 	void initialise(const SearchPaths& vfsSearchPaths, const ExtensionSet& allowedExtensions) override;
     bool isInitialised() const override;
@@ -67,6 +69,7 @@ public:
 
 	void addObserver(Observer& observer) override;
 	void removeObserver(Observer& observer) override;
+	sigc::signal<void>& signal_Initialised() override;
 
 	const SearchPaths& getVfsSearchPaths() override;
     FileInfo getFileInfo(const std::string& vfsRelativePath) override;
@@ -0,0 +1,157 @@
+#include "gtest/gtest.h"
+
+#include "../plugins/dm.gameconnection/BinaryMapDiff.h"
+
+namespace test
+{
+
+using namespace gameconn;
+
+namespace
+{
+
+std::vector<binarydiff::EntityRecord> createTestRecords()
+{
+    std::vector<binarydiff::EntityRecord> records(4);
+
+    records[0].op = binarydiff::EntityOp::Remove;
+    records[0].name = "removed_entity";
+
+    records[1].op = binarydiff::EntityOp::Add;
+    records[1].name = "light_1";
+    records[1].spawnargs = { { "classname", "light" }, { "origin", "0 0 64" }, { "_color", "" } };
+
+    records[2].op = binarydiff::EntityOp::ModifyRespawn;
+    records[2].name = "func_static_1";
+    // Long values need more than one byte to encode their length,
+    // values are stored verbatim, including quotes, newlines and null bytes
+    records[2].spawnargs = { { "model", std::string(300, 'm') }, { "note", std::string("a\"b\n\0c", 6) } };
+
+    records[3].op = binarydiff::EntityOp::Modify;
+    records[3].name = "worldspawn";
+
+    return records;
+}
+
+void expectEqualRecords(const std::vector<binarydiff::EntityRecord>& a, const std::vector<binarydiff::EntityRecord>& b)
+{
+    ASSERT_EQ(a.size(), b.size());
+
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        EXPECT_EQ(a[i].op, b[i].op) << "Record " << i;
+        EXPECT_EQ(a[i].name, b[i].name) << "Record " << i;
+        EXPECT_EQ(a[i].spawnargs, b[i].spawnargs) << "Record " << i;
+    }
+}
+
+bool decode(const std::string& data, std::vector<binarydiff::EntityRecord>& records)
+{
+    return binarydiff::decode(data.data(), data.size(), records);
+}
+
+}
+
+TEST(BinaryMapDiffTest, EncodeDecodeRoundTrip)
+{
+    auto records = createTestRecords();
+    auto data = binarydiff::encode(records);
+
+    EXPECT_EQ(data.substr(0, 4), "DRMD");
+
+    std::vector<binarydiff::EntityRecord> decoded;
+    EXPECT_TRUE(decode(data, decoded));
+    expectEqualRecords(decoded, records);
+}
+
+TEST(BinaryMapDiffTest, EncodeDecodeEmptyDiff)
+{
+    auto data = binarydiff::encode({});
+
+    std::vector<binarydiff::EntityRecord> decoded = createTestRecords();
+    EXPECT_TRUE(decode(data, decoded));
+    EXPECT_TRUE(decoded.empty()) << "Previous contents should have been cleared";
+}
+
+TEST(BinaryMapDiffTest, DecodeRejectsTruncatedData)
+{
+    auto data = binarydiff::encode(createTestRecords());
+    std::vector<binarydiff::EntityRecord> decoded;
+
+    // Every proper prefix of a valid diff is invalid
+    for (std::size_t length = 0; length < data.size(); ++length)
+    {
+        EXPECT_FALSE(decode(data.substr(0, length), decoded)) << "Prefix length " << length;
+    }
+}
+
+TEST(BinaryMapDiffTest, DecodeRejectsTrailingData)
+{
+    auto data = binarydiff::encode(createTestRecords()) + "x";
+
+    std::vector<binarydiff::EntityRecord> decoded;
+    EXPECT_FALSE(decode(data, decoded));
+}
+
+TEST(BinaryMapDiffTest, DecodeRejectsWrongHeader)
+{
+    auto data = binarydiff::encode(createTestRecords());
+    std::vector<binarydiff::EntityRecord> decoded;
+
+    auto wrongMagic = data;
+    wrongMagic[0] = 'X';
+    EXPECT_FALSE(decode(wrongMagic, decoded));
+
+    auto wrongVersion = data;
+    wrongVersion[4] = static_cast<char>(binarydiff::VERSION + 1);
+    EXPECT_FALSE(decode(wrongVersion, decoded));
+}
+
+TEST(BinaryMapDiffTest, DecodeRejectsMalformedRecords)
+{
+    std::vector<binarydiff::EntityRecord> records(1);
+    records[0].name = "entity";
+    records[0].spawnargs = { { "key", "value" } };
+
+    auto data = binarydiff::encode(records);
+    std::vector<binarydiff::EntityRecord> decoded;
+    ASSERT_TRUE(decode(data, decoded));
+
+    // The op code follows the header (magic, version, entity count)
+    auto opOffset = 4 + 1 + 1;
+
+    auto unknownOp = data;
+    unknownOp[opOffset] = static_cast<char>(static_cast<unsigned char>(binarydiff::EntityOp::Remove) + 1);
+    EXPECT_FALSE(decode(unknownOp, decoded));
+
+    // A string length pointing past the end of the data
+    auto longName = data;
+    longName[opOffset + 1] = static_cast<char>(100);
+    EXPECT_FALSE(decode(longName, decoded));
+}
+
+TEST(BinaryMapDiffTest, DecodeRejectsImplausibleCounts)
+{
+    std::vector<binarydiff::EntityRecord> decoded;
+
+    // The entity count claims a huge number of records, nothing is allocated for them
+    std::string hugeCount("DRMD", 4);
+    hugeCount += static_cast<char>(binarydiff::VERSION);
+    hugeCount += std::string(9, static_cast<char>(0xFF)) + static_cast<char>(0x01);
+    EXPECT_FALSE(decode(hugeCount, decoded));
+
+    // A varint that never terminates
+    std::string overlong("DRMD", 4);
+    overlong += static_cast<char>(binarydiff::VERSION);
+    overlong += std::string(20, static_cast<char>(0x80));
+    EXPECT_FALSE(decode(overlong, decoded));
+
+    // The spawnarg count doesn't match the remaining data
+    std::vector<binarydiff::EntityRecord> records(1);
+    records[0].name = "e";
+    auto data = binarydiff::encode(records);
+    data.back() = static_cast<char>(0x7F);
+    EXPECT_FALSE(decode(data, decoded));
+}
+
+}
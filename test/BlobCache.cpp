@@ -0,0 +1,167 @@
+#include "gtest/gtest.h"
+
+#include <istream>
+#include "../plugins/vcs/BlobCache.h"
+#include "stream/MemoryStreamBuffer.h"
+
+namespace test
+{
+
+namespace
+{
+
+// Stand-in for git::Blob, the cache only looks at the object ID and the size
+class TestBlob
+{
+private:
+    std::string _oid;
+    std::size_t _size;
+
+public:
+    using Ptr = std::shared_ptr<TestBlob>;
+
+    TestBlob(const std::string& oid, std::size_t size) :
+        _oid(oid),
+        _size(size)
+    {}
+
+    const std::string& getOid() const
+    {
+        return _oid;
+    }
+
+    std::size_t getSize() const
+    {
+        return _size;
+    }
+};
+
+using TestBlobCache = vcs::git::BlobCache<TestBlob>;
+
+}
+
+TEST(BlobCacheTest, FindInsertedBlobs)
+{
+    TestBlobCache cache(100);
+
+    auto blob = std::make_shared<TestBlob>("a", 10);
+    cache.insert(blob);
+
+    EXPECT_EQ(cache.find("a"), blob);
+    EXPECT_FALSE(cache.find("b"));
+    EXPECT_EQ(cache.getSize(), 10);
+    EXPECT_EQ(cache.getBlobCount(), 1);
+
+    // Inserting the same object ID again doesn't change anything
+    cache.insert(std::make_shared<TestBlob>("a", 10));
+
+    EXPECT_EQ(cache.find("a"), blob);
+    EXPECT_EQ(cache.getSize(), 10);
+    EXPECT_EQ(cache.getBlobCount(), 1);
+}
+
+TEST(BlobCacheTest, LeastRecentlyUsedBlobsAreEvictedFirst)
+{
+    TestBlobCache cache(30);
+
+    auto a = std::make_shared<TestBlob>("a", 10);
+    auto b = std::make_shared<TestBlob>("b", 10);
+    auto c = std::make_shared<TestBlob>("c", 10);
+
+    cache.insert(a);
+    cache.insert(b);
+    cache.insert(c);
+    EXPECT_EQ(cache.getSize(), 30);
+
+    // Looking up "a" makes "b" the least recently used one
+    EXPECT_EQ(cache.find("a"), a);
+
+    cache.insert(std::make_shared<TestBlob>("d", 10));
+
+    EXPECT_FALSE(cache.find("b"));
+    EXPECT_EQ(cache.find("a"), a);
+    EXPECT_EQ(cache.find("c"), c);
+    EXPECT_TRUE(cache.find("d"));
+    EXPECT_EQ(cache.getSize(), 30);
+    EXPECT_EQ(cache.getBlobCount(), 3);
+
+    // The evicted blob is still alive as long as it's referenced elsewhere
+    EXPECT_EQ(b->getOid(), "b");
+}
+
+TEST(BlobCacheTest, SizeLimitIsRespected)
+{
+    TestBlobCache cache(25);
+
+    cache.insert(std::make_shared<TestBlob>("a", 10));
+    cache.insert(std::make_shared<TestBlob>("b", 10));
+
+    // A large blob evicts as many blobs as needed to fit
+    cache.insert(std::make_shared<TestBlob>("c", 20));
+
+    EXPECT_FALSE(cache.find("a"));
+    EXPECT_FALSE(cache.find("b"));
+    EXPECT_TRUE(cache.find("c"));
+    EXPECT_EQ(cache.getSize(), 20);
+
+    // Blobs exceeding the limit on their own are not cached, nothing is evicted
+    cache.insert(std::make_shared<TestBlob>("d", 26));
+
+    EXPECT_FALSE(cache.find("d"));
+    EXPECT_TRUE(cache.find("c"));
+    EXPECT_EQ(cache.getSize(), 20);
+
+    // A blob filling the cache exactly is accepted
+    cache.insert(std::make_shared<TestBlob>("e", 25));
+
+    EXPECT_TRUE(cache.find("e"));
+    EXPECT_FALSE(cache.find("c"));
+    EXPECT_EQ(cache.getSize(), 25);
+    EXPECT_EQ(cache.getBlobCount(), 1);
+}
+
+TEST(BlobCacheTest, Clear)
+{
+    TestBlobCache cache(100);
+
+    cache.insert(std::make_shared<TestBlob>("a", 10));
+    cache.insert(std::make_shared<TestBlob>("b", 20));
+    cache.clear();
+
+    EXPECT_FALSE(cache.find("a"));
+    EXPECT_FALSE(cache.find("b"));
+    EXPECT_EQ(cache.getSize(), 0);
+    EXPECT_EQ(cache.getBlobCount(), 0);
+
+    // The cache is usable after clearing
+    cache.insert(std::make_shared<TestBlob>("a", 10));
+    EXPECT_TRUE(cache.find("a"));
+    EXPECT_EQ(cache.getSize(), 10);
+}
+
+TEST(MemoryStreamBufferTest, SeekAndRead)
+{
+    std::string contents = "Version 2\n{ worldspawn }";
+    stream::MemoryStreamBuffer buffer(contents.data(), contents.size());
+    std::istream stream(&buffer);
+
+    // This is how the map importer is determining the stream size
+    stream.seekg(0, std::ios::end);
+    EXPECT_EQ(static_cast<std::size_t>(stream.tellg()), contents.size());
+    stream.seekg(0, std::ios::beg);
+
+    std::string token;
+    stream >> token;
+    EXPECT_EQ(token, "Version");
+    EXPECT_EQ(stream.tellg(), 7);
+
+    stream.seekg(3, std::ios::cur);
+    stream >> token;
+    EXPECT_EQ(token, "{");
+
+    // Seeking past the end fails
+    stream.seekg(contents.size() + 1, std::ios::beg);
+    EXPECT_TRUE(stream.fail());
+}
+
+}
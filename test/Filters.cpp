@@ -0,0 +1,236 @@
+#include "RadiantTest.h"
+
+#include "ifilter.h"
+#include "ientity.h"
+#include "ieclass.h"
+#include "imap.h"
+#include "iscenegraph.h"
+#include "algorithm/Entity.h"
+#include "algorithm/Primitives.h"
+#include "scenelib.h"
+#include <fmt/format.h>
+
+namespace test
+{
+
+using FilterTest = RadiantTest;
+
+namespace
+{
+
+const char* const TEST_FILTER = "TestFilter";
+
+void activateTestFilter(const FilterRules& rules)
+{
+    EXPECT_TRUE(GlobalFilterSystem().addFilter(TEST_FILTER, rules));
+    GlobalFilterSystem().setFilterState(TEST_FILTER, true);
+}
+
+scene::INodePtr createEntity(const std::string& className)
+{
+    auto eclass = GlobalEntityClassManager().findOrInsert(className, true);
+    auto entity = GlobalEntityModule().createEntity(eclass);
+    GlobalMapModule().getRoot()->addChildNode(entity);
+    return entity;
+}
+
+}
+
+TEST_F(FilterTest, LiteralTextureRule)
+{
+    activateTestFilter({ FilterRule::Create(FilterRule::TYPE_TEXTURE, "textures/common/caulk", false) });
+
+    EXPECT_FALSE(GlobalFilterSystem().isVisible(FilterRule::TYPE_TEXTURE, "textures/common/caulk"));
+    EXPECT_TRUE(GlobalFilterSystem().isVisible(FilterRule::TYPE_TEXTURE, "textures/common/caulk2"));
+    EXPECT_TRUE(GlobalFilterSystem().isVisible(FilterRule::TYPE_TEXTURE, "textures/common/cau"));
+
+    // The rule type must be respected, even though the name is the same
+    EXPECT_TRUE(GlobalFilterSystem().isVisible(FilterRule::TYPE_ENTITYCLASS, "textures/common/caulk"));
+}
+
+TEST_F(FilterTest, PrefixTextureRule)
+{
+    activateTestFilter({ FilterRule::Create(FilterRule::TYPE_TEXTURE, "textures/common/.*", false) });
+
+    EXPECT_FALSE(GlobalFilterSystem().isVisible(FilterRule::TYPE_TEXTURE, "textures/common/caulk"));
+    EXPECT_FALSE(GlobalFilterSystem().isVisible(FilterRule::TYPE_TEXTURE, "textures/common/"));
+    EXPECT_TRUE(GlobalFilterSystem().isVisible(FilterRule::TYPE_TEXTURE, "textures/common"));
+    EXPECT_TRUE(GlobalFilterSystem().isVisible(FilterRule::TYPE_TEXTURE, "textures/darkmod/stone"));
+}
+
+TEST_F(FilterTest, RegexTextureRule)
+{
+    activateTestFilter({
+        FilterRule::Create(FilterRule::TYPE_TEXTURE, "textures(.*)decals(.*)", false),
+        FilterRule::Create(FilterRule::TYPE_TEXTURE, "textures/common/clip(_plusmovables)*$", false),
+    });
+
+    EXPECT_FALSE(GlobalFilterSystem().isVisible(FilterRule::TYPE_TEXTURE, "textures/darkmod/decals/dirt"));
+    EXPECT_FALSE(GlobalFilterSystem().isVisible(FilterRule::TYPE_TEXTURE, "textures/common/clip"));
+    EXPECT_FALSE(GlobalFilterSystem().isVisible(FilterRule::TYPE_TEXTURE, "textures/common/clip_plusmovables"));
+    EXPECT_TRUE(GlobalFilterSystem().isVisible(FilterRule::TYPE_TEXTURE, "textures/common/clip_monster"));
+    EXPECT_TRUE(GlobalFilterSystem().isVisible(FilterRule::TYPE_TEXTURE, "textures/darkmod/stone"));
+}
+
+TEST_F(FilterTest, RulesAreEvaluatedInOrder)
+{
+    activateTestFilter({
+        FilterRule::Create(FilterRule::TYPE_ENTITYCLASS, ".*", false),
+        FilterRule::Create(FilterRule::TYPE_ENTITYCLASS, "worldspawn", true),
+    });
+
+    EXPECT_TRUE(GlobalFilterSystem().isVisible(FilterRule::TYPE_ENTITYCLASS, "worldspawn"));
+    EXPECT_FALSE(GlobalFilterSystem().isVisible(FilterRule::TYPE_ENTITYCLASS, "light"));
+}
+
+TEST_F(FilterTest, ChangedRulesInvalidateCache)
+{
+    activateTestFilter({ FilterRule::Create(FilterRule::TYPE_ENTITYCLASS, "light", false) });
+
+    EXPECT_FALSE(GlobalFilterSystem().isVisible(FilterRule::TYPE_ENTITYCLASS, "light"));
+    EXPECT_TRUE(GlobalFilterSystem().isVisible(FilterRule::TYPE_ENTITYCLASS, "func_static"));
+
+    GlobalFilterSystem().setFilterRules(TEST_FILTER, { FilterRule::Create(FilterRule::TYPE_ENTITYCLASS, "func_.*", false) });
+
+    EXPECT_TRUE(GlobalFilterSystem().isVisible(FilterRule::TYPE_ENTITYCLASS, "light"));
+    EXPECT_FALSE(GlobalFilterSystem().isVisible(FilterRule::TYPE_ENTITYCLASS, "func_static"));
+
+    GlobalFilterSystem().setFilterState(TEST_FILTER, false);
+
+    EXPECT_TRUE(GlobalFilterSystem().isVisible(FilterRule::TYPE_ENTITYCLASS, "func_static"));
+}
+
+TEST_F(FilterTest, EntityKeyValueRule)
+{
+    auto hidden = createEntity("func_static");
+    Node_getEntity(hidden)->setKeyValue("team", "blue");
+
+    auto visible = createEntity("func_static");
+    Node_getEntity(visible)->setKeyValue("team", "red");
+
+    auto untagged = createEntity("func_static");
+
+    activateTestFilter({ FilterRule::CreateEntityKeyValueRule("team", "bl.*", false) });
+
+    EXPECT_FALSE(hidden->visible());
+    EXPECT_TRUE(visible->visible());
+    EXPECT_TRUE(untagged->visible());
+
+    // Change the value, the cached verdict for "red" must not be used for "blue"
+    Node_getEntity(visible)->setKeyValue("team", "blue");
+    GlobalFilterSystem().update();
+
+    EXPECT_FALSE(visible->visible());
+    EXPECT_TRUE(untagged->visible());
+}
+
+TEST_F(FilterTest, HiddenEntityHidesChildPrimitives)
+{
+    auto entity = createEntity("func_static");
+    auto brush = algorithm::createCubicBrush(entity);
+
+    Node_setSelected(brush, true);
+    EXPECT_TRUE(Node_isSelected(brush));
+
+    activateTestFilter({ FilterRule::Create(FilterRule::TYPE_ENTITYCLASS, "func_static", false) });
+
+    EXPECT_FALSE(entity->visible());
+    EXPECT_FALSE(brush->visible());
+    EXPECT_FALSE(Node_isSelected(brush));
+
+    GlobalFilterSystem().setFilterState(TEST_FILTER, false);
+
+    EXPECT_TRUE(entity->visible());
+    EXPECT_TRUE(brush->visible());
+}
+
+TEST_F(FilterTest, NodesStayingHiddenAreNotDeselected)
+{
+    auto entity = createEntity("func_static");
+    auto brush = algorithm::createCubicBrush(entity);
+
+    activateTestFilter({ FilterRule::Create(FilterRule::TYPE_ENTITYCLASS, "func_static", false) });
+    EXPECT_FALSE(brush->visible());
+
+    // Selecting a hidden node is possible through the API
+    Node_setSelected(brush, true);
+    EXPECT_TRUE(Node_isSelected(brush));
+
+    // The brush has been hidden before, the update doesn't touch it again
+    GlobalFilterSystem().update();
+
+    EXPECT_FALSE(brush->visible());
+    EXPECT_TRUE(Node_isSelected(brush));
+}
+
+TEST_F(FilterTest, TextureRuleUpdatesFaceVisibility)
+{
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+    auto brush = algorithm::createCubicBrush(worldspawn, Vector3(0, 0, 0), "textures/common/caulk");
+
+    // One face with a different material keeps the brush visible
+    auto& face = Node_getIBrush(brush)->getFace(0);
+    face.setShader("textures/numbers/1");
+
+    activateTestFilter({ FilterRule::Create(FilterRule::TYPE_TEXTURE, "textures/common/caulk", false) });
+
+    EXPECT_TRUE(brush->visible());
+    EXPECT_TRUE(face.isVisible());
+    EXPECT_FALSE(Node_getIBrush(brush)->getFace(1).isVisible());
+
+    GlobalFilterSystem().setFilterState(TEST_FILTER, false);
+
+    EXPECT_TRUE(brush->visible());
+    EXPECT_TRUE(Node_getIBrush(brush)->getFace(1).isVisible());
+}
+
+// Toggling filters several times on a larger map leaves the right nodes visible,
+// the time it takes is measured by the Filter_Toggle benchmark
+TEST_F(FilterTest, ToggleFiltersOnLargeMap)
+{
+    constexpr std::size_t NumEntities = 2000;
+    constexpr std::size_t NumToggles = 10;
+
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+
+    for (std::size_t i = 0; i < NumEntities; ++i)
+    {
+        auto entity = createEntity(i % 2 == 0 ? "light" : "func_static");
+        Node_getEntity(entity)->setKeyValue("name", fmt::format("entity_{0}", i));
+        Node_getEntity(entity)->setKeyValue("team", i % 3 == 0 ? "blue" : "red");
+    }
+
+    for (std::size_t i = 0; i < 1000; ++i)
+    {
+        algorithm::createCubicBrush(worldspawn, Vector3(i * 128.0, 0, 0), "textures/common/caulk");
+    }
+
+    activateTestFilter({
+        FilterRule::Create(FilterRule::TYPE_ENTITYCLASS, "light.*", false),
+        FilterRule::Create(FilterRule::TYPE_ENTITYCLASS, "(func|info)_static", false),
+        FilterRule::CreateEntityKeyValueRule("team", "blue", false),
+        FilterRule::Create(FilterRule::TYPE_TEXTURE, "textures/common/.*", false),
+    });
+
+    for (std::size_t i = 0; i < NumToggles; ++i)
+    {
+        GlobalFilterSystem().setFilterState(TEST_FILTER, i % 2 != 0);
+    }
+
+    // Last toggle activated the filter
+    std::size_t visibleEntities = 0;
+
+    GlobalMapModule().getRoot()->foreachNode([&](const scene::INodePtr& node)
+    {
+        if (Node_isEntity(node) && node->visible())
+        {
+            ++visibleEntities;
+        }
+        return true;
+    });
+
+    // Only worldspawn survives
+    EXPECT_EQ(visibleEntities, 1);
+}
+
+}
@@ -239,4 +239,65 @@ TEST_F(ImageLoadingTest, LoadDDSCompressedBC5MipMaps)
     EXPECT_EQ(img->getGLFormat(), GL_COMPRESSED_RG_RGTC2);
 }
 
+TEST_F(ImageLoadingTest, GetImageDimensionsFromVFS)
+{
+    std::size_t width = 0;
+    std::size_t height = 0;
+
+    EXPECT_TRUE(GlobalImageLoader().getImageDimensionsFromVFS("textures/a_1024x512", width, height));
+    EXPECT_EQ(width, 1024);
+    EXPECT_EQ(height, 512);
+
+    // The extension is ignored, like in imageFromVFS
+    width = height = 0;
+    EXPECT_TRUE(GlobalImageLoader().getImageDimensionsFromVFS("textures/numbers/1.tga", width, height));
+    EXPECT_EQ(width, 32);
+    EXPECT_EQ(height, 32);
+
+    // Second call is served from the cache
+    width = height = 0;
+    EXPECT_TRUE(GlobalImageLoader().getImageDimensionsFromVFS("textures/numbers/1", width, height));
+    EXPECT_EQ(width, 32);
+    EXPECT_EQ(height, 32);
+}
+
+TEST_F(ImageLoadingTest, GetJpegDimensionsWithFillBytes)
+{
+    std::size_t width = 0;
+    std::size_t height = 0;
+
+    // Only the header of this file is valid, the frame marker is preceded by a single 0xFF fill byte
+    EXPECT_TRUE(GlobalImageLoader().getImageDimensionsFromVFS("textures/jpgs/fill_bytes", width, height));
+    EXPECT_EQ(width, 48);
+    EXPECT_EQ(height, 24);
+}
+
+TEST_F(ImageLoadingTest, GetImageDimensionsOfMissingImage)
+{
+    std::size_t width = 7;
+    std::size_t height = 7;
+
+    EXPECT_FALSE(GlobalImageLoader().getImageDimensionsFromVFS("textures/doesnotexist", width, height));
+
+    // Values should be untouched
+    EXPECT_EQ(width, 7);
+    EXPECT_EQ(height, 7);
+}
+
+TEST_F(ImageLoadingTest, ImageDimensionsMatchLoadedImage)
+{
+    for (auto path : { "textures/a_1024x512", "textures/numbers/10" })
+    {
+        std::size_t width = 0;
+        std::size_t height = 0;
+        EXPECT_TRUE(GlobalImageLoader().getImageDimensionsFromVFS(path, width, height));
+
+        auto img = GlobalImageLoader().imageFromVFS(path);
+        ASSERT_TRUE(img);
+
+        EXPECT_EQ(img->getWidth(), width) << "Width mismatch in " << path;
+        EXPECT_EQ(img->getHeight(), height) << "Height mismatch in " << path;
+    }
+}
+
 }
\ No newline at end of file
@@ -0,0 +1,170 @@
+#include "RadiantTest.h"
+
+#include <sstream>
+#include "imap.h"
+#include "imapformat.h"
+#include "imapmerge.h"
+#include "iselection.h"
+#include "icommandsystem.h"
+#include "ientity.h"
+#include "scenelib.h"
+#include "algorithm/MapGenerator.h"
+#include "algorithm/Scene.h"
+
+namespace test
+{
+
+using LargeMapTest = RadiantTest;
+
+namespace
+{
+
+// Big enough to not fit into a single octree node, small enough to keep the tests fast
+constexpr std::size_t NumPrimitives = 5000;
+
+std::string exportWholeMap(const std::string& formatName)
+{
+    auto format = GlobalMapFormatManager().getMapFormatByName(formatName);
+
+    GlobalSelectionSystem().setSelectedAll(true);
+
+    std::ostringstream output;
+    GlobalMapModule().exportSelected(output, format);
+
+    GlobalSelectionSystem().setSelectedAll(false);
+
+    return output.str();
+}
+
+std::size_t countEntitiesWithClassName(const std::string& className)
+{
+    return algorithm::getChildCount(GlobalMapModule().getRoot(), [&](const scene::INodePtr& node)
+    {
+        return Node_isEntity(node) && Node_getEntity(node)->getKeyValue("classname") == className;
+    });
+}
+
+std::size_t countPrimitives()
+{
+    std::size_t count = 0;
+
+    GlobalMapModule().getRoot()->foreachNode([&](const scene::INodePtr& entity)
+    {
+        count += algorithm::getChildCount(entity, [](const scene::INodePtr& node)
+        {
+            return Node_isPrimitive(node);
+        });
+
+        return true;
+    });
+
+    return count;
+}
+
+void expectMapMatchesSettings(const algorithm::MapGeneratorSettings& settings)
+{
+    EXPECT_EQ(countPrimitives(), settings.getNumPrimitives());
+
+    auto worldspawn = algorithm::findWorldspawn(GlobalMapModule().getRoot());
+    EXPECT_EQ(algorithm::getChildCount(worldspawn, Node_isBrush), settings.numWorldspawnBrushes);
+    EXPECT_EQ(algorithm::getChildCount(worldspawn, Node_isPatch), settings.numTerrainPatches);
+
+    EXPECT_EQ(countEntitiesWithClassName("func_static"), settings.numFuncStatics + settings.numModels);
+    EXPECT_EQ(countEntitiesWithClassName("light"), settings.numLights);
+
+    // The second func_static of each chain is bound to the first one
+    auto boundStatic = algorithm::getEntityByName(GlobalMapModule().getRoot(), "generated_static_1");
+    ASSERT_TRUE(boundStatic);
+    EXPECT_EQ(Node_getEntity(boundStatic)->getKeyValue("bind"), "generated_static_0");
+    EXPECT_EQ(algorithm::getChildCount(boundStatic), settings.primitivesPerFuncStatic);
+}
+
+}
+
+TEST_F(LargeMapTest, GeneratedMapMatchesSettings)
+{
+    auto settings = algorithm::MapGeneratorSettings::ForPrimitiveCount(NumPrimitives);
+    EXPECT_EQ(settings.getNumPrimitives(), NumPrimitives);
+
+    algorithm::MapGenerator::GenerateMap(settings);
+
+    expectMapMatchesSettings(settings);
+}
+
+TEST_F(LargeMapTest, GeneratedMapIsDeterministic)
+{
+    auto settings = algorithm::MapGeneratorSettings::ForPrimitiveCount(NumPrimitives);
+
+    algorithm::MapGenerator::GenerateMap(settings);
+    auto firstMap = exportWholeMap(map::PORTABLE_MAP_FORMAT_NAME);
+
+    algorithm::MapGenerator::GenerateMap(settings);
+    auto secondMap = exportWholeMap(map::PORTABLE_MAP_FORMAT_NAME);
+
+    EXPECT_EQ(firstMap, secondMap) << "Same settings should produce the same map";
+
+    settings.seed = 2;
+    algorithm::MapGenerator::GenerateMap(settings);
+    auto otherMap = exportWholeMap(map::PORTABLE_MAP_FORMAT_NAME);
+
+    EXPECT_NE(firstMap, otherMap) << "A different seed should produce a different map";
+}
+
+TEST_F(LargeMapTest, LoadGeneratedMapInBothFormats)
+{
+    auto settings = algorithm::MapGeneratorSettings::ForPrimitiveCount(NumPrimitives);
+
+    for (auto extension : { "map", "mapx" })
+    {
+        auto path = _context.getTemporaryDataPath() + "generated." + extension;
+
+        algorithm::MapGenerator::GenerateMap(settings);
+        algorithm::MapGenerator::WriteMap(path);
+
+        GlobalMapModule().createNewMap();
+        EXPECT_EQ(countPrimitives(), 0);
+
+        GlobalCommandSystem().executeCommand("OpenMap", cmd::Argument(path));
+
+        expectMapMatchesSettings(settings);
+    }
+}
+
+// Two maps generated from the same seed only differ in the additional lights
+TEST_F(LargeMapTest, MergeGeneratedMapWithAdditionalLights)
+{
+    auto settings = algorithm::MapGeneratorSettings::ForPrimitiveCount(NumPrimitives);
+    auto path = _context.getTemporaryDataPath() + "generated.mapx";
+    auto changedPath = _context.getTemporaryDataPath() + "generated_changed.mapx";
+
+    algorithm::MapGenerator::GenerateMap(settings);
+    algorithm::MapGenerator::WriteMap(path);
+
+    auto changedSettings = settings;
+    changedSettings.numLights += 10;
+    algorithm::MapGenerator::GenerateMap(changedSettings);
+    algorithm::MapGenerator::WriteMap(changedPath);
+
+    GlobalCommandSystem().executeCommand("OpenMap", cmd::Argument(path));
+    GlobalMapModule().startMergeOperation(changedPath);
+
+    auto operation = GlobalMapModule().getActiveMergeOperation();
+    ASSERT_TRUE(operation);
+
+    std::size_t numActions = 0;
+
+    operation->foreachAction([&](const scene::merge::IMergeAction::Ptr& action)
+    {
+        EXPECT_EQ(action->getType(), scene::merge::ActionType::AddEntity);
+        ++numActions;
+    });
+
+    EXPECT_EQ(numActions, 10);
+
+    GlobalMapModule().finishMergeOperation();
+
+    EXPECT_EQ(countEntitiesWithClassName("light"), changedSettings.numLights);
+    EXPECT_EQ(countPrimitives(), settings.getNumPrimitives());
+}
+
+}
@@ -3,6 +3,8 @@
 #include "imap.h"
 #include "ilayer.h"
 #include "algorithm/Scene.h"
+#include "algorithm/Primitives.h"
+#include "algorithm/Entity.h"
 #include "scenelib.h"
 
 namespace test
@@ -110,4 +112,217 @@ TEST_F(LayerTest, RemovingFromLayerMarksMapAsModified)
     performMoveOrAddToLayerTest(LayerAction::RemoveFromLayer);
 }
 
+// A parent node stays visible as long as one of its children is on a visible layer
+TEST_F(LayerTest, ParentOfVisibleChildStaysVisible)
+{
+    auto& layerManager = GlobalMapModule().getRoot()->getLayerManager();
+    auto hiddenLayer = layerManager.createLayer("Hidden");
+
+    auto entity = algorithm::createEntityByClassName("func_static");
+    scene::addNodeToContainer(entity, GlobalMapModule().getRoot());
+
+    auto hiddenBrush = algorithm::createCubicBrush(entity, Vector3(0, 0, 0));
+    auto visibleBrush = algorithm::createCubicBrush(entity, Vector3(128, 0, 0));
+
+    entity->moveToLayer(hiddenLayer);
+    hiddenBrush->moveToLayer(hiddenLayer);
+
+    Node_setSelected(hiddenBrush, true);
+    layerManager.setLayerVisibility(hiddenLayer, false);
+
+    EXPECT_FALSE(hiddenBrush->visible());
+    EXPECT_FALSE(Node_isSelected(hiddenBrush));
+    EXPECT_TRUE(visibleBrush->visible());
+    EXPECT_TRUE(entity->visible());
+
+    // Move the remaining brush to the hidden layer, the entity is hidden now
+    visibleBrush->moveToLayer(hiddenLayer);
+    layerManager.setLayerVisibility(hiddenLayer, true);
+    layerManager.setLayerVisibility(hiddenLayer, false);
+
+    EXPECT_FALSE(visibleBrush->visible());
+    EXPECT_FALSE(entity->visible());
+
+    layerManager.setLayerVisibility(hiddenLayer, true);
+
+    EXPECT_TRUE(hiddenBrush->visible());
+    EXPECT_TRUE(visibleBrush->visible());
+    EXPECT_TRUE(entity->visible());
+}
+
+// Large enough to have the layer visibility evaluated on several threads
+TEST_F(LayerTest, LayerVisibilityOnLargeScene)
+{
+    auto& layerManager = GlobalMapModule().getRoot()->getLayerManager();
+    auto hiddenLayer = layerManager.createLayer("Hidden");
+
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+    std::vector<scene::INodePtr> brushes;
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        auto brush = algorithm::createCubicBrush(worldspawn, Vector3(i * 128.0, 0, 0));
+
+        if (i % 2 == 0)
+        {
+            brush->moveToLayer(hiddenLayer);
+        }
+
+        brushes.push_back(brush);
+    }
+
+    layerManager.setLayerVisibility(hiddenLayer, false);
+
+    for (std::size_t i = 0; i < brushes.size(); ++i)
+    {
+        EXPECT_EQ(brushes[i]->visible(), i % 2 != 0) << "Brush " << i << " has the wrong visibility";
+    }
+
+    EXPECT_TRUE(worldspawn->visible());
+
+    layerManager.setLayerVisibility(hiddenLayer, true);
+
+    for (const auto& brush : brushes)
+    {
+        EXPECT_TRUE(brush->visible());
+    }
+}
+
+TEST(LayerListTest, MembershipAndIterationOrder)
+{
+    scene::LayerList list{ 70, 3, 0, -2, 63, 64 };
+
+    EXPECT_EQ(list.size(), 6);
+    EXPECT_TRUE(list.contains(0));
+    EXPECT_TRUE(list.contains(63));
+    EXPECT_TRUE(list.contains(64));
+    EXPECT_TRUE(list.contains(-2));
+    EXPECT_FALSE(list.contains(1));
+    EXPECT_FALSE(list.contains(65));
+
+    // Iteration is in ascending order, like std::set
+    std::vector<int> ids(list.begin(), list.end());
+    EXPECT_EQ(ids, std::vector<int>({ -2, 0, 3, 63, 64, 70 }));
+
+    EXPECT_EQ(list.erase(70), 1);
+    EXPECT_EQ(list.erase(70), 0);
+    EXPECT_EQ(list.erase(3), 1);
+    EXPECT_EQ(list, scene::LayerList({ 0, -2, 63, 64 }));
+
+    EXPECT_TRUE(list.intersects(scene::LayerList{ 64 }));
+    EXPECT_TRUE(list.intersects(scene::LayerList{ 1, 63 }));
+    EXPECT_FALSE(list.intersects(scene::LayerList{ 1, 2, 100 }));
+    EXPECT_FALSE(list.intersects(scene::LayerList()));
+
+    list.clear();
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(list.begin(), list.end());
+}
+
+namespace
+{
+
+// Counts the layer members by walking the scene
+std::size_t countLayerMembers(int layerId)
+{
+    std::size_t count = 0;
+
+    GlobalSceneGraph().root()->foreachNode([&](const scene::INodePtr& node)
+    {
+        if ((Node_isEntity(node) || Node_isPrimitive(node)) && node->getLayers().contains(layerId))
+        {
+            ++count;
+        }
+        return true;
+    });
+
+    return count;
+}
+
+}
+
+TEST_F(LayerTest, LayerMemberCountsAreUpdated)
+{
+    loadMap("general_purpose.mapx");
+
+    auto& layerManager = GlobalMapModule().getRoot()->getLayerManager();
+    auto secondLayer = layerManager.getLayerID("Second Layer");
+    auto newLayer = layerManager.createLayer("New Layer");
+
+    auto checkCounts = [&]()
+    {
+        for (auto layerId : { 0, secondLayer, newLayer })
+        {
+            EXPECT_EQ(layerManager.getLayerMemberCount(layerId), countLayerMembers(layerId)) << "Layer " << layerId;
+        }
+    };
+
+    // Counts of the loaded map
+    checkCounts();
+    EXPECT_EQ(layerManager.getLayerMemberCount(newLayer), 0);
+
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+    auto brush = algorithm::createCubicBrush(worldspawn);
+
+    checkCounts();
+
+    brush->addToLayer(newLayer);
+    checkCounts();
+    EXPECT_EQ(layerManager.getLayerMemberCount(newLayer), 1);
+
+    brush->moveToLayer(secondLayer);
+    checkCounts();
+    EXPECT_EQ(layerManager.getLayerMemberCount(newLayer), 0);
+
+    brush->assignToLayers(scene::LayerList{ 0, newLayer });
+    checkCounts();
+
+    brush->removeFromLayer(newLayer);
+    checkCounts();
+
+    scene::removeNodeFromParent(brush);
+    checkCounts();
+
+    // Deleting a layer moves the members back to the default layer
+    brush = algorithm::createCubicBrush(worldspawn);
+    brush->moveToLayer(newLayer);
+    layerManager.deleteLayer("New Layer");
+    checkCounts();
+    EXPECT_EQ(layerManager.getLayerMemberCount(newLayer), 0);
+}
+
+TEST_F(LayerTest, LayerMemberCountsWithLargeIdsAndReset)
+{
+    loadMap("general_purpose.mapx");
+
+    auto& layerManager = GlobalMapModule().getRoot()->getLayerManager();
+    auto secondLayer = layerManager.getLayerID("Second Layer");
+    EXPECT_GT(layerManager.getLayerMemberCount(secondLayer), 0);
+
+    // Layer IDs are not required to be contiguous
+    auto largeId = 1000000;
+    EXPECT_EQ(layerManager.createLayer("Large ID", largeId), largeId);
+
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+    auto brush = algorithm::createCubicBrush(worldspawn);
+
+    brush->addToLayer(largeId);
+    EXPECT_EQ(layerManager.getLayerMemberCount(largeId), 1);
+
+    brush->removeFromLayer(largeId);
+    EXPECT_EQ(layerManager.getLayerMemberCount(largeId), 0);
+
+    brush->addToLayer(largeId);
+
+    // The counts are gone along with the layers
+    layerManager.reset();
+
+    EXPECT_EQ(layerManager.getLayerMemberCount(secondLayer), 0);
+    EXPECT_EQ(layerManager.getLayerMemberCount(largeId), 0);
+
+    // Removing a node counted before the reset doesn't break the counts
+    scene::removeNodeFromParent(brush);
+    EXPECT_EQ(layerManager.getLayerMemberCount(0), 0);
+}
+
 }
@@ -3,17 +3,26 @@
 #include "imap.h"
 #include "imapformat.h"
 #include "ibrush.h"
+#include "ipatch.h"
+#include "ientity.h"
+#include "ieclass.h"
+#include "ilayer.h"
+#include "iselectiongroup.h"
+#include "iselectionset.h"
 #include "math/Plane3.h"
 #include "math/Matrix3.h"
 #include "iselection.h"
 #include "scenelib.h"
+#include "scene/BasicRootNode.h"
 #include "os/path.h"
 #include "string/predicate.h"
 #include "xmlutil/Document.h"
 #include "messages/MapFileOperation.h"
+#include "algorithm/Scene.h"
 #include "algorithm/XmlUtils.h"
 #include "algorithm/Primitives.h"
 #include "testutil/FileSelectionHelper.h"
+#include <fmt/format.h>
 
 namespace test
 {
@@ -339,4 +348,188 @@ TEST_F(MapExportTest, ExportPrefabWithEmptyFileExtension)
     runExportWithEmptyFileExtension(_context.getTemporaryDataPath(), "SaveSelectedAsPrefab");
 }
 
+namespace
+{
+
+// Collects the parsed nodes below a root node which is not part of the scene
+class TestImportFilter :
+    public map::IMapImportFilter
+{
+private:
+    scene::IMapRootNodePtr _root;
+
+public:
+    TestImportFilter() :
+        _root(std::make_shared<scene::BasicRootNode>())
+    {}
+
+    const scene::IMapRootNodePtr& getRootNode() const override
+    {
+        return _root;
+    }
+
+    bool addEntity(const scene::INodePtr& entityNode) override
+    {
+        _root->addChildNode(entityNode);
+        return true;
+    }
+
+    bool addPrimitiveToEntity(const scene::INodePtr& primitive, const scene::INodePtr& entity) override
+    {
+        entity->addChildNode(primitive);
+        return true;
+    }
+};
+
+scene::INodePtr createEntity(const std::string& className)
+{
+    auto eclass = GlobalEntityClassManager().findOrInsert(className, true);
+    auto entity = GlobalEntityModule().createEntity(eclass);
+    GlobalMapModule().getRoot()->addChildNode(entity);
+    return entity;
+}
+
+// Populates the map with brushes, patches and entities using layers, selection groups and sets
+void createTestMap(std::size_t numWorldspawnBrushes, std::size_t numEntities)
+{
+    auto root = GlobalMapModule().getRoot();
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+
+    auto layerId = root->getLayerManager().createLayer("Layer & <Details>");
+    auto group = root->getSelectionGroupManager().createSelectionGroup();
+    group->setName("Group \"1\"");
+    auto set = root->getSelectionSetManager().createSelectionSet("Set 1");
+
+    for (std::size_t i = 0; i < numWorldspawnBrushes; ++i)
+    {
+        auto brush = algorithm::createCubicBrush(worldspawn, Vector3(i * 64.0, i % 7 * 64.0, 0), "textures/common/caulk");
+
+        if (i % 3 == 0) brush->moveToLayer(layerId);
+        if (i % 5 == 0) group->addNode(brush);
+        if (i % 11 == 0) set->addNode(brush);
+    }
+
+    for (std::size_t i = 0; i < numEntities; ++i)
+    {
+        auto entity = createEntity(i % 2 == 0 ? "func_static" : "light");
+        Node_getEntity(entity)->setKeyValue("name", fmt::format("entity_{0}", i));
+
+        if (Node_getEntity(entity)->isContainer())
+        {
+            algorithm::createCubicBrush(entity, Vector3(i * 64.0, 512, 0), "textures/darkmod/numbers/1");
+            algorithm::createPatchFromBounds(entity, AABB(Vector3(i * 64.0, 1024, 0), Vector3(32, 32, 32)), "textures/darkmod/numbers/2");
+        }
+
+        if (i % 4 == 0) group->addNode(entity);
+    }
+}
+
+std::string exportWholeMap(const std::string& formatName)
+{
+    auto format = GlobalMapFormatManager().getMapFormatByName(formatName);
+
+    GlobalSelectionSystem().setSelectedAll(true);
+
+    std::ostringstream output;
+    GlobalMapModule().exportSelected(output, format);
+
+    GlobalSelectionSystem().setSelectedAll(false);
+
+    return output.str();
+}
+
+scene::IMapRootNodePtr importMap(const std::string& formatName, const std::string& text)
+{
+    auto format = GlobalMapFormatManager().getMapFormatByName(formatName);
+
+    TestImportFilter filter;
+    std::istringstream input(text);
+    format->getMapReader(filter)->readFromStream(input);
+
+    return filter.getRootNode();
+}
+
+std::size_t countNodes(const scene::INodePtr& root, const std::function<bool(const scene::INodePtr&)>& predicate)
+{
+    std::size_t count = 0;
+
+    root->foreachNode([&](const scene::INodePtr& node)
+    {
+        if (predicate(node)) ++count;
+        return true;
+    });
+
+    return count;
+}
+
+}
+
+// The portable format is written as a stream, check that the output is formatted
+// exactly like libxml2 saves the same document
+TEST_F(MapExportTest, PortableFormatOutputMatchesDocumentOutput)
+{
+    createTestMap(50, 10);
+
+    auto text = exportWholeMap(map::PORTABLE_MAP_FORMAT_NAME);
+    algorithm::assertStringIsMapxFile(text);
+
+    std::stringstream stream(text);
+    xml::Document doc(stream);
+
+    EXPECT_EQ(doc.saveToString(), text) << "Re-saving the parsed document should yield the same text";
+    EXPECT_EQ(doc.findXPath("//entity").size(), 11) << "Worldspawn and 10 entities should have been exported";
+    EXPECT_EQ(doc.findXPath("//brush").size(), 55);
+    EXPECT_EQ(doc.findXPath("//patch").size(), 5);
+}
+
+TEST_F(MapExportTest, PortableFormatRoundTrip)
+{
+    createTestMap(50, 10);
+
+    // Characters that need to be escaped in XML attributes
+    auto entityToExport = algorithm::getEntityByName(GlobalMapModule().getRoot(), "entity_4");
+    Node_getEntity(entityToExport)->setKeyValue("note", "<tag attr=\"value\"> & 'quotes'\n\ttab");
+
+    auto root = importMap(map::PORTABLE_MAP_FORMAT_NAME, exportWholeMap(map::PORTABLE_MAP_FORMAT_NAME));
+
+    EXPECT_EQ(countNodes(root, Node_isEntity), 11);
+    EXPECT_EQ(countNodes(root, Node_isBrush), 55);
+    EXPECT_EQ(countNodes(root, Node_isPatch), 5);
+
+    auto entity = algorithm::getEntityByName(root, "entity_4");
+    ASSERT_TRUE(entity);
+    EXPECT_EQ(Node_getEntity(entity)->getKeyValue("note"), "<tag attr=\"value\"> & 'quotes'\n\ttab") << "Spawnarg has not been preserved";
+    EXPECT_EQ(algorithm::getChildCount(entity), 2) << "Entity should have a brush and a patch";
+
+    // Layers, selection groups and sets have been restored
+    auto layerId = root->getLayerManager().getLayerID("Layer & <Details>");
+    EXPECT_NE(layerId, -1) << "Layer has not been restored";
+    EXPECT_EQ(countNodes(root, [&](const scene::INodePtr& node) { return node->getLayers().count(layerId) > 0; }), 17);
+
+    std::size_t groupCount = 0;
+    root->getSelectionGroupManager().foreachSelectionGroup([&](selection::ISelectionGroup& group)
+    {
+        EXPECT_EQ(group.getName(), "Group \"1\"");
+        EXPECT_EQ(group.size(), 13) << "Group should contain 10 brushes and 3 entities";
+        ++groupCount;
+    });
+    EXPECT_EQ(groupCount, 1);
+
+    auto set = root->getSelectionSetManager().findSelectionSet("Set 1");
+    ASSERT_TRUE(set) << "Selection set has not been restored";
+    EXPECT_EQ(set->getNodes().size(), 5);
+}
+
+TEST_F(MapExportTest, PortableFormatRejectsMalformedDocument)
+{
+    createTestMap(5, 2);
+
+    auto text = exportWholeMap(map::PORTABLE_MAP_FORMAT_NAME);
+
+    // Cut off the document in the middle of an entity
+    text.resize(text.rfind("<entity"));
+
+    EXPECT_THROW(importMap(map::PORTABLE_MAP_FORMAT_NAME, text), map::IMapReader::FailureException);
+}
+
 }
@@ -7,8 +7,12 @@
 #include "ipatch.h"
 #include "icomparablenode.h"
 #include "algorithm/Scene.h"
+#include "algorithm/Entity.h"
+#include "algorithm/Primitives.h"
 #include "registry/registry.h"
+#include "string/convert.h"
 #include "scenelib.h"
+#include "scene/merge/FingerprintIndex.h"
 #include "scene/merge/GraphComparer.h"
 #include "scene/merge/MergeOperation.h"
 #include "scene/merge/ThreeWayMergeOperation.h"
@@ -2588,4 +2592,113 @@ TEST_F(ThreeWayLayerMergeTest, LayerModifiedInSource)
     EXPECT_FALSE(nodeIsMemberOfLayer(brush4, { "4" }));
 }
 
+// The index must produce the same fingerprints as the nodes themselves
+TEST_F(MapMergeTest, FingerprintIndexMatchesNodeFingerprints)
+{
+    auto resource = GlobalMapResourceManager().createFromPath("maps/threeway_merge_base.mapx");
+    EXPECT_TRUE(resource->load()) << "Test map not found";
+
+    FingerprintIndex index(resource->getRootNode());
+
+    EXPECT_FALSE(index.getEntities().empty());
+
+    for (const auto& entry : index.getEntities())
+    {
+        auto comparable = std::dynamic_pointer_cast<scene::IComparableNode>(entry.node);
+        EXPECT_EQ(entry.fingerprint, comparable->getFingerprint()) << "Fingerprint mismatch for " << entry.entityName;
+        EXPECT_EQ(index.findByFingerprint(entry.fingerprint), &entry);
+
+        // Primitives with the same fingerprint are only indexed once
+        EXPECT_LE(entry.primitives.size(), algorithm::getChildCount(entry.node, [](const scene::INodePtr& node)
+        {
+            return Node_isPrimitive(node);
+        }));
+
+        for (const auto& primitive : entry.primitives)
+        {
+            EXPECT_EQ(primitive.second->getParent(), entry.node);
+            EXPECT_EQ(std::dynamic_pointer_cast<scene::IComparableNode>(primitive.second)->getFingerprint(), primitive.first);
+        }
+    }
+
+    EXPECT_EQ(index.findByFingerprint("nonexistent"), nullptr);
+}
+
+namespace
+{
+
+// Adds the same large set of brushes and entities to the given map,
+// the scaled maps still differ by the changes of the original fixture
+void addScaledContent(const scene::IMapRootNodePtr& root, std::size_t numWorldspawnBrushes, std::size_t numEntities)
+{
+    constexpr std::size_t BrushesPerEntity = 8;
+    auto worldspawn = algorithm::findWorldspawn(root);
+
+    for (std::size_t i = 0; i < numWorldspawnBrushes; ++i)
+    {
+        algorithm::createCubicBrush(worldspawn, Vector3(8192 + (i % 128) * 128.0, (i / 128) * 128.0, 0),
+            "textures/scaled/" + string::to_string(i % 20));
+    }
+
+    for (std::size_t i = 0; i < numEntities; ++i)
+    {
+        auto entity = algorithm::createEntityByClassName("func_static");
+        root->addChildNode(entity);
+        Node_getEntity(entity)->setKeyValue("name", "scaled_func_static_" + string::to_string(i));
+
+        for (std::size_t j = 0; j < BrushesPerEntity; ++j)
+        {
+            algorithm::createCubicBrush(entity, Vector3(-8192 - j * 128.0, i * 128.0, 0), "textures/scaled/entity");
+        }
+    }
+}
+
+}
+
+// Merges the first fixture set scaled up to tens of thousands of primitives,
+// the merge must produce the same actions as with the small maps
+TEST_F(ThreeWayMergeTest, MergeLargeScaledMaps)
+{
+    constexpr std::size_t NumWorldspawnBrushes = 16000;
+    constexpr std::size_t NumEntities = 500;
+    constexpr std::size_t NumModifiedEntities = 100;
+
+    auto baseResource = GlobalMapResourceManager().createFromPath("maps/threeway_merge_base.mapx");
+    EXPECT_TRUE(baseResource->load()) << "Base map not found.";
+
+    auto targetResource = GlobalMapResourceManager().createFromPath("maps/threeway_merge_target_1.mapx");
+    EXPECT_TRUE(targetResource->load()) << "Target map not found";
+
+    auto sourceResource = GlobalMapResourceManager().createFromPath("maps/threeway_merge_source_1.mapx");
+    EXPECT_TRUE(sourceResource->load()) << "Source map not found";
+
+    for (const auto& resource : { baseResource, targetResource, sourceResource })
+    {
+        addScaledContent(resource->getRootNode(), NumWorldspawnBrushes, NumEntities);
+    }
+
+    // Modify a few of the scaled entities in the source map
+    for (std::size_t i = 0; i < NumModifiedEntities; ++i)
+    {
+        auto entity = algorithm::getEntityByName(sourceResource->getRootNode(), "scaled_func_static_" + string::to_string(i));
+        Node_getEntity(entity)->setKeyValue("scaled_spawnarg", "value");
+    }
+
+    auto operation = ThreeWayMergeOperation::Create(baseResource->getRootNode(), 
+        sourceResource->getRootNode(), targetResource->getRootNode());
+
+    verifyTargetChanges1(operation->getTargetRoot());
+
+    // The actions of the original fixture are still present
+    EXPECT_TRUE(findAction<AddEntityAction>(operation, [](const std::shared_ptr<AddEntityAction>& action)
+    {
+        return Node_getEntity(action->getSourceNodeToAdd())->getKeyValue("name") == "light_2";
+    })) << "No merge action found for missing entity";
+
+    EXPECT_EQ(countActions<AddEntityKeyValueAction>(operation, [](const std::shared_ptr<AddEntityKeyValueAction>& action)
+    {
+        return action->getKey() == "scaled_spawnarg";
+    }), NumModifiedEntities);
+}
+
 }
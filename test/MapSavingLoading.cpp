@@ -1,6 +1,7 @@
 #include "RadiantTest.h"
 
 #include <fstream>
+#include <thread>
 #include "iundo.h"
 #include "imap.h"
 #include "imapformat.h"
@@ -24,6 +25,7 @@
 #include <sigc++/connection.h>
 #include "testutil/FileSelectionHelper.h"
 #include "registry/registry.h"
+#include "time/ProfilingSession.h"
 
 using namespace std::chrono_literals;
 
@@ -451,6 +453,59 @@ TEST_F(MapLoadingTest, loadingCanBeCancelled)
     GlobalRadiantCore().getMessageBus().removeListener(msgSubscription);
 }
 
+// Cancelling the operation in the middle of parsing, through a progress message
+TEST_F(MapLoadingTest, loadingCanBeCancelledWhileParsing)
+{
+    std::string mapName = "altar.map";
+    std::string otherMap = "altar_loadingCanBeCancelledWhileParsing.map";
+    auto tempPath = createMapCopyInTempDataPath(mapName, otherMap);
+
+    GlobalCommandSystem().executeCommand("OpenMap", mapName);
+    checkAltarScene();
+
+    // Send a progress message for every entity and primitive
+    registry::setValue("user/ui/map/loadStatusInterleave", 0);
+
+    std::size_t numProgressMessages = 0;
+    auto testThread = std::this_thread::get_id();
+
+    auto msgSubscription = GlobalRadiantCore().getMessageBus().addListener(
+        radiant::IMessage::Type::MapFileOperation,
+        radiant::TypeListener<map::FileOperation>(
+            [&](map::FileOperation& msg)
+    {
+        if (msg.getOperationType() != map::FileOperation::Type::Import ||
+            msg.getMessageType() != map::FileOperation::Progress)
+        {
+            return;
+        }
+
+        // The nodes are created on the calling thread, like the UI which is handling the messages,
+        // only the tokeniser is running on a worker thread
+        EXPECT_EQ(std::this_thread::get_id(), testThread) << "Progress message sent from another thread";
+
+        // Let the parser create a few nodes before cancelling
+        if (++numProgressMessages == 5)
+        {
+            msg.cancelOperation();
+        }
+    }));
+
+    GlobalCommandSystem().executeCommand("OpenMap", tempPath.string());
+
+    GlobalRadiantCore().getMessageBus().removeListener(msgSubscription);
+
+    EXPECT_EQ(numProgressMessages, 5) << "Parsing should have stopped at the cancelled message";
+
+    // None of the parsed nodes made it into the scene
+    EXPECT_FALSE(algorithm::getEntityByName(GlobalMapModule().getRoot(), "world"));
+    EXPECT_EQ(GlobalMapModule().getMapName(), "unnamed.map");
+
+    // Loading the map again works fine
+    GlobalCommandSystem().executeCommand("OpenMap", tempPath.string());
+    checkAltarScene();
+}
+
 // Loading a map through MapResource::load without inserting the nodes into a scene,
 // this should produce a valid scene too including the group information (which was a problem before)
 TEST_F(MapLoadingTest, loadMapInResourceOnly)
@@ -488,6 +543,66 @@ TEST_F(MapLoadingTest, loadMapxInResourceOnly)
     checkAltarScene(resource->getRootNode());
 }
 
+TEST_F(MapLoadingTest, loadingReportsProfilingStages)
+{
+    fs::path mapPath = _context.getTestProjectPath();
+    mapPath /= "maps/altar.map";
+
+    util::ProfilingSession profile("Test");
+    GlobalCommandSystem().executeCommand("OpenMap", mapPath.string());
+    profile.stop();
+
+    checkAltarScene();
+
+    std::size_t numEntities = 0;
+    std::size_t numPrimitives = 0;
+
+    GlobalMapModule().getRoot()->foreachNode([&](const scene::INodePtr& node)
+    {
+        numEntities += Node_isEntity(node) ? 1 : 0;
+        numPrimitives += Node_isPrimitive(node) ? 1 : 0;
+        return true;
+    });
+
+    EXPECT_EQ(profile.getCounter("Bytes parsed"), fs::file_size(mapPath));
+    EXPECT_EQ(profile.getCounter("Entities created"), numEntities);
+    EXPECT_EQ(profile.getCounter("Primitives created"), numPrimitives);
+
+    EXPECT_EQ(profile.getNumStageCalls("Map parsing"), 1);
+    EXPECT_EQ(profile.getNumStageCalls("Info file parsing"), 1);
+    EXPECT_EQ(profile.getNumStageCalls("Primitive parsing"), numPrimitives);
+    EXPECT_GE(profile.getNumStageCalls("Entity class lookup"), numEntities);
+    EXPECT_GT(profile.getNumStageCalls("Brush B-rep construction"), 0);
+    EXPECT_GT(profile.getNumStageCalls("Octree linking"), 0);
+
+    // Nothing is recorded after the session has been stopped
+    GlobalCommandSystem().executeCommand("OpenMap", mapPath.string());
+    EXPECT_EQ(profile.getNumStageCalls("Map parsing"), 1);
+}
+
+TEST_F(MapLoadingTest, loadingWritesProfileTrace)
+{
+    fs::path tracePath = _context.getTemporaryDataPath();
+    tracePath /= "map_load_trace.json";
+
+    registry::setValue("debug/map/loadProfileTraceFile", tracePath.string());
+    GlobalCommandSystem().executeCommand("OpenMap", cmd::Argument("maps/altar.map"));
+    registry::setValue("debug/map/loadProfileTraceFile", std::string());
+
+    checkAltarScene();
+
+    std::ifstream stream(tracePath);
+    EXPECT_TRUE(stream.good()) << "Trace file not written";
+
+    std::string trace((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+    EXPECT_EQ(trace.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["), 0);
+    EXPECT_NE(trace.find("\"name\":\"Map parsing\",\"cat\":\"Map load\",\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(trace.find("\"name\":\"Scene insertion\""), std::string::npos);
+    EXPECT_NE(trace.find("\"Primitives created\":"), std::string::npos);
+    EXPECT_NE(trace.rfind("]}"), std::string::npos);
+}
+
 TEST_F(MapSavingTest, saveMapWithoutModification)
 {
     auto tempPath = createMapCopyInTempDataPath("altar.map", "altar_saveMapWithoutModification.map");
@@ -54,6 +54,44 @@ TEST_F(MaterialsTest, MaterialCanBeModified)
     EXPECT_FALSE(materialManager.materialCanBeModified("textures/AFX/AFXweight"));
 }
 
+TEST_F(MaterialsTest, EditorImageDimensionsWithoutLoading)
+{
+    auto material = GlobalMaterialManager().getMaterial("textures/a_1024x512");
+
+    // The size is read from the diffusemap's file header
+    std::size_t width = 0;
+    std::size_t height = 0;
+    EXPECT_TRUE(material->getEditorImageDimensions(width, height));
+    EXPECT_EQ(width, 1024);
+    EXPECT_EQ(height, 512);
+
+    // Must match the size of the loaded image
+    auto editorImage = material->getEditorImage();
+    EXPECT_EQ(editorImage->getWidth(), width);
+    EXPECT_EQ(editorImage->getHeight(), height);
+}
+
+TEST_F(MaterialsTest, ReleaseEditorImage)
+{
+    auto material = GlobalMaterialManager().getMaterial("textures/numbers/2");
+
+    auto editorImage = material->getEditorImage();
+    ASSERT_TRUE(editorImage);
+    EXPECT_EQ(editorImage->getWidth(), 32);
+
+    material->releaseEditorImage();
+
+    // Released image is still valid as long as we hold a reference
+    EXPECT_EQ(editorImage->getWidth(), 32);
+    editorImage.reset();
+
+    // Next request reloads the image
+    auto reloaded = material->getEditorImage();
+    ASSERT_TRUE(reloaded);
+    EXPECT_EQ(reloaded->getWidth(), 32);
+    EXPECT_EQ(reloaded->getHeight(), 32);
+}
+
 TEST_F(MaterialsTest, MaterialCreation)
 {
     auto& materialManager = GlobalMaterialManager();
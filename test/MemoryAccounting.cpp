@@ -0,0 +1,215 @@
+#include "RadiantTest.h"
+
+#include <algorithm>
+#include "imemoryaccounting.h"
+#include "icommandsystem.h"
+#include "imodelcache.h"
+#include "imap.h"
+#include "ieclass.h"
+#include "ishaders.h"
+#include "iundo.h"
+#include "scenelib.h"
+#include "algorithm/Primitives.h"
+
+namespace test
+{
+
+using MemoryAccountingTest = RadiantTest;
+
+namespace
+{
+
+memory::Usage getUsageOfSubsystem(const std::string& name)
+{
+    for (const auto& subsystem : GlobalMemoryAccounting().collectUsage())
+    {
+        if (subsystem.name == name)
+        {
+            return subsystem.usage;
+        }
+    }
+
+    return memory::Usage();
+}
+
+bool subsystemIsReporting(const std::string& name)
+{
+    auto usages = GlobalMemoryAccounting().collectUsage();
+
+    return std::any_of(usages.begin(), usages.end(), [&](const memory::SubsystemUsage& subsystem)
+    {
+        return subsystem.name == name;
+    });
+}
+
+}
+
+TEST_F(MemoryAccountingTest, MajorSubsystemsAreReporting)
+{
+    for (auto name : { "UndoSystem", "GLTextureManager", "ModelCache", "GeometryStore",
+        "ShaderLibrary", "EClassManager", "Brushes", "Patches" })
+    {
+        EXPECT_TRUE(subsystemIsReporting(name)) << name << " is not reporting its memory usage";
+    }
+}
+
+TEST_F(MemoryAccountingTest, UsageIsSortedBySize)
+{
+    auto usages = GlobalMemoryAccounting().collectUsage();
+
+    for (std::size_t i = 1; i < usages.size(); ++i)
+    {
+        EXPECT_GE(usages[i - 1].usage.bytes, usages[i].usage.bytes) << "Usage is not sorted";
+    }
+}
+
+TEST_F(MemoryAccountingTest, ReportersWithSameNameAreSummedUp)
+{
+    auto first = GlobalMemoryAccounting().addReporter("TestSubsystem", [] { return memory::Usage{ 1000, 1 }; });
+    auto second = GlobalMemoryAccounting().addReporter("TestSubsystem", [] { return memory::Usage{ 500, 2 }; });
+
+    auto usage = getUsageOfSubsystem("TestSubsystem");
+    EXPECT_EQ(usage.bytes, 1500);
+    EXPECT_EQ(usage.numItems, 3);
+
+    GlobalMemoryAccounting().removeReporter(first);
+
+    usage = getUsageOfSubsystem("TestSubsystem");
+    EXPECT_EQ(usage.bytes, 500);
+    EXPECT_EQ(usage.numItems, 2);
+
+    GlobalMemoryAccounting().removeReporter(second);
+
+    EXPECT_FALSE(subsystemIsReporting("TestSubsystem")) << "Subsystem should be gone after removing its reporters";
+}
+
+TEST_F(MemoryAccountingTest, BrushesAndPatchesInSceneAreCounted)
+{
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+
+    auto brushesBefore = getUsageOfSubsystem("Brushes");
+    auto patchesBefore = getUsageOfSubsystem("Patches");
+
+    for (int i = 0; i < 10; ++i)
+    {
+        algorithm::createCubicBrush(worldspawn, Vector3(i * 128, 0, 0));
+        algorithm::createPatchFromBounds(worldspawn, AABB(Vector3(i * 128, 256, 0), Vector3(32, 32, 32)));
+    }
+
+    auto brushesAfter = getUsageOfSubsystem("Brushes");
+    auto patchesAfter = getUsageOfSubsystem("Patches");
+
+    EXPECT_EQ(brushesAfter.numItems, brushesBefore.numItems + 10);
+    EXPECT_GT(brushesAfter.bytes, brushesBefore.bytes);
+
+    EXPECT_EQ(patchesAfter.numItems, patchesBefore.numItems + 10);
+    EXPECT_GT(patchesAfter.bytes, patchesBefore.bytes);
+}
+
+TEST_F(MemoryAccountingTest, UndoStackIsCounted)
+{
+    GlobalMapModule().createNewMap();
+
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+    auto before = getUsageOfSubsystem("UndoSystem");
+
+    // Each brush creation is an undoable operation
+    for (int i = 0; i < 5; ++i)
+    {
+        algorithm::createCubicBrush(worldspawn, Vector3(i * 128, 0, 0));
+    }
+
+    auto after = getUsageOfSubsystem("UndoSystem");
+
+    EXPECT_EQ(after.numItems, before.numItems + 5);
+    EXPECT_GT(after.bytes, before.bytes);
+
+    // Undone operations are moving to the redo stack, they're still held in memory
+    GlobalCommandSystem().executeCommand("Undo");
+
+    auto afterUndo = getUsageOfSubsystem("UndoSystem");
+    EXPECT_EQ(afterUndo.numItems, after.numItems);
+
+    // A new map discards the old undo system
+    GlobalMapModule().createNewMap();
+
+    auto afterNewMap = getUsageOfSubsystem("UndoSystem");
+    EXPECT_LT(afterNewMap.bytes, after.bytes);
+    EXPECT_LT(afterNewMap.numItems, after.numItems);
+}
+
+TEST_F(MemoryAccountingTest, DeletedNodesAreCountedByUndoSystem)
+{
+    GlobalMapModule().createNewMap();
+
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+    std::vector<scene::INodePtr> brushes;
+
+    for (int i = 0; i < 5; ++i)
+    {
+        brushes.push_back(algorithm::createCubicBrush(worldspawn, Vector3(i * 128, 0, 0)));
+    }
+
+    auto brushUsage = getUsageOfSubsystem("Brushes");
+    auto undoBefore = getUsageOfSubsystem("UndoSystem");
+
+    {
+        UndoableCommand cmd("deleteBrushes");
+
+        for (const auto& brush : brushes)
+        {
+            scene::removeNodeFromParent(brush);
+        }
+    }
+
+    // Drop our own references, the brushes are now kept alive by the undo stack alone
+    brushes.clear();
+
+    EXPECT_EQ(getUsageOfSubsystem("Brushes").numItems, brushUsage.numItems - 5);
+
+    auto undoAfter = getUsageOfSubsystem("UndoSystem");
+    EXPECT_EQ(undoAfter.numItems, undoBefore.numItems + 1);
+    EXPECT_GE(undoAfter.bytes, undoBefore.bytes + brushUsage.bytes) << "The removed brushes should be counted";
+
+    // After undo the brushes are in the scene again and counted there
+    GlobalCommandSystem().executeCommand("Undo");
+
+    EXPECT_EQ(getUsageOfSubsystem("Brushes").numItems, brushUsage.numItems);
+    EXPECT_LT(getUsageOfSubsystem("UndoSystem").bytes, undoAfter.bytes);
+}
+
+TEST_F(MemoryAccountingTest, ModelCacheIsCounted)
+{
+    GlobalModelCache().clear();
+    EXPECT_EQ(getUsageOfSubsystem("ModelCache").numItems, 0);
+
+    auto model = GlobalModelCache().getModel("models/darkmod/test/unit_cube.ase");
+    ASSERT_TRUE(model);
+
+    auto usage = getUsageOfSubsystem("ModelCache");
+    EXPECT_EQ(usage.numItems, 1);
+    EXPECT_GT(usage.bytes, model->getVertexCount() * sizeof(Vector3)) << "Vertices should be counted";
+}
+
+TEST_F(MemoryAccountingTest, DeclarationLibrariesAreCounted)
+{
+    // Make sure the defs are loaded
+    EXPECT_TRUE(GlobalEntityClassManager().findClass("light"));
+    EXPECT_TRUE(GlobalMaterialManager().materialExists("textures/numbers/1"));
+
+    EXPECT_GT(getUsageOfSubsystem("EClassManager").numItems, 0);
+    EXPECT_GT(getUsageOfSubsystem("EClassManager").bytes, 0);
+
+    EXPECT_GT(getUsageOfSubsystem("ShaderLibrary").numItems, 0);
+    EXPECT_GT(getUsageOfSubsystem("ShaderLibrary").bytes, 0);
+}
+
+TEST_F(MemoryAccountingTest, ShowMemoryUsageCommand)
+{
+    EXPECT_TRUE(GlobalCommandSystem().commandExists("ShowMemoryUsage"));
+
+    // Should not throw or crash
+    GlobalCommandSystem().executeCommand("ShowMemoryUsage");
+}
+
+}
@@ -0,0 +1,300 @@
+#include "gtest/gtest.h"
+
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <atomic>
+#include <memory>
+
+#include "../plugins/dm.gameconnection/SpscQueue.h"
+#include "../plugins/dm.gameconnection/MessagePump.h"
+#include "../plugins/dm.gameconnection/MessageTcp.h"
+#include "../plugins/dm.gameconnection/clsocket/ActiveSocket.h"
+#include "../plugins/dm.gameconnection/clsocket/PassiveSocket.h"
+
+namespace test
+{
+
+using namespace gameconn;
+
+namespace
+{
+
+const char* const LOOPBACK_HOST = "127.0.0.1";
+const int TEST_PORT = 3881;
+
+// Generous upper bound for anything happening on the loopback interface
+const std::chrono::seconds TIMEOUT(10);
+
+template<typename Predicate>
+bool waitUntil(Predicate predicate)
+{
+    auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+
+    while (!predicate())
+    {
+        if (std::chrono::steady_clock::now() > deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    return true;
+}
+
+// The game side of a connection, served on the test thread
+class GameSide
+{
+private:
+    CPassiveSocket _listener;
+    MessageTcp _connection;
+
+public:
+    bool listen()
+    {
+        return _listener.Initialize() && _listener.SetOptionReuseAddr() && _listener.Listen(LOOPBACK_HOST, TEST_PORT);
+    }
+
+    bool accept()
+    {
+        std::unique_ptr<CActiveSocket> socket(_listener.Accept());
+        if (!socket) return false;
+
+        socket->SetNonblocking();
+        _connection.init(std::move(socket));
+        return _connection.isAlive();
+    }
+
+    // Waits for the next message from DarkRadiant
+    bool readMessage(std::string& message)
+    {
+        std::vector<char> bytes;
+
+        bool received = waitUntil([&]()
+        {
+            _connection.think();
+            return _connection.readMessage(bytes);
+        });
+
+        message.assign(bytes.begin(), bytes.end());
+        return received;
+    }
+
+    void writeMessage(const std::string& message)
+    {
+        _connection.writeMessage(message.data(), static_cast<int>(message.size()));
+
+        // Flush the output buffer
+        _connection.think();
+    }
+
+    void disconnect()
+    {
+        _connection.init(std::unique_ptr<CActiveSocket>());
+        _listener.Close();
+    }
+};
+
+std::unique_ptr<CActiveSocket> connectToGameSide()
+{
+    std::unique_ptr<CActiveSocket> socket(new CActiveSocket());
+
+    if (!socket->Initialize() || !socket->Open(LOOPBACK_HOST, TEST_PORT))
+    {
+        return std::unique_ptr<CActiveSocket>();
+    }
+
+    socket->SetNonblocking();
+    return socket;
+}
+
+}
+
+TEST(SpscQueueTest, PopReturnsValuesInOrder)
+{
+    SpscQueue<std::string> queue;
+
+    std::string value;
+    EXPECT_FALSE(queue.pop(value)) << "New queue should be empty";
+
+    queue.push("first");
+    queue.push("second");
+
+    EXPECT_TRUE(queue.pop(value));
+    EXPECT_EQ(value, "first");
+
+    queue.push("third");
+
+    EXPECT_TRUE(queue.pop(value));
+    EXPECT_EQ(value, "second");
+    EXPECT_TRUE(queue.pop(value));
+    EXPECT_EQ(value, "third");
+
+    EXPECT_FALSE(queue.pop(value)) << "Queue should be empty again";
+}
+
+TEST(SpscQueueTest, DestructorFreesRemainingValues)
+{
+    auto value = std::make_shared<int>(5);
+
+    {
+        SpscQueue<std::shared_ptr<int>> queue;
+        queue.push(value);
+        queue.push(value);
+        EXPECT_EQ(value.use_count(), 3);
+    }
+
+    EXPECT_EQ(value.use_count(), 1) << "Values left in the queue have not been destroyed";
+}
+
+TEST(SpscQueueTest, ProducerAndConsumerThreads)
+{
+    const int NumValues = 100000;
+
+    SpscQueue<int> queue;
+
+    std::thread producer([&]()
+    {
+        for (int i = 0; i < NumValues; ++i)
+        {
+            queue.push(i);
+        }
+    });
+
+    // Every value must arrive exactly once and in the order it has been pushed
+    int expected = 0;
+    int value = -1;
+
+    while (expected < NumValues)
+    {
+        if (!queue.pop(value))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        if (value != expected) break;
+        ++expected;
+    }
+
+    producer.join();
+
+    EXPECT_EQ(expected, NumValues) << "Received " << value << " instead of " << expected;
+    EXPECT_FALSE(queue.pop(value));
+}
+
+TEST(MessagePumpTest, ResponseIsPassedToHandler)
+{
+    GameSide game;
+    ASSERT_TRUE(game.listen());
+
+    auto socket = connectToGameSide();
+    ASSERT_TRUE(socket);
+    ASSERT_TRUE(game.accept());
+
+    MessagePump pump(std::move(socket));
+    EXPECT_TRUE(pump.isAlive());
+
+    std::atomic<bool> handlerCalled(false);
+    std::string handlerResponse;
+
+    pump.writeMessage("seqno 7\nrequest", 7, [&](const std::string* response)
+    {
+        handlerResponse = response ? *response : "<disconnected>";
+        handlerCalled = true;
+    });
+
+    std::string message;
+    ASSERT_TRUE(game.readMessage(message));
+    EXPECT_EQ(message, "seqno 7\nrequest");
+
+    // Responses to other requests are not passed to the handler
+    game.writeMessage("response 6\nsomething else");
+    game.writeMessage("response 7\ncontent");
+
+    ASSERT_TRUE(waitUntil([&]() { return handlerCalled.load(); }));
+    EXPECT_EQ(handlerResponse, "content");
+
+    // All messages are available for reading on the owning thread
+    ASSERT_TRUE(waitUntil([&]() { return pump.readMessage(message); }));
+    EXPECT_EQ(message, "response 6\nsomething else");
+    ASSERT_TRUE(waitUntil([&]() { return pump.readMessage(message); }));
+    EXPECT_EQ(message, "response 7\ncontent");
+    EXPECT_FALSE(pump.readMessage(message));
+}
+
+TEST(MessagePumpTest, HandlersAreCalledOnDisconnect)
+{
+    GameSide game;
+    ASSERT_TRUE(game.listen());
+
+    auto socket = connectToGameSide();
+    ASSERT_TRUE(socket);
+    ASSERT_TRUE(game.accept());
+
+    MessagePump pump(std::move(socket));
+
+    std::atomic<int> pendingHandlerCalls(0);
+
+    pump.writeMessage("seqno 1\nrequest", 1, [&](const std::string* response)
+    {
+        EXPECT_EQ(response, nullptr) << "There is no response to this request";
+        ++pendingHandlerCalls;
+    });
+
+    std::string message;
+    ASSERT_TRUE(game.readMessage(message));
+
+    game.disconnect();
+
+    ASSERT_TRUE(waitUntil([&]() { return !pump.isAlive(); }));
+    ASSERT_TRUE(waitUntil([&]() { return pendingHandlerCalls == 1; }));
+
+    // Messages written after the connection is lost fail right away
+    bool lateHandlerCalled = false;
+
+    pump.writeMessage("seqno 2\nrequest", 2, [&](const std::string* response)
+    {
+        EXPECT_EQ(response, nullptr);
+        lateHandlerCalled = true;
+    });
+
+    EXPECT_TRUE(lateHandlerCalled);
+    EXPECT_EQ(pendingHandlerCalls, 1);
+}
+
+TEST(MessagePumpTest, HandlersAreCalledWhenWritingDuringDisconnect)
+{
+    const int NumMessages = 10000;
+
+    GameSide game;
+    ASSERT_TRUE(game.listen());
+
+    auto socket = connectToGameSide();
+    ASSERT_TRUE(socket);
+    ASSERT_TRUE(game.accept());
+
+    std::atomic<int> handlerCalls(0);
+
+    {
+        MessagePump pump(std::move(socket));
+
+        // Keep writing while the I/O thread shuts down, no message may get lost
+        std::thread disconnector([&]() { game.disconnect(); });
+
+        for (int i = 1; i <= NumMessages; ++i)
+        {
+            pump.writeMessage("seqno " + std::to_string(i) + "\nrequest", i, [&](const std::string* response)
+            {
+                ++handlerCalls;
+            });
+        }
+
+        disconnector.join();
+
+        ASSERT_TRUE(waitUntil([&]() { return !pump.isAlive(); }));
+    }
+
+    // The I/O thread has finished now, every handler must have been called exactly once
+    EXPECT_EQ(handlerCalls, NumMessages);
+}
+
+}
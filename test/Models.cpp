@@ -4,6 +4,7 @@
 #include "imodelsurface.h"
 #include "imodelcache.h"
 #include "scenelib.h"
+#include "time/ProfilingSession.h"
 #include "algorithm/Entity.h"
 #include "algorithm/Scene.h"
 
@@ -456,6 +457,49 @@ TEST_F(ModelTest, LoadFbxModel)
     EXPECT_EQ(model->getPolyCount(), 12);
 }
 
+TEST_F(ModelTest, UncachedModelNodeDoesNotFillCache)
+{
+    auto modelPath = "models/darkmod/test/unit_cube.ase";
+    GlobalModelCache().clear();
+
+    util::ProfilingSession profile("Test");
+    ASSERT_TRUE(profile.isActive());
+
+    auto modelNode = Node_getModel(GlobalModelCache().getUncachedModelNode(modelPath));
+    ASSERT_TRUE(modelNode) << "Expected a model node for " << modelPath;
+    EXPECT_EQ(modelNode->getIModel().getPolyCount(), 12);
+    EXPECT_EQ(profile.getCounter("Models loaded"), 1);
+
+    // The model data must not have been stored, the cache needs to load it again
+    auto cachedModel = GlobalModelCache().getModel(modelPath);
+    ASSERT_TRUE(cachedModel);
+    EXPECT_EQ(profile.getCounter("Models loaded"), 2) << "Uncached model node should not fill the cache";
+
+    // Regular requests are cached as before
+    EXPECT_EQ(GlobalModelCache().getModel(modelPath), cachedModel);
+    EXPECT_EQ(profile.getCounter("Models loaded"), 2) << "The model should have been taken from the cache";
+}
+
+TEST_F(ModelTest, UncachedModelNodeUsesCachedModel)
+{
+    auto modelPath = "models/darkmod/test/unit_cube.lwo";
+    GlobalModelCache().clear();
+
+    auto cachedModel = GlobalModelCache().getModel(modelPath);
+    ASSERT_TRUE(cachedModel);
+
+    util::ProfilingSession profile("Test");
+    ASSERT_TRUE(profile.isActive());
+
+    auto modelNode = Node_getModel(GlobalModelCache().getUncachedModelNode(modelPath));
+    ASSERT_TRUE(modelNode) << "Expected a model node for " << modelPath;
+    EXPECT_EQ(modelNode->getIModel().getPolyCount(), cachedModel->getPolyCount());
+    EXPECT_EQ(profile.getCounter("Models loaded"), 0) << "Model already in the cache should not be loaded again";
+
+    // The cached model stays in the cache
+    EXPECT_EQ(GlobalModelCache().getModel(modelPath), cachedModel);
+}
+
 // #5964: Model nodes below a func_emitter didn't get rendered at the entity's origin after creating the entity
 TEST_F(ModelTest, NullModelTransformAfterSceneInsertion)
 {
@@ -0,0 +1,109 @@
+#include "RadiantTest.h"
+
+#include <fstream>
+#include <set>
+#include "icommandsystem.h"
+#include "ientity.h"
+#include "imap.h"
+#include "inamespace.h"
+#include "algorithm/Scene.h"
+#include <fmt/format.h>
+
+namespace test
+{
+
+using NamespaceTest = RadiantTest;
+
+TEST_F(NamespaceTest, AddUniqueNameUsesLowestUnusedPostfix)
+{
+    auto nspace = GlobalNamespaceFactory().createNamespace();
+
+    EXPECT_EQ(nspace->addUniqueName("func_static_1"), "func_static_1") << "Unused name should be kept";
+    EXPECT_EQ(nspace->addUniqueName("func_static_1"), "func_static_2");
+    EXPECT_TRUE(nspace->insert("func_static_4"));
+    EXPECT_EQ(nspace->addUniqueName("func_static_1"), "func_static_3");
+    EXPECT_EQ(nspace->addUniqueName("func_static_1"), "func_static_5") << "Used postfix 4 should have been skipped";
+
+    // Freed numbers are handed out again
+    EXPECT_TRUE(nspace->erase("func_static_2"));
+    EXPECT_EQ(nspace->addUniqueName("func_static_3"), "func_static_2");
+    EXPECT_EQ(nspace->addUniqueName("func_static_3"), "func_static_6");
+
+    // Zero-padded postfixes are different from their unpadded counterparts
+    EXPECT_EQ(nspace->addUniqueName("func_static_04"), "func_static_04");
+    EXPECT_TRUE(nspace->erase("func_static_04"));
+    EXPECT_EQ(nspace->addUniqueName("func_static_4"), "func_static_7");
+
+    // Names without postfix are kept if unused
+    EXPECT_EQ(nspace->addUniqueName("func_static_"), "func_static_");
+    EXPECT_EQ(nspace->addUniqueName("func_static_"), "func_static_8");
+
+    // Prefixes are independent
+    EXPECT_EQ(nspace->addUniqueName("light_1"), "light_1");
+    EXPECT_EQ(nspace->addUniqueName("light_1"), "light_2");
+}
+
+namespace
+{
+
+// Writes a prefab containing the given number of func_statics named func_static_1 .. func_static_N
+void writePrefabWithNamedEntities(const std::string& path, std::size_t numEntities)
+{
+    std::ofstream stream(path);
+
+    stream << "Version 2\n// entity 0\n{\n\"classname\" \"worldspawn\"\n}\n";
+
+    for (std::size_t i = 1; i <= numEntities; ++i)
+    {
+        stream << fmt::format("// entity {0}\n{{\n\"classname\" \"func_static\"\n\"name\" \"func_static_{0}\"\n"
+            "\"origin\" \"{1} 0 0\"\n}}\n", i, i * 16);
+    }
+}
+
+std::set<std::string> getFuncStaticNames()
+{
+    std::set<std::string> names;
+
+    GlobalMapModule().getRoot()->foreachNode([&](const scene::INodePtr& node)
+    {
+        auto entity = Node_getEntity(node);
+
+        if (entity && entity->getKeyValue("classname") == "func_static")
+        {
+            EXPECT_TRUE(names.insert(entity->getKeyValue("name")).second) << "Duplicate name " << entity->getKeyValue("name");
+        }
+
+        return true;
+    });
+
+    return names;
+}
+
+}
+
+TEST_F(NamespaceTest, ImportPrefabWithManyConflictingNames)
+{
+    constexpr std::size_t NumEntities = 3000;
+    constexpr std::size_t NumImports = 3;
+
+    fs::path prefabPath = _context.getTemporaryDataPath();
+    prefabPath /= "named_entities.pfb";
+    writePrefabWithNamedEntities(prefabPath.string(), NumEntities);
+
+    for (std::size_t i = 0; i < NumImports; ++i)
+    {
+        // Every import after the first one conflicts with all existing names
+        GlobalCommandSystem().executeCommand("LoadPrefabAt", prefabPath.string(), Vector3(0, 0, 0), 0);
+    }
+
+    auto names = getFuncStaticNames();
+    EXPECT_EQ(names.size(), NumEntities * NumImports);
+
+    // The renamed entities got the next free numbers
+    for (std::size_t i = 1; i <= NumEntities * NumImports; ++i)
+    {
+        EXPECT_EQ(names.count(fmt::format("func_static_{0}", i)), 1) << "Missing func_static_" << i;
+    }
+}
+
+}
@@ -2,6 +2,9 @@
 
 #include "isound.h"
 #include "parser/DefBlockTokeniser.h"
+#include "parser/ThreadedDefTokeniser.h"
+#include "parser/ParseException.h"
+#include <fmt/format.h>
 
 namespace test
 {
@@ -113,6 +116,83 @@ TEST(DefBlockTokeniser, BlockSeparation)
     });
 }
 
+namespace
+{
+
+// A text containing a few thousand tokens, filling several batches of the threaded tokeniser
+std::string createLargeTokenText()
+{
+    std::string text;
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        text += fmt::format("brush_{0} {{ ( {0} 0.5 -1 ) \"textures/{0}\" }} // comment {0}\n", i);
+    }
+
+    return text;
+}
+
+}
+
+TEST(ThreadedDefTokeniser, ProducesSameTokensAsBasicTokeniser)
+{
+    auto text = createLargeTokenText();
+
+    std::istringstream basicStream{ text };
+    parser::BasicDefTokeniser<std::istream> basic(basicStream);
+
+    std::istringstream threadedStream{ text };
+    parser::ThreadedDefTokeniser threaded(threadedStream);
+
+    std::size_t numTokens = 0;
+
+    while (basic.hasMoreTokens())
+    {
+        ASSERT_TRUE(threaded.hasMoreTokens());
+        EXPECT_EQ(threaded.peek(), basic.peek());
+        ASSERT_EQ(threaded.nextToken(), basic.nextToken()) << "Mismatch at token " << numTokens;
+        ++numTokens;
+    }
+
+    EXPECT_FALSE(threaded.hasMoreTokens());
+    EXPECT_THROW(threaded.nextToken(), parser::ParseException);
+    EXPECT_EQ(numTokens, 5000 * 9);
+}
+
+TEST(ThreadedDefTokeniser, AssertAndSkipTokens)
+{
+    std::istringstream stream{ "Version 2 { \"key\" \"value\" }" };
+    parser::ThreadedDefTokeniser tokeniser(stream);
+
+    tokeniser.assertNextToken("Version");
+    tokeniser.skipTokens(2);
+    EXPECT_EQ(tokeniser.nextToken(), "key");
+    EXPECT_THROW(tokeniser.assertNextToken("key"), parser::ParseException);
+}
+
+TEST(ThreadedDefTokeniser, EmptyStream)
+{
+    std::istringstream stream{ "  // only a comment\n" };
+    parser::ThreadedDefTokeniser tokeniser(stream);
+
+    EXPECT_FALSE(tokeniser.hasMoreTokens());
+    EXPECT_THROW(tokeniser.peek(), parser::ParseException);
+}
+
+TEST(ThreadedDefTokeniser, DestroyedBeforeAllTokensConsumed)
+{
+    auto text = createLargeTokenText();
+
+    // The worker is blocked by the full queue, destruction must stop it
+    for (int i = 0; i < 10; ++i)
+    {
+        std::istringstream stream{ text };
+        parser::ThreadedDefTokeniser tokeniser(stream);
+
+        EXPECT_EQ(tokeniser.nextToken(), "brush_0");
+    }
+}
+
 using SoundShaderParsingTests = RadiantTest;
 
 TEST_F(SoundShaderParsingTests, ShaderParsing)
@@ -0,0 +1,167 @@
+#include "gtest/gtest.h"
+
+#include <vector>
+#include <cstdint>
+#include "math/Vector3.h"
+#include "util/PoolAllocator.h"
+
+namespace test
+{
+
+TEST(PoolAllocatorTest, ReusesBlocks)
+{
+    util::FixedSizePool pool(sizeof(Vector3), alignof(Vector3));
+
+    std::vector<void*> blocks;
+
+    for (auto i = 0; i < 100; ++i)
+    {
+        blocks.push_back(pool.allocate());
+    }
+
+    EXPECT_EQ(pool.getNumAllocatedBlocks(), 100);
+
+    auto reservedBytes = pool.getReservedBytes();
+    EXPECT_GE(reservedBytes, 100 * sizeof(Vector3));
+
+    auto released = blocks[42];
+    pool.deallocate(released);
+
+    EXPECT_EQ(pool.getNumAllocatedBlocks(), 99);
+    EXPECT_EQ(pool.allocate(), released) << "Released block should be handed out again";
+    EXPECT_EQ(pool.getReservedBytes(), reservedBytes) << "Pool should not have grown";
+
+    for (auto block : blocks)
+    {
+        pool.deallocate(block);
+    }
+}
+
+TEST(PoolAllocatorTest, BlocksAreAligned)
+{
+    struct alignas(32) AlignedType
+    {
+        char data[40];
+    };
+
+    util::FixedSizePool pool(sizeof(AlignedType), alignof(AlignedType));
+
+    std::vector<void*> blocks;
+
+    for (auto i = 0; i < 1000; ++i)
+    {
+        blocks.push_back(pool.allocate());
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(blocks.back()) % alignof(AlignedType), 0);
+    }
+
+    for (auto block : blocks)
+    {
+        pool.deallocate(block);
+    }
+}
+
+TEST(PoolAllocatorTest, ChunksAreReleasedWhenEmpty)
+{
+    util::FixedSizePool pool(sizeof(Vector3), alignof(Vector3));
+
+    EXPECT_EQ(pool.getReservedBytes(), 0);
+
+    auto first = pool.allocate();
+    auto singleChunkBytes = pool.getReservedBytes();
+    EXPECT_GT(singleChunkBytes, 0);
+
+    // Allocate enough blocks to need several chunks
+    std::vector<void*> blocks;
+
+    while (pool.getReservedBytes() < 4 * singleChunkBytes)
+    {
+        blocks.push_back(pool.allocate());
+    }
+
+    for (auto block : blocks)
+    {
+        pool.deallocate(block);
+    }
+
+    EXPECT_EQ(pool.getNumAllocatedBlocks(), 1);
+    EXPECT_EQ(pool.getReservedBytes(), 4 * singleChunkBytes) << "Chunks must be kept while blocks are in use";
+
+    // Releasing the last block frees all chunks but one
+    pool.deallocate(first);
+
+    EXPECT_EQ(pool.getNumAllocatedBlocks(), 0);
+    EXPECT_EQ(pool.getReservedBytes(), singleChunkBytes);
+
+    // The pool is usable again, filling the remaining chunk first.
+    // Without the first block, the others fit into three chunks.
+    for (auto& block : blocks)
+    {
+        block = pool.allocate();
+    }
+
+    EXPECT_EQ(pool.getNumAllocatedBlocks(), blocks.size());
+    EXPECT_EQ(pool.getReservedBytes(), 3 * singleChunkBytes);
+
+    for (auto block : blocks)
+    {
+        pool.deallocate(block);
+    }
+
+    EXPECT_EQ(pool.getReservedBytes(), singleChunkBytes);
+}
+
+TEST(PoolAllocatorTest, PooledSharedPointers)
+{
+    auto vector = util::makePooledShared<Vector3>(1, 2, 3);
+    EXPECT_EQ(*vector, Vector3(1, 2, 3));
+
+    auto other = util::makePooledShared<Vector3>(4, 5, 6);
+    EXPECT_EQ(*other, Vector3(4, 5, 6));
+    EXPECT_NE(vector.get(), other.get());
+
+    // The control block and the object are released to the pool together
+    vector.reset();
+    other.reset();
+
+    auto reused = util::makePooledShared<Vector3>(7, 8, 9);
+    EXPECT_EQ(*reused, Vector3(7, 8, 9));
+}
+
+TEST(PoolAllocatorTest, PooledSharedPointerUsage)
+{
+    // A type of its own, such that no other test is using its pool
+    struct PooledType
+    {
+        double values[4];
+    };
+
+    using Group = util::PoolGroup<PooledType>;
+    EXPECT_EQ(Group::GetNumAllocatedBlocks(), 0u);
+
+    std::vector<std::shared_ptr<PooledType>> objects;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        objects.push_back(util::makePooledShared<PooledType>());
+    }
+
+    // The control blocks are allocated through the rebound allocator, they are found through the owner type
+    EXPECT_EQ(Group::GetNumAllocatedBlocks(), objects.size());
+    EXPECT_GE(Group::GetReservedBytes(), objects.size() * sizeof(PooledType));
+
+    objects.resize(10);
+
+    // Released blocks are still reserved
+    EXPECT_EQ(Group::GetNumAllocatedBlocks(), 10u);
+    auto reservedBytes = Group::GetReservedBytes();
+    EXPECT_GE(reservedBytes, 100 * sizeof(PooledType));
+
+    // Once all objects are gone, a single chunk is kept
+    objects.clear();
+
+    EXPECT_EQ(Group::GetNumAllocatedBlocks(), 0u);
+    EXPECT_GT(Group::GetReservedBytes(), 0u);
+    EXPECT_LE(Group::GetReservedBytes(), reservedBytes);
+}
+
+}
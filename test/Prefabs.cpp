@@ -4,6 +4,7 @@
 #include "ispeakernode.h"
 #include "ilightnode.h"
 #include "ibrush.h"
+#include "imapresource.h"
 #include "scene/PrefabBoundsAccumulator.h"
 #include "os/path.h"
 #include "algorithm/Scene.h"
@@ -117,4 +118,84 @@ TEST_F(PrefabTest, PrefabInsertPositionWithoutOriginCorrection)
     EXPECT_EQ(brush->worldAABB().getOrigin(), Vector3(128, 0, 0));
 }
 
+namespace
+{
+
+std::vector<scene::INodePtr> getAllNodes(const scene::INodePtr& root)
+{
+    std::vector<scene::INodePtr> nodes;
+
+    root->foreachNode([&](const scene::INodePtr& node)
+    {
+        nodes.push_back(node);
+        return true;
+    });
+
+    return nodes;
+}
+
+}
+
+TEST_F(PrefabTest, CreateFromLoadedResource)
+{
+    fs::path prefabPath = _context.getTestProjectPath();
+    prefabPath /= "prefabs/large_bounds.pfbx";
+
+    EXPECT_FALSE(GlobalMapResourceManager().createFromLoadedResource(prefabPath.string()))
+        << "No resource has been loaded yet";
+
+    // Load the prefab like the preview does
+    auto previewResource = GlobalMapResourceManager().createFromPath(prefabPath.string());
+    EXPECT_FALSE(GlobalMapResourceManager().createFromLoadedResource(prefabPath.string()))
+        << "Resource has been created but not loaded yet";
+
+    EXPECT_TRUE(previewResource->load());
+    auto previewNodes = getAllNodes(previewResource->getRootNode());
+
+    auto copiedResource = GlobalMapResourceManager().createFromLoadedResource(prefabPath.string());
+    ASSERT_TRUE(copiedResource);
+    EXPECT_TRUE(copiedResource->load()) << "Copied resource should report as loaded";
+    EXPECT_NE(copiedResource->getRootNode(), previewResource->getRootNode());
+
+    auto copiedNodes = getAllNodes(copiedResource->getRootNode());
+    ASSERT_EQ(copiedNodes.size(), previewNodes.size());
+
+    for (std::size_t i = 0; i < copiedNodes.size(); ++i)
+    {
+        EXPECT_NE(copiedNodes[i], previewNodes[i]) << "Nodes should have been copied";
+        EXPECT_EQ(copiedNodes[i]->getNodeType(), previewNodes[i]->getNodeType());
+        EXPECT_TRUE(math::isNear(copiedNodes[i]->worldAABB().getOrigin(), previewNodes[i]->worldAABB().getOrigin(), 0.01));
+    }
+
+    // Inserting the prefab leaves the previewed nodes alone
+    GlobalCommandSystem().executeCommand("LoadPrefabAt", prefabPath.string(), Vector3(0, 0, 0), 1);
+
+    EXPECT_EQ(getAllNodes(previewResource->getRootNode()), previewNodes);
+    EXPECT_TRUE(algorithm::getEntityByName(GlobalMapModule().getRoot(), "speaker_1"));
+    EXPECT_TRUE(algorithm::getEntityByName(GlobalMapModule().getRoot(), "light_1"));
+
+    // Once the preview is gone, the file needs to be parsed again
+    previewResource.reset();
+    copiedResource.reset();
+
+    EXPECT_FALSE(GlobalMapResourceManager().createFromLoadedResource(prefabPath.string()));
+}
+
+TEST_F(PrefabTest, CreateFromLoadedResourceChangedOnDisk)
+{
+    fs::path prefabPath = _context.getTemporaryDataPath();
+    prefabPath /= "changed_prefab.pfbx";
+    fs::copy(fs::path(_context.getTestProjectPath()) / "prefabs/large_bounds.pfbx", prefabPath);
+
+    auto previewResource = GlobalMapResourceManager().createFromPath(prefabPath.string());
+    EXPECT_TRUE(previewResource->load());
+    EXPECT_TRUE(GlobalMapResourceManager().createFromLoadedResource(prefabPath.string()));
+
+    // Pretend the file has been saved by someone else
+    fs::last_write_time(prefabPath, fs::last_write_time(prefabPath) + std::chrono::hours(1));
+
+    EXPECT_FALSE(GlobalMapResourceManager().createFromLoadedResource(prefabPath.string()))
+        << "Loaded nodes are outdated, the file needs to be parsed again";
+}
+
 }
@@ -0,0 +1,204 @@
+#include "RadiantTest.h"
+
+#include "wxutil/dataview/ResourceTreeModelCache.h"
+
+namespace test
+{
+
+namespace
+{
+
+struct CacheColumns :
+    public wxutil::TreeModel::ColumnRecord
+{
+    CacheColumns() :
+        name(add(wxutil::TreeModel::Column::String))
+    {}
+
+    wxutil::TreeModel::Column name;
+};
+
+}
+
+class ResourceTreeModelCacheTest :
+    public RadiantTest
+{
+protected:
+    CacheColumns _columns;
+
+    void SetUp() override
+    {
+        RadiantTest::SetUp();
+
+        // The cache is process-wide, start with a clean slate
+        wxutil::ResourceTreeModelCache::Clear();
+    }
+
+    wxutil::TreeModel::Ptr createModel()
+    {
+        return wxutil::TreeModel::Ptr(new wxutil::TreeModel(_columns));
+    }
+};
+
+using Cache = wxutil::ResourceTreeModelCache;
+
+TEST_F(ResourceTreeModelCacheTest, StoreAndGet)
+{
+    EXPECT_FALSE(Cache::Get("test/models")) << "Nothing should be stored yet";
+
+    auto model = createModel();
+    Cache::Store("test/models", model, Cache::GetGeneration("test/models"));
+
+    EXPECT_EQ(Cache::Get("test/models").get(), model.get());
+    EXPECT_FALSE(Cache::Get("test/other")) << "Keys should be independent";
+
+    // Storing a newer model replaces the old one
+    auto newModel = createModel();
+    Cache::Store("test/models", newModel, Cache::GetGeneration("test/models"));
+
+    EXPECT_EQ(Cache::Get("test/models").get(), newModel.get());
+}
+
+TEST_F(ResourceTreeModelCacheTest, StoreChecksGeneration)
+{
+    // A populator remembers the generation before it starts to work
+    auto generation = Cache::GetGeneration("test/models");
+
+    // The key is invalidated while the model is being populated
+    Cache::Invalidate("test/models");
+    EXPECT_EQ(Cache::GetGeneration("test/models"), generation + 1);
+
+    Cache::Store("test/models", createModel(), generation);
+    EXPECT_FALSE(Cache::Get("test/models")) << "An outdated model must not be stored";
+
+    // A populator started after the invalidation is allowed to store its model
+    auto model = createModel();
+    Cache::Store("test/models", model, Cache::GetGeneration("test/models"));
+
+    EXPECT_EQ(Cache::Get("test/models").get(), model.get());
+
+    // Invalidating other keys doesn't affect this one
+    Cache::Invalidate("test/other");
+    EXPECT_EQ(Cache::Get("test/models").get(), model.get());
+    EXPECT_EQ(Cache::GetGeneration("test/models"), generation + 1);
+}
+
+TEST_F(ResourceTreeModelCacheTest, InvalidateRemovesModel)
+{
+    auto model = createModel();
+    Cache::Store("test/models", model, Cache::GetGeneration("test/models"));
+
+    Cache::Invalidate("test/models");
+
+    EXPECT_FALSE(Cache::Get("test/models"));
+    EXPECT_EQ(model->GetRefCount(), 1) << "The cache should have released its reference";
+}
+
+TEST_F(ResourceTreeModelCacheTest, InvalidateOnSignals)
+{
+    sigc::signal<void> firstSignal;
+    sigc::signal<void> secondSignal;
+
+    Cache::InvalidateOnSignals("test/models", { firstSignal, secondSignal });
+
+    Cache::Store("test/models", createModel(), Cache::GetGeneration("test/models"));
+    EXPECT_TRUE(Cache::Get("test/models"));
+
+    auto generation = Cache::GetGeneration("test/models");
+    firstSignal.emit();
+
+    EXPECT_FALSE(Cache::Get("test/models")) << "The first signal should have invalidated the model";
+    EXPECT_EQ(Cache::GetGeneration("test/models"), generation + 1);
+
+    Cache::Store("test/models", createModel(), Cache::GetGeneration("test/models"));
+    secondSignal.emit();
+
+    EXPECT_FALSE(Cache::Get("test/models")) << "The second signal should have invalidated the model";
+    EXPECT_EQ(Cache::GetGeneration("test/models"), generation + 2);
+}
+
+TEST_F(ResourceTreeModelCacheTest, SignalsAreConnectedOnce)
+{
+    sigc::signal<void> signal;
+    sigc::signal<void> otherSignal;
+
+    Cache::InvalidateOnSignals("test/models", { signal });
+
+    // Connecting the same key again does nothing, neither the same nor other signals
+    Cache::InvalidateOnSignals("test/models", { signal });
+    Cache::InvalidateOnSignals("test/models", { otherSignal });
+
+    auto generation = Cache::GetGeneration("test/models");
+
+    signal.emit();
+    EXPECT_EQ(Cache::GetGeneration("test/models"), generation + 1) << "The signal should invalidate the key once";
+
+    Cache::Store("test/models", createModel(), Cache::GetGeneration("test/models"));
+    otherSignal.emit();
+
+    EXPECT_TRUE(Cache::Get("test/models")) << "The signal connected later should have been ignored";
+    EXPECT_EQ(Cache::GetGeneration("test/models"), generation + 1);
+}
+
+TEST_F(ResourceTreeModelCacheTest, ClearDisconnectsSignals)
+{
+    sigc::signal<void> signal;
+    Cache::InvalidateOnSignals("test/models", { signal });
+
+    auto model = createModel();
+    Cache::Store("test/models", model, Cache::GetGeneration("test/models"));
+
+    auto generation = Cache::GetGeneration("test/models");
+    Cache::Clear();
+
+    EXPECT_FALSE(Cache::Get("test/models"));
+    EXPECT_EQ(model->GetRefCount(), 1) << "The cache should have released its reference";
+
+    // Clearing outdates any running populators
+    EXPECT_EQ(Cache::GetGeneration("test/models"), generation + 1);
+
+    signal.emit();
+    EXPECT_EQ(Cache::GetGeneration("test/models"), generation + 1) << "The signal should have been disconnected";
+}
+
+// Keeps a model in the cache until the modules are shut down
+class ResourceTreeModelCacheShutdownTest :
+    public ResourceTreeModelCacheTest
+{
+protected:
+    sigc::signal<void> _signal;
+    wxutil::TreeModel::Ptr _model;
+    std::size_t _generation = 0;
+
+    void preShutdown() override
+    {
+        Cache::InvalidateOnSignals("test/models", { _signal });
+
+        _model = createModel();
+        Cache::Store("test/models", _model, Cache::GetGeneration("test/models"));
+        EXPECT_TRUE(Cache::Get("test/models"));
+
+        _generation = Cache::GetGeneration("test/models");
+    }
+
+    void postShutdown() override
+    {
+        // The models are released while the modules are uninitialising
+        EXPECT_FALSE(Cache::Get("test/models"));
+        EXPECT_EQ(_model->GetRefCount(), 1) << "The cache should have released its reference";
+        EXPECT_EQ(Cache::GetGeneration("test/models"), _generation + 1);
+
+        // The invalidation signals have been disconnected
+        _signal.emit();
+        EXPECT_EQ(Cache::GetGeneration("test/models"), _generation + 1);
+
+        _model.reset();
+    }
+};
+
+TEST_F(ResourceTreeModelCacheShutdownTest, ClearedOnModuleShutdown)
+{
+    // The checks are performed by preShutdown() and postShutdown()
+}
+
+}
@@ -3,6 +3,7 @@
 #include "scene/BasicRootNode.h"
 #include "scene/Node.h"
 #include "scenelib.h"
+#include "imap.h"
 
 namespace test
 {
@@ -257,4 +258,140 @@ TEST_F(SceneNodeTest, SetFilterStatus)
     EXPECT_FALSE(node->isFiltered()) << "Node should report as unfiltered";
 }
 
+namespace
+{
+
+std::vector<scene::INodePtr> createChildNodes(const scene::INodePtr& parent, std::size_t count)
+{
+    std::vector<scene::INodePtr> children;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        children.emplace_back(std::make_shared<VisibilityTestNode>());
+        scene::addNodeToContainer(children.back(), parent);
+    }
+
+    return children;
+}
+
+// Invokes the functor for every visited node, without descending into its children
+class FunctorVisitor :
+    public scene::NodeVisitor
+{
+private:
+    std::function<void(const scene::INodePtr&)> _functor;
+
+public:
+    FunctorVisitor(const std::function<void(const scene::INodePtr&)>& functor) :
+        _functor(functor)
+    {}
+
+    bool pre(const scene::INodePtr& node) override
+    {
+        _functor(node);
+        return false;
+    }
+};
+
+std::vector<scene::INodePtr> getChildNodes(const scene::INodePtr& parent)
+{
+    std::vector<scene::INodePtr> children;
+
+    parent->foreachNode([&](const scene::INodePtr& child)
+    {
+        children.push_back(child);
+        return true;
+    });
+
+    return children;
+}
+
+}
+
+TEST_F(SceneNodeTest, RemoveChildNodesDuringTraversal)
+{
+    auto parent = std::make_shared<VisibilityTestNode>();
+    auto children = createChildNodes(parent, 5);
+
+    std::vector<scene::INodePtr> visited;
+
+    parent->foreachNode([&](const scene::INodePtr& child)
+    {
+        visited.push_back(child);
+
+        // Remove the current and the next node while traversing
+        if (child == children[1])
+        {
+            scene::removeNodeFromParent(children[1]);
+            scene::removeNodeFromParent(children[2]);
+        }
+        return true;
+    });
+
+    EXPECT_EQ(visited, std::vector<scene::INodePtr>({ children[0], children[1], children[3], children[4] }))
+        << "Removed nodes should not be visited, all others should";
+    EXPECT_EQ(getChildNodes(parent), std::vector<scene::INodePtr>({ children[0], children[3], children[4] }));
+}
+
+TEST_F(SceneNodeTest, RemoveChildNodesDuringVisitorTraversal)
+{
+    auto parent = std::make_shared<VisibilityTestNode>();
+    auto children = createChildNodes(parent, 4);
+
+    std::vector<scene::INodePtr> visited;
+
+    FunctorVisitor visitor([&](const scene::INodePtr& child)
+    {
+        visited.push_back(child);
+
+        // Remove the node that would be visited next
+        if (child == children[2])
+        {
+            scene::removeNodeFromParent(children[3]);
+        }
+    });
+    parent->traverseChildren(visitor);
+
+    EXPECT_EQ(visited, std::vector<scene::INodePtr>({ children[0], children[1], children[2] }));
+    EXPECT_EQ(getChildNodes(parent), std::vector<scene::INodePtr>({ children[0], children[1], children[2] }));
+    EXPECT_TRUE(parent->hasChildNodes());
+
+    // Remove every child from within a traversal
+    parent->foreachNode([&](const scene::INodePtr& child)
+    {
+        scene::removeNodeFromParent(child);
+        return true;
+    });
+
+    EXPECT_FALSE(parent->hasChildNodes()) << "All child nodes should be gone";
+}
+
+TEST_F(SceneNodeTest, AddChildNodesDuringTraversal)
+{
+    auto parent = std::make_shared<VisibilityTestNode>();
+    auto children = createChildNodes(parent, 3);
+
+    auto appended = std::make_shared<VisibilityTestNode>();
+    auto prepended = std::make_shared<VisibilityTestNode>();
+
+    std::vector<scene::INodePtr> visited;
+
+    parent->foreachNode([&](const scene::INodePtr& child)
+    {
+        visited.push_back(child);
+
+        if (child == children[1])
+        {
+            parent->addChildNodeToFront(prepended);
+            parent->addChildNode(appended);
+        }
+        return true;
+    });
+
+    // Appended nodes are visited, nodes inserted in front of the current one are not
+    // and the ones already visited are not visited a second time
+    EXPECT_EQ(visited, std::vector<scene::INodePtr>({ children[0], children[1], children[2], appended }));
+    EXPECT_EQ(getChildNodes(parent), std::vector<scene::INodePtr>({ prepended, children[0], children[1], children[2], appended }));
+}
+
 }
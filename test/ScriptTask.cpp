@@ -0,0 +1,386 @@
+#include "RadiantTest.h"
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include "imap.h"
+#include "icommandsystem.h"
+#include "imessagebus.h"
+#include "messages/LongRunningOperationMessage.h"
+#include "algorithm/Primitives.h"
+#include "algorithm/Scene.h"
+#include "../plugins/script/ScriptTask.h"
+
+namespace test
+{
+
+using ScriptTaskTest = RadiantTest;
+
+namespace
+{
+
+// Stands in for the UI thread's event queue, processed by the test thread
+class DispatchQueue
+{
+private:
+    std::mutex _lock;
+    std::deque<std::function<void()>> _queue;
+
+public:
+    script::ScriptTask::Dispatcher getDispatcher()
+    {
+        return [this](const std::function<void()>& functor)
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            _queue.push_back(functor);
+        };
+    }
+
+    std::size_t size()
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        return _queue.size();
+    }
+
+    // Runs the queued functors on the calling thread until the condition is met
+    void processUntil(const std::function<bool()>& condition)
+    {
+        while (!condition())
+        {
+            std::deque<std::function<void()>> pending;
+
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                pending.swap(_queue);
+            }
+
+            for (const auto& functor : pending)
+            {
+                functor();
+            }
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+};
+
+// Records the long-running operation messages sent while it's alive
+class OperationMessageRecorder
+{
+public:
+    struct Entry
+    {
+        radiant::OperationEvent event;
+        std::string message;
+        float progress;
+        bool blocksScreenUpdates;
+        std::thread::id threadId;
+    };
+
+    std::vector<Entry> entries;
+
+    // Set to request the cancellation through the next progress message
+    bool cancelOnProgress = false;
+
+private:
+    std::size_t _listener;
+
+public:
+    OperationMessageRecorder()
+    {
+        _listener = GlobalRadiantCore().getMessageBus().addListener(radiant::IMessage::Type::LongRunningOperation,
+            radiant::TypeListener<radiant::LongRunningOperationMessage>([this](radiant::LongRunningOperationMessage& msg)
+        {
+            entries.push_back(Entry{ msg.getType(), msg.getMessage(), msg.getProgress(),
+                msg.blocksScreenUpdates(), std::this_thread::get_id() });
+
+            if (cancelOnProgress && msg.getType() == radiant::OperationEvent::Progress)
+            {
+                msg.requestCancellation();
+            }
+        }));
+    }
+
+    ~OperationMessageRecorder()
+    {
+        GlobalRadiantCore().getMessageBus().removeListener(_listener);
+    }
+
+    std::size_t count(radiant::OperationEvent event) const
+    {
+        return std::count_if(entries.begin(), entries.end(), [&](const Entry& entry) { return entry.event == event; });
+    }
+};
+
+// Starts the task and processes the queue until it has been finished
+void runTask(script::ScriptTask& task, DispatchQueue& queue)
+{
+    bool finished = false;
+
+    task.start([&]()
+    {
+        task.wait();
+        finished = true;
+    });
+
+    queue.processUntil([&]() { return finished; });
+}
+
+}
+
+TEST_F(ScriptTaskTest, BodyRunsInWorkerThread)
+{
+    DispatchQueue queue;
+    std::thread::id bodyThread;
+
+    script::ScriptTask task("test", true, [&]() { bodyThread = std::this_thread::get_id(); }, queue.getDispatcher());
+
+    runTask(task, queue);
+
+    EXPECT_TRUE(task.isFinished());
+    EXPECT_NE(bodyThread, std::thread::id());
+    EXPECT_NE(bodyThread, std::this_thread::get_id());
+    EXPECT_EQ(script::ScriptTask::GetCurrent(), nullptr) << "Task should be gone after waiting for it";
+}
+
+TEST_F(ScriptTaskTest, ProgressIsReportedOnCallingThread)
+{
+    DispatchQueue queue;
+    OperationMessageRecorder recorder;
+
+    script::ScriptTask task("test", true, [&]() { task.setProgress(0.5f, "Halfway"); }, queue.getDispatcher());
+
+    runTask(task, queue);
+
+    ASSERT_EQ(recorder.entries.size(), 3);
+
+    // The views keep rendering while the task is running
+    EXPECT_EQ(recorder.entries[0].event, radiant::OperationEvent::Started);
+    EXPECT_EQ(recorder.entries[0].message, "test");
+    EXPECT_FALSE(recorder.entries[0].blocksScreenUpdates);
+
+    EXPECT_EQ(recorder.entries[1].event, radiant::OperationEvent::Progress);
+    EXPECT_EQ(recorder.entries[1].message, "Halfway");
+    EXPECT_EQ(recorder.entries[1].progress, 0.5f);
+
+    EXPECT_EQ(recorder.entries[2].event, radiant::OperationEvent::Finished);
+
+    for (const auto& entry : recorder.entries)
+    {
+        EXPECT_EQ(entry.threadId, std::this_thread::get_id()) << "Messages should be sent by the calling thread";
+    }
+}
+
+TEST_F(ScriptTaskTest, ProgressUpdatesAreThrottled)
+{
+    DispatchQueue queue;
+    OperationMessageRecorder recorder;
+
+    script::ScriptTask task("test", true, [&]()
+    {
+        for (int i = 0; i < 1000; ++i)
+        {
+            task.setProgress(i / 1000.0f, "Counting");
+        }
+    }, queue.getDispatcher());
+
+    runTask(task, queue);
+
+    EXPECT_GE(recorder.count(radiant::OperationEvent::Progress), 1);
+    EXPECT_LT(recorder.count(radiant::OperationEvent::Progress), 1000);
+}
+
+TEST_F(ScriptTaskTest, CancellationThroughProgressMessage)
+{
+    DispatchQueue queue;
+    OperationMessageRecorder recorder;
+    recorder.cancelOnProgress = true;
+
+    bool cancelled = false;
+
+    script::ScriptTask task("test", true, [&]()
+    {
+        try
+        {
+            // Runs until the cancellation request of the progress message arrives
+            while (true)
+            {
+                task.setProgress(-1, "Running");
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        catch (const script::ScriptTask::Cancelled&)
+        {
+            cancelled = true;
+            throw;
+        }
+    }, queue.getDispatcher());
+
+    runTask(task, queue);
+
+    EXPECT_TRUE(cancelled);
+    EXPECT_TRUE(task.isCancelled());
+    EXPECT_EQ(recorder.count(radiant::OperationEvent::Finished), 1);
+}
+
+TEST_F(ScriptTaskTest, CancellationFromCallingThread)
+{
+    DispatchQueue queue;
+    std::atomic<bool> running(false);
+    bool cancelled = false;
+
+    script::ScriptTask task("test", true, [&]()
+    {
+        running = true;
+
+        try
+        {
+            while (true)
+            {
+                task.setProgress(-1, "Running");
+            }
+        }
+        catch (const script::ScriptTask::Cancelled&)
+        {
+            cancelled = true;
+        }
+    }, queue.getDispatcher());
+
+    bool finished = false;
+
+    task.start([&]()
+    {
+        task.wait();
+        finished = true;
+    });
+
+    queue.processUntil([&]() { return running.load(); });
+    task.cancel();
+    queue.processUntil([&]() { return finished; });
+
+    EXPECT_TRUE(cancelled);
+}
+
+TEST_F(ScriptTaskTest, SceneBatchesRunOnCallingThreadInOneUndoStep)
+{
+    DispatchQueue queue;
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+    auto childrenBefore = algorithm::getChildCount(worldspawn);
+    std::vector<std::thread::id> batchThreads;
+
+    script::ScriptTask task("test", false, [&]()
+    {
+        for (int i = 0; i < 2; ++i)
+        {
+            task.modifyScene([&]()
+            {
+                batchThreads.push_back(std::this_thread::get_id());
+                algorithm::createCubicBrush(worldspawn, Vector3(i * 128, 0, 0));
+            });
+        }
+    }, queue.getDispatcher());
+
+    runTask(task, queue);
+
+    ASSERT_EQ(batchThreads.size(), 2);
+    EXPECT_EQ(batchThreads[0], std::this_thread::get_id());
+    EXPECT_EQ(batchThreads[1], std::this_thread::get_id());
+    EXPECT_EQ(algorithm::getChildCount(worldspawn), childrenBefore + 2);
+
+    // Both batches are reverted by a single undo
+    GlobalCommandSystem().executeCommand("Undo");
+    EXPECT_EQ(algorithm::getChildCount(worldspawn), childrenBefore);
+}
+
+TEST_F(ScriptTaskTest, ReadOnlyTaskCannotModifyScene)
+{
+    DispatchQueue queue;
+    bool batchExecuted = false;
+    bool refused = false;
+
+    script::ScriptTask task("test", true, [&]()
+    {
+        try
+        {
+            task.modifyScene([&]() { batchExecuted = true; });
+        }
+        catch (const std::logic_error&)
+        {
+            refused = true;
+        }
+    }, queue.getDispatcher());
+
+    runTask(task, queue);
+
+    EXPECT_TRUE(refused);
+    EXPECT_FALSE(batchExecuted);
+}
+
+TEST_F(ScriptTaskTest, CancellationAbandonsQueuedBatch)
+{
+    DispatchQueue queue;
+    bool batchExecuted = false;
+    std::atomic<bool> cancelled(false);
+
+    script::ScriptTask task("test", false, [&]()
+    {
+        try
+        {
+            task.modifyScene([&]() { batchExecuted = true; });
+        }
+        catch (const script::ScriptTask::Cancelled&)
+        {
+            cancelled = true;
+        }
+    }, queue.getDispatcher());
+
+    bool finished = false;
+
+    task.start([&]()
+    {
+        task.wait();
+        finished = true;
+    });
+
+    // Cancel while the batch is waiting to be processed
+    while (queue.size() == 0)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    task.cancel();
+
+    while (!cancelled)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    queue.processUntil([&]() { return finished; });
+
+    EXPECT_FALSE(batchExecuted);
+}
+
+TEST_F(ScriptTaskTest, BatchExceptionIsPropagated)
+{
+    DispatchQueue queue;
+    std::string error;
+
+    script::ScriptTask task("test", false, [&]()
+    {
+        try
+        {
+            task.modifyScene([&]() { throw std::runtime_error("Batch failed"); });
+        }
+        catch (const std::runtime_error& ex)
+        {
+            error = ex.what();
+        }
+    }, queue.getDispatcher());
+
+    runTask(task, queue);
+
+    EXPECT_EQ(error, "Batch failed");
+}
+
+}
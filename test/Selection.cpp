@@ -16,6 +16,7 @@
 #include "scenelib.h"
 #include "selectionlib.h"
 #include "string/convert.h"
+#include "string/replace.h"
 #include "render/View.h"
 #include "render/CameraView.h"
 #include "selection/SelectionVolume.h"
@@ -625,4 +626,92 @@ TEST_F(ClipboardTest, CopyFaceSelection)
     EXPECT_EQ(GlobalShaderClipboard().getShaderName(), "textures/common/caulk") << "Shaderclipboard should contain the material name now";
 }
 
+TEST_F(ClipboardTest, PasteCopiedSelection)
+{
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+    auto brush = algorithm::createCubicBrush(worldspawn, { 0, 0, 0 }, "textures/common/caulk");
+    Node_setSelected(brush, true);
+
+    GlobalCommandSystem().executeCommand("Copy");
+    EXPECT_EQ(algorithm::getChildCount(worldspawn), 1);
+
+    GlobalCommandSystem().executeCommand("Paste");
+
+    EXPECT_EQ(algorithm::getChildCount(worldspawn), 2) << "Paste should have added a brush to the worldspawn";
+    EXPECT_FALSE(Node_isSelected(brush)) << "Original brush should have been de-selected";
+    EXPECT_EQ(GlobalSelectionSystem().countSelected(), 1) << "The pasted brush should be selected";
+
+    auto pastedBrush = GlobalSelectionSystem().ultimateSelected();
+    EXPECT_NE(pastedBrush, brush) << "Paste should have created a new brush";
+    EXPECT_TRUE(pastedBrush->inScene());
+    EXPECT_TRUE(Node_getIBrush(pastedBrush)->hasShader("textures/common/caulk"));
+    EXPECT_EQ(pastedBrush->worldAABB().getOrigin(), brush->worldAABB().getOrigin()) << "Pasted brush should be at the same position";
+
+    // The same contents can be pasted more than once
+    GlobalCommandSystem().executeCommand("Paste");
+    EXPECT_EQ(algorithm::getChildCount(worldspawn), 3) << "Second paste should have added another brush";
+
+    GlobalCommandSystem().executeCommand("Undo");
+    GlobalCommandSystem().executeCommand("Undo");
+    EXPECT_EQ(algorithm::getChildCount(worldspawn), 1) << "Pasted brushes should be gone after undo";
+}
+
+TEST_F(ClipboardTest, PasteUsesContentsAtTimeOfCopy)
+{
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+    auto brush = algorithm::createCubicBrush(worldspawn, { 0, 0, 0 }, "textures/common/caulk");
+    Node_setSelected(brush, true);
+
+    GlobalCommandSystem().executeCommand("Copy");
+
+    // Changing the original after copying must not affect the pasted brush
+    Node_getIBrush(brush)->setShader("textures/common/nodraw");
+
+    GlobalCommandSystem().executeCommand("Paste");
+
+    EXPECT_EQ(algorithm::getChildCount(worldspawn), 2) << "Paste should have added a brush to the worldspawn";
+    EXPECT_TRUE(algorithm::findFirstBrushWithMaterial(worldspawn, "textures/common/caulk"))
+        << "Pasted brush should have the material it had when it was copied";
+}
+
+TEST_F(ClipboardTest, PasteChangedClipboardText)
+{
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+    auto brush = algorithm::createCubicBrush(worldspawn, { 0, 0, 0 }, "textures/common/caulk");
+    Node_setSelected(brush, true);
+
+    GlobalCommandSystem().executeCommand("Copy");
+
+    // Someone else replaced the clipboard contents, the text needs to be parsed
+    auto contents = GlobalClipboard().getString();
+    string::replace_all(contents, "textures/common/caulk", "textures/common/nodraw");
+    GlobalClipboard().setString(contents);
+
+    GlobalCommandSystem().executeCommand("Paste");
+
+    EXPECT_EQ(algorithm::getChildCount(worldspawn), 2) << "Paste should have added a brush to the worldspawn";
+    EXPECT_TRUE(algorithm::findFirstBrushWithMaterial(worldspawn, "textures/common/nodraw"))
+        << "Pasted brush should have been created from the clipboard text";
+}
+
+TEST_F(ClipboardTest, PasteCopiedEntity)
+{
+    auto entity = GlobalEntityModule().createEntity(GlobalEntityClassManager().findClass("func_static"));
+    scene::addNodeToContainer(entity, GlobalMapModule().getRoot());
+    algorithm::createCubicBrush(entity, { 0, 0, 0 }, "textures/common/caulk");
+
+    auto originalName = Node_getEntity(entity)->getKeyValue("name");
+    Node_setSelected(entity, true);
+
+    GlobalCommandSystem().executeCommand("Copy");
+    GlobalCommandSystem().executeCommand("Paste");
+
+    EXPECT_EQ(GlobalSelectionSystem().countSelected(), 1) << "The pasted entity should be selected";
+
+    auto pastedEntity = GlobalSelectionSystem().ultimateSelected();
+    EXPECT_NE(pastedEntity, entity) << "Paste should have created a new entity";
+    EXPECT_NE(Node_getEntity(pastedEntity)->getKeyValue("name"), originalName) << "Pasted entity should have been renamed";
+    EXPECT_EQ(algorithm::getChildCount(pastedEntity), 1) << "Pasted entity should have its child brush";
+}
+
 }
@@ -0,0 +1,193 @@
+#include "RadiantTest.h"
+
+#include <fstream>
+#include <thread>
+#include "icommandsystem.h"
+#include "iregistry.h"
+#include "iundo.h"
+#include "algorithm/Scene.h"
+#include "time/Tracing.h"
+
+namespace test
+{
+
+using TracingTest = RadiantTest;
+
+namespace
+{
+
+std::string loadTextFile(const fs::path& path)
+{
+    std::ifstream stream(path);
+    return std::string((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+}
+
+void performUndoableOperation()
+{
+    {
+        UndoableCommand command("tracingTestOperation");
+        algorithm::setWorldspawnKeyValue("tracing_test", "1");
+    }
+
+    GlobalCommandSystem().executeCommand("Undo");
+}
+
+}
+
+TEST_F(TracingTest, TraceBufferKeepsMostRecentEvents)
+{
+    util::TraceBuffer buffer(1);
+
+    // Use the start time to identify the events
+    auto epoch = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0; i < util::TraceBuffer::Capacity + 10; ++i)
+    {
+        buffer.add("test", "event", std::string(), epoch + std::chrono::microseconds(i), std::chrono::microseconds(1));
+    }
+
+    EXPECT_EQ(buffer.getNumEvents(), util::TraceBuffer::Capacity);
+
+    std::size_t expectedIndex = 10;
+
+    buffer.foreachEvent([&](const util::TraceEvent& event)
+    {
+        EXPECT_EQ(event.start, epoch + std::chrono::microseconds(expectedIndex)) << "Events out of order";
+        ++expectedIndex;
+    });
+
+    EXPECT_EQ(expectedIndex, util::TraceBuffer::Capacity + 10);
+
+    buffer.clear();
+    EXPECT_EQ(buffer.getNumEvents(), 0);
+
+    buffer.foreachEvent([&](const util::TraceEvent& event)
+    {
+        FAIL() << "Buffer should be empty after clear";
+    });
+
+    // Recording continues after clearing
+    buffer.add("test", "after clear", std::string(), epoch, std::chrono::microseconds(1));
+    EXPECT_EQ(buffer.getNumEvents(), 1);
+}
+
+TEST_F(TracingTest, TraceBufferTruncatesLongDetails)
+{
+    util::TraceBuffer buffer(1);
+
+    std::string shortDetail = "maps/altar.map";
+    std::string longDetail = std::string(200, 'x') + "/maps/altar.map";
+
+    buffer.add("test", "short", shortDetail, std::chrono::steady_clock::now(), std::chrono::microseconds(1));
+    buffer.add("test", "long", longDetail, std::chrono::steady_clock::now(), std::chrono::microseconds(1));
+
+    std::vector<std::string> details;
+
+    buffer.foreachEvent([&](const util::TraceEvent& event)
+    {
+        details.push_back(event.detail);
+    });
+
+    ASSERT_EQ(details.size(), 2);
+    EXPECT_EQ(details[0], shortDetail);
+
+    // The end of the detail is kept
+    EXPECT_EQ(details[1].length(), util::TraceEvent::MaxDetailLength);
+    EXPECT_EQ(details[1].substr(0, 3), "...");
+    EXPECT_EQ(details[1].substr(details[1].length() - 15), "/maps/altar.map");
+}
+
+// The owning thread keeps adding events while another one is reading the buffer
+TEST_F(TracingTest, TraceBufferCanBeReadWhileWriting)
+{
+    constexpr std::size_t NumEvents = util::TraceBuffer::Capacity * 20;
+
+    util::TraceBuffer buffer(1);
+    auto epoch = std::chrono::steady_clock::now();
+
+    std::thread writer([&]()
+    {
+        for (std::size_t i = 0; i < NumEvents; ++i)
+        {
+            // The detail duplicates the event number, to detect torn events
+            buffer.add("test", "event", std::to_string(i), epoch + std::chrono::microseconds(i), std::chrono::microseconds(1));
+        }
+    });
+
+    std::size_t numReads = 0;
+    bool failed = false;
+
+    while (!failed && (numReads < 10 || buffer.getNumEvents() < util::TraceBuffer::Capacity))
+    {
+        std::size_t previous = 0;
+        bool first = true;
+
+        buffer.foreachEvent([&](const util::TraceEvent& event)
+        {
+            auto index = static_cast<std::size_t>(std::chrono::duration_cast<std::chrono::microseconds>(event.start - epoch).count());
+
+            if (std::to_string(index) != event.detail || (!first && index != previous + 1))
+            {
+                failed = true;
+            }
+
+            previous = index;
+            first = false;
+        });
+
+        ++numReads;
+    }
+
+    writer.join();
+
+    EXPECT_FALSE(failed) << "Read a torn or missing event";
+    EXPECT_EQ(buffer.getNumEvents(), util::TraceBuffer::Capacity);
+}
+
+TEST_F(TracingTest, SaveTraceWritesRecordedEvents)
+{
+    fs::path tracePath = _context.getTemporaryDataPath();
+    tracePath /= "trace.json";
+
+    GlobalCommandSystem().executeCommand("ToggleTracing");
+
+    GlobalCommandSystem().executeCommand("OpenMap", cmd::Argument("maps/altar.map"));
+    performUndoableOperation();
+
+    GlobalCommandSystem().executeCommand("SaveTrace", tracePath.string());
+    GlobalCommandSystem().executeCommand("ToggleTracing");
+
+    auto trace = loadTextFile(tracePath);
+
+    EXPECT_EQ(trace.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["), 0);
+    EXPECT_NE(trace.find("\"name\":\"thread_name\""), std::string::npos);
+    EXPECT_NE(trace.find("\"name\":\"Load map\",\"cat\":\"map\",\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(trace.find("\"cat\":\"vfs\""), std::string::npos);
+    EXPECT_NE(trace.find("altar.map\"}"), std::string::npos) << "Map path should be attached to the event";
+    EXPECT_NE(trace.find("\"name\":\"Undo\",\"cat\":\"undo\""), std::string::npos);
+    EXPECT_NE(trace.find("\"args\":{\"detail\":\"tracingTestOperation\"}"), std::string::npos);
+}
+
+TEST_F(TracingTest, NothingIsRecordedWhileDisabled)
+{
+    fs::path tracePath = _context.getTemporaryDataPath();
+    tracePath /= "trace.json";
+
+    GlobalCommandSystem().executeCommand("OpenMap", cmd::Argument("maps/altar.map"));
+
+    // Enabling discards the previous events
+    GlobalCommandSystem().executeCommand("ToggleTracing");
+    GlobalCommandSystem().executeCommand("ToggleTracing");
+
+    performUndoableOperation();
+
+    GlobalCommandSystem().executeCommand("SaveTrace", tracePath.string());
+
+    auto trace = loadTextFile(tracePath);
+
+    EXPECT_EQ(trace.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["), 0);
+    EXPECT_EQ(trace.find("\"name\":\"Undo\""), std::string::npos);
+    EXPECT_EQ(trace.find("\"name\":\"Load map\""), std::string::npos);
+}
+
+}
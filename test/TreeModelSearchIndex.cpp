@@ -0,0 +1,263 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "wxutil/dataview/TreeModel.h"
+#include "wxutil/dataview/TreeModelSearchIndex.h"
+
+namespace test
+{
+
+namespace
+{
+
+struct SearchColumns :
+    public wxutil::TreeModel::ColumnRecord
+{
+    SearchColumns() :
+        name(add(wxutil::TreeModel::Column::IconText)),
+        path(add(wxutil::TreeModel::Column::String)),
+        number(add(wxutil::TreeModel::Column::Integer))
+    {}
+
+    wxutil::TreeModel::Column name;
+    wxutil::TreeModel::Column path;
+    wxutil::TreeModel::Column number;
+};
+
+class TreeModelSearchIndexTest :
+    public testing::Test
+{
+protected:
+    SearchColumns _columns;
+    wxutil::TreeModel::Ptr _model;
+
+    void SetUp() override
+    {
+        _model = new wxutil::TreeModel(_columns);
+    }
+
+    void TearDown() override
+    {
+        _model.reset();
+    }
+
+    wxutil::TreeModel::Row addRow(const wxDataViewItem& parent, const std::string& name, const std::string& path)
+    {
+        auto row = _model->AddItem(parent);
+
+        row[_columns.name] = wxVariant(wxDataViewIconText(wxString::FromUTF8(name)));
+        row[_columns.path] = wxString::FromUTF8(path);
+        row[_columns.number] = 1234;
+        row.SendItemAdded();
+
+        return row;
+    }
+
+    wxutil::TreeModel::Row addRow(const std::string& name, const std::string& path)
+    {
+        return addRow(_model->GetRoot(), name, path);
+    }
+
+    std::vector<wxutil::TreeModel::Column> getSearchColumns()
+    {
+        return { _columns.name, _columns.path };
+    }
+
+    // Returns the (UTF-8) names of the items containing the given UTF-8 needle, sorted
+    std::vector<std::string> findNames(wxutil::TreeModelSearchIndex& index, const std::string& needle)
+    {
+        std::vector<std::string> names;
+
+        for (const auto& item : index.FindItemsContainingString(wxString::FromUTF8(needle)))
+        {
+            wxutil::TreeModel::Row row(item, *_model);
+            names.push_back(row[_columns.name].getString().ToUTF8().data());
+        }
+
+        std::sort(names.begin(), names.end());
+        return names;
+    }
+};
+
+using Names = std::vector<std::string>;
+
+}
+
+TEST_F(TreeModelSearchIndexTest, FindsSubstringsInAllColumns)
+{
+    addRow("stone_wall", "textures/stone/wall");
+    addRow("wood_floor", "textures/wood/floor");
+    addRow("marble", "textures/stone/marble");
+
+    wxutil::TreeModelSearchIndex index(*_model, getSearchColumns());
+
+    EXPECT_EQ(findNames(index, "stone"), Names({ "marble", "stone_wall" }));
+    EXPECT_EQ(findNames(index, "floor"), Names({ "wood_floor" }));
+    EXPECT_EQ(findNames(index, "textures/"), Names({ "marble", "stone_wall", "wood_floor" }));
+    EXPECT_EQ(findNames(index, "granite"), Names());
+
+    // All trigrams are present, but not in this order
+    EXPECT_EQ(findNames(index, "wallstone"), Names());
+
+    // The values of the columns are not joined into one string
+    EXPECT_EQ(findNames(index, "marbletextures"), Names());
+
+    // Non-indexed columns are not searched
+    EXPECT_EQ(findNames(index, "1234"), Names());
+}
+
+TEST_F(TreeModelSearchIndexTest, ShortNeedles)
+{
+    addRow("ab", "x");
+    addRow("abc", "y");
+    addRow("cab", "z");
+
+    wxutil::TreeModelSearchIndex index(*_model, getSearchColumns());
+
+    // Needles shorter than a trigram are checked against all rows
+    EXPECT_EQ(findNames(index, "a"), Names({ "ab", "abc", "cab" }));
+    EXPECT_EQ(findNames(index, "ab"), Names({ "ab", "abc", "cab" }));
+    EXPECT_EQ(findNames(index, "bc"), Names({ "abc" }));
+    EXPECT_EQ(findNames(index, "y"), Names({ "abc" }));
+    EXPECT_EQ(findNames(index, "q"), Names());
+
+    // The empty string is contained in every row
+    EXPECT_EQ(findNames(index, ""), Names({ "ab", "abc", "cab" }));
+
+    // Values shorter than three characters don't contribute any trigrams
+    EXPECT_EQ(findNames(index, "abc"), Names({ "abc" }));
+}
+
+TEST_F(TreeModelSearchIndexTest, ValuesAreCaseFolded)
+{
+    addRow("Stone_Wall", "Textures/STONE/Wall");
+    addRow("GRÜN", "textures/colours");
+
+    wxutil::TreeModelSearchIndex index(*_model, getSearchColumns());
+
+    // The needle is expected in lower case, the values are folded by the index
+    EXPECT_EQ(findNames(index, "stone_wall"), Names({ "Stone_Wall" }));
+    EXPECT_EQ(findNames(index, "textures/stone"), Names({ "Stone_Wall" }));
+    EXPECT_EQ(findNames(index, "st"), Names({ "Stone_Wall" }));
+
+    // Non-ASCII characters are folded too
+    EXPECT_EQ(findNames(index, "grün"), Names({ "GRÜN" }));
+
+    // Short needles are matched in UTF-8 as well
+    EXPECT_EQ(findNames(index, "ün"), Names({ "GRÜN" }));
+}
+
+TEST_F(TreeModelSearchIndexTest, FollowsAddedAndChangedRows)
+{
+    auto row = addRow("stone", "textures/stone");
+
+    wxutil::TreeModelSearchIndex index(*_model, getSearchColumns());
+
+    EXPECT_EQ(findNames(index, "stone"), Names({ "stone" }));
+
+    addRow("wood", "textures/wood");
+    EXPECT_EQ(findNames(index, "wood"), Names({ "wood" }));
+
+    row[_columns.name] = wxVariant(wxDataViewIconText("granite"));
+    row[_columns.path] = std::string("textures/granite");
+    row.SendItemChanged();
+
+    // The old value must not be found anymore, and the new one only once
+    EXPECT_EQ(findNames(index, "stone"), Names());
+    EXPECT_EQ(findNames(index, "granite"), Names({ "granite" }));
+    EXPECT_EQ(findNames(index, "textures"), Names({ "granite", "wood" }));
+}
+
+TEST_F(TreeModelSearchIndexTest, RebuildsAfterManyChanges)
+{
+    std::vector<wxutil::TreeModel::Row> rows;
+
+    for (int i = 0; i < 10; ++i)
+    {
+        rows.push_back(addRow("row" + std::to_string(i), "original"));
+    }
+
+    wxutil::TreeModelSearchIndex index(*_model, getSearchColumns());
+
+    // Keep changing the rows, such that the obsolete entries are exceeding the threshold
+    for (int pass = 0; pass < 5; ++pass)
+    {
+        for (auto& row : rows)
+        {
+            row[_columns.path] = "pass" + std::to_string(pass);
+            row.SendItemChanged();
+        }
+
+        // Every row must be found exactly once, whether the index has been rebuilt or not
+        EXPECT_EQ(index.FindItemsContainingString("row").size(), rows.size());
+        EXPECT_EQ(index.FindItemsContainingString("pass" + std::to_string(pass)).size(), rows.size());
+        EXPECT_TRUE(index.FindItemsContainingString("original").empty());
+
+        if (pass > 0)
+        {
+            EXPECT_TRUE(index.FindItemsContainingString("pass" + std::to_string(pass - 1)).empty());
+        }
+    }
+
+    // The items found are still valid items of the model
+    for (const auto& item : index.FindItemsContainingString("row"))
+    {
+        EXPECT_TRUE(item.IsOk());
+        EXPECT_EQ(_model->GetParent(item), _model->GetRoot());
+    }
+}
+
+TEST_F(TreeModelSearchIndexTest, RebuildsAfterItemDeleted)
+{
+    auto folder = addRow("folder", "textures/stone");
+    addRow(folder.getItem(), "child", "textures/stone/child");
+    addRow("sibling", "textures/stone/sibling");
+
+    wxutil::TreeModelSearchIndex index(*_model, getSearchColumns());
+
+    EXPECT_EQ(findNames(index, "stone"), Names({ "child", "folder", "sibling" }));
+
+    // Only the folder is signalled, its child is removed as well
+    EXPECT_TRUE(_model->RemoveItem(folder.getItem()));
+
+    EXPECT_EQ(findNames(index, "stone"), Names({ "sibling" }));
+    EXPECT_EQ(findNames(index, "child"), Names());
+}
+
+TEST_F(TreeModelSearchIndexTest, RebuildsAfterClear)
+{
+    addRow("stone", "textures/stone");
+    addRow("wood", "textures/wood");
+
+    wxutil::TreeModelSearchIndex index(*_model, getSearchColumns());
+
+    EXPECT_EQ(findNames(index, "textures"), Names({ "stone", "wood" }));
+
+    _model->Clear();
+
+    EXPECT_EQ(findNames(index, "textures"), Names());
+    EXPECT_EQ(findNames(index, "st"), Names());
+
+    // Rows added after clearing are indexed again
+    addRow("granite", "textures/granite");
+
+    EXPECT_EQ(findNames(index, "textures"), Names({ "granite" }));
+}
+
+TEST_F(TreeModelSearchIndexTest, ModelRebuildsIndexForOtherColumns)
+{
+    addRow("stone", "textures/granite");
+
+    std::vector<wxutil::TreeModel::Column> nameColumn = { _columns.name };
+    std::vector<wxutil::TreeModel::Column> pathColumn = { _columns.path };
+
+    EXPECT_EQ(_model->FindItemsContainingString("granite", nameColumn).size(), 0u);
+    EXPECT_EQ(_model->FindItemsContainingString("granite", pathColumn).size(), 1);
+    EXPECT_EQ(_model->FindItemsContainingString("stone", pathColumn).size(), 0u);
+    EXPECT_EQ(_model->FindItemsContainingString("stone", nameColumn).size(), 1);
+}
+
+}
@@ -240,4 +240,27 @@ TEST_F(VfsTest, GetFileInfo)
     EXPECT_EQ(info.visibility, vfs::Visibility::HIDDEN);
 }
 
+TEST_F(VfsTest, InitialisedSignalIsEmittedOnReinitialisation)
+{
+    // Copy the current configuration, it's cleared during shutdown
+    auto searchPaths = GlobalFileSystem().getVfsSearchPaths();
+    auto extensions = GlobalFileSystem().getArchiveExtensions();
+
+    std::size_t signalCount = 0;
+    bool fileWasAvailable = false;
+
+    auto connection = GlobalFileSystem().signal_Initialised().connect([&]()
+    {
+        ++signalCount;
+        fileWasAvailable = GlobalFileSystem().getFileCount("materials/example.mtr") == 1;
+    });
+
+    GlobalFileSystem().initialise(searchPaths, extensions);
+    connection.disconnect();
+
+    EXPECT_EQ(signalCount, 1) << "Signal should have been emitted exactly once";
+    EXPECT_TRUE(fileWasAvailable) << "Files should be available when the signal is emitted";
+    EXPECT_TRUE(GlobalFileSystem().isInitialised());
+}
+
 }
@@ -0,0 +1,395 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <fmt/format.h>
+
+#include "imap.h"
+#include "ibrush.h"
+#include "ipatch.h"
+#include "ientity.h"
+#include "ieclass.h"
+#include "icommandsystem.h"
+#include "math/AABB.h"
+#include "math/Matrix4.h"
+#include "math/pi.h"
+
+namespace test
+{
+
+namespace algorithm
+{
+
+/**
+ * Parameters of the synthetic maps produced by the MapGenerator.
+ * All counts are exact, the same settings will always produce the same map.
+ */
+struct MapGeneratorSettings
+{
+    // Brushes of the worldspawn, arranged in a grid, some of them are prisms
+    std::size_t numWorldspawnBrushes = 1000;
+
+    // Number of patches (9x9 control points each) forming a square terrain below the brushes
+    std::size_t numTerrainPatches = 64;
+
+    // func_static entities holding brushes and patches, bound to each other in chains
+    std::size_t numFuncStatics = 20;
+    std::size_t primitivesPerFuncStatic = 8;
+    std::size_t funcStaticBindChainLength = 4;
+
+    // Model-based func_statics and lights, scattered above the brush grid
+    std::size_t numModels = 50;
+    std::size_t numLights = 50;
+
+    std::uint32_t seed = 1;
+
+    std::size_t getNumPrimitives() const
+    {
+        return numWorldspawnBrushes + numTerrainPatches + numFuncStatics * primitivesPerFuncStatic;
+    }
+
+    // Returns settings for a map with the given number of primitives,
+    // 80% of them worldspawn brushes, the rest terrain and func_static primitives.
+    static MapGeneratorSettings ForPrimitiveCount(std::size_t numPrimitives)
+    {
+        MapGeneratorSettings settings;
+
+        settings.numTerrainPatches = numPrimitives / 10;
+        settings.numFuncStatics = numPrimitives / 10 / settings.primitivesPerFuncStatic;
+        settings.numWorldspawnBrushes = numPrimitives - settings.numTerrainPatches -
+            settings.numFuncStatics * settings.primitivesPerFuncStatic;
+        settings.numModels = numPrimitives / 100;
+        settings.numLights = numPrimitives / 100;
+
+        return settings;
+    }
+};
+
+/**
+ * Produces deterministic large maps for scalability tests and benchmarks:
+ * a grid of worldspawn brushes on top of a patch terrain, brush-based
+ * func_statics bound to each other, model func_statics and lights.
+ *
+ * The nodes are inserted into the currently loaded map, use WriteMap()
+ * to save it in one of the supported formats.
+ */
+class MapGenerator
+{
+public:
+    static constexpr double CellSize = 128;
+    static constexpr double TerrainPatchSize = 512;
+
+private:
+    MapGeneratorSettings _settings;
+
+    // The raw engine output is the same on all platforms, the std distributions are not
+    std::minstd_rand _random;
+
+    std::size_t _cellsPerRow;
+
+public:
+    MapGenerator(const MapGeneratorSettings& settings) :
+        _settings(settings),
+        _random(settings.seed),
+        _cellsPerRow(getGridSize(settings.numWorldspawnBrushes))
+    {}
+
+    // Populates the current map, usually a freshly created one
+    void generate()
+    {
+        auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+
+        for (std::size_t i = 0; i < _settings.numWorldspawnBrushes; ++i)
+        {
+            createWorldspawnBrush(worldspawn, i);
+        }
+
+        createTerrain(worldspawn);
+        createFuncStatics();
+        createModels();
+        createLights();
+    }
+
+    // Returns the bounds of the area covered by the brush grid
+    AABB getGridBounds() const
+    {
+        auto extent = _cellsPerRow * CellSize;
+        return AABB::createFromMinMax(Vector3(0, 0, 0), Vector3(extent, extent, CellSize * 2));
+    }
+
+    // Returns the world origin of the given cell of the brush grid
+    Vector3 getCellOrigin(std::size_t cell) const
+    {
+        return Vector3((cell % _cellsPerRow + 0.5) * CellSize, (cell / _cellsPerRow + 0.5) * CellSize, CellSize / 2);
+    }
+
+    const MapGeneratorSettings& getSettings() const
+    {
+        return _settings;
+    }
+
+    // Generates a map using the given settings, replacing the current one.
+    // The returned generator can be used to query the layout of the map.
+    static MapGenerator GenerateMap(const MapGeneratorSettings& settings)
+    {
+        GlobalMapModule().createNewMap();
+
+        MapGenerator generator(settings);
+        generator.generate();
+
+        return generator;
+    }
+
+    // Saves a copy of the current map, the format is determined by the file extension
+    // (.map for the Doom 3 format, .mapx for the portable one)
+    static void WriteMap(const std::string& path)
+    {
+        GlobalCommandSystem().executeCommand("SaveMapCopyAs", cmd::Argument(path));
+    }
+
+private:
+    static std::size_t getGridSize(std::size_t numCells)
+    {
+        return std::max(static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(numCells)))), std::size_t(1));
+    }
+
+    // Returns a random number in the range [min..max]
+    std::size_t nextInt(std::size_t min, std::size_t max)
+    {
+        return min + _random() % (max - min + 1);
+    }
+
+    double nextDouble(double min, double max)
+    {
+        return min + (max - min) * (_random() - _random.min()) / (_random.max() - _random.min());
+    }
+
+    // Returns a vector with random integer components in the range [min..max]
+    Vector3 nextVector(std::size_t min, std::size_t max)
+    {
+        // Separate statements, the evaluation order of function arguments is unspecified
+        auto x = nextInt(min, max);
+        auto y = nextInt(min, max);
+        auto z = nextInt(min, max);
+
+        return Vector3(static_cast<double>(x), static_cast<double>(y), static_cast<double>(z));
+    }
+
+    std::string getRandomMaterial()
+    {
+        return nextInt(0, 9) == 0 ? "textures/common/caulk" : fmt::format("textures/numbers/{0}", nextInt(0, 9));
+    }
+
+    IEntityNodePtr createEntity(const std::string& className, const std::string& name)
+    {
+        auto eclass = GlobalEntityClassManager().findOrInsert(className, true);
+        auto entity = GlobalEntityModule().createEntity(eclass);
+
+        entity->getEntity().setKeyValue("name", name);
+        GlobalMapModule().getRoot()->addChildNode(entity);
+
+        return entity;
+    }
+
+    void createWorldspawnBrush(const scene::INodePtr& parent, std::size_t cell)
+    {
+        auto origin = getCellOrigin(cell);
+        auto extents = nextVector(8, 56);
+
+        // Every fifth brush is a prism with more faces, the rest are cuboids
+        if (cell % 5 == 4)
+        {
+            createPrism(parent, origin, extents, nextInt(5, 12));
+        }
+        else
+        {
+            createCuboid(parent, AABB(origin, extents));
+        }
+    }
+
+    void createCuboid(const scene::INodePtr& parent, const AABB& bounds)
+    {
+        auto brushNode = GlobalBrushCreator().createBrush();
+        parent->addChildNode(brushNode);
+
+        auto& brush = *Node_getIBrush(brushNode);
+        const auto& origin = bounds.getOrigin();
+        const auto& extents = bounds.getExtents();
+
+        brush.addFace(Plane3(+1, 0, 0, origin.x() + extents.x()));
+        brush.addFace(Plane3(-1, 0, 0, -origin.x() + extents.x()));
+        brush.addFace(Plane3(0, +1, 0, origin.y() + extents.y()));
+        brush.addFace(Plane3(0, -1, 0, -origin.y() + extents.y()));
+        brush.addFace(Plane3(0, 0, +1, origin.z() + extents.z()));
+        brush.addFace(Plane3(0, 0, -1, -origin.z() + extents.z()));
+
+        brush.setShader(getRandomMaterial());
+        brush.evaluateBRep();
+    }
+
+    void createPrism(const scene::INodePtr& parent, const Vector3& origin, const Vector3& extents, std::size_t numSides)
+    {
+        auto brushNode = GlobalBrushCreator().createBrush();
+        parent->addChildNode(brushNode);
+
+        auto& brush = *Node_getIBrush(brushNode);
+        auto translation = Matrix4::getTranslation(origin);
+        auto radius = std::min(extents.x(), extents.y());
+
+        for (std::size_t side = 0; side < numSides; ++side)
+        {
+            auto angle = 2 * math::PI * side / numSides;
+            brush.addFace(Plane3(Vector3(cos(angle), sin(angle), 0), radius).transform(translation));
+        }
+
+        brush.addFace(Plane3(0, 0, +1, extents.z()).transform(translation));
+        brush.addFace(Plane3(0, 0, -1, extents.z()).transform(translation));
+
+        brush.setShader(getRandomMaterial());
+        brush.evaluateBRep();
+    }
+
+    // The height of the terrain at the given control point, continuous across patch borders
+    double getTerrainHeight(std::size_t x, std::size_t y) const
+    {
+        auto noise = ((x * 73856093) ^ (y * 19349663) ^ _settings.seed) % 17;
+        return -CellSize * 2 + 48 * sin(x * 0.35) * cos(y * 0.25) + static_cast<double>(noise);
+    }
+
+    void createTerrain(const scene::INodePtr& parent)
+    {
+        constexpr std::size_t PatchSize = 9;
+        auto patchesPerRow = getGridSize(_settings.numTerrainPatches);
+
+        for (std::size_t i = 0; i < _settings.numTerrainPatches; ++i)
+        {
+            auto patchNode = GlobalPatchModule().createPatch(patch::PatchDefType::Def2);
+            parent->addChildNode(patchNode);
+
+            auto& patch = *Node_getIPatch(patchNode);
+            patch.setDims(PatchSize, PatchSize);
+            patch.setShader("textures/numbers/0");
+
+            // Position of the first control point of this patch in the terrain grid
+            auto firstX = (i % patchesPerRow) * (PatchSize - 1);
+            auto firstY = (i / patchesPerRow) * (PatchSize - 1);
+            auto spacing = TerrainPatchSize / (PatchSize - 1);
+
+            for (std::size_t col = 0; col < PatchSize; ++col)
+            {
+                for (std::size_t row = 0; row < PatchSize; ++row)
+                {
+                    auto x = firstX + col;
+                    auto y = firstY + row;
+
+                    auto& control = patch.ctrlAt(row, col);
+                    control.vertex = Vector3(x * spacing, y * spacing, getTerrainHeight(x, y));
+                    control.texcoord = Vector2(x * spacing / 256, y * spacing / 256);
+                }
+            }
+
+            patch.controlPointsChanged();
+        }
+    }
+
+    void createFuncStatics()
+    {
+        auto bounds = getGridBounds();
+        std::string bindMaster;
+
+        for (std::size_t i = 0; i < _settings.numFuncStatics; ++i)
+        {
+            auto name = fmt::format("generated_static_{0}", i);
+            auto entity = createEntity("func_static", name);
+
+            auto x = nextDouble(bounds.origin.x() - bounds.extents.x(), bounds.origin.x() + bounds.extents.x());
+            auto y = nextDouble(bounds.origin.y() - bounds.extents.y(), bounds.origin.y() + bounds.extents.y());
+            auto origin = Vector3(x, y, CellSize * 3);
+
+            entity->getEntity().setKeyValue("origin", fmt::format("{0} {1} {2}", origin.x(), origin.y(), origin.z()));
+
+            // Each func_static is bound to the previous one of its chain
+            if (i % std::max(_settings.funcStaticBindChainLength, std::size_t(1)) != 0)
+            {
+                entity->getEntity().setKeyValue("bind", bindMaster);
+            }
+
+            bindMaster = name;
+
+            for (std::size_t p = 0; p < _settings.primitivesPerFuncStatic; ++p)
+            {
+                auto offset = Vector3((p % 4) * 32.0, (p / 4) * 32.0, 0);
+
+                if (p % 4 == 3)
+                {
+                    createBumpyPatch(entity, origin + offset);
+                }
+                else
+                {
+                    createCuboid(entity, AABB(origin + offset, nextVector(4, 16)));
+                }
+            }
+        }
+    }
+
+    void createBumpyPatch(const scene::INodePtr& parent, const Vector3& origin)
+    {
+        constexpr std::size_t PatchSize = 5;
+
+        auto patchNode = GlobalPatchModule().createPatch(patch::PatchDefType::Def2);
+        parent->addChildNode(patchNode);
+
+        auto& patch = *Node_getIPatch(patchNode);
+        patch.setDims(PatchSize, PatchSize);
+        patch.setShader(getRandomMaterial());
+
+        for (std::size_t col = 0; col < PatchSize; ++col)
+        {
+            for (std::size_t row = 0; row < PatchSize; ++row)
+            {
+                auto& control = patch.ctrlAt(row, col);
+                control.vertex = origin + Vector3(col * 8.0, row * 8.0, (row + col) % 2 == 0 ? 0.0 : 8.0);
+                control.texcoord = Vector2(col * 0.25, row * 0.25);
+            }
+        }
+
+        patch.controlPointsChanged();
+    }
+
+    void createModels()
+    {
+        static const char* const Models[] = { "models/moss_patch.ase", "models/torch.lwo", "models/twosided_ivy.lwo" };
+
+        for (std::size_t i = 0; i < _settings.numModels; ++i)
+        {
+            auto entity = createEntity("func_static", fmt::format("generated_model_{0}", i));
+            auto origin = getCellOrigin(nextInt(0, _cellsPerRow * _cellsPerRow - 1)) + Vector3(0, 0, CellSize);
+
+            entity->getEntity().setKeyValue("model", Models[i % std::size(Models)]);
+            entity->getEntity().setKeyValue("origin", fmt::format("{0} {1} {2}", origin.x(), origin.y(), origin.z()));
+            entity->getEntity().setKeyValue("angle", std::to_string(nextInt(0, 359)));
+        }
+    }
+
+    void createLights()
+    {
+        for (std::size_t i = 0; i < _settings.numLights; ++i)
+        {
+            auto entity = createEntity("light", fmt::format("generated_light_{0}", i));
+            auto origin = getCellOrigin(nextInt(0, _cellsPerRow * _cellsPerRow - 1)) + Vector3(0, 0, CellSize * 1.5);
+            auto radius = nextInt(64, 512);
+
+            entity->getEntity().setKeyValue("origin", fmt::format("{0} {1} {2}", origin.x(), origin.y(), origin.z()));
+            entity->getEntity().setKeyValue("light_radius", fmt::format("{0} {0} {0}", radius));
+            auto colour = nextVector(0, 10) / 10.0;
+            entity->getEntity().setKeyValue("_color", fmt::format("{0} {1} {2}", colour.x(), colour.y(), colour.z()));
+        }
+    }
+};
+
+}
+
+}
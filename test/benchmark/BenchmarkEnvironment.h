@@ -0,0 +1,40 @@
+#pragma once
+
+#include "RadiantTest.h"
+
+namespace test
+{
+
+/**
+ * Starts up the radiant core module and the test game environment
+ * the same way the RadiantTest fixture does, but only once for the
+ * whole benchmark run instead of once per test case.
+ */
+class BenchmarkEnvironment :
+    public RadiantTest
+{
+public:
+    void startup()
+    {
+        SetUp();
+    }
+
+    void shutdown()
+    {
+        TearDown();
+    }
+
+    const radiant::TestContext& getContext() const
+    {
+        return _context;
+    }
+
+    // The benchmarks are not run through the GoogleTest framework
+    void TestBody() override
+    {}
+};
+
+// The environment of the running drbench process, available after startup
+BenchmarkEnvironment& GlobalBenchmarkEnvironment();
+
+}
@@ -0,0 +1,49 @@
+#include "BenchmarkEnvironment.h"
+
+#include <benchmark/benchmark.h>
+
+/**
+ * Entry point of the drbench executable. The core module is started once,
+ * headless, then all registered benchmarks are run. Use the Google Benchmark
+ * options to filter and to get machine-readable results, e.g.
+ *
+ * drbench --benchmark_filter=Brush --benchmark_out=results.json --benchmark_out_format=json
+ */
+namespace test
+{
+
+namespace
+{
+    BenchmarkEnvironment* _environment = nullptr;
+}
+
+BenchmarkEnvironment& GlobalBenchmarkEnvironment()
+{
+    return *_environment;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    benchmark::Initialize(&argc, argv);
+
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+
+    test::BenchmarkEnvironment environment;
+    test::_environment = &environment;
+
+    environment.startup();
+
+    benchmark::RunSpecifiedBenchmarks();
+
+    environment.shutdown();
+    test::_environment = nullptr;
+
+    benchmark::Shutdown();
+
+    return 0;
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cmath>
+#include "imap.h"
+#include "ibrush.h"
+#include "ipatch.h"
+#include "scenelib.h"
+#include "math/pi.h"
+
+#include "algorithm/MapGenerator.h"
+
+namespace test
+{
+
+namespace benchmark_scene
+{
+
+/**
+ * Discards the current map and generates a new one with about the given
+ * number of primitives. The returned generator describes the map layout.
+ *
+ * Benchmark functions are invoked several times while determining the
+ * iteration count, the map is only generated again if it has been
+ * replaced or the number of primitives has changed in the meantime.
+ */
+inline algorithm::MapGenerator populateScene(std::size_t numPrimitives)
+{
+    static std::weak_ptr<scene::IMapRootNode> _generatedRoot;
+    static algorithm::MapGenerator _generator(algorithm::MapGeneratorSettings::ForPrimitiveCount(0));
+
+    if (_generatedRoot.lock() != GlobalMapModule().getRoot() ||
+        _generator.getSettings().getNumPrimitives() != numPrimitives)
+    {
+        _generator = algorithm::MapGenerator::GenerateMap(algorithm::MapGeneratorSettings::ForPrimitiveCount(numPrimitives));
+        _generatedRoot = GlobalMapModule().getRoot();
+    }
+
+    return _generator;
+}
+
+// Adds a brush shaped like a prism with the given number of sides (at least 3) to the given parent
+inline scene::INodePtr createPrismBrush(const scene::INodePtr& parent, std::size_t numSides)
+{
+    auto brushNode = GlobalBrushCreator().createBrush();
+    parent->addChildNode(brushNode);
+
+    auto& brush = *Node_getIBrush(brushNode);
+
+    for (std::size_t side = 0; side < numSides; ++side)
+    {
+        auto angle = 2 * math::PI * side / numSides;
+        brush.addFace(Plane3(Vector3(cos(angle), sin(angle), 0), 64));
+    }
+
+    brush.addFace(Plane3(0, 0, +1, 64));
+    brush.addFace(Plane3(0, 0, -1, 64));
+
+    brush.setShader("textures/numbers/1");
+    brush.evaluateBRep();
+
+    return brushNode;
+}
+
+// Adds a curved patch with the given number of control points in each direction (odd, at least 3)
+inline scene::INodePtr createCurvedPatch(const scene::INodePtr& parent, std::size_t size)
+{
+    auto patchNode = GlobalPatchModule().createPatch(patch::PatchDefType::Def2);
+    parent->addChildNode(patchNode);
+
+    auto& patch = *Node_getIPatch(patchNode);
+    patch.setDims(size, size);
+    patch.setShader("textures/numbers/2");
+
+    for (std::size_t col = 0; col < size; ++col)
+    {
+        for (std::size_t row = 0; row < size; ++row)
+        {
+            // Alternating heights produce a bumpy surface, requiring subdivision
+            patch.ctrlAt(row, col).vertex = Vector3(col * 64.0, row * 64.0, (row + col) % 2 == 0 ? 0 : 48);
+            patch.ctrlAt(row, col).texcoord = Vector2(col * 0.5, row * 0.5);
+        }
+    }
+
+    patch.controlPointsChanged();
+
+    return patchNode;
+}
+
+}
+
+}
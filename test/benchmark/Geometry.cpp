@@ -0,0 +1,149 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+#include "render/ContinuousBuffer.h"
+#include "render/GeometryStore.h"
+#include "testutil/TestBufferObjectProvider.h"
+#include "testutil/TestSyncObjectProvider.h"
+#include "testutil/RenderUtils.h"
+
+namespace test
+{
+
+namespace
+{
+    TestBufferObjectProvider _testBufferObjectProvider;
+}
+
+// Allocates the given number of chunks with random sizes, then releases and re-allocates every other
+void ContinuousBuffer_AllocateDeallocate(benchmark::State& state)
+{
+    auto numAllocations = static_cast<std::size_t>(state.range(0));
+
+    std::minstd_rand rand(17); // fixed seed
+    std::uniform_int_distribution<std::size_t> sizeDistribution(4, 256);
+
+    std::vector<std::size_t> sizes(numAllocations);
+    std::generate(sizes.begin(), sizes.end(), [&]() { return sizeDistribution(rand); });
+
+    std::vector<render::ContinuousBuffer<render::RenderVertex>::Handle> handles(numAllocations);
+
+    for (auto _ : state)
+    {
+        render::ContinuousBuffer<render::RenderVertex> buffer;
+
+        for (std::size_t i = 0; i < numAllocations; ++i)
+        {
+            handles[i] = buffer.allocate(sizes[i]);
+        }
+
+        // Punch holes into the buffer and fill them again with chunks of a different size
+        for (std::size_t i = 0; i < numAllocations; i += 2)
+        {
+            buffer.deallocate(handles[i]);
+        }
+
+        for (std::size_t i = 0; i < numAllocations; i += 2)
+        {
+            handles[i] = buffer.allocate(sizes[numAllocations - i - 1]);
+        }
+
+        for (auto handle : handles)
+        {
+            buffer.deallocate(handle);
+        }
+
+        benchmark::DoNotOptimize(buffer.getNumAllocatedElements());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * numAllocations * 2));
+}
+BENCHMARK(ContinuousBuffer_AllocateDeallocate)->Arg(1000)->Arg(10000);
+
+// Rewrites the data of all slots each frame, like a scene being transformed as a whole
+void GeometryStore_UpdateData(benchmark::State& state)
+{
+    auto numSlots = static_cast<std::size_t>(state.range(0));
+    render::GeometryStore store(TestSyncObjectProvider::Instance(), _testBufferObjectProvider);
+
+    // A cuboid brush has 24 vertices, rendered using 36 indices
+    auto vertices = generateVertices(0, 24);
+    auto indices = generateIndices(vertices);
+    indices.resize(36);
+
+    std::vector<render::IGeometryStore::Slot> slots;
+
+    store.onFrameStart();
+
+    for (std::size_t i = 0; i < numSlots; ++i)
+    {
+        slots.push_back(store.allocateSlot(vertices.size(), indices.size()));
+        store.updateData(slots.back(), vertices, indices);
+    }
+
+    store.onFrameFinished();
+
+    for (auto _ : state)
+    {
+        store.onFrameStart();
+
+        for (auto slot : slots)
+        {
+            store.updateData(slot, vertices, indices);
+        }
+
+        store.syncToBufferObjects();
+        store.onFrameFinished();
+    }
+
+    for (auto slot : slots)
+    {
+        store.deallocateSlot(slot);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * numSlots));
+}
+BENCHMARK(GeometryStore_UpdateData)->Arg(1000)->Arg(10000);
+
+// Re-allocates a fraction of the slots each frame, like primitives being created and deleted
+void GeometryStore_AllocateDeallocate(benchmark::State& state)
+{
+    auto numSlots = static_cast<std::size_t>(state.range(0));
+    render::GeometryStore store(TestSyncObjectProvider::Instance(), _testBufferObjectProvider);
+
+    auto vertices = generateVertices(0, 24);
+    auto indices = generateIndices(vertices);
+
+    std::vector<render::IGeometryStore::Slot> slots;
+
+    for (std::size_t i = 0; i < numSlots; ++i)
+    {
+        slots.push_back(store.allocateSlot(vertices.size(), indices.size()));
+    }
+
+    std::size_t nextSlot = 0;
+
+    for (auto _ : state)
+    {
+        store.onFrameStart();
+
+        // Replace every tenth slot per frame
+        for (std::size_t i = 0; i < numSlots / 10; ++i)
+        {
+            auto& slot = slots[nextSlot];
+            nextSlot = (nextSlot + 1) % numSlots;
+
+            store.deallocateSlot(slot);
+            slot = store.allocateSlot(vertices.size(), indices.size());
+            store.updateData(slot, vertices, indices);
+        }
+
+        store.onFrameFinished();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * (numSlots / 10)));
+}
+BENCHMARK(GeometryStore_AllocateDeallocate)->Arg(1000)->Arg(10000);
+
+}
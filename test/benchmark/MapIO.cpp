@@ -0,0 +1,255 @@
+#include "BenchmarkEnvironment.h"
+#include "BenchmarkScene.h"
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <fstream>
+#include <sstream>
+#include "icommandsystem.h"
+#include "imapformat.h"
+#include "imapresource.h"
+#include "iselection.h"
+#include "os/fs.h"
+#include "os/path.h"
+#include "scene/BasicRootNode.h"
+
+namespace test
+{
+
+namespace
+{
+
+// Collects the parsed nodes below a root node which is not part of the scene
+class BenchmarkImportFilter :
+    public map::IMapImportFilter
+{
+private:
+    scene::IMapRootNodePtr _root;
+
+public:
+    BenchmarkImportFilter() :
+        _root(std::make_shared<scene::BasicRootNode>())
+    {}
+
+    const scene::IMapRootNodePtr& getRootNode() const override
+    {
+        return _root;
+    }
+
+    bool addEntity(const scene::INodePtr& entityNode) override
+    {
+        _root->addChildNode(entityNode);
+        return true;
+    }
+
+    bool addPrimitiveToEntity(const scene::INodePtr& primitive, const scene::INodePtr& entity) override
+    {
+        entity->addChildNode(primitive);
+        return true;
+    }
+};
+
+// The formats are selected by the second benchmark argument
+map::MapFormatPtr getMapFormat(int64_t index)
+{
+    return index == 0 ?
+        GlobalMapFormatManager().getMapFormatForGameType("doom3", "map") :
+        GlobalMapFormatManager().getMapFormatByName(map::PORTABLE_MAP_FORMAT_NAME);
+}
+
+// Generates a map file with the given number of primitives in the temporary data folder, unless it exists
+std::string getGeneratedMapFile(std::size_t numPrimitives, int64_t formatIndex, std::uint32_t seed = 1)
+{
+    auto path = fmt::format("{0}generated_{1}_{2}.{3}", GlobalBenchmarkEnvironment().getContext().getTemporaryDataPath(),
+        numPrimitives, seed, formatIndex == 0 ? "map" : "mapx");
+
+    if (!fs::exists(path))
+    {
+        auto settings = algorithm::MapGeneratorSettings::ForPrimitiveCount(numPrimitives);
+        settings.seed = seed;
+
+        algorithm::MapGenerator::GenerateMap(settings);
+        algorithm::MapGenerator::WriteMap(path);
+    }
+
+    return path;
+}
+
+std::string exportScene(const map::MapFormatPtr& format)
+{
+    GlobalSelectionSystem().setSelectedAll(true);
+
+    std::ostringstream output;
+    GlobalMapModule().exportSelected(output, format);
+
+    GlobalSelectionSystem().setSelectedAll(false);
+
+    return output.str();
+}
+
+// Writes a prefab with the given number of func_statics named func_static_1 .. func_static_N, unless it exists
+std::string getNamedEntitiesPrefabFile(std::size_t numEntities)
+{
+    auto path = fmt::format("{0}named_entities_{1}.pfb", GlobalBenchmarkEnvironment().getContext().getTemporaryDataPath(), numEntities);
+
+    if (!fs::exists(path))
+    {
+        std::ofstream stream(path);
+
+        stream << "Version 2\n// entity 0\n{\n\"classname\" \"worldspawn\"\n}\n";
+
+        for (std::size_t i = 1; i <= numEntities; ++i)
+        {
+            stream << fmt::format("// entity {0}\n{{\n\"classname\" \"func_static\"\n\"name\" \"func_static_{0}\"\n"
+                "\"origin\" \"{1} 0 0\"\n}}\n", i, i * 16);
+        }
+    }
+
+    return path;
+}
+
+}
+
+void Map_Write(benchmark::State& state)
+{
+    auto format = getMapFormat(state.range(1));
+    benchmark_scene::populateScene(static_cast<std::size_t>(state.range(0)));
+
+    state.SetLabel(format->getMapFormatName());
+
+    std::size_t numBytes = 0;
+
+    for (auto _ : state)
+    {
+        numBytes += exportScene(format).size();
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(numBytes));
+}
+BENCHMARK(Map_Write)->ArgsProduct({ { 10000, 50000 }, { 0, 1 } })->Unit(benchmark::kMillisecond);
+
+void Map_Read(benchmark::State& state)
+{
+    auto format = getMapFormat(state.range(1));
+    benchmark_scene::populateScene(static_cast<std::size_t>(state.range(0)));
+
+    state.SetLabel(format->getMapFormatName());
+
+    auto mapText = exportScene(format);
+
+    std::unique_ptr<BenchmarkImportFilter> filter;
+
+    for (auto _ : state)
+    {
+        // Don't measure the destruction of the nodes parsed in the previous iteration
+        state.PauseTiming();
+        filter = std::make_unique<BenchmarkImportFilter>();
+        std::istringstream input(mapText);
+        state.ResumeTiming();
+
+        format->getMapReader(*filter)->readFromStream(input);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * mapText.size()));
+}
+BENCHMARK(Map_Read)->ArgsProduct({ { 10000, 50000 }, { 0, 1 } })->Unit(benchmark::kMillisecond);
+
+// Loads a generated map file through the regular map loading code
+void Map_Load(benchmark::State& state)
+{
+    auto path = getGeneratedMapFile(static_cast<std::size_t>(state.range(0)), state.range(1));
+
+    for (auto _ : state)
+    {
+        GlobalCommandSystem().executeCommand("OpenMap", cmd::Argument(path));
+    }
+
+    state.SetLabel(os::getExtension(path));
+}
+BENCHMARK(Map_Load)->ArgsProduct({ { 10000, 50000 }, { 0, 1 } })->Unit(benchmark::kMillisecond);
+
+// Compares a generated map to one generated with a different seed, producing lots of merge actions
+void Map_MergeOperation(benchmark::State& state)
+{
+    auto numPrimitives = static_cast<std::size_t>(state.range(0));
+    auto sourcePath = getGeneratedMapFile(numPrimitives, 0, 2);
+    auto path = getGeneratedMapFile(numPrimitives, 0);
+
+    GlobalCommandSystem().executeCommand("OpenMap", cmd::Argument(path));
+
+    for (auto _ : state)
+    {
+        GlobalCommandSystem().executeCommand("StartMergeOperation", cmd::Argument(sourcePath));
+
+        state.PauseTiming();
+        GlobalCommandSystem().executeCommand("AbortMergeOperation");
+        state.ResumeTiming();
+    }
+}
+BENCHMARK(Map_MergeOperation)->Arg(10000)->Arg(50000)->Unit(benchmark::kMillisecond);
+
+// Imports a prefab into a map which already contains all of its entity names,
+// every imported entity needs to be renamed
+void Prefab_ImportConflictingNames(benchmark::State& state)
+{
+    auto path = getNamedEntitiesPrefabFile(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        GlobalMapModule().createNewMap();
+        GlobalCommandSystem().executeCommand("LoadPrefabAt", path, Vector3(0, 0, 0), 0);
+        state.ResumeTiming();
+
+        GlobalCommandSystem().executeCommand("LoadPrefabAt", path, Vector3(0, 0, 0), 0);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * state.range(0)));
+}
+BENCHMARK(Prefab_ImportConflictingNames)->Arg(1000)->Arg(5000)->Unit(benchmark::kMillisecond);
+
+std::string getAltarMapPath()
+{
+    return GlobalBenchmarkEnvironment().getContext().getTestProjectPath() + "maps/altar.map";
+}
+
+// Parses a map file into a new resource, like the prefab preview does
+void MapResource_Load(benchmark::State& state)
+{
+    auto path = getAltarMapPath();
+
+    for (auto _ : state)
+    {
+        auto resource = GlobalMapResourceManager().createFromPath(path);
+        benchmark::DoNotOptimize(resource->load());
+
+        // Don't measure the destruction of the parsed nodes
+        state.PauseTiming();
+        resource.reset();
+        state.ResumeTiming();
+    }
+}
+BENCHMARK(MapResource_Load)->Unit(benchmark::kMillisecond);
+
+// Copies the nodes of a loaded resource instead of parsing the file again,
+// like inserting the previewed prefab does
+void MapResource_CopyLoaded(benchmark::State& state)
+{
+    auto path = getAltarMapPath();
+
+    auto loadedResource = GlobalMapResourceManager().createFromPath(path);
+    loadedResource->load();
+
+    for (auto _ : state)
+    {
+        auto resource = GlobalMapResourceManager().createFromLoadedResource(path);
+        benchmark::DoNotOptimize(resource);
+
+        state.PauseTiming();
+        resource.reset();
+        state.ResumeTiming();
+    }
+}
+BENCHMARK(MapResource_CopyLoaded)->Unit(benchmark::kMillisecond);
+
+}
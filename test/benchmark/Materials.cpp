@@ -0,0 +1,78 @@
+#include "BenchmarkEnvironment.h"
+
+#include <benchmark/benchmark.h>
+#include "ishaders.h"
+#include "ishaderexpression.h"
+#include "ishaderlayer.h"
+
+namespace test
+{
+
+namespace
+{
+
+const char* const ShaderExpressions[] =
+{
+    "0.5",
+    "time * 0.25 + 1",
+    "sinTable[time * 0.1] * 0.5 + 0.5",
+    "(cosTable[time] * 2 - 1) * (sinTable[time * 0.3] > 0.5 && time >= 2)",
+    "((time * 0.1) % 3 + parm3 * 4) / (1 + global0) - sinTable[time * 0.05 + 0.25] * cosTable[time * 0.7]",
+};
+
+}
+
+void ShaderExpression_Evaluate(benchmark::State& state)
+{
+    auto exprString = ShaderExpressions[state.range(0)];
+    auto expr = GlobalMaterialManager().createShaderExpressionFromString(exprString);
+
+    if (!expr)
+    {
+        state.SkipWithError("Failed to parse the shader expression");
+        return;
+    }
+
+    state.SetLabel(exprString);
+
+    std::size_t time = 0;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(expr->getValue(time));
+        time += 16;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(ShaderExpression_Evaluate)->DenseRange(0, std::size(ShaderExpressions) - 1);
+
+void ShaderExpression_Parse(benchmark::State& state)
+{
+    auto exprString = ShaderExpressions[state.range(0)];
+    state.SetLabel(exprString);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(GlobalMaterialManager().createShaderExpressionFromString(exprString));
+    }
+}
+BENCHMARK(ShaderExpression_Parse)->DenseRange(0, std::size(ShaderExpressions) - 1);
+
+// Evaluates all expressions of a material stage, as done by the renderer each frame
+void ShaderLayer_EvaluateExpressions(benchmark::State& state)
+{
+    auto material = GlobalMaterialManager().getMaterial("textures/parsertest/expressions/rotationCalculation");
+    auto& stage = material->getAllLayers().front();
+
+    std::size_t time = 0;
+
+    for (auto _ : state)
+    {
+        stage->evaluateExpressions(time);
+        time += 16;
+    }
+}
+BENCHMARK(ShaderLayer_EvaluateExpressions);
+
+}
@@ -0,0 +1,76 @@
+#include "BenchmarkEnvironment.h"
+
+#include <benchmark/benchmark.h>
+#include <fstream>
+#include <sstream>
+#include "os/fs.h"
+#include "parser/DefTokeniser.h"
+
+namespace test
+{
+
+namespace
+{
+
+// Concatenates the material files of the test project
+std::string loadMaterialSources()
+{
+    std::stringstream content;
+
+    fs::path materialsPath = GlobalBenchmarkEnvironment().getContext().getTestProjectPath();
+    materialsPath /= "materials";
+
+    for (const auto& entry : fs::directory_iterator(materialsPath))
+    {
+        if (entry.path().extension() != ".mtr") continue;
+
+        std::ifstream stream(entry.path());
+        content << stream.rdbuf() << "\n";
+    }
+
+    return content.str();
+}
+
+}
+
+void DefTokeniser_StringThroughput(benchmark::State& state)
+{
+    auto source = loadMaterialSources();
+    std::size_t numTokens = 0;
+
+    for (auto _ : state)
+    {
+        parser::BasicDefTokeniser<std::string> tokeniser(source);
+
+        while (tokeniser.hasMoreTokens())
+        {
+            benchmark::DoNotOptimize(tokeniser.nextToken());
+            ++numTokens;
+        }
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * source.size()));
+    state.counters["tokens"] = benchmark::Counter(static_cast<double>(numTokens), benchmark::Counter::kIsRate);
+}
+BENCHMARK(DefTokeniser_StringThroughput);
+
+void DefTokeniser_StreamThroughput(benchmark::State& state)
+{
+    auto source = loadMaterialSources();
+
+    for (auto _ : state)
+    {
+        std::istringstream stream(source);
+        parser::BasicDefTokeniser<std::istream> tokeniser(stream);
+
+        while (tokeniser.hasMoreTokens())
+        {
+            benchmark::DoNotOptimize(tokeniser.nextToken());
+        }
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * source.size()));
+}
+BENCHMARK(DefTokeniser_StreamThroughput);
+
+}
@@ -0,0 +1,64 @@
+#include "BenchmarkEnvironment.h"
+#include "BenchmarkScene.h"
+
+#include <benchmark/benchmark.h>
+#include "irender.h"
+#include "render/View.h"
+#include "render/CamRenderer.h"
+#include "render/RenderableCollectionWalker.h"
+
+#include "algorithm/View.h"
+
+namespace test
+{
+
+namespace
+{
+
+// The flags of the textured camera mode
+constexpr unsigned int TexturedModeRenderFlags = RENDER_DEPTHTEST | RENDER_MASKCOLOUR | RENDER_DEPTHWRITE |
+    RENDER_ALPHATEST | RENDER_BLEND | RENDER_CULLFACE | RENDER_OFFSETLINE | RENDER_VERTEX_COLOUR |
+    RENDER_POINT_COLOUR | RENDER_FILL | RENDER_LIGHTING | RENDER_TEXTURE_2D | RENDER_SMOOTH | RENDER_SCALED;
+
+}
+
+// Renders a frame of a camera looking down on the generated map: the front end collecting
+// the renderables (argument 1 == 0) or the whole frame including the back end (argument 1 == 1)
+void Render_CameraView(benchmark::State& state)
+{
+    auto generator = benchmark_scene::populateScene(static_cast<std::size_t>(state.range(0)));
+    auto renderBackEnd = state.range(1) == 1;
+
+    render::View view(true);
+    algorithm::constructCameraView(view, generator.getGridBounds(), Vector3(0, 0, -1), Vector3(-90, 0, 0));
+
+    render::CamRenderer::HighlightShaders highlightShaders;
+    render::CamRenderer renderer(view, highlightShaders);
+
+    IRenderResult::Ptr result;
+
+    for (auto _ : state)
+    {
+        GlobalRenderSystem().startFrame();
+
+        renderer.prepare();
+        render::RenderableCollectionWalker::CollectRenderablesInScene(renderer, view);
+
+        if (renderBackEnd)
+        {
+            result = GlobalRenderSystem().renderFullBrightScene(RenderViewType::Camera, TexturedModeRenderFlags, view);
+        }
+
+        renderer.cleanup();
+
+        GlobalRenderSystem().endFrame();
+    }
+
+    if (result)
+    {
+        state.SetLabel(result->toString());
+    }
+}
+BENCHMARK(Render_CameraView)->ArgsProduct({ { 10000, 100000 }, { 0, 1 } })->Unit(benchmark::kMillisecond);
+
+}
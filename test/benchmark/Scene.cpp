@@ -0,0 +1,290 @@
+#include "BenchmarkEnvironment.h"
+#include "BenchmarkScene.h"
+
+#include <benchmark/benchmark.h>
+#include "iscenegraph.h"
+#include "ispacepartition.h"
+#include "iselection.h"
+#include "ifilter.h"
+#include "render/View.h"
+#include "selection/SelectionVolume.h"
+
+#include "algorithm/View.h"
+
+namespace test
+{
+
+namespace
+{
+
+// Collects the primitives below the worldspawn
+std::vector<scene::INodePtr> getWorldspawnChildren()
+{
+    std::vector<scene::INodePtr> nodes;
+
+    GlobalMapModule().findOrInsertWorldspawn()->foreachNode([&](const scene::INodePtr& node)
+    {
+        nodes.push_back(node);
+        return true;
+    });
+
+    return nodes;
+}
+
+class CountingVisitor :
+    public scene::NodeVisitor
+{
+public:
+    std::size_t numVisited = 0;
+
+    bool pre(const scene::INodePtr& node) override
+    {
+        ++numVisited;
+        return true;
+    }
+};
+
+}
+
+// Rebuilds the windings of a brush with the given number of sides
+void Brush_BuildWindings(benchmark::State& state)
+{
+    GlobalMapModule().createNewMap();
+
+    auto numSides = static_cast<std::size_t>(state.range(0));
+    auto brushNode = benchmark_scene::createPrismBrush(GlobalMapModule().findOrInsertWorldspawn(), numSides);
+    auto& brush = *Node_getIBrush(brushNode);
+
+    // Moving the brush back and forth changes all face planes, the B-Rep needs to be rebuilt
+    auto forth = Matrix4::getTranslation(Vector3(16, 8, 4));
+    auto back = Matrix4::getTranslation(Vector3(-16, -8, -4));
+    bool movedForth = false;
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < brush.getNumFaces(); ++i)
+        {
+            brush.getFace(i).transform(movedForth ? back : forth);
+            brush.getFace(i).freezeTransform();
+        }
+
+        movedForth = !movedForth;
+        brush.evaluateBRep();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(Brush_BuildWindings)->Arg(6)->Arg(16)->Arg(64);
+
+// Generates the tesselation of a curved patch with the given number of control points per row and column
+void Patch_Tesselation(benchmark::State& state)
+{
+    GlobalMapModule().createNewMap();
+
+    auto size = static_cast<std::size_t>(state.range(0));
+    auto patchNode = benchmark_scene::createCurvedPatch(GlobalMapModule().findOrInsertWorldspawn(), size);
+    auto& patch = *Node_getIPatch(patchNode);
+
+    for (auto _ : state)
+    {
+        patch.updateTesselation(true);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(Patch_Tesselation)->Arg(3)->Arg(9)->Arg(17)->Arg(33);
+
+// Creates the given number of brushes and appends them to the worldspawn
+void Scene_AddBrushes(benchmark::State& state)
+{
+    auto numBrushes = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state)
+    {
+        // Don't measure the destruction of the brushes added in the previous iteration
+        state.PauseTiming();
+        GlobalMapModule().createNewMap();
+        auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+        state.ResumeTiming();
+
+        for (std::size_t i = 0; i < numBrushes; ++i)
+        {
+            scene::addNodeToContainer(GlobalBrushCreator().createBrush(), worldspawn);
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * numBrushes));
+}
+BENCHMARK(Scene_AddBrushes)->Arg(10000)->Arg(80000)->Unit(benchmark::kMillisecond);
+
+// Visits the children of the worldspawn through foreachNode
+void Scene_ForeachNode(benchmark::State& state)
+{
+    benchmark_scene::populateScene(static_cast<std::size_t>(state.range(0)));
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+
+    std::size_t numVisited = 0;
+
+    for (auto _ : state)
+    {
+        worldspawn->foreachNode([&](const scene::INodePtr& node)
+        {
+            ++numVisited;
+            return true;
+        });
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(numVisited));
+}
+BENCHMARK(Scene_ForeachNode)->Arg(10000)->Arg(100000);
+
+// Visits the children of the worldspawn through traverseChildren
+void Scene_TraverseChildren(benchmark::State& state)
+{
+    benchmark_scene::populateScene(static_cast<std::size_t>(state.range(0)));
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+
+    CountingVisitor visitor;
+
+    for (auto _ : state)
+    {
+        worldspawn->traverseChildren(visitor);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(visitor.numVisited));
+}
+BENCHMARK(Scene_TraverseChildren)->Arg(10000)->Arg(100000);
+
+// Toggles a filter hiding entities by class and spawnarg and brushes by texture
+void Filter_Toggle(benchmark::State& state)
+{
+    benchmark_scene::populateScene(static_cast<std::size_t>(state.range(0)));
+
+    const std::string filterName = "BenchmarkFilter";
+
+    GlobalFilterSystem().addFilter(filterName, {
+        FilterRule::Create(FilterRule::TYPE_ENTITYCLASS, "light.*", false),
+        FilterRule::CreateEntityKeyValueRule("bind", ".*", false),
+        FilterRule::Create(FilterRule::TYPE_TEXTURE, "textures/common/.*", false),
+    });
+
+    bool active = false;
+
+    for (auto _ : state)
+    {
+        active = !active;
+        GlobalFilterSystem().setFilterState(filterName, active);
+    }
+
+    GlobalFilterSystem().setFilterState(filterName, false);
+    GlobalFilterSystem().removeFilter(filterName);
+}
+BENCHMARK(Filter_Toggle)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+// Unlinks and re-links all primitives from the space partition (the octree)
+void SpacePartition_LinkUnlink(benchmark::State& state)
+{
+    benchmark_scene::populateScene(static_cast<std::size_t>(state.range(0)));
+
+    auto spacePartition = GlobalSceneGraph().getSpacePartition();
+    auto nodes = getWorldspawnChildren();
+
+    for (auto _ : state)
+    {
+        for (const auto& node : nodes)
+        {
+            spacePartition->unlink(node);
+        }
+
+        for (const auto& node : nodes)
+        {
+            spacePartition->link(node);
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * nodes.size()));
+}
+BENCHMARK(SpacePartition_LinkUnlink)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+// Collects the nodes visible in a camera view looking down on the whole scene (argument 1 == 1)
+// or in an orthoview centered on the scene (argument 1 == 0)
+void SpacePartition_VolumeQuery(benchmark::State& state)
+{
+    auto generator = benchmark_scene::populateScene(static_cast<std::size_t>(state.range(0)));
+
+    auto bounds = generator.getGridBounds();
+    auto useCamera = state.range(1) == 1;
+
+    render::View view(useCamera);
+
+    if (useCamera)
+    {
+        algorithm::constructCameraView(view, bounds, Vector3(0, 0, -1), Vector3(-90, 0, 0));
+    }
+    else
+    {
+        algorithm::constructCenteredOrthoview(view, bounds.getOrigin());
+    }
+
+    std::size_t numVisibleNodes = 0;
+
+    for (auto _ : state)
+    {
+        numVisibleNodes = 0;
+
+        GlobalSceneGraph().foreachVisibleNodeInVolume(view, [&](const scene::INodePtr& node)
+        {
+            ++numVisibleNodes;
+            return true;
+        });
+    }
+
+    state.counters["visibleNodes"] = static_cast<double>(numVisibleNodes);
+}
+BENCHMARK(SpacePartition_VolumeQuery)->ArgsProduct({ { 10000, 100000 }, { 0, 1 } });
+
+// Point selection in an orthoview centered on a brush in the middle of the scene
+void Selection_SelectPoint(benchmark::State& state)
+{
+    auto generator = benchmark_scene::populateScene(static_cast<std::size_t>(state.range(0)));
+    auto center = generator.getCellOrigin(generator.getSettings().numWorldspawnBrushes / 2);
+
+    render::View view(false);
+    algorithm::constructCenteredOrthoview(view, center);
+
+    for (auto _ : state)
+    {
+        auto test = algorithm::constructOrthoviewSelectionTest(view);
+        GlobalSelectionSystem().selectPoint(test, selection::SelectionSystem::eReplace, false);
+    }
+
+    state.counters["selected"] = static_cast<double>(GlobalSelectionSystem().countSelected());
+
+    GlobalSelectionSystem().setSelectedAll(false);
+}
+BENCHMARK(Selection_SelectPoint)->Arg(10000)->Arg(100000);
+
+// Drag-selects everything within an orthoview centered on the scene
+void Selection_SelectArea(benchmark::State& state)
+{
+    auto generator = benchmark_scene::populateScene(static_cast<std::size_t>(state.range(0)));
+
+    render::View view(false);
+    algorithm::constructCenteredOrthoview(view, generator.getGridBounds().getOrigin());
+
+    for (auto _ : state)
+    {
+        render::View scissored(view);
+        ConstructSelectionTest(scissored, selection::Rectangle::ConstructFromArea(Vector2(-1, -1), Vector2(2, 2)));
+
+        SelectionVolume test(scissored);
+        GlobalSelectionSystem().selectArea(test, selection::SelectionSystem::eReplace, false);
+    }
+
+    state.counters["selected"] = static_cast<double>(GlobalSelectionSystem().countSelected());
+
+    GlobalSelectionSystem().setSelectedAll(false);
+}
+BENCHMARK(Selection_SelectArea)->Arg(10000)->Arg(100000);
+
+}